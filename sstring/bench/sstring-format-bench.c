@@ -0,0 +1,186 @@
+/**
+ * @file sstring-format-bench.c
+ * @brief Benchmark for the safe strings formatting functions
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * This file compares string_append_format() against the classic two-pass
+ * approach (measure with vsnprintf(NULL, 0, ...), then format) on typical
+ * log lines, both into a reused buffer and into a freshly created string,
+ * and the dedicated number appenders against their printf equivalents.
+ */
+
+#include <stdarg.h>
+#include <time.h>
+
+#include "sstring.h"
+
+/** @brief Number of log lines formatted per measurement */
+#define BENCH_ITERATIONS 1000000
+
+/** @brief Number of log lines kept in a reused buffer before it is cleared */
+#define BENCH_LINES_PER_FLUSH 64
+
+/**
+ * @brief Get a monotonic-enough timestamp in nanoseconds
+ * @return double Current time in nanoseconds
+ */
+static double bench_now_ns(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/**
+ * @brief Append formatted text by measuring first and formatting second
+ * @param str Destination string
+ * @param format Printf-style format string
+ * @param ... Variable arguments for format string
+ * @return string_result_t Success or error code
+ * @details Baseline reproducing the two-pass strategy
+ */
+static string_result_t two_pass_append_format(string_t *str, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+
+    va_list args_copy;
+    va_copy(args_copy, args);
+    int required_length = vsnprintf(NULL, 0, format, args_copy);
+    va_end(args_copy);
+
+    if (required_length < 0) {
+        va_end(args);
+        return STRING_ERROR_INVALID_ARGUMENT;
+    }
+
+    size_t new_length = str->length + (size_t)required_length;
+    string_result_t result = string_reserve(str, new_length + 1);
+    if (result == STRING_SUCCESS) {
+        vsnprintf(str->data + str->length, (size_t)required_length + 1, format, args);
+        str->length = new_length;
+    }
+
+    va_end(args);
+    return result;
+}
+
+/**
+ * @brief Signature shared by the benchmarked append functions
+ */
+typedef string_result_t (*bench_append_t)(string_t *str, const char *format, ...);
+
+/**
+ * @brief Format log lines into one reused buffer
+ * @param append Append function to benchmark
+ * @return double Average nanoseconds per line
+ */
+static double bench_reused_buffer(bench_append_t append) {
+    string_t *str = string_create_with_capacity(8192);
+    size_t checksum = 0;
+
+    double start = bench_now_ns();
+    for (int i = 0; i < BENCH_ITERATIONS; ++i) {
+        append(str, "%s [%-5s] worker-%02d: request %u handled in %.3f ms (%s)\n",
+               "2025-01-01T12:00:00Z", i % 7 ? "INFO" : "WARN", i % 16, (unsigned)i, (double)(i % 1000) / 7.0, "/api/v1/items");
+        if (i % BENCH_LINES_PER_FLUSH == BENCH_LINES_PER_FLUSH - 1) {
+            checksum += string_length(str);
+            string_clear(str);
+        }
+    }
+    double elapsed = bench_now_ns() - start;
+
+    string_destroy(str);
+    return checksum ? elapsed / BENCH_ITERATIONS : 0.0;
+}
+
+/**
+ * @brief Format each log line into a new short string
+ * @param append Append function to benchmark
+ * @return double Average nanoseconds per line
+ */
+static double bench_fresh_string(bench_append_t append) {
+    size_t checksum = 0;
+
+    double start = bench_now_ns();
+    for (int i = 0; i < BENCH_ITERATIONS; ++i) {
+        string_t *str = string_create_from_cstr("");
+        append(str, "id=%d status=%s", i, i % 3 ? "ok" : "retry");
+        checksum += string_length(str);
+        string_destroy(str);
+    }
+    double elapsed = bench_now_ns() - start;
+
+    return checksum ? elapsed / BENCH_ITERATIONS : 0.0;
+}
+
+/**
+ * @brief Append numbers with printf-style formatting
+ * @param str Destination string
+ * @param i Integer to append
+ * @param d Double to append
+ */
+static void numbers_with_format(string_t *str, int i, double d) {
+    string_append_format(str, "%d,%.17g;", i, d);
+}
+
+/**
+ * @brief Append numbers with the dedicated appenders
+ * @param str Destination string
+ * @param i Integer to append
+ * @param d Double to append
+ */
+static void numbers_with_appenders(string_t *str, int i, double d) {
+    string_append_int(str, i);
+    string_append_char(str, ',');
+    string_append_double(str, d);
+    string_append_char(str, ';');
+}
+
+/**
+ * @brief Append an integer and a double per iteration into a reused buffer
+ * @param append Number append strategy to benchmark
+ * @return double Average nanoseconds per iteration
+ */
+static double bench_numbers(void (*append)(string_t *, int, double)) {
+    string_t *str = string_create_with_capacity(8192);
+    size_t checksum = 0;
+
+    double start = bench_now_ns();
+    for (int i = 0; i < BENCH_ITERATIONS; ++i) {
+        append(str, i * 31, (double)i / 7.0);
+        if (i % BENCH_LINES_PER_FLUSH == BENCH_LINES_PER_FLUSH - 1) {
+            checksum += string_length(str);
+            string_clear(str);
+        }
+    }
+    double elapsed = bench_now_ns() - start;
+
+    string_destroy(str);
+    return checksum ? elapsed / BENCH_ITERATIONS : 0.0;
+}
+
+/**
+ * @brief Main benchmark runner function
+ * @details Prints the average cost per log line for each strategy
+ * @return int Returns 0 on completion
+ */
+int main(void) {
+    printf("Running strings formatting benchmark (%d lines per case)...\n\n", BENCH_ITERATIONS);
+
+    double two_pass = bench_reused_buffer(two_pass_append_format);
+    double single_pass = bench_reused_buffer(string_append_format);
+    printf("reused buffer: two-pass %8.1f ns/line, string_append_format %8.1f ns/line (%.2fx)\n",
+           two_pass, single_pass, two_pass / single_pass);
+
+    two_pass = bench_fresh_string(two_pass_append_format);
+    single_pass = bench_fresh_string(string_append_format);
+    printf("fresh string:  two-pass %8.1f ns/line, string_append_format %8.1f ns/line (%.2fx)\n",
+           two_pass, single_pass, two_pass / single_pass);
+
+    double formatted = bench_numbers(numbers_with_format);
+    double appended = bench_numbers(numbers_with_appenders);
+    printf("numbers:       \"%%d,%%.17g\" %8.1f ns/pair, string_append_int/double %8.1f ns/pair (%.2fx)\n",
+           formatted, appended, formatted / appended);
+
+    return 0;
+}
@@ -0,0 +1,539 @@
+/**
+ * @file sstring-micro-bench.c
+ * @brief Microbenchmarks for the safe strings hot paths
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * This file times creation, append growth, byte and substring search at
+ * several haystack sizes, formatting, comparison and trimming, each next to
+ * the closest libc baseline (malloc, realloc, memchr, memmem, snprintf,
+ * memcmp, isspace). Inputs come from a fixed-seed generator and every case
+ * reports the fastest of several timed runs, so results are repeatable on a
+ * quiet machine.
+ *
+ * Results are written as JSON, to stdout or to the file named by the first
+ * argument:
+ *
+ *     { "benchmark": "sstring", "simd": "avx2", "repeats": 7, "cases": [
+ *       { "name": "find_char", "variant": "end", "size": 4096,
+ *         "ns_per_op": 61.2, "baseline": "memchr", "baseline_ns_per_op": 58.0,
+ *         "ratio": 1.055 }, ... ] }
+ *
+ * ratio is ns_per_op over baseline_ns_per_op; values above 1 mean sstring is
+ * slower than the baseline.
+ */
+
+#define _GNU_SOURCE
+
+#include <ctype.h>
+#include <time.h>
+
+#include "sstring.h"
+
+/** @brief Number of timed runs per case; the fastest is reported */
+#define BENCH_REPEATS 7
+
+/** @brief Bytes scanned per timed run of the search cases */
+#define BENCH_BYTES_PER_RUN ((size_t)32 * 1024 * 1024)
+
+/** @brief Operations per timed run of the fixed-size cases */
+#define BENCH_OPS_PER_RUN 200000
+
+/** @brief Largest haystack used by the search cases */
+#define BENCH_MAX_SIZE ((size_t)1024 * 1024)
+
+/** @brief Keeps results alive so the compiler cannot drop the work */
+static volatile size_t bench_sink;
+
+/**
+ * @brief Make the compiler assume memory changed between iterations
+ * @details Without it, calls to pure libc functions such as memchr() on
+ *          unchanged input are hoisted out of the timing loops.
+ */
+#define BENCH_CLOBBER() __asm__ __volatile__("" ::: "memory")
+
+/**
+ * @brief Body of a benchmark case
+ * @param context Case-specific input
+ * @param iterations Number of operations to run
+ * @return size_t Checksum of the results
+ */
+typedef size_t (*bench_body_t)(void *context, size_t iterations);
+
+/**
+ * @brief Input shared by the benchmark bodies
+ */
+typedef struct {
+    string_t *str;         /**< Haystack or operand as a string */
+    const char *data;      /**< Same bytes as str, for the libc baselines */
+    size_t length;         /**< Number of bytes in data */
+    const char *needle;    /**< Needle or second operand */
+    size_t needle_length;  /**< Number of bytes in needle */
+} bench_input_t;
+
+/*
+ * ======================
+ * Timing and reporting
+ * ======================
+ */
+
+/**
+ * @brief Get a monotonic timestamp in nanoseconds
+ * @return double Current time in nanoseconds
+ */
+static double bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/**
+ * @brief Time a benchmark body
+ * @param body Body to run
+ * @param input Input passed to the body
+ * @param iterations Operations per timed run
+ * @return double Fastest time per operation over BENCH_REPEATS runs, in nanoseconds
+ */
+static double bench_measure(bench_body_t body, bench_input_t *input, size_t iterations) {
+    // Warm caches, branch predictors and the allocator first
+    bench_sink += body(input, iterations / 8 + 1);
+
+    double best = 0.0;
+    for (int run = 0; run < BENCH_REPEATS; ++run) {
+        double start = bench_now_ns();
+        bench_sink += body(input, iterations);
+        double elapsed = (bench_now_ns() - start) / (double)iterations;
+        if (run == 0 || elapsed < best) {
+            best = elapsed;
+        }
+    }
+
+    return best;
+}
+
+/**
+ * @brief Time one case against its baseline and write a JSON record
+ * @param out Destination stream
+ * @param name Operation being measured
+ * @param variant Input shape
+ * @param size Input size in bytes
+ * @param body sstring body
+ * @param baseline_name Name of the libc baseline
+ * @param baseline Baseline body
+ * @param input Input shared by both bodies
+ * @param iterations Operations per timed run
+ */
+static void bench_case(FILE *out, const char *name, const char *variant, size_t size, bench_body_t body,
+                       const char *baseline_name, bench_body_t baseline, bench_input_t *input, size_t iterations) {
+    static bool first = true;
+    double ns = bench_measure(body, input, iterations);
+    double baseline_ns = bench_measure(baseline, input, iterations);
+
+    fprintf(out, "%s\n    { \"name\": \"%s\", \"variant\": \"%s\", \"size\": %zu, \"ns_per_op\": %.2f, "
+                 "\"baseline\": \"%s\", \"baseline_ns_per_op\": %.2f, \"ratio\": %.3f }",
+            first ? "" : ",", name, variant, size, ns, baseline_name, baseline_ns, baseline_ns > 0.0 ? ns / baseline_ns : 0.0);
+    first = false;
+    fprintf(stderr, "%-14s %-10s %8zu B  %10.2f ns  %-8s %10.2f ns  %6.3fx\n",
+            name, variant, size, ns, baseline_name, baseline_ns, baseline_ns > 0.0 ? ns / baseline_ns : 0.0);
+}
+
+/**
+ * @brief Get the number of operations for a run over inputs of a given size
+ * @param size Bytes processed per operation
+ * @return size_t Operations per timed run
+ */
+static size_t bench_iterations(size_t size) {
+    size_t iterations = BENCH_BYTES_PER_RUN / (size ? size : 1);
+    return iterations < 16 ? 16 : iterations > BENCH_OPS_PER_RUN * 10 ? BENCH_OPS_PER_RUN * 10 : iterations;
+}
+
+/**
+ * @brief Fill a buffer with reproducible lowercase text
+ * @param data Buffer to fill
+ * @param length Number of bytes
+ * @details Uses only 'a' to 'w', so needles built from 'x' to 'z' never match by accident
+ */
+static void bench_fill(char *data, size_t length) {
+    uint32_t state = 0x5EED;
+    for (size_t i = 0; i < length; ++i) {
+        state = state * 1664525u + 1013904223u;
+        data[i] = (char)('a' + (state >> 24) % 23);
+    }
+}
+
+/*
+ * ========================
+ * Creation and appending
+ * ========================
+ */
+
+/** @brief Create and destroy a string from the input bytes */
+static size_t body_create(void *context, size_t iterations) {
+    bench_input_t *input = context;
+    size_t checksum = 0;
+    for (size_t i = 0; i < iterations; ++i) {
+        BENCH_CLOBBER();
+        string_t *str = string_create_from_buffer(input->data, input->length);
+        checksum += string_length(str);
+        string_destroy(str);
+    }
+    return checksum;
+}
+
+/** @brief Baseline: malloc, copy and free the input bytes */
+static size_t baseline_create(void *context, size_t iterations) {
+    bench_input_t *input = context;
+    size_t checksum = 0;
+    for (size_t i = 0; i < iterations; ++i) {
+        BENCH_CLOBBER();
+        char *copy = malloc(input->length + 1);
+        memcpy(copy, input->data, input->length);
+        copy[input->length] = '\0';
+        checksum += (unsigned char)copy[input->length / 2];
+        free(copy);
+    }
+    return checksum;
+}
+
+/** @brief Grow a string one needle at a time up to the input length */
+static size_t body_append(void *context, size_t iterations) {
+    bench_input_t *input = context;
+    size_t checksum = 0;
+    for (size_t i = 0; i < iterations; ++i) {
+        BENCH_CLOBBER();
+        string_t *str = string_create();
+        while (string_length(str) < input->length) {
+            if (input->needle_length == 1) {
+                string_append_char(str, input->needle[0]);
+            } else {
+                string_append_buffer(str, input->needle, input->needle_length);
+            }
+        }
+        checksum += string_length(str);
+        string_destroy(str);
+    }
+    return checksum;
+}
+
+/** @brief Baseline: grow a realloc-doubled buffer one needle at a time */
+static size_t baseline_append(void *context, size_t iterations) {
+    bench_input_t *input = context;
+    size_t checksum = 0;
+    for (size_t i = 0; i < iterations; ++i) {
+        BENCH_CLOBBER();
+        size_t capacity = 16;
+        size_t length = 0;
+        char *buffer = malloc(capacity);
+        while (length < input->length) {
+            if (length + input->needle_length + 1 > capacity) {
+                capacity *= 2;
+                buffer = realloc(buffer, capacity);
+            }
+            memcpy(buffer + length, input->needle, input->needle_length);
+            length += input->needle_length;
+            buffer[length] = '\0';
+        }
+        checksum += length;
+        free(buffer);
+    }
+    return checksum;
+}
+
+/*
+ * ==================
+ * Search functions
+ * ==================
+ */
+
+/** @brief Find the needle byte with string_find_char() */
+static size_t body_find_char(void *context, size_t iterations) {
+    bench_input_t *input = context;
+    size_t checksum = 0;
+    for (size_t i = 0; i < iterations; ++i) {
+        BENCH_CLOBBER();
+        checksum += string_find_char(input->str, input->needle[0], 0);
+    }
+    return checksum;
+}
+
+/** @brief Baseline: find the needle byte with memchr() */
+static size_t baseline_find_char(void *context, size_t iterations) {
+    bench_input_t *input = context;
+    size_t checksum = 0;
+    for (size_t i = 0; i < iterations; ++i) {
+        BENCH_CLOBBER();
+        const char *found = memchr(input->data, input->needle[0], input->length);
+        checksum += found ? (size_t)(found - input->data) : STRING_NPOS;
+    }
+    return checksum;
+}
+
+/** @brief Find the needle with string_find_cstr() */
+static size_t body_find_cstr(void *context, size_t iterations) {
+    bench_input_t *input = context;
+    size_t checksum = 0;
+    for (size_t i = 0; i < iterations; ++i) {
+        BENCH_CLOBBER();
+        checksum += string_find_cstr(input->str, input->needle, 0);
+    }
+    return checksum;
+}
+
+/** @brief Baseline: find the needle with memmem() */
+static size_t baseline_find_cstr(void *context, size_t iterations) {
+    bench_input_t *input = context;
+    size_t checksum = 0;
+    for (size_t i = 0; i < iterations; ++i) {
+        BENCH_CLOBBER();
+        const char *found = memmem(input->data, input->length, input->needle, input->needle_length);
+        checksum += found ? (size_t)(found - input->data) : STRING_NPOS;
+    }
+    return checksum;
+}
+
+/*
+ * ===========================================
+ * Formatting, comparison and trim functions
+ * ===========================================
+ */
+
+/** @brief Format a log line into a cleared string */
+static size_t body_format(void *context, size_t iterations) {
+    bench_input_t *input = context;
+    size_t checksum = 0;
+    for (size_t i = 0; i < iterations; ++i) {
+        BENCH_CLOBBER();
+        string_clear(input->str);
+        string_append_format(input->str, "%s [%s] request %zu took %.3f ms", "2025-01-01T12:00:00Z", "INFO", i, (double)(i % 1000) / 7.0);
+        checksum += string_length(input->str);
+    }
+    return checksum;
+}
+
+/** @brief Baseline: format the same log line with snprintf() into a stack buffer */
+static size_t baseline_format(void *context, size_t iterations) {
+    (void)context;
+    size_t checksum = 0;
+    char buffer[128];
+    for (size_t i = 0; i < iterations; ++i) {
+        BENCH_CLOBBER();
+        int written = snprintf(buffer, sizeof(buffer), "%s [%s] request %zu took %.3f ms", "2025-01-01T12:00:00Z", "INFO", i, (double)(i % 1000) / 7.0);
+        checksum += (size_t)written;
+    }
+    return checksum;
+}
+
+/** @brief Compare the two operands with string_equals_buffer() */
+static size_t body_equals(void *context, size_t iterations) {
+    bench_input_t *input = context;
+    size_t checksum = 0;
+    for (size_t i = 0; i < iterations; ++i) {
+        BENCH_CLOBBER();
+        checksum += string_equals_buffer(input->str, input->needle, input->needle_length);
+    }
+    return checksum;
+}
+
+/** @brief Baseline: compare lengths, then bytes with memcmp() */
+static size_t baseline_equals(void *context, size_t iterations) {
+    bench_input_t *input = context;
+    size_t checksum = 0;
+    for (size_t i = 0; i < iterations; ++i) {
+        BENCH_CLOBBER();
+        checksum += input->length == input->needle_length && memcmp(input->data, input->needle, input->length) == 0;
+    }
+    return checksum;
+}
+
+/** @brief Copy the padded input into a string and trim it in place */
+static size_t body_trim(void *context, size_t iterations) {
+    bench_input_t *input = context;
+    size_t checksum = 0;
+    for (size_t i = 0; i < iterations; ++i) {
+        BENCH_CLOBBER();
+        string_assign_buffer(input->str, input->data, input->length);
+        string_trim(input->str);
+        checksum += string_length(input->str);
+    }
+    return checksum;
+}
+
+/** @brief Baseline: copy the padded input and trim it with isspace() and memmove() */
+static size_t baseline_trim(void *context, size_t iterations) {
+    bench_input_t *input = context;
+    size_t checksum = 0;
+    char *buffer = malloc(input->length + 1);
+    for (size_t i = 0; i < iterations; ++i) {
+        BENCH_CLOBBER();
+        memcpy(buffer, input->data, input->length);
+        size_t start = 0;
+        size_t end = input->length;
+        while (start < end && isspace((unsigned char)buffer[start])) {
+            start++;
+        }
+        while (end > start && isspace((unsigned char)buffer[end - 1])) {
+            end--;
+        }
+        memmove(buffer, buffer + start, end - start);
+        buffer[end - start] = '\0';
+        checksum += end - start;
+    }
+    free(buffer);
+    return checksum;
+}
+
+/*
+ * ================
+ * Benchmark runs
+ * ================
+ */
+
+/**
+ * @brief Name the active vector instruction set
+ * @return const char* Lowercase name
+ */
+static const char *bench_simd_name(void) {
+    switch (string_get_simd_level()) {
+    case STRING_SIMD_SSE2: return "sse2";
+    case STRING_SIMD_AVX2: return "avx2";
+    case STRING_SIMD_NEON: return "neon";
+    default: return "scalar";
+    }
+}
+
+/**
+ * @brief Run the search cases over haystacks of growing size
+ * @param out Destination stream
+ * @param text Reproducible text of BENCH_MAX_SIZE bytes
+ */
+static void bench_search(FILE *out, char *text) {
+    static const size_t sizes[] = { 16, 256, 4096, 65536, BENCH_MAX_SIZE };
+    char long_needle[33];
+    memset(long_needle, 'x', 32);
+    long_needle[31] = 'y';
+    long_needle[32] = '\0';
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        size_t size = sizes[s];
+        bench_input_t input = { string_create(), text, size, "z", 1 };
+
+        // The byte and the needles sit at the very end, so the whole haystack is scanned
+        char saved = text[size - 1];
+        text[size - 1] = 'z';
+        string_assign_buffer(input.str, text, size);
+        bench_case(out, "find_char", "end", size, body_find_char, "memchr", baseline_find_char, &input, bench_iterations(size));
+        text[size - 1] = saved;
+
+        if (size >= 64) {
+            memcpy(text + size - 3, "xyz", 3);
+            string_assign_buffer(input.str, text, size);
+            input.needle = "xyz";
+            input.needle_length = 3;
+            bench_case(out, "find_cstr", "short", size, body_find_cstr, "memmem", baseline_find_cstr, &input, bench_iterations(size));
+
+            memcpy(text + size - 32, long_needle, 32);
+            string_assign_buffer(input.str, text, size);
+            input.needle = long_needle;
+            input.needle_length = 32;
+            bench_case(out, "find_cstr", "long", size, body_find_cstr, "memmem", baseline_find_cstr, &input, bench_iterations(size));
+
+            // Near-matches everywhere: the case naive searches are quadratic on
+            char *periodic = malloc(size);
+            memset(periodic, 'x', size);
+            periodic[size - 1] = 'y';
+            string_assign_buffer(input.str, periodic, size);
+            input.data = periodic;
+            bench_case(out, "find_cstr", "periodic", size, body_find_cstr, "memmem", baseline_find_cstr, &input, bench_iterations(size));
+            free(periodic);
+        }
+
+        bench_fill(text, BENCH_MAX_SIZE);
+        string_destroy(input.str);
+    }
+}
+
+/**
+ * @brief Main benchmark runner function
+ * @param argc Number of arguments
+ * @param argv Optional path of the JSON report (stdout if omitted)
+ * @return int Returns 0 on completion, 1 if the report cannot be written
+ */
+int main(int argc, char **argv) {
+    FILE *out = stdout;
+    if (argc > 1 && !(out = fopen(argv[1], "w"))) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    char *text = malloc(BENCH_MAX_SIZE);
+    bench_fill(text, BENCH_MAX_SIZE);
+
+    fprintf(out, "{\n  \"benchmark\": \"sstring\",\n  \"simd\": \"%s\",\n  \"repeats\": %d,\n  \"cases\": [",
+            bench_simd_name(), BENCH_REPEATS);
+
+    // Creation: inline (SSO) and heap-sized content
+    bench_input_t input = { NULL, text, 11, NULL, 0 };
+    bench_case(out, "create", "inline", 11, body_create, "malloc", baseline_create, &input, BENCH_OPS_PER_RUN * 5);
+    input.length = 200;
+    bench_case(out, "create", "heap", 200, body_create, "malloc", baseline_create, &input, BENCH_OPS_PER_RUN * 5);
+
+    // Append growth from empty, by bytes and by 16-byte pieces
+    input.length = 65536;
+    input.needle = "q";
+    input.needle_length = 1;
+    bench_case(out, "append", "char", 65536, body_append, "realloc", baseline_append, &input, 64);
+    input.length = BENCH_MAX_SIZE;
+    input.needle = "0123456789abcdef";
+    input.needle_length = 16;
+    bench_case(out, "append", "piece16", BENCH_MAX_SIZE, body_append, "realloc", baseline_append, &input, 16);
+
+    bench_search(out, text);
+
+    // Formatting into a reused string
+    input.str = string_create_with_capacity(256);
+    bench_case(out, "format", "log_line", 0, body_format, "snprintf", baseline_format, &input, BENCH_OPS_PER_RUN * 5);
+    string_destroy(input.str);
+
+    // Equality of identical content, and of same-length content differing at the end
+    static const size_t compare_sizes[] = { 8, 16, 64, 4096 };
+    for (size_t s = 0; s < sizeof(compare_sizes) / sizeof(compare_sizes[0]); ++s) {
+        size_t size = compare_sizes[s];
+        char *other = malloc(size);
+        memcpy(other, text, size);
+        input.str = string_create_from_buffer(text, size);
+        input.data = text;
+        input.length = size;
+        input.needle = other;
+        input.needle_length = size;
+        bench_case(out, "equals", "equal", size, body_equals, "memcmp", baseline_equals, &input, BENCH_OPS_PER_RUN * 25);
+        other[size - 1] = 'z';
+        bench_case(out, "equals", "differ_end", size, body_equals, "memcmp", baseline_equals, &input, BENCH_OPS_PER_RUN * 25);
+        string_destroy(input.str);
+        free(other);
+    }
+
+    // Trimming text padded with whitespace on both ends
+    static const size_t trim_sizes[] = { 64, 4096 };
+    for (size_t s = 0; s < sizeof(trim_sizes) / sizeof(trim_sizes[0]); ++s) {
+        size_t size = trim_sizes[s];
+        char *padded = malloc(size + 80);
+        memset(padded, ' ', 40);
+        memcpy(padded + 40, text, size);
+        memcpy(padded + 40 + size, "\t\t\n\n                                    ", 40);
+        input.str = string_create();
+        input.data = padded;
+        input.length = size + 80;
+        bench_case(out, "trim", "padded40", size + 80, body_trim, "isspace", baseline_trim, &input, bench_iterations(size + 80));
+        string_destroy(input.str);
+        free(padded);
+    }
+
+    fprintf(out, "\n  ]\n}\n");
+    free(text);
+
+    if (out != stdout) {
+        fclose(out);
+    }
+
+    return 0;
+}
@@ -9,59 +9,424 @@
  * bounds checking, and comprehensive error handling.
  */
 
+#include <stdatomic.h>
+
 #include "sstring.h"
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#endif
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#define STRING_MALLOC_USABLE_SIZE(ptr) malloc_usable_size(ptr)
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#define STRING_MALLOC_USABLE_SIZE(ptr) malloc_size(ptr)
+#endif
+
+#include "sstring_number.h"
+#include "sstring_simd.h"
+#include "sstring_stats.h"
+
 /*
  * ==========================
  * Internal helper functions
  * ==========================
  */
 
+/**
+ * @brief Default allocator callback backed by malloc()
+ */
+static void *string_malloc_allocate(void *context, size_t size) {
+    (void)context;
+    return malloc(size);
+}
+
+/**
+ * @brief Default allocator callback backed by realloc()
+ */
+static void *string_malloc_reallocate(void *context, void *ptr, size_t old_size, size_t new_size) {
+    (void)context;
+    (void)old_size;
+    return realloc(ptr, new_size);
+}
+
+/**
+ * @brief Default allocator callback backed by free()
+ */
+static void string_malloc_deallocate(void *context, void *ptr, size_t size) {
+    (void)context;
+    (void)size;
+    free(ptr);
+}
+
+/** @brief Process-wide default allocator using the C library heap */
+static const string_allocator_t string_malloc_allocator = {
+    string_malloc_allocate,
+    string_malloc_reallocate,
+    string_malloc_deallocate,
+    NULL,
+};
+
+/** @brief Allocator used by constructors on the current thread (NULL selects the default) */
+static _Thread_local const string_allocator_t *string_thread_allocator = NULL;
+
+/** @brief Process-wide growth policy (a string_growth_t) */
+static atomic_int string_growth_policy = STRING_GROWTH_DOUBLE;
+
 /**
  * @brief Calculate the new capacity for string growth
  * @param current_capacity Current capacity of the string
  * @param required_capacity Minimum required capacity
  * @return size_t New capacity that satisfies the requirement
- * @details Uses exponential growth strategy to minimize reallocations
+ * @details Grows geometrically according to the policy, in constant time. The
+ *          result saturates at SIZE_MAX instead of wrapping, so an impossible
+ *          request fails in the allocator rather than under-allocating.
  */
 static size_t string_calculate_growth(size_t current_capacity, size_t required_capacity) {
-    size_t new_capacity = current_capacity;
+    size_t new_capacity;
 
-    while (new_capacity < required_capacity) {
-        new_capacity *= STRING_GROWTH_FACTOR;
+    if (atomic_load_explicit(&string_growth_policy, memory_order_relaxed) == STRING_GROWTH_DOUBLE) {
+        new_capacity = current_capacity > SIZE_MAX / STRING_GROWTH_FACTOR ? SIZE_MAX
+                                                                           : current_capacity * STRING_GROWTH_FACTOR;
+    } else {
+        new_capacity = current_capacity > SIZE_MAX - current_capacity / 2 ? SIZE_MAX
+                                                                            : current_capacity + current_capacity / 2;
     }
 
-    return new_capacity;
+    return new_capacity > required_capacity ? new_capacity : required_capacity;
 }
 
 /**
- * @brief Ensure string has sufficient capacity for operations
+ * @brief Get the capacity actually available in a new data buffer
+ * @param allocator Allocator that provided the buffer
+ * @param data Buffer just returned by the allocator
+ * @param capacity Size that was requested
+ * @return size_t Usable size of the buffer (at least capacity)
+ * @details Only the default allocator on C libraries that report usable sizes
+ *          can hand out slack, and only under STRING_GROWTH_USABLE_SIZE.
+ */
+static size_t string_usable_capacity(const string_allocator_t *allocator, void *data, size_t capacity) {
+#if defined(__GLIBC__) || defined(__APPLE__)
+    if (allocator == &string_malloc_allocator &&
+        atomic_load_explicit(&string_growth_policy, memory_order_relaxed) == STRING_GROWTH_USABLE_SIZE) {
+        size_t usable = STRING_MALLOC_USABLE_SIZE(data);
+        return usable > capacity ? usable : capacity;
+    }
+#else
+    (void)allocator;
+    (void)data;
+#endif
+
+    return capacity;
+}
+
+/**
+ * @brief Fold an ASCII uppercase letter to lowercase
+ * @param c Byte to fold
+ * @return int Folded byte value
+ */
+static int string_ascii_fold(unsigned char c) {
+    return (unsigned)(c - 'A') < 26u ? c | 0x20 : c;
+}
+
+/**
+ * @brief Reference-counted buffer behind shared strings
+ * @details The bytes never change while the buffer is shared; a sharer that
+ *          wants to modify its string copies them out first.
+ */
+typedef struct {
+    atomic_size_t refcount;                /**< Number of strings referencing the buffer */
+    const string_allocator_t *allocator;   /**< Allocator that provided the buffer */
+    size_t size;                           /**< Size of the allocation */
+    char data[];                           /**< Content followed by a null terminator */
+} string_shared_t;
+
+/**
+ * @brief Get the shared buffer of a shared string
+ * @param str String with STRING_STORAGE_SHARED storage
+ * @return string_shared_t* Buffer holding the data
+ */
+static string_shared_t *string_shared_of(const string_t *str) {
+    return (string_shared_t *)(void *)(str->data - offsetof(string_shared_t, data));
+}
+
+/**
+ * @brief Drop one reference to the shared buffer of a string
+ * @param str String with STRING_STORAGE_SHARED storage
+ * @details The last sharer frees the buffer. Acquire-release ordering makes every
+ *          other sharer's reads happen before the free.
+ */
+static void string_shared_release(string_t *str) {
+    string_shared_t *shared = string_shared_of(str);
+    if (atomic_fetch_sub_explicit(&shared->refcount, 1, memory_order_acq_rel) == 1) {
+        shared->allocator->deallocate(shared->allocator->context, shared, shared->size);
+    }
+}
+
+/**
+ * @brief Point a string at the shared buffer of another one
+ * @param str String to attach (its previous data must already be released)
+ * @param src String with STRING_STORAGE_SHARED storage
+ */
+static void string_shared_attach(string_t *str, const string_t *src) {
+    atomic_fetch_add_explicit(&string_shared_of(src)->refcount, 1, memory_order_relaxed);
+    str->data = src->data;
+    str->length = src->length;
+    str->capacity = src->capacity;
+    str->storage = STRING_STORAGE_SHARED;
+    str->hash = src->hash;
+    str->has_hash = src->has_hash;
+    str->is_utf8 = src->is_utf8;
+}
+
+/**
+ * @brief Give a shared string a private copy of its content
+ * @param str String with STRING_STORAGE_SHARED storage
+ * @param capacity Capacity of the private buffer (at least length + 1)
+ * @return string_result_t Success or error code
+ * @details Short content moves inline; the reference is dropped only once the
+ *          copy succeeded, so a failure leaves the string untouched.
+ */
+static string_result_t string_detach(string_t *str, size_t capacity) {
+    char *data = str->inline_data;
+
+    if (capacity > STRING_SSO_CAPACITY) {
+        data = str->allocator->allocate(str->allocator->context, capacity);
+        if (!data) {
+            return STRING_ERROR_OUT_OF_MEMORY;
+        }
+        STRING_STATS_ADD(allocations, 1);
+        STRING_STATS_ADD(bytes_allocated, capacity);
+    } else {
+        capacity = STRING_SSO_CAPACITY;
+    }
+
+    memcpy(data, str->data, str->length + 1);
+    STRING_STATS_ADD(bytes_copied, str->length);
+    string_shared_release(str);
+    str->data = data;
+    str->capacity = capacity;
+    str->storage = data == str->inline_data ? STRING_STORAGE_INLINE : STRING_STORAGE_HEAP;
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Check that the buffer of a string may be written or resized
  * @param str Pointer to the string structure
- * @param required_capacity Minimum capacity needed
  * @return string_result_t Success or error code
- * @details Reallocates memory if current capacity is insufficient
+ * @details Strings that do not own their memory (views) are read-only, and shared
+ *          strings are detached from their buffer. The cached hash and UTF-8 flag
+ *          are kept, so capacity-only operations use this directly.
  */
-static string_result_t string_ensure_capacity(string_t *str, size_t required_capacity) {
-    if (!str || !str->is_owner) {
+static string_result_t string_begin_write(string_t *str) {
+    if (!str) {
         return STRING_ERROR_NULL_POINTER;
     }
 
+    if (!str->is_owner) {
+        return STRING_ERROR_READ_ONLY;
+    }
+
+    if (str->storage == STRING_STORAGE_SHARED) {
+        string_result_t result = string_detach(str, str->length + 1);
+        if (result != STRING_SUCCESS) {
+            return result;
+        }
+    }
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Drop the caches that describe the content of a string
+ * @param str Pointer to the string structure
+ * @details Called by every path that changes the content, after its checks pass
+ */
+static void string_drop_caches(string_t *str) {
+    str->has_hash = false;
+    str->is_utf8 = false;
+}
+
+/**
+ * @brief Check that a string may be modified
+ * @param str Pointer to the string structure
+ * @return string_result_t Success or error code
+ * @details Every operation that changes the content goes through this check
+ *          before touching data. On top of string_begin_write() it calls
+ *          string_drop_caches().
+ */
+static string_result_t string_begin_mutation(string_t *str) {
+    string_result_t result = string_begin_write(str);
+    if (result != STRING_SUCCESS) {
+        return result;
+    }
+
+    // The content is about to change
+    string_drop_caches(str);
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Grow the data buffer of a string to a given capacity
+ * @param str Pointer to the string structure
+ * @param required_capacity Minimum capacity needed
+ * @param is_exact Whether to allocate exactly the required capacity instead of
+ *                 applying the growth policy
+ * @return string_result_t Success or error code
+ * @details Reallocates memory if current capacity is insufficient. The content
+ *          is unchanged, so the cached hash and UTF-8 flag are kept.
+ */
+static string_result_t string_grow(string_t *str, size_t required_capacity, bool is_exact) {
+    // Detach straight into a buffer of the required size
+    if (str && str->is_owner && str->storage == STRING_STORAGE_SHARED && required_capacity > str->length + 1) {
+        string_result_t result = string_detach(str, required_capacity);
+        if (result != STRING_SUCCESS) {
+            return result;
+        }
+    }
+
+    string_result_t result = string_begin_write(str);
+    if (result != STRING_SUCCESS) {
+        return result;
+    }
+
     if (str->capacity >= required_capacity) {
         return STRING_SUCCESS;
     }
 
-    size_t new_capacity = string_calculate_growth(str->capacity, required_capacity);
-    char *new_data = realloc(str->data, new_capacity);
+    size_t new_capacity = is_exact ? required_capacity : string_calculate_growth(str->capacity, required_capacity);
+    char *new_data;
+    const string_allocator_t *allocator = str->allocator;
+    if (str->storage != STRING_STORAGE_HEAP) {
+        // Move inline or external content to the heap
+        new_data = allocator->allocate(allocator->context, new_capacity);
+        if (new_data) {
+            memcpy(new_data, str->data, str->length + 1);
+            STRING_STATS_ADD(allocations, 1);
+            STRING_STATS_ADD(bytes_copied, str->length);
+        }
+    } else {
+        new_data = allocator->reallocate(allocator->context, str->data, str->capacity, new_capacity);
+        if (new_data) {
+            STRING_STATS_ADD(reallocations, 1);
+        }
+    }
     if (!new_data) {
         return STRING_ERROR_OUT_OF_MEMORY;
     }
+    STRING_STATS_ADD(bytes_allocated, new_capacity);
 
     str->data = new_data;
-    str->capacity = new_capacity;
+    str->capacity = string_usable_capacity(allocator, new_data, new_capacity);
+    str->storage = STRING_STORAGE_HEAP;
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Ensure string has sufficient capacity for operations
+ * @param str Pointer to the string structure
+ * @param required_capacity Minimum capacity needed
+ * @return string_result_t Success or error code
+ * @details Reallocates memory if current capacity is insufficient. Used by
+ *          operations about to change the content, so the cached hash and UTF-8
+ *          flag are dropped.
+ */
+static string_result_t string_ensure_capacity(string_t *str, size_t required_capacity) {
+    string_result_t result = string_grow(str, required_capacity, false);
+    if (result != STRING_SUCCESS) {
+        return result;
+    }
+
+    string_drop_caches(str);
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Ensure string has room for extra bytes after a given length
+ * @param str Pointer to the string structure
+ * @param length Length of the content to keep
+ * @param extra Number of bytes to add after it
+ * @return string_result_t Success or error code
+ * @details Fails with STRING_ERROR_OUT_OF_MEMORY when length + extra plus the
+ *          null terminator does not fit a size_t
+ */
+static string_result_t string_ensure_room(string_t *str, size_t length, size_t extra) {
+    if (extra >= SIZE_MAX - length) {
+        return STRING_ERROR_OUT_OF_MEMORY;
+    }
+
+    return string_ensure_capacity(str, length + extra + 1);
+}
+
+/**
+ * @brief Initialize string structure fields for a given capacity
+ * @param str Pointer to the string structure
+ * @param capacity Requested capacity (non-zero)
+ * @param allocator Allocator for the data buffer
+ * @return string_result_t Success or error code
+ * @details Uses the inline buffer when the capacity fits, otherwise allocates heap data
+ */
+static string_result_t string_setup(string_t *str, size_t capacity, const string_allocator_t *allocator) {
+    str->allocator = allocator;
+
+    if (capacity <= STRING_SSO_CAPACITY) {
+        str->data = str->inline_data;
+        str->capacity = STRING_SSO_CAPACITY;
+        str->storage = STRING_STORAGE_INLINE;
+    } else {
+        str->data = allocator->allocate(allocator->context, capacity);
+        if (!str->data) {
+            return STRING_ERROR_OUT_OF_MEMORY;
+        }
+        STRING_STATS_ADD(allocations, 1);
+        STRING_STATS_ADD(bytes_allocated, capacity);
+        str->capacity = capacity;
+        str->storage = STRING_STORAGE_HEAP;
+    }
+
+    str->data[0] = '\0';
+    str->length = 0;
+    str->is_owner = true;
+    str->has_hash = false;
+    str->is_utf8 = false;
 
     return STRING_SUCCESS;
 }
 
+/**
+ * @brief Unmap the file mapping of a mapped string
+ * @param str String with STRING_STORAGE_MAPPED storage
+ * @details The capacity of a mapped string is the size of its mapping.
+ */
+static void string_unmap(string_t *str) {
+#if defined(__unix__) || defined(__APPLE__)
+    munmap(str->data, str->capacity);
+#else
+    (void)str;
+#endif
+}
+
+/**
+ * @brief Release the heap data buffer of a string, if it has one
+ * @param str Pointer to the string structure
+ */
+static void string_release_data(string_t *str) {
+    if (str->is_owner && str->storage == STRING_STORAGE_HEAP) {
+        STRING_STATS_UTILIZATION(str->length, str->capacity);
+        str->allocator->deallocate(str->allocator->context, str->data, str->capacity);
+    } else if (str->storage == STRING_STORAGE_SHARED) {
+        string_shared_release(str);
+    } else if (str->storage == STRING_STORAGE_MAPPED) {
+        string_unmap(str);
+    }
+}
+
 /**
  * @brief Get human-readable error message for result code
  * @param error The error code to convert to message
@@ -76,6 +441,11 @@ const char *string_error_message(string_result_t error) {
     case STRING_ERROR_INVALID_INDEX: return "Invalid index";
     case STRING_ERROR_BUFFER_TOO_SMALL: return "Buffer too small";
     case STRING_ERROR_INVALID_ARGUMENT: return "Invalid argument";
+    case STRING_ERROR_READ_ONLY: return "String is read-only";
+    case STRING_ERROR_OUT_OF_RANGE: return "Value out of range";
+    case STRING_ERROR_IO: return "I/O error";
+    case STRING_ERROR_END_OF_FILE: return "End of file";
+    case STRING_ERROR_INVALID_ENCODING: return "Invalid encoding";
     default: return "Unknown error";
     }
 }
@@ -90,29 +460,41 @@ const char *string_error_message(string_result_t error) {
  * @brief Create a new string with specified capacity
  * @param capacity Initial capacity for the string (minimum capacity if 0)
  * @return string_t* Pointer to new string or NULL on failure
- * @details Allocates memory for string structure and data buffer
+ * @details Allocates memory for string structure and, if the capacity does not
+ *          fit the inline buffer, a separate data buffer, using the thread allocator
  */
 string_t *string_create_with_capacity(size_t capacity) {
+    return string_create_with_allocator(capacity, string_get_thread_allocator());
+}
+
+/**
+ * @brief Create a new string bound to a specific allocator
+ * @param capacity Initial capacity for the string (minimum capacity if 0)
+ * @param allocator Allocator for the header and data (NULL selects the default)
+ * @return string_t* Pointer to new string or NULL on failure
+ * @details The allocator is used for every later growth and release of the string
+ */
+string_t *string_create_with_allocator(size_t capacity, const string_allocator_t *allocator) {
     if (capacity == 0) {
         capacity = STRING_DEFAULT_CAPACITY;
     }
 
-    string_t *str = malloc(sizeof(string_t));
+    if (!allocator) {
+        allocator = &string_malloc_allocator;
+    }
+
+    string_t *str = allocator->allocate(allocator->context, sizeof(string_t));
     if (!str) {
         return NULL;
     }
+    STRING_STATS_ADD(allocations, 1);
+    STRING_STATS_ADD(bytes_allocated, sizeof(string_t));
 
-    str->data = malloc(capacity);
-    if (!str->data) {
-        free(str);
+    if (string_setup(str, capacity, allocator) != STRING_SUCCESS) {
+        allocator->deallocate(allocator->context, str, sizeof(string_t));
         return NULL;
     }
 
-    str->data[0] = '\0';
-    str->length = 0;
-    str->capacity = capacity;
-    str->is_owner = true;
-
     return str;
 }
 
@@ -130,7 +512,8 @@ string_t *string_create(void) {
  * @param buffer Source buffer to copy from
  * @param length Number of bytes to copy from buffer
  * @return string_t* Pointer to new string or NULL on failure
- * @details Safely copies specified number of bytes, allowing embedded nulls
+ * @details Safely copies specified number of bytes, allowing embedded nulls.
+ *          Short content is stored inline without a separate data allocation.
  */
 string_t *string_create_from_buffer(const char *buffer, size_t length) {
     if (!buffer && length > 0) {
@@ -138,7 +521,7 @@ string_t *string_create_from_buffer(const char *buffer, size_t length) {
     }
 
     size_t capacity = length + 1;
-    if (capacity < STRING_DEFAULT_CAPACITY) {
+    if (capacity > STRING_SSO_CAPACITY && capacity < STRING_DEFAULT_CAPACITY) {
         capacity = STRING_DEFAULT_CAPACITY;
     }
 
@@ -149,6 +532,7 @@ string_t *string_create_from_buffer(const char *buffer, size_t length) {
 
     if (length > 0) {
         memcpy(str->data, buffer, length);
+        STRING_STATS_ADD(bytes_copied, length);
     }
     str->data[length] = '\0';
     str->length = length;
@@ -182,7 +566,27 @@ string_t *string_clone(const string_t *src) {
         return NULL;
     }
 
-    return string_create_from_buffer(src->data, src->length);
+    if (src->storage != STRING_STORAGE_SHARED) {
+        string_t *copy = string_create_from_buffer(src->data, src->length);
+        if (copy) {
+            copy->is_utf8 = src->is_utf8;
+        }
+        return copy;
+    }
+
+    const string_allocator_t *allocator = string_get_thread_allocator();
+    string_t *str = allocator->allocate(allocator->context, sizeof(string_t));
+    if (!str) {
+        return NULL;
+    }
+    STRING_STATS_ADD(allocations, 1);
+    STRING_STATS_ADD(bytes_allocated, sizeof(string_t));
+
+    str->allocator = allocator;
+    str->is_owner = true;
+    string_shared_attach(str, src);
+
+    return str;
 }
 
 /**
@@ -192,11 +596,141 @@ string_t *string_clone(const string_t *src) {
  */
 void string_destroy(string_t *str) {
     if (str) {
-        if (str->is_owner && str->data) {
-            free(str->data);
-        }
-        free(str);
+        const string_allocator_t *allocator = str->allocator;
+        string_release_data(str);
+        allocator->deallocate(allocator->context, str, sizeof(string_t));
+    }
+}
+
+/*
+ * ============================================
+ * Caller-owned string initialization functions
+ * ============================================
+ */
+
+/**
+ * @brief Initialize a caller-owned string as empty
+ * @param str String structure to initialize
+ * @return string_result_t Success or error code
+ * @details Starts in the inline buffer without allocating, bound to the thread allocator
+ */
+string_result_t string_init(string_t *str) {
+    return string_init_with_allocator(str, string_get_thread_allocator());
+}
+
+/**
+ * @brief Initialize a caller-owned string bound to a specific allocator
+ * @param str String structure to initialize
+ * @param allocator Allocator for data buffers (NULL selects the default)
+ * @return string_result_t Success or error code
+ * @details Starts in the inline buffer without allocating
+ */
+string_result_t string_init_with_allocator(string_t *str, const string_allocator_t *allocator) {
+    if (!str) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    return string_setup(str, STRING_SSO_CAPACITY, allocator ? allocator : &string_malloc_allocator);
+}
+
+/**
+ * @brief Initialize a caller-owned string on a caller-supplied buffer
+ * @param str String structure to initialize
+ * @param buffer Initial storage buffer
+ * @param size Size of the buffer in bytes
+ * @return string_result_t Success or error code
+ * @details The buffer is used until the content outgrows it and is never freed
+ */
+string_result_t string_init_with_buffer(string_t *str, char *buffer, size_t size) {
+    if (!str || !buffer) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    if (size == 0) {
+        return STRING_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    str->data = buffer;
+    str->data[0] = '\0';
+    str->length = 0;
+    str->capacity = size;
+    str->is_owner = true;
+    str->has_hash = false;
+    str->is_utf8 = false;
+    str->storage = STRING_STORAGE_EXTERNAL;
+    str->allocator = string_get_thread_allocator();
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Release the storage of a caller-owned string
+ * @param str String to deinitialize
+ * @details Frees heap data, then resets the string to an empty inline state
+ */
+void string_deinit(string_t *str) {
+    if (str) {
+        string_release_data(str);
+        string_setup(str, STRING_SSO_CAPACITY, str->allocator);
+    }
+}
+
+/*
+ * =============================
+ * Allocator binding functions
+ * =============================
+ */
+
+/**
+ * @brief Get the default allocator
+ * @return const string_allocator_t* Allocator backed by malloc/realloc/free
+ */
+const string_allocator_t *string_default_allocator(void) {
+    return &string_malloc_allocator;
+}
+
+/**
+ * @brief Bind an allocator to the current thread
+ * @param allocator Allocator for new strings (NULL restores the default)
+ * @details Affects only strings created or initialized afterwards on this thread
+ */
+void string_set_thread_allocator(const string_allocator_t *allocator) {
+    string_thread_allocator = allocator;
+}
+
+/**
+ * @brief Get the allocator bound to the current thread
+ * @return const string_allocator_t* Current thread allocator, never NULL
+ */
+const string_allocator_t *string_get_thread_allocator(void) {
+    return string_thread_allocator ? string_thread_allocator : &string_malloc_allocator;
+}
+
+/*
+ * ========================
+ * Growth policy functions
+ * ========================
+ */
+
+/**
+ * @brief Select how strings grow when they run out of capacity
+ * @param policy Growth policy for every later reallocation
+ * @return string_growth_t Previous policy
+ */
+string_growth_t string_set_growth_policy(string_growth_t policy) {
+    if (policy != STRING_GROWTH_ONE_AND_HALF && policy != STRING_GROWTH_USABLE_SIZE) {
+        policy = STRING_GROWTH_DOUBLE;
     }
+
+    return (string_growth_t)atomic_exchange_explicit(&string_growth_policy, (int)policy, memory_order_relaxed);
+}
+
+/**
+ * @brief Get the active growth policy
+ * @return string_growth_t Current policy
+ */
+string_growth_t string_get_growth_policy(void) {
+    return (string_growth_t)atomic_load_explicit(&string_growth_policy, memory_order_relaxed);
 }
 
 /*
@@ -245,17 +779,49 @@ const char *string_cstr(const string_t *str) {
     return str && str->data ? str->data : "";
 }
 
-/*
- * ==============================
- * String modification functions
- * ==============================
+/**
+ * @brief Check if a string is stored inline
+ * @param str String to check
+ * @return bool true if content lives in the inline buffer, false otherwise
+ * @details Inline strings have no separate heap data buffer
  */
+bool string_is_inline(const string_t *str) {
+    return str && str->storage == STRING_STORAGE_INLINE;
+}
 
 /**
- * @brief Reserve capacity for string without changing content
- * @param str String to modify
- * @param new_capacity Minimum capacity to reserve
- * @return string_result_t Success or error code
+ * @brief Check if a string uses a shared copy-on-write buffer
+ * @param str String to check
+ * @return bool true if content lives in a shared buffer
+ */
+bool string_is_shared(const string_t *str) {
+    return str && str->storage == STRING_STORAGE_SHARED;
+}
+
+/**
+ * @brief Get the number of strings referencing a shared buffer
+ * @param str String to check
+ * @return size_t Reference count, or 0 if not shared
+ */
+size_t string_shared_count(const string_t *str) {
+    if (!string_is_shared(str)) {
+        return 0;
+    }
+
+    return atomic_load_explicit(&string_shared_of(str)->refcount, memory_order_relaxed);
+}
+
+/*
+ * ==============================
+ * String modification functions
+ * ==============================
+ */
+
+/**
+ * @brief Reserve capacity for string without changing content
+ * @param str String to modify
+ * @param new_capacity Minimum capacity to reserve
+ * @return string_result_t Success or error code
  * @details Ensures string can hold at least new_capacity characters
  */
 string_result_t string_reserve(string_t *str, size_t new_capacity) {
@@ -267,7 +833,83 @@ string_result_t string_reserve(string_t *str, size_t new_capacity) {
         return STRING_SUCCESS;
     }
 
-    return string_ensure_capacity(str, new_capacity);
+    return string_grow(str, new_capacity, false);
+}
+
+/**
+ * @brief Pre-size a string for its expected final length
+ * @param str String to pre-size
+ * @param expected_length Expected content length
+ * @return string_result_t Success or error code
+ * @details Allocates the exact capacity instead of applying the growth policy
+ */
+string_result_t string_reserve_hint(string_t *str, size_t expected_length) {
+    if (!str) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    if (expected_length == SIZE_MAX) {
+        return STRING_ERROR_OUT_OF_MEMORY;
+    }
+
+    if (expected_length < str->capacity) {
+        return STRING_SUCCESS;
+    }
+
+    return string_grow(str, expected_length + 1, true);
+}
+
+/**
+ * @brief Get writable room after the content of a string
+ * @param str String to write into
+ * @param min_extra Minimum number of bytes to make room for
+ * @param spare Receives the first byte after the content
+ * @param available Receives the number of writable bytes
+ * @return string_result_t Success or error code
+ * @details Goes through the usual growth path, so the string is detached even
+ *          when no growth is needed. The cached hash is kept until
+ *          string_commit_spare() is called.
+ */
+string_result_t string_reserve_spare(string_t *str, size_t min_extra, char **spare, size_t *available) {
+    if (!str || !spare || !available) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    if (min_extra >= SIZE_MAX - str->length) {
+        return STRING_ERROR_OUT_OF_MEMORY;
+    }
+
+    string_result_t result = string_grow(str, str->length + min_extra + 1, false);
+    if (result != STRING_SUCCESS) {
+        return result;
+    }
+
+    *spare = str->data + str->length;
+    *available = str->capacity - str->length - 1;
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Extend the content over bytes written into the spare room
+ * @param str String to extend
+ * @param written Number of bytes written after the content
+ * @return string_result_t Success or error code
+ */
+string_result_t string_commit_spare(string_t *str, size_t written) {
+    string_result_t result = string_begin_mutation(str);
+    if (result != STRING_SUCCESS) {
+        return result;
+    }
+
+    if (written > str->capacity - str->length - 1) {
+        return STRING_ERROR_INVALID_ARGUMENT;
+    }
+
+    str->length += written;
+    str->data[str->length] = '\0';
+
+    return STRING_SUCCESS;
 }
 
 /**
@@ -282,7 +924,7 @@ string_result_t string_resize(string_t *str, size_t new_length) {
         return STRING_ERROR_NULL_POINTER;
     }
 
-    string_result_t result = string_ensure_capacity(str, new_length + 1);
+    string_result_t result = string_ensure_room(str, 0, new_length);
     if (result != STRING_SUCCESS) {
         return result;
     }
@@ -305,8 +947,17 @@ string_result_t string_resize(string_t *str, size_t new_length) {
  * @details Keeps allocated memory but resets length to 0
  */
 string_result_t string_clear(string_t *str) {
-    if (!str) {
-        return STRING_ERROR_NULL_POINTER;
+    if (str && str->is_owner && str->storage == STRING_STORAGE_SHARED) {
+        // Dropping the content needs no private copy
+        string_shared_release(str);
+        str->data = str->inline_data;
+        str->capacity = STRING_SSO_CAPACITY;
+        str->storage = STRING_STORAGE_INLINE;
+    }
+
+    string_result_t result = string_begin_mutation(str);
+    if (result != STRING_SUCCESS) {
+        return result;
     }
 
     str->length = 0;
@@ -321,22 +972,36 @@ string_result_t string_clear(string_t *str) {
  * @brief Shrink string capacity to fit current length
  * @param str String to shrink
  * @return string_result_t Success or error code
- * @details Reduces memory usage by reallocating to minimum required size
+ * @details Reduces memory usage by reallocating to minimum required size,
+ *          moving the content back inline if it fits the inline buffer
  */
 string_result_t string_shrink_to_fit(string_t *str) {
-    if (!str || !str->is_owner) {
-        return STRING_ERROR_NULL_POINTER;
+    string_result_t result = string_begin_write(str);
+    if (result != STRING_SUCCESS) {
+        return result;
     }
 
     size_t new_capacity = str->length + 1;
-    if (new_capacity >= str->capacity) {
+    if (new_capacity >= str->capacity || str->storage != STRING_STORAGE_HEAP) {
+        return STRING_SUCCESS;
+    }
+
+    if (new_capacity <= STRING_SSO_CAPACITY) {
+        memcpy(str->inline_data, str->data, new_capacity);
+        STRING_STATS_ADD(bytes_copied, str->length);
+        string_release_data(str);
+        str->data = str->inline_data;
+        str->capacity = STRING_SSO_CAPACITY;
+        str->storage = STRING_STORAGE_INLINE;
         return STRING_SUCCESS;
     }
 
-    char *new_data = realloc(str->data, new_capacity);
+    char *new_data = str->allocator->reallocate(str->allocator->context, str->data, str->capacity, new_capacity);
     if (!new_data) {
         return STRING_ERROR_OUT_OF_MEMORY;
     }
+    STRING_STATS_ADD(reallocations, 1);
+    STRING_STATS_ADD(bytes_allocated, new_capacity);
 
     str->data = new_data;
     str->capacity = new_capacity;
@@ -344,6 +1009,53 @@ string_result_t string_shrink_to_fit(string_t *str) {
     return STRING_SUCCESS;
 }
 
+/**
+ * @brief Move the content into a shared copy-on-write buffer
+ * @param str String to convert
+ * @return string_result_t Success or error code
+ * @details Copies the content once into a reference-counted buffer from the
+ *          string's allocator; clones then only increment the count
+ */
+string_result_t string_make_shared(string_t *str) {
+    if (!str) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    if (!str->is_owner) {
+        return STRING_ERROR_READ_ONLY;
+    }
+
+    if (str->storage == STRING_STORAGE_SHARED) {
+        return STRING_SUCCESS;
+    }
+
+    if (str->length > SIZE_MAX - sizeof(string_shared_t) - 1) {
+        return STRING_ERROR_OUT_OF_MEMORY;
+    }
+
+    const string_allocator_t *allocator = str->allocator;
+    size_t size = sizeof(string_shared_t) + str->length + 1;
+    string_shared_t *shared = allocator->allocate(allocator->context, size);
+    if (!shared) {
+        return STRING_ERROR_OUT_OF_MEMORY;
+    }
+    STRING_STATS_ADD(allocations, 1);
+    STRING_STATS_ADD(bytes_allocated, size);
+
+    atomic_init(&shared->refcount, 1);
+    shared->allocator = allocator;
+    shared->size = size;
+    memcpy(shared->data, str->data, str->length + 1);
+    STRING_STATS_ADD(bytes_copied, str->length);
+
+    string_release_data(str);
+    str->data = shared->data;
+    str->capacity = str->length + 1;
+    str->storage = STRING_STORAGE_SHARED;
+
+    return STRING_SUCCESS;
+}
+
 /*
  * ============================
  * String assignment functions
@@ -367,13 +1079,23 @@ string_result_t string_assign_buffer(string_t *str, const char *buffer, size_t l
         return STRING_ERROR_INVALID_ARGUMENT;
     }
 
-    string_result_t result = string_ensure_capacity(str, length + 1);
+    // A view into this string must be rebased if detaching a shared buffer moves the data
+    bool is_self = buffer >= str->data && buffer < str->data + str->length;
+    size_t self_offset = is_self ? (size_t)(buffer - str->data) : 0;
+
+    string_result_t result = string_ensure_room(str, 0, length);
     if (result != STRING_SUCCESS) {
         return result;
     }
 
+    if (is_self) {
+        buffer = str->data + self_offset;
+    }
+
+    // memmove: the buffer may be a view into this string
     if (length > 0) {
-        memcpy(str->data, buffer, length);
+        memmove(str->data, buffer, length);
+        STRING_STATS_ADD(bytes_copied, length);
     }
     str->data[length] = '\0';
     str->length = length;
@@ -417,9 +1139,189 @@ string_result_t string_assign_string(string_t *dest, const string_t *src) {
         return string_clear(dest);
     }
 
+    if (src->storage == STRING_STORAGE_SHARED) {
+        if (!dest->is_owner) {
+            return STRING_ERROR_READ_ONLY;
+        }
+
+        // Already sharing this buffer (including self-assignment)
+        if (dest->storage == STRING_STORAGE_SHARED && dest->data == src->data) {
+            return STRING_SUCCESS;
+        }
+
+        string_release_data(dest);
+        string_shared_attach(dest, src);
+        return STRING_SUCCESS;
+    }
+
     return string_assign_buffer(dest, src->data, src->length);
 }
 
+/*
+ * ===================================
+ * String ownership transfer functions
+ * ===================================
+ */
+
+/**
+ * @brief Copy the data fields of one string into another
+ * @param dest String receiving the data (its own data must already be released)
+ * @param src String giving up the data
+ * @details Inline content is copied into the inline buffer of dest; any other
+ *          storage is taken over by pointer. Ownership and allocator are kept.
+ */
+static void string_take_data(string_t *dest, const string_t *src) {
+    if (src->storage == STRING_STORAGE_INLINE) {
+        memcpy(dest->inline_data, src->data, src->length + 1);
+        dest->data = dest->inline_data;
+    } else {
+        dest->data = src->data;
+    }
+    dest->length = src->length;
+    dest->capacity = src->capacity;
+    dest->storage = src->storage;
+    dest->hash = src->hash;
+    dest->has_hash = src->has_hash;
+    dest->is_utf8 = src->is_utf8;
+}
+
+/**
+ * @brief Create a string that takes ownership of an existing buffer
+ * @param buffer Buffer from the thread allocator
+ * @param length Content length
+ * @param capacity Buffer size (greater than length)
+ * @return string_t* Pointer to new string or NULL on failure
+ * @details Only the header is allocated; the buffer becomes the heap data
+ */
+string_t *string_adopt(char *buffer, size_t length, size_t capacity) {
+    if (!buffer || capacity <= length) {
+        return NULL;
+    }
+
+    const string_allocator_t *allocator = string_get_thread_allocator();
+    string_t *str = allocator->allocate(allocator->context, sizeof(string_t));
+    if (!str) {
+        return NULL;
+    }
+    STRING_STATS_ADD(allocations, 1);
+    STRING_STATS_ADD(bytes_allocated, sizeof(string_t));
+
+    buffer[length] = '\0';
+    str->data = buffer;
+    str->length = length;
+    str->capacity = capacity;
+    str->is_owner = true;
+    str->has_hash = false;
+    str->is_utf8 = false;
+    str->storage = STRING_STORAGE_HEAP;
+    str->allocator = allocator;
+
+    return str;
+}
+
+/**
+ * @brief Hand the data buffer of a string over to the caller
+ * @param str String to release the buffer of
+ * @param length Receives the content length (optional)
+ * @param capacity Receives the buffer size (optional)
+ * @return char* Caller-owned buffer or NULL on failure
+ * @details Only non-heap content needs a copy; the string ends up empty and inline
+ */
+char *string_release(string_t *str, size_t *length, size_t *capacity) {
+    if (!str || !str->is_owner) {
+        return NULL;
+    }
+
+    char *buffer = str->data;
+    size_t size = str->capacity;
+    if (str->storage != STRING_STORAGE_HEAP) {
+        size = str->length + 1;
+        buffer = str->allocator->allocate(str->allocator->context, size);
+        if (!buffer) {
+            return NULL;
+        }
+        STRING_STATS_ADD(allocations, 1);
+        STRING_STATS_ADD(bytes_allocated, size);
+        memcpy(buffer, str->data, size);
+        STRING_STATS_ADD(bytes_copied, str->length);
+        if (str->storage == STRING_STORAGE_SHARED) {
+            string_shared_release(str);
+        }
+    }
+
+    if (length) {
+        *length = str->length;
+    }
+    if (capacity) {
+        *capacity = size;
+    }
+
+    string_setup(str, STRING_SSO_CAPACITY, str->allocator);
+
+    return buffer;
+}
+
+/**
+ * @brief Exchange the contents of two strings
+ * @param str1 First string
+ * @param str2 Second string
+ * @return string_result_t Success or error code
+ * @details Exchanges pointers, so heap data must be released by the same allocator
+ */
+string_result_t string_swap(string_t *str1, string_t *str2) {
+    if (!str1 || !str2) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    if (!str1->is_owner || !str2->is_owner) {
+        return STRING_ERROR_READ_ONLY;
+    }
+
+    if (str1->allocator != str2->allocator &&
+        (str1->storage == STRING_STORAGE_HEAP || str2->storage == STRING_STORAGE_HEAP)) {
+        return STRING_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (str1 != str2) {
+        string_t tmp;
+        string_take_data(&tmp, str1);
+        string_take_data(str1, str2);
+        string_take_data(str2, &tmp);
+    }
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Move the content of one string into another
+ * @param dest Destination string
+ * @param src Source string
+ * @return string_result_t Success or error code
+ * @details Releases the destination data, takes over the source data and
+ *          resets the source to an empty inline state
+ */
+string_result_t string_move(string_t *dest, string_t *src) {
+    if (!dest || !src) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    if (!dest->is_owner || !src->is_owner) {
+        return STRING_ERROR_READ_ONLY;
+    }
+
+    if (dest->allocator != src->allocator && src->storage == STRING_STORAGE_HEAP) {
+        return STRING_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (dest != src) {
+        string_release_data(dest);
+        string_take_data(dest, src);
+        string_setup(src, STRING_SSO_CAPACITY, src->allocator);
+    }
+
+    return STRING_SUCCESS;
+}
+
 /*
  * ===============================
  * String concatenation functions
@@ -427,14 +1329,13 @@ string_result_t string_assign_string(string_t *dest, const string_t *src) {
  */
 
 /**
- * @brief Append buffer content to end of string
+ * @brief Append buffer content to end of string (untimed)
  * @param str Target string to append to
  * @param buffer Source buffer to append from
  * @param length Number of bytes to append
  * @return string_result_t Success or error code
- * @details Adds buffer content to end without replacing existing content
  */
-string_result_t string_append_buffer(string_t *str, const char *buffer, size_t length) {
+static string_result_t string_append_impl(string_t *str, const char *buffer, size_t length) {
     if (!str) {
         return STRING_ERROR_NULL_POINTER;
     }
@@ -447,19 +1348,40 @@ string_result_t string_append_buffer(string_t *str, const char *buffer, size_t l
         return STRING_SUCCESS;
     }
 
+    // A view into this string must be rebased if the data moves
+    bool is_self = buffer >= str->data && buffer < str->data + str->length;
+    size_t self_offset = is_self ? (size_t)(buffer - str->data) : 0;
+
     size_t new_length = str->length + length;
-    string_result_t result = string_ensure_capacity(str, new_length + 1);
+    string_result_t result = string_ensure_room(str, str->length, length);
     if (result != STRING_SUCCESS) {
         return result;
     }
 
+    if (is_self) {
+        buffer = str->data + self_offset;
+    }
+
     memcpy(str->data + str->length, buffer, length);
+    STRING_STATS_ADD(bytes_copied, length);
     str->length = new_length;
     str->data[new_length] = '\0';
 
     return STRING_SUCCESS;
 }
 
+/**
+ * @brief Append buffer content to end of string
+ * @param str Target string to append to
+ * @param buffer Source buffer to append from
+ * @param length Number of bytes to append
+ * @return string_result_t Success or error code
+ * @details Adds buffer content to end without replacing existing content
+ */
+string_result_t string_append_buffer(string_t *str, const char *buffer, size_t length) {
+    STRING_STATS_RETURN_TIMED(string_result_t, STRING_STATS_OP_APPEND, length, string_append_impl(str, buffer, length));
+}
+
 /**
  * @brief Append C string content to end of string
  * @param str Target string to append to
@@ -510,68 +1432,247 @@ string_result_t string_append_char(string_t *str, char c) {
     return string_append_buffer(str, &c, 1);
 }
 
-/*
- * ===========================
- * String insertion functions
- * ===========================
+/**
+ * @brief Get one piece of a gather list
+ * @param views Array of views, or NULL when strings is used
+ * @param strings Array of strings
+ * @param index Index of the piece
+ * @return string_view_t View of the piece (empty for a NULL string)
  */
+static string_view_t string_piece_at(const string_view_t *views, const string_t *const *strings, size_t index) {
+    if (views) {
+        return views[index];
+    }
+
+    const string_t *piece = strings[index];
+    return piece ? string_view_from_buffer(piece->data, piece->length) : string_view_from_buffer("", 0);
+}
 
 /**
- * @brief Insert buffer content at specified position in string
- * @param str Target string to insert into
- * @param index Position to insert at (0-based)
- * @param buffer Source buffer to insert from
- * @param length Number of bytes to insert
+ * @brief Copy one piece of a gather list, rebasing it if it pointed into the old data
+ * @param out Destination position
+ * @param piece Piece to copy
+ * @param data Current data of the destination string
+ * @param old_begin Address of the destination data before it grew
+ * @param old_length Length of the destination before the append
+ * @return char* Position after the copied bytes
+ */
+static char *string_copy_piece(char *out, string_view_t piece, const char *data, uintptr_t old_begin, size_t old_length) {
+    uintptr_t address = (uintptr_t)piece.data;
+    const char *source = piece.data;
+    if (address >= old_begin && address < old_begin + old_length) {
+        source = data + (address - old_begin);
+    }
+
+    memcpy(out, source, piece.length);
+    return out + piece.length;
+}
+
+/**
+ * @brief Append a list of pieces with optional separators in one allocation
+ * @param str Target string to append to
+ * @param views Array of views, or NULL to read from strings
+ * @param strings Array of strings, used when views is NULL
+ * @param count Number of pieces
+ * @param separator Separator placed between consecutive pieces (may be empty)
  * @return string_result_t Success or error code
- * @details Inserts content at position, shifting existing content right
+ * @details Sums the lengths, grows once, then copies each piece once. Pieces and
+ *          the separator may point into str and are rebased if its data moves.
  */
-string_result_t string_insert_buffer(string_t *str, size_t index, const char *buffer, size_t length) {
-    if (!str) {
+static string_result_t string_append_pieces(string_t *str,
+                                            const string_view_t *views,
+                                            const string_t *const *strings,
+                                            size_t count,
+                                            string_view_t separator) {
+    if (!str || (count > 0 && !views && !strings)) {
         return STRING_ERROR_NULL_POINTER;
     }
 
-    if (index > str->length) {
-        return STRING_ERROR_INVALID_INDEX;
+    if (!separator.data && separator.length > 0) {
+        return STRING_ERROR_INVALID_ARGUMENT;
     }
 
-    if (!buffer && length > 0) {
-        return STRING_ERROR_INVALID_ARGUMENT;
+    size_t old_length = str->length;
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        string_view_t piece = string_piece_at(views, strings, i);
+        if (!piece.data && piece.length > 0) {
+            return STRING_ERROR_INVALID_ARGUMENT;
+        }
+
+        size_t step = piece.length + (i > 0 ? separator.length : 0);
+        if (step < piece.length || total > SIZE_MAX - old_length - 1 - step) {
+            return STRING_ERROR_OUT_OF_MEMORY;
+        }
+        total += step;
     }
 
-    if (length == 0) {
+    if (total == 0) {
         return STRING_SUCCESS;
     }
 
-    size_t new_length = str->length + length;
-    string_result_t result = string_ensure_capacity(str, new_length + 1);
+    // Views into this string must be rebased if the data moves
+    uintptr_t old_begin = (uintptr_t)str->data;
+    string_result_t result = string_ensure_capacity(str, old_length + total + 1);
     if (result != STRING_SUCCESS) {
         return result;
     }
 
-    // Move existing characters after insertion point
-    if (index < str->length) {
-        memmove(str->data + index + length, str->data + index, str->length - index);
+    char *out = str->data + old_length;
+    for (size_t i = 0; i < count; ++i) {
+        if (i > 0) {
+            out = string_copy_piece(out, separator, str->data, old_begin, old_length);
+        }
+        out = string_copy_piece(out, string_piece_at(views, strings, i), str->data, old_begin, old_length);
     }
 
-    // Insert new characters
-    memcpy(str->data + index, buffer, length);
-    str->length = new_length;
-    str->data[new_length] = '\0';
+    str->length = old_length + total;
+    str->data[str->length] = '\0';
 
     return STRING_SUCCESS;
 }
 
 /**
- * @brief Insert C string content at specified position in string
- * @param str Target string to insert into
- * @param index Position to insert at (0-based)
- * @param cstr Source C string to insert from
+ * @brief Append several strings with a single allocation
+ * @param dest Target string to append to
+ * @param strings Array of strings to append
+ * @param count Number of elements in the array
  * @return string_result_t Success or error code
- * @details Inserts C string at position, shifting existing content right
  */
-string_result_t string_insert_cstr(string_t *str, size_t index, const char *cstr) {
-    if (!str) {
-        return STRING_ERROR_NULL_POINTER;
+string_result_t string_concat_many(string_t *dest, const string_t *const *strings, size_t count) {
+    return string_append_pieces(dest, NULL, strings, count, string_view_from_buffer(NULL, 0));
+}
+
+/**
+ * @brief Append several strings separated by a separator
+ * @param dest Target string to append to
+ * @param strings Array of strings to join
+ * @param count Number of elements in the array
+ * @param separator Separator placed between consecutive pieces
+ * @return string_result_t Success or error code
+ */
+string_result_t string_join(string_t *dest, const string_t *const *strings, size_t count, string_view_t separator) {
+    return string_append_pieces(dest, NULL, strings, count, separator);
+}
+
+/**
+ * @brief Append a gather list of buffers with a single allocation
+ * @param dest Target string to append to
+ * @param views Array of pieces to append
+ * @param count Number of elements in the array
+ * @return string_result_t Success or error code
+ */
+string_result_t string_append_views(string_t *dest, const string_view_t *views, size_t count) {
+    return string_append_pieces(dest, views, NULL, count, string_view_from_buffer(NULL, 0));
+}
+
+/**
+ * @brief Append a gather list of buffers separated by a separator
+ * @param dest Target string to append to
+ * @param views Array of pieces to join
+ * @param count Number of elements in the array
+ * @param separator Separator placed between consecutive pieces
+ * @return string_result_t Success or error code
+ */
+string_result_t string_join_views(string_t *dest, const string_view_t *views, size_t count, string_view_t separator) {
+    return string_append_pieces(dest, views, NULL, count, separator);
+}
+
+/*
+ * ===========================
+ * String insertion functions
+ * ===========================
+ */
+
+/**
+ * @brief Insert buffer content at specified position in string (untimed)
+ * @param str Target string to insert into
+ * @param index Position to insert at (0-based)
+ * @param buffer Source buffer to insert from
+ * @param length Number of bytes to insert
+ * @return string_result_t Success or error code
+ */
+static string_result_t string_insert_impl(string_t *str, size_t index, const char *buffer, size_t length) {
+    if (!str) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    if (index > str->length) {
+        return STRING_ERROR_INVALID_INDEX;
+    }
+
+    if (!buffer && length > 0) {
+        return STRING_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (length == 0) {
+        return STRING_SUCCESS;
+    }
+
+    // A view into this string must be rebased if the data moves
+    bool is_self = buffer >= str->data && buffer < str->data + str->length;
+    size_t self_offset = is_self ? (size_t)(buffer - str->data) : 0;
+
+    size_t new_length = str->length + length;
+    string_result_t result = string_ensure_room(str, str->length, length);
+    if (result != STRING_SUCCESS) {
+        return result;
+    }
+
+    if (is_self) {
+        buffer = str->data + self_offset;
+    }
+
+    // Move existing characters after insertion point
+    if (index < str->length) {
+        memmove(str->data + index + length, str->data + index, str->length - index);
+        STRING_STATS_ADD(memmoves, 1);
+        STRING_STATS_ADD(bytes_moved, str->length - index);
+    }
+
+    // Insert new characters
+    if (is_self) {
+        // Source bytes before the insertion point stayed put; the rest moved with the tail
+        size_t head = self_offset < index ? index - self_offset : 0;
+        if (head > length) {
+            head = length;
+        }
+        memcpy(str->data + index, buffer, head);
+        memcpy(str->data + index + head, buffer + head + length, length - head);
+    } else {
+        memcpy(str->data + index, buffer, length);
+    }
+    STRING_STATS_ADD(bytes_copied, length);
+    str->length = new_length;
+    str->data[new_length] = '\0';
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Insert buffer content at specified position in string
+ * @param str Target string to insert into
+ * @param index Position to insert at (0-based)
+ * @param buffer Source buffer to insert from
+ * @param length Number of bytes to insert
+ * @return string_result_t Success or error code
+ * @details Inserts content at position, shifting existing content right
+ */
+string_result_t string_insert_buffer(string_t *str, size_t index, const char *buffer, size_t length) {
+    STRING_STATS_RETURN_TIMED(string_result_t, STRING_STATS_OP_INSERT, length, string_insert_impl(str, index, buffer, length));
+}
+
+/**
+ * @brief Insert C string content at specified position in string
+ * @param str Target string to insert into
+ * @param index Position to insert at (0-based)
+ * @param cstr Source C string to insert from
+ * @return string_result_t Success or error code
+ * @details Inserts C string at position, shifting existing content right
+ */
+string_result_t string_insert_cstr(string_t *str, size_t index, const char *cstr) {
+    if (!str) {
+        return STRING_ERROR_NULL_POINTER;
     }
 
     if (!cstr) {
@@ -621,16 +1722,16 @@ string_result_t string_insert_char(string_t *str, size_t index, char c) {
  */
 
 /**
- * @brief Erase characters from string starting at specified position
+ * @brief Erase characters from string starting at specified position (untimed)
  * @param str Target string to erase from
  * @param index Starting position for erasure (0-based)
  * @param count Number of characters to erase
  * @return string_result_t Success or error code
- * @details Removes characters and shifts remaining content left
  */
-string_result_t string_erase(string_t *str, size_t index, size_t count) {
-    if (!str) {
-        return STRING_ERROR_NULL_POINTER;
+static string_result_t string_erase_impl(string_t *str, size_t index, size_t count) {
+    string_result_t result = string_begin_mutation(str);
+    if (result != STRING_SUCCESS) {
+        return result;
     }
 
     if (index >= str->length) {
@@ -650,6 +1751,8 @@ string_result_t string_erase(string_t *str, size_t index, size_t count) {
     size_t chars_after = str->length - index - count;
     if (chars_after > 0) {
         memmove(str->data + index, str->data + index + count, chars_after);
+        STRING_STATS_ADD(memmoves, 1);
+        STRING_STATS_ADD(bytes_moved, chars_after);
     }
 
     str->length -= count;
@@ -658,6 +1761,18 @@ string_result_t string_erase(string_t *str, size_t index, size_t count) {
     return STRING_SUCCESS;
 }
 
+/**
+ * @brief Erase characters from string starting at specified position
+ * @param str Target string to erase from
+ * @param index Starting position for erasure (0-based)
+ * @param count Number of characters to erase
+ * @return string_result_t Success or error code
+ * @details Removes characters and shifts remaining content left
+ */
+string_result_t string_erase(string_t *str, size_t index, size_t count) {
+    STRING_STATS_RETURN_TIMED(string_result_t, STRING_STATS_OP_ERASE, count, string_erase_impl(str, index, count));
+}
+
 /**
  * @brief Remove the last character from string
  * @param str Target string to modify
@@ -669,6 +1784,11 @@ string_result_t string_pop_back(string_t *str) {
         return STRING_ERROR_INVALID_INDEX;
     }
 
+    string_result_t result = string_begin_mutation(str);
+    if (result != STRING_SUCCESS) {
+        return result;
+    }
+
     str->length--;
     str->data[str->length] = '\0';
 
@@ -705,8 +1825,9 @@ char string_at(const string_t *str, size_t index) {
  * @details Safe character modification with bounds checking
  */
 string_result_t string_set_at(string_t *str, size_t index, char c) {
-    if (!str) {
-        return STRING_ERROR_NULL_POINTER;
+    string_result_t result = string_begin_mutation(str);
+    if (result != STRING_SUCCESS) {
+        return result;
     }
 
     if (index >= str->length) {
@@ -723,6 +1844,41 @@ string_result_t string_set_at(string_t *str, size_t index, char c) {
  * ============================
  */
 
+/**
+ * @brief Check two byte ranges of the same length for equality
+ * @param a First range
+ * @param b Second range
+ * @param length Number of bytes in each range
+ * @return bool True if the ranges hold the same bytes
+ * @details Up to 16 bytes are compared as two overlapping words from each end,
+ *          with no loop and no call; longer ranges go to memcmp()
+ */
+static inline bool string_bytes_equal(const char *a, const char *b, size_t length) {
+    if (length >= 8 && length <= 16) {
+        uint64_t a_head, b_head, a_tail, b_tail;
+        memcpy(&a_head, a, 8);
+        memcpy(&b_head, b, 8);
+        memcpy(&a_tail, a + length - 8, 8);
+        memcpy(&b_tail, b + length - 8, 8);
+        return ((a_head ^ b_head) | (a_tail ^ b_tail)) == 0;
+    }
+
+    if (length >= 4 && length < 8) {
+        uint32_t a_head, b_head, a_tail, b_tail;
+        memcpy(&a_head, a, 4);
+        memcpy(&b_head, b, 4);
+        memcpy(&a_tail, a + length - 4, 4);
+        memcpy(&b_tail, b + length - 4, 4);
+        return ((a_head ^ b_head) | (a_tail ^ b_tail)) == 0;
+    }
+
+    if (length < 4) {
+        return length == 0 || (a[0] == b[0] && a[length / 2] == b[length / 2] && a[length - 1] == b[length - 1]);
+    }
+
+    return memcmp(a, b, length) == 0;
+}
+
 /**
  * @brief Compare two strings lexicographically
  * @param str1 First string to compare
@@ -758,7 +1914,7 @@ int string_compare_cstr(const string_t *str, const char *cstr) {
     if (!str) return -1;
     if (!cstr) return 1;
 
-    return strcmp(str->data, cstr);
+    return string_view_compare(string_view_from_string(str), string_view_from_cstr(cstr));
 }
 
 /**
@@ -766,10 +1922,57 @@ int string_compare_cstr(const string_t *str, const char *cstr) {
  * @param str1 First string to compare
  * @param str2 Second string to compare
  * @return bool true if strings are equal, false otherwise
- * @details Convenient equality check using string comparison
+ * @details Different lengths or different cached hashes answer without reading
+ *          the data; clones sharing one buffer answer from the pointer
  */
 bool string_equals(const string_t *str1, const string_t *str2) {
-    return string_compare(str1, str2) == 0;
+    // Interned strings are equal exactly when they are the same object
+    if (str1 == str2) {
+        return true;
+    }
+
+    if (!str1 || !str2 || str1->length != str2->length) {
+        return false;
+    }
+
+    if (str1->has_hash && str2->has_hash && str1->hash != str2->hash) {
+        return false;
+    }
+
+    return str1->data == str2->data || string_bytes_equal(str1->data, str2->data, str1->length);
+}
+
+/**
+ * @brief Hash the content of a string
+ * @param str String to hash
+ * @return uint64_t Cached or freshly computed hash
+ * @details Never writes to the string
+ */
+uint64_t string_hash(const string_t *str) {
+    if (!str) {
+        return 0;
+    }
+
+    return str->has_hash ? str->hash : string_view_hash(string_view_from_buffer(str->data, str->length));
+}
+
+/**
+ * @brief Hash the content of a string and cache the result in it
+ * @param str String to hash
+ * @return uint64_t Cached hash
+ * @details The cache is cleared by string_drop_caches() when the content changes
+ */
+uint64_t string_hash_cached(string_t *str) {
+    if (!str) {
+        return 0;
+    }
+
+    if (!str->has_hash) {
+        str->hash = string_view_hash(string_view_from_buffer(str->data, str->length));
+        str->has_hash = true;
+    }
+
+    return str->hash;
 }
 
 /**
@@ -777,10 +1980,60 @@ bool string_equals(const string_t *str1, const string_t *str2) {
  * @param str String to compare
  * @param cstr C string to compare with
  * @return bool true if strings are equal, false otherwise
- * @details Convenient equality check using C string comparison
+ * @details Measures the C string once, then compares lengths before any bytes
  */
 bool string_equals_cstr(const string_t *str, const char *cstr) {
-    return string_compare_cstr(str, cstr) == 0;
+    if (!str || !cstr) {
+        return !str && !cstr;
+    }
+
+    return string_equals_buffer(str, cstr, strlen(cstr));
+}
+
+/**
+ * @brief Check if string equals a buffer
+ * @param str String to compare
+ * @param buffer Bytes to compare with
+ * @param length Number of bytes in the buffer
+ * @return bool true if equal, false otherwise
+ * @details Compares lengths before any bytes
+ */
+bool string_equals_buffer(const string_t *str, const char *buffer, size_t length) {
+    if (!str || (!buffer && length > 0)) {
+        return false;
+    }
+
+    return str->length == length && string_bytes_equal(str->data, buffer, length);
+}
+
+/**
+ * @brief Compare two strings lexicographically ignoring ASCII case
+ * @param str1 First string to compare
+ * @param str2 Second string to compare
+ * @return int Negative if str1 < str2, 0 if equal, positive if str1 > str2
+ * @details Performs safe comparison handling NULL pointers
+ */
+int string_compare_icase(const string_t *str1, const string_t *str2) {
+    if (!str1 && !str2) return 0;
+    if (!str1) return -1;
+    if (!str2) return 1;
+
+    return string_view_compare_icase(string_view_from_string(str1), string_view_from_string(str2));
+}
+
+/**
+ * @brief Check if two strings are equal ignoring ASCII case
+ * @param str1 First string to compare
+ * @param str2 Second string to compare
+ * @return bool true if strings are equal, false otherwise
+ * @details Compares lengths before any bytes
+ */
+bool string_equals_icase(const string_t *str1, const string_t *str2) {
+    if (!str1 || !str2) {
+        return str1 == str2;
+    }
+
+    return string_view_equals_icase(string_view_from_string(str1), string_view_from_string(str2));
 }
 
 /*
@@ -795,20 +2048,14 @@ bool string_equals_cstr(const string_t *str, const char *cstr) {
  * @param c Character to search for
  * @param start_pos Starting position for search (0-based)
  * @return size_t Position of character or STRING_NPOS if not found
- * @details Searches forward from start_pos for character
+ * @details Searches forward from start_pos using the vectorized byte kernel
  */
 size_t string_find_char(const string_t *str, char c, size_t start_pos) {
-    if (!str || start_pos >= str->length) {
+    if (!str) {
         return STRING_NPOS;
     }
 
-    for (size_t i = start_pos; i < str->length; ++i) {
-        if (str->data[i] == c) {
-            return i;
-        }
-    }
-
-    return STRING_NPOS;
+    return string_view_find_char(string_view_from_string(str), c, start_pos);
 }
 
 /**
@@ -820,42 +2067,60 @@ size_t string_find_char(const string_t *str, char c, size_t start_pos) {
  * @details Searches forward from start_pos for substring
  */
 size_t string_find_cstr(const string_t *str, const char *substr, size_t start_pos) {
-    if (!str || !substr || start_pos >= str->length) {
+    if (!substr) {
         return STRING_NPOS;
     }
 
-    size_t substr_len = strlen(substr);
-    if (substr_len == 0) {
-        return start_pos;
-    }
+    return string_find_buffer(str, substr, strlen(substr), start_pos);
+}
 
-    if (start_pos + substr_len > str->length) {
+/**
+ * @brief Find first occurrence of string substring in string
+ * @param str String to search in
+ * @param substr String substring to search for
+ * @param start_pos Starting position for search (0-based)
+ * @return size_t Position of substring or STRING_NPOS if not found
+ * @details Uses the substring length, so embedded null bytes are honored
+ */
+size_t string_find_string(const string_t *str, const string_t *substr, size_t start_pos) {
+    if (!substr) {
         return STRING_NPOS;
     }
 
-    for (size_t i = start_pos; i <= str->length - substr_len; ++i) {
-        if (memcmp(str->data + i, substr, substr_len) == 0) {
-            return i;
-        }
+    return string_find_buffer(str, substr->data, substr->length, start_pos);
+}
+
+/**
+ * @brief Find first occurrence of a byte sequence in string
+ * @param str String to search in
+ * @param buffer Bytes to search for
+ * @param length Number of bytes to search for
+ * @param start_pos Starting position for search (0-based)
+ * @return size_t Position of the sequence or STRING_NPOS if not found
+ * @details Uses the vectorized prefilter for short needles and Two-Way for long ones
+ */
+size_t string_find_buffer(const string_t *str, const char *buffer, size_t length, size_t start_pos) {
+    if (!str || (!buffer && length > 0) || start_pos >= str->length) {
+        return STRING_NPOS;
     }
 
-    return STRING_NPOS;
+    return string_view_find(string_view_from_string(str), string_view_from_buffer(buffer, length), start_pos);
 }
 
 /**
- * @brief Find first occurrence of string substring in string
+ * @brief Find first occurrence of C string substring ignoring ASCII case
  * @param str String to search in
- * @param substr String substring to search for
+ * @param substr C string substring to search for
  * @param start_pos Starting position for search (0-based)
  * @return size_t Position of substring or STRING_NPOS if not found
- * @details Searches forward from start_pos for substring
+ * @details Uses the case-insensitive search kernel, no lowered copies are made
  */
-size_t string_find_string(const string_t *str, const string_t *substr, size_t start_pos) {
-    if (!str || !substr) {
+size_t string_find_icase(const string_t *str, const char *substr, size_t start_pos) {
+    if (!str || !substr || start_pos >= str->length) {
         return STRING_NPOS;
     }
 
-    return string_find_cstr(str, substr->data, start_pos);
+    return string_view_find_icase(string_view_from_string(str), string_view_from_cstr(substr), start_pos);
 }
 
 /**
@@ -867,21 +2132,43 @@ size_t string_find_string(const string_t *str, const string_t *substr, size_t st
  * @details Searches backward from start_pos for character
  */
 size_t string_rfind_char(const string_t *str, char c, size_t start_pos) {
-    if (!str || str->length == 0) {
+    if (!str) {
         return STRING_NPOS;
     }
 
-    if (start_pos >= str->length) {
-        start_pos = str->length - 1;
+    return string_view_rfind_char(string_view_from_string(str), c, start_pos);
+}
+
+/**
+ * @brief Find first occurrence of any character from a set
+ * @param str String to search in
+ * @param chars Null-terminated set of characters
+ * @param start_pos Starting position for search (0-based)
+ * @return size_t Position of match or STRING_NPOS if not found
+ * @details Searches forward from start_pos using the vectorized byte-set kernel
+ */
+size_t string_find_first_of(const string_t *str, const char *chars, size_t start_pos) {
+    if (!str || !chars) {
+        return STRING_NPOS;
     }
 
-    for (size_t i = start_pos + 1; i > 0; --i) {
-        if (str->data[i - 1] == c) {
-            return i - 1;
-        }
+    return string_view_find_first_of(string_view_from_string(str), string_view_from_cstr(chars), start_pos);
+}
+
+/**
+ * @brief Find last occurrence of any character from a set
+ * @param str String to search in
+ * @param chars Null-terminated set of characters
+ * @param start_pos Starting position for reverse search (STRING_NPOS for end)
+ * @return size_t Position of match or STRING_NPOS if not found
+ * @details Searches backward from start_pos using the vectorized byte-set kernel
+ */
+size_t string_find_last_of(const string_t *str, const char *chars, size_t start_pos) {
+    if (!str || !chars) {
+        return STRING_NPOS;
     }
 
-    return STRING_NPOS;
+    return string_view_find_last_of(string_view_from_string(str), string_view_from_cstr(chars), start_pos);
 }
 
 /*
@@ -891,67 +2178,115 @@ size_t string_rfind_char(const string_t *str, char c, size_t start_pos) {
  */
 
 /**
- * @brief Convert all characters in string to uppercase
+ * @brief Convert all ASCII letters in string to uppercase
  * @param str String to convert
  * @return string_result_t Success or error code
- * @details Modifies string in-place using toupper() function
+ * @details Modifies string in-place with the vectorized ASCII kernel
  */
 string_result_t string_to_upper(string_t *str) {
-    if (!str) {
-        return STRING_ERROR_NULL_POINTER;
+    string_result_t result = string_begin_mutation(str);
+    if (result != STRING_SUCCESS) {
+        return result;
     }
 
-    for (size_t i = 0; i < str->length; ++i) {
-        str->data[i] = toupper(str->data[i]);
-    }
+    string_simd_ascii_case(str->data, str->length, true);
 
     return STRING_SUCCESS;
 }
 
 /**
- * @brief Convert all characters in string to lowercase
+ * @brief Convert all ASCII letters in string to lowercase
  * @param str String to convert
  * @return string_result_t Success or error code
- * @details Modifies string in-place using tolower() function
+ * @details Modifies string in-place with the vectorized ASCII kernel
  */
 string_result_t string_to_lower(string_t *str) {
-    if (!str) {
-        return STRING_ERROR_NULL_POINTER;
+    string_result_t result = string_begin_mutation(str);
+    if (result != STRING_SUCCESS) {
+        return result;
     }
 
-    for (size_t i = 0; i < str->length; ++i) {
-        str->data[i] = tolower(str->data[i]);
-    }
+    string_simd_ascii_case(str->data, str->length, false);
 
     return STRING_SUCCESS;
 }
 
 /**
- * @brief Remove leading and trailing whitespace from string
- * @param str String to trim
+ * @brief Convert all characters in string to uppercase using the current locale
+ * @param str String to convert
  * @return string_result_t Success or error code
- * @details Removes spaces, tabs, newlines, and other whitespace characters
+ * @details Modifies string in-place using toupper() function
  */
-string_result_t string_trim(string_t *str) {
-    if (!str || str->length == 0) {
-        return STRING_ERROR_NULL_POINTER;
+string_result_t string_to_upper_locale(string_t *str) {
+    string_result_t result = string_begin_mutation(str);
+    if (result != STRING_SUCCESS) {
+        return result;
+    }
+
+    for (size_t i = 0; i < str->length; ++i) {
+        str->data[i] = (char)toupper((unsigned char)str->data[i]);
+    }
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Convert all characters in string to lowercase using the current locale
+ * @param str String to convert
+ * @return string_result_t Success or error code
+ * @details Modifies string in-place using tolower() function
+ */
+string_result_t string_to_lower_locale(string_t *str) {
+    string_result_t result = string_begin_mutation(str);
+    if (result != STRING_SUCCESS) {
+        return result;
+    }
+
+    for (size_t i = 0; i < str->length; ++i) {
+        str->data[i] = (char)tolower((unsigned char)str->data[i]);
+    }
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Remove bytes of a class from one or both ends of a string
+ * @param str String to trim
+ * @param cls Class of bytes to remove
+ * @param leading Whether to remove from the start
+ * @param trailing Whether to remove from the end
+ * @return string_result_t Success or error code
+ * @details Trailing bytes are dropped by shortening the length; only leading
+ *          bytes cost a memmove of the remaining content
+ */
+static string_result_t string_trim_ends(string_t *str, const string_char_class_t *cls, bool leading, bool trailing) {
+    if (!cls) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    string_result_t result = string_begin_mutation(str);
+    if (result != STRING_SUCCESS) {
+        return result;
     }
 
-    // Find first non-whitespace character
     size_t start = 0;
-    while (start < str->length && isspace(str->data[start])) {
-        start++;
+    if (leading) {
+        start = string_simd_find_class(str->data, str->length, cls, false);
+        if (start == STRING_NPOS) {
+            start = str->length;
+        }
     }
 
-    // Find last non-whitespace character
     size_t end = str->length;
-    while (end > start && isspace(str->data[end - 1])) {
-        end--;
+    if (trailing && end > start) {
+        size_t last = string_simd_rfind_class(str->data + start, end - start, cls, false);
+        end = last == STRING_NPOS ? start : start + last + 1;
     }
 
-    // Move trimmed content to beginning if needed
     if (start > 0) {
         memmove(str->data, str->data + start, end - start);
+        STRING_STATS_ADD(memmoves, 1);
+        STRING_STATS_ADD(bytes_moved, end - start);
     }
 
     str->length = end - start;
@@ -960,6 +2295,89 @@ string_result_t string_trim(string_t *str) {
     return STRING_SUCCESS;
 }
 
+/**
+ * @brief Remove leading and trailing whitespace from string
+ * @param str String to trim
+ * @return string_result_t Success or error code
+ * @details Removes spaces, tabs, newlines, and other ASCII whitespace characters
+ */
+string_result_t string_trim(string_t *str) {
+    return string_trim_ends(str, &string_class_space, true, true);
+}
+
+/**
+ * @brief Remove leading whitespace from string
+ * @param str String to trim
+ * @return string_result_t Success or error code
+ */
+string_result_t string_ltrim(string_t *str) {
+    return string_trim_ends(str, &string_class_space, true, false);
+}
+
+/**
+ * @brief Remove trailing whitespace from string
+ * @param str String to trim
+ * @return string_result_t Success or error code
+ */
+string_result_t string_rtrim(string_t *str) {
+    return string_trim_ends(str, &string_class_space, false, true);
+}
+
+/**
+ * @brief Remove leading and trailing bytes of a character class from string
+ * @param str String to trim
+ * @param cls Class of bytes to remove
+ * @return string_result_t Success or error code
+ */
+string_result_t string_trim_class(string_t *str, const string_char_class_t *cls) {
+    return string_trim_ends(str, cls, true, true);
+}
+
+/**
+ * @brief Trim a string and replace each inner run of whitespace with one space
+ * @param str String to modify
+ * @return string_result_t Success or error code
+ * @details Compacts in place, one pass: each word is moved down only once an
+ *          earlier run has been shortened
+ */
+string_result_t string_collapse_whitespace(string_t *str) {
+    string_result_t result = string_trim(str);
+    if (result != STRING_SUCCESS) {
+        return result;
+    }
+
+    char *data = str->data;
+    size_t length = str->length;
+    size_t read = string_simd_find_class(data, length, &string_class_space, true);
+    if (read == STRING_NPOS) {
+        return STRING_SUCCESS;
+    }
+
+    // After the trim every run of whitespace is followed by a word
+    size_t write = read;
+    while (read < length) {
+        size_t word = read + string_simd_find_class(data + read, length - read, &string_class_space, false);
+        size_t span = string_simd_find_class(data + word, length - word, &string_class_space, true);
+        if (span == STRING_NPOS) {
+            span = length - word;
+        }
+
+        data[write++] = ' ';
+        if (write != word) {
+            memmove(data + write, data + word, span);
+            STRING_STATS_ADD(memmoves, 1);
+            STRING_STATS_ADD(bytes_moved, span);
+        }
+        write += span;
+        read = word + span;
+    }
+
+    str->length = write;
+    data[write] = '\0';
+
+    return STRING_SUCCESS;
+}
+
 /**
  * @brief Replace all occurrences of one character with another
  * @param str String to modify
@@ -969,8 +2387,9 @@ string_result_t string_trim(string_t *str) {
  * @details Replaces all instances of old_char with new_char in string
  */
 string_result_t string_replace_char(string_t *str, char old_char, char new_char) {
-    if (!str) {
-        return STRING_ERROR_NULL_POINTER;
+    string_result_t result = string_begin_mutation(str);
+    if (result != STRING_SUCCESS) {
+        return result;
     }
 
     for (size_t i = 0; i < str->length; ++i) {
@@ -982,123 +2401,1648 @@ string_result_t string_replace_char(string_t *str, char old_char, char new_char)
     return STRING_SUCCESS;
 }
 
-/*
- * =========================
- * String copying functions
- * =========================
+/**
+ * @brief Check whether a view points into a string's data
+ * @param str String to check against
+ * @param view View to check
+ * @return bool true if the view overlaps the string's data
  */
+static bool string_view_overlaps(const string_t *str, string_view_t view) {
+    uintptr_t begin = (uintptr_t)str->data;
+    uintptr_t address = (uintptr_t)view.data;
+    return view.length > 0 && address < begin + str->length && address + view.length > begin;
+}
 
 /**
- * @brief Safely copy string content to C-style buffer
- * @param str Source string to copy from
- * @param buffer Destination buffer to copy to
- * @param buffer_size Size of destination buffer
- * @return string_result_t Success or error code indicating truncation
- * @details Copies as much as possible, always null-terminates buffer
+ * @brief Replace up to limit occurrences of a pattern in one forward pass
+ * @param str String to modify
+ * @param pattern Pattern to replace (non-empty)
+ * @param replacement Replacement bytes
+ * @param limit Maximum number of replacements
+ * @param count Receives the number of replacements made (can be NULL)
+ * @return string_result_t Success or error code
+ * @details When the replacement is longer, matches are counted first so the
+ *          buffer grows once; the content after the first match is then moved to
+ *          the end of the grown buffer and the result is written from the front.
+ *          Writes never overtake the unread source, so no scratch copy is needed.
  */
-string_result_t string_copy_to_buffer(const string_t *str, char *buffer, size_t buffer_size) {
-    if (!str || !buffer) {
+static string_result_t string_replace_impl(string_t *str, string_view_t pattern, string_view_t replacement, size_t limit, size_t *count) {
+    if (count) {
+        *count = 0;
+    }
+
+    if (!str || !pattern.data || (!replacement.data && replacement.length > 0)) {
         return STRING_ERROR_NULL_POINTER;
     }
 
-    if (buffer_size == 0) {
-        return STRING_ERROR_BUFFER_TOO_SMALL;
+    if (pattern.length == 0) {
+        return STRING_ERROR_INVALID_ARGUMENT;
     }
 
-    size_t copy_length = str->length;
-    if (copy_length >= buffer_size) {
-        copy_length = buffer_size - 1;
+    if (!str->is_owner) {
+        return STRING_ERROR_READ_ONLY;
     }
 
-    memcpy(buffer, str->data, copy_length);
-    buffer[copy_length] = '\0';
+    // Searching a shared buffer is safe, so a call that replaces nothing neither
+    // detaches the string nor drops its caches
+    size_t length = str->length;
+    size_t first = string_simd_find_substr(str->data, length, pattern.data, pattern.length);
+    if (first == STRING_NPOS) {
+        return STRING_SUCCESS;
+    }
 
-    return copy_length == str->length ? STRING_SUCCESS : STRING_ERROR_BUFFER_TOO_SMALL;
+    // Arguments viewing this string would be overwritten while still in use, or
+    // freed when a shared buffer is detached, so they are copied first
+    if (string_view_overlaps(str, pattern) || string_view_overlaps(str, replacement)) {
+        const string_allocator_t *allocator = str->allocator;
+        size_t size = pattern.length + replacement.length;
+        char *copy = allocator->allocate(allocator->context, size);
+        if (!copy) {
+            return STRING_ERROR_OUT_OF_MEMORY;
+        }
+
+        memcpy(copy, pattern.data, pattern.length);
+        if (replacement.length > 0) {
+            memcpy(copy + pattern.length, replacement.data, replacement.length);
+        }
+        string_result_t result = string_replace_impl(str,
+                                                     string_view_from_buffer(copy, pattern.length),
+                                                     string_view_from_buffer(copy + pattern.length, replacement.length),
+                                                     limit,
+                                                     count);
+        allocator->deallocate(allocator->context, copy, size);
+        return result;
+    }
+
+    string_result_t result = string_begin_mutation(str);
+    if (result != STRING_SUCCESS) {
+        return result;
+    }
+
+    size_t matches = 1;
+    size_t shift = 0;
+    if (replacement.length > pattern.length) {
+        for (size_t pos = first + pattern.length; matches < limit; ++matches) {
+            size_t found = string_simd_find_substr(str->data + pos, length - pos, pattern.data, pattern.length);
+            if (found == STRING_NPOS) {
+                break;
+            }
+            pos += found + pattern.length;
+        }
+
+        size_t extra = replacement.length - pattern.length;
+        if (matches > (SIZE_MAX - length - 1) / extra) {
+            return STRING_ERROR_OUT_OF_MEMORY;
+        }
+
+        shift = matches * extra;
+        result = string_ensure_capacity(str, length + shift + 1);
+        if (result != STRING_SUCCESS) {
+            return result;
+        }
+        memmove(str->data + first + shift, str->data + first, length - first);
+        STRING_STATS_ADD(memmoves, 1);
+        STRING_STATS_ADD(bytes_moved, length - first);
+    }
+
+    // The unread source lives at src, shifted right by the growth if any
+    char *data = str->data;
+    const char *src = data + shift;
+    size_t read = first;
+    size_t write = first;
+    size_t done = 0;
+    size_t pos = first;
+    while (pos != STRING_NPOS) {
+        if (data + write != src + read) {
+            memmove(data + write, src + read, pos - read);
+            STRING_STATS_ADD(memmoves, 1);
+            STRING_STATS_ADD(bytes_moved, pos - read);
+        }
+        write += pos - read;
+        memcpy(data + write, replacement.data, replacement.length);
+        STRING_STATS_ADD(bytes_copied, replacement.length);
+        write += replacement.length;
+        read = pos + pattern.length;
+
+        if (++done == limit) {
+            break;
+        }
+        pos = string_simd_find_substr(src + read, length - read, pattern.data, pattern.length);
+        if (pos != STRING_NPOS) {
+            pos += read;
+        }
+    }
+
+    if (data + write != src + read) {
+        memmove(data + write, src + read, length - read);
+        STRING_STATS_ADD(memmoves, 1);
+        STRING_STATS_ADD(bytes_moved, length - read);
+    }
+    write += length - read;
+
+    str->length = write;
+    data[write] = '\0';
+    if (count) {
+        *count = done;
+    }
+
+    return STRING_SUCCESS;
 }
 
-/*
- * ============================
- * String formatting functions
- * ============================
+/**
+ * @brief Replace every occurrence of a pattern
+ * @param str String to modify
+ * @param pattern Pattern to replace
+ * @param replacement Replacement bytes
+ * @param count Receives the number of replacements made (can be NULL)
+ * @return string_result_t Success or error code
  */
+string_result_t string_replace_all(string_t *str, string_view_t pattern, string_view_t replacement, size_t *count) {
+    STRING_STATS_RETURN_TIMED(string_result_t, STRING_STATS_OP_REPLACE, str ? str->length : 0,
+                              string_replace_impl(str, pattern, replacement, SIZE_MAX, count));
+}
 
 /**
- * @brief Format string using printf-style format specifiers
- * @param str Target string to store formatted result
- * @param format Printf-style format string
- * @param ... Variable arguments for format string
+ * @brief Replace the first occurrence of a pattern
+ * @param str String to modify
+ * @param pattern Pattern to replace
+ * @param replacement Replacement bytes
+ * @param count Receives 1 if a replacement was made (can be NULL)
  * @return string_result_t Success or error code
- * @details Replaces entire string content with formatted result
  */
-string_result_t string_format(string_t *str, const char *format, ...) {
-    if (!str || !format) {
+string_result_t string_replace_first(string_t *str, string_view_t pattern, string_view_t replacement, size_t *count) {
+    STRING_STATS_RETURN_TIMED(string_result_t, STRING_STATS_OP_REPLACE, str ? str->length : 0,
+                              string_replace_impl(str, pattern, replacement, 1, count));
+}
+
+/**
+ * @brief Replace every occurrence of a C string pattern
+ * @param str String to modify
+ * @param pattern Pattern C string to replace
+ * @param replacement Replacement C string
+ * @return string_result_t Success or error code
+ */
+string_result_t string_replace_all_cstr(string_t *str, const char *pattern, const char *replacement) {
+    if (!pattern || !replacement) {
         return STRING_ERROR_NULL_POINTER;
     }
 
-    va_list args;
-    va_start(args, format);
+    return string_replace_all(str, string_view_from_cstr(pattern), string_view_from_cstr(replacement), NULL);
+}
 
-    // Calculate required length
-    va_list args_copy;
-    va_copy(args_copy, args);
-    int required_length = vsnprintf(NULL, 0, format, args_copy);
-    va_end(args_copy);
+/*
+ * ========================
+ * String batch functions
+ * ========================
+ */
 
-    if (required_length < 0) {
-        va_end(args);
-        return STRING_ERROR_INVALID_ARGUMENT;
+/**
+ * @brief Convert the ASCII letters of every string of an array to one case
+ * @param strings Array of strings to convert
+ * @param count Number of elements in the array
+ * @param upper Convert to uppercase (true) or lowercase (false)
+ * @return string_result_t Success or error code
+ * @details The first pass checks every entry, so nothing is modified unless all
+ *          of them may be; only detaching a shared buffer can still fail midway.
+ */
+static string_result_t string_batch_case(string_t *const *strings, size_t count, bool upper) {
+    if (count > 0 && !strings) {
+        return STRING_ERROR_NULL_POINTER;
     }
 
-    string_result_t result = string_ensure_capacity(str, required_length + 1);
-    if (result != STRING_SUCCESS) {
-        va_end(args);
-        return result;
+    for (size_t i = 0; i < count; ++i) {
+        if (!strings[i]) {
+            return STRING_ERROR_NULL_POINTER;
+        }
+        if (!strings[i]->is_owner) {
+            return STRING_ERROR_READ_ONLY;
+        }
     }
 
-    vsnprintf(str->data, required_length + 1, format, args);
-    str->length = required_length;
+    for (size_t i = 0; i < count; ++i) {
+        string_result_t result = string_begin_mutation(strings[i]);
+        if (result != STRING_SUCCESS) {
+            return result;
+        }
+        string_simd_ascii_case(strings[i]->data, strings[i]->length, upper);
+    }
 
-    va_end(args);
     return STRING_SUCCESS;
 }
 
 /**
- * @brief Append formatted content to end of string
- * @param str Target string to append to
- * @param format Printf-style format string
- * @param ... Variable arguments for format string
- * @return string_result_t Success or error code
- * @details Appends formatted result to existing string content
+ * @brief Check whether one piece of a batch equals a key
+ * @param piece Piece to compare
+ * @param key Valid key
+ * @return bool true if the bytes are equal
+ * @details Length and first byte reject most pieces before the full compare.
  */
-string_result_t string_append_format(string_t *str, const char *format, ...) {
-    if (!str || !format) {
-        return STRING_ERROR_NULL_POINTER;
+static inline bool string_batch_piece_equals(string_view_t piece, string_view_t key) {
+    if (piece.length != key.length) {
+        return false;
     }
 
-    va_list args;
-    va_start(args, format);
+    if (key.length == 0) {
+        return true;
+    }
 
-    // Calculate required length
-    va_list args_copy;
-    va_copy(args_copy, args);
-    int required_length = vsnprintf(NULL, 0, format, args_copy);
-    va_end(args_copy);
+    return piece.data && piece.data[0] == key.data[0] && string_bytes_equal(piece.data, key.data, key.length);
+}
 
-    if (required_length < 0) {
-        va_end(args);
-        return STRING_ERROR_INVALID_ARGUMENT;
+/**
+ * @brief Compare every piece of a batch against a key
+ * @param views Array of views, or NULL to read from strings
+ * @param strings Array of strings, used when views is NULL
+ * @param count Number of pieces
+ * @param key Bytes to compare against
+ * @param matches Receives the result for each piece (can be NULL)
+ * @return size_t Number of equal pieces
+ */
+static size_t string_batch_count_pieces(const string_view_t *views,
+                                        const string_t *const *strings,
+                                        size_t count,
+                                        string_view_t key,
+                                        bool *matches) {
+    bool is_valid = (views || strings) && (key.data || key.length == 0);
+    size_t equal = 0;
+    for (size_t i = 0; i < count; ++i) {
+        bool match = is_valid && string_batch_piece_equals(string_piece_at(views, strings, i), key);
+        equal += match;
+        if (matches) {
+            matches[i] = match;
+        }
     }
 
-    size_t new_length = str->length + required_length;
-    string_result_t result = string_ensure_capacity(str, new_length + 1);
-    if (result != STRING_SUCCESS) {
-        va_end(args);
-        return result;
+    return equal;
+}
+
+/**
+ * @brief Find the first piece of a batch equal to a key
+ * @param views Array of views, or NULL to read from strings
+ * @param strings Array of strings, used when views is NULL
+ * @param count Number of pieces
+ * @param key Bytes to look for
+ * @return size_t Index of the first equal piece, or STRING_NPOS
+ */
+static size_t string_batch_find_piece(const string_view_t *views,
+                                      const string_t *const *strings,
+                                      size_t count,
+                                      string_view_t key) {
+    if ((!views && !strings) || (!key.data && key.length > 0)) {
+        return STRING_NPOS;
     }
 
-    vsnprintf(str->data + str->length, required_length + 1, format, args);
-    str->length = new_length;
+    for (size_t i = 0; i < count; ++i) {
+        if (string_batch_piece_equals(string_piece_at(views, strings, i), key)) {
+            return i;
+        }
+    }
 
-    va_end(args);
-    return STRING_SUCCESS;
+    return STRING_NPOS;
+}
+
+/**
+ * @brief Find the first piece of a batch that contains a byte
+ * @param views Array of views, or NULL to read from strings
+ * @param strings Array of strings, used when views is NULL
+ * @param count Number of pieces
+ * @param c Byte to search for
+ * @param position Receives the offset of the byte in that piece (can be NULL)
+ * @return size_t Index of the first piece containing the byte, or STRING_NPOS
+ */
+static size_t string_batch_find_char_in(const string_view_t *views,
+                                        const string_t *const *strings,
+                                        size_t count,
+                                        char c,
+                                        size_t *position) {
+    if (views || strings) {
+        for (size_t i = 0; i < count; ++i) {
+            string_view_t piece = string_piece_at(views, strings, i);
+            if (!piece.data || piece.length == 0) {
+                continue;
+            }
+
+            size_t found = string_simd_find_byte(piece.data, piece.length, c);
+            if (found != STRING_NPOS) {
+                if (position) {
+                    *position = found;
+                }
+                return i;
+            }
+        }
+    }
+
+    return STRING_NPOS;
+}
+
+/**
+ * @brief Sum the lengths of the pieces of a batch
+ * @param views Array of views, or NULL to read from strings
+ * @param strings Array of strings, used when views is NULL
+ * @param count Number of pieces
+ * @return size_t Total length, saturated at SIZE_MAX
+ */
+static size_t string_batch_sum_lengths(const string_view_t *views, const string_t *const *strings, size_t count) {
+    if (!views && !strings) {
+        return 0;
+    }
+
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        size_t length = string_piece_at(views, strings, i).length;
+        if (length > SIZE_MAX - total) {
+            return SIZE_MAX;
+        }
+        total += length;
+    }
+
+    return total;
+}
+
+/**
+ * @brief Convert every string of an array to lowercase
+ * @param strings Array of strings to convert
+ * @param count Number of elements in the array
+ * @return string_result_t Success or error code
+ */
+string_result_t string_batch_to_lower(string_t *const *strings, size_t count) {
+    return string_batch_case(strings, count, false);
+}
+
+/**
+ * @brief Convert every string of an array to uppercase
+ * @param strings Array of strings to convert
+ * @param count Number of elements in the array
+ * @return string_result_t Success or error code
+ */
+string_result_t string_batch_to_upper(string_t *const *strings, size_t count) {
+    return string_batch_case(strings, count, true);
+}
+
+/**
+ * @brief Compare every string of an array against one key
+ * @param strings Array of strings
+ * @param count Number of elements in the array
+ * @param key Bytes to compare against
+ * @param matches Receives the result for each element (can be NULL)
+ * @return size_t Number of elements equal to the key
+ */
+size_t string_batch_count_equal(const string_t *const *strings, size_t count, string_view_t key, bool *matches) {
+    return string_batch_count_pieces(NULL, strings, count, key, matches);
+}
+
+/**
+ * @brief Find the first string of an array equal to a key
+ * @param strings Array of strings
+ * @param count Number of elements in the array
+ * @param key Bytes to look for
+ * @return size_t Index of the first equal element, or STRING_NPOS
+ */
+size_t string_batch_find_equal(const string_t *const *strings, size_t count, string_view_t key) {
+    return string_batch_find_piece(NULL, strings, count, key);
+}
+
+/**
+ * @brief Find the first string of an array that contains a byte
+ * @param strings Array of strings
+ * @param count Number of elements in the array
+ * @param c Byte to search for
+ * @param position Receives the offset of the byte (can be NULL)
+ * @return size_t Index of the first matching string, or STRING_NPOS
+ */
+size_t string_batch_find_char(const string_t *const *strings, size_t count, char c, size_t *position) {
+    return string_batch_find_char_in(NULL, strings, count, c, position);
+}
+
+/**
+ * @brief Sum the lengths of an array of strings
+ * @param strings Array of strings
+ * @param count Number of elements in the array
+ * @return size_t Total length, or SIZE_MAX on overflow
+ */
+size_t string_batch_total_length(const string_t *const *strings, size_t count) {
+    return string_batch_sum_lengths(NULL, strings, count);
 }
+
+/**
+ * @brief Compare every view of an array against one key
+ * @param views Array of views
+ * @param count Number of elements in the array
+ * @param key Bytes to compare against
+ * @param matches Receives the result for each element (can be NULL)
+ * @return size_t Number of elements equal to the key
+ */
+size_t string_batch_count_equal_views(const string_view_t *views, size_t count, string_view_t key, bool *matches) {
+    return string_batch_count_pieces(views, NULL, count, key, matches);
+}
+
+/**
+ * @brief Find the first view of an array equal to a key
+ * @param views Array of views
+ * @param count Number of elements in the array
+ * @param key Bytes to look for
+ * @return size_t Index of the first equal element, or STRING_NPOS
+ */
+size_t string_batch_find_equal_views(const string_view_t *views, size_t count, string_view_t key) {
+    return string_batch_find_piece(views, NULL, count, key);
+}
+
+/**
+ * @brief Find the first view of an array that contains a byte
+ * @param views Array of views
+ * @param count Number of elements in the array
+ * @param c Byte to search for
+ * @param position Receives the offset of the byte (can be NULL)
+ * @return size_t Index of the first matching view, or STRING_NPOS
+ */
+size_t string_batch_find_char_views(const string_view_t *views, size_t count, char c, size_t *position) {
+    return string_batch_find_char_in(views, NULL, count, c, position);
+}
+
+/**
+ * @brief Sum the lengths of an array of views
+ * @param views Array of views
+ * @param count Number of elements in the array
+ * @return size_t Total length, or SIZE_MAX on overflow
+ */
+size_t string_batch_total_length_views(const string_view_t *views, size_t count) {
+    return string_batch_sum_lengths(views, NULL, count);
+}
+
+/*
+ * =========================
+ * String copying functions
+ * =========================
+ */
+
+/**
+ * @brief Safely copy string content to C-style buffer
+ * @param str Source string to copy from
+ * @param buffer Destination buffer to copy to
+ * @param buffer_size Size of destination buffer
+ * @return string_result_t Success or error code indicating truncation
+ * @details Copies as much as possible, always null-terminates buffer
+ */
+string_result_t string_copy_to_buffer(const string_t *str, char *buffer, size_t buffer_size) {
+    if (!str || !buffer) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    if (buffer_size == 0) {
+        return STRING_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    size_t copy_length = str->length;
+    if (copy_length >= buffer_size) {
+        copy_length = buffer_size - 1;
+    }
+
+    memcpy(buffer, str->data, copy_length);
+    buffer[copy_length] = '\0';
+
+    return copy_length == str->length ? STRING_SUCCESS : STRING_ERROR_BUFFER_TOO_SMALL;
+}
+
+/*
+ * ============================
+ * String formatting functions
+ * ============================
+ */
+
+/**
+ * @brief Format into a string starting at a given offset
+ * @param str Target string
+ * @param offset Offset where formatted output starts (at most the current length)
+ * @param format Printf-style format string
+ * @param args Variable argument list for format string
+ * @return string_result_t Success or error code
+ * @details Formats straight into the spare capacity and only grows the buffer
+ *          and formats a second time when the output did not fit. On failure
+ *          the string is truncated to offset.
+ */
+static string_result_t string_vformat_at(string_t *str, size_t offset, const char *format, va_list args) {
+    string_result_t result = string_begin_mutation(str);
+    if (result != STRING_SUCCESS) {
+        return result;
+    }
+
+    if (!format) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    va_list args_copy;
+    va_copy(args_copy, args);
+    size_t available = str->capacity - offset;
+    int written = vsnprintf(str->data + offset, available, format, args_copy);
+    va_end(args_copy);
+
+    if (written < 0) {
+        str->length = offset;
+        str->data[offset] = '\0';
+        return STRING_ERROR_INVALID_ARGUMENT;
+    }
+
+    if ((size_t)written < available) {
+        str->length = offset + (size_t)written;
+        return STRING_SUCCESS;
+    }
+
+    // Output was truncated: grow once to the exact size and format again
+    str->length = offset;
+    str->data[offset] = '\0';
+    result = string_ensure_capacity(str, offset + (size_t)written + 1);
+    if (result != STRING_SUCCESS) {
+        return result;
+    }
+
+    va_copy(args_copy, args);
+    vsnprintf(str->data + offset, (size_t)written + 1, format, args_copy);
+    va_end(args_copy);
+    str->length = offset + (size_t)written;
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Format string using printf-style format specifiers
+ * @param str Target string to store formatted result
+ * @param format Printf-style format string
+ * @param ... Variable arguments for format string
+ * @return string_result_t Success or error code
+ * @details Replaces entire string content with formatted result
+ */
+string_result_t string_format(string_t *str, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    string_result_t result = string_vformat(str, format, args);
+    va_end(args);
+
+    return result;
+}
+
+/**
+ * @brief Format string using a va_list
+ * @param str Target string to store formatted result
+ * @param format Printf-style format string
+ * @param args Variable argument list for format string
+ * @return string_result_t Success or error code
+ * @details Replaces entire string content with formatted result
+ */
+string_result_t string_vformat(string_t *str, const char *format, va_list args) {
+    return string_vformat_at(str, 0, format, args);
+}
+
+/**
+ * @brief Append formatted content to end of string
+ * @param str Target string to append to
+ * @param format Printf-style format string
+ * @param ... Variable arguments for format string
+ * @return string_result_t Success or error code
+ * @details Appends formatted result to existing string content
+ */
+string_result_t string_append_format(string_t *str, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    string_result_t result = string_append_vformat(str, format, args);
+    va_end(args);
+
+    return result;
+}
+
+/**
+ * @brief Append formatted content to end of string using a va_list
+ * @param str Target string to append to
+ * @param format Printf-style format string
+ * @param args Variable argument list for format string
+ * @return string_result_t Success or error code
+ * @details Appends formatted result to existing string content
+ */
+string_result_t string_append_vformat(string_t *str, const char *format, va_list args) {
+    if (!str) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    STRING_STATS_RETURN_TIMED(string_result_t, STRING_STATS_OP_FORMAT, 0, string_vformat_at(str, str->length, format, args));
+}
+
+/*
+ * ===================================
+ * String number conversion functions
+ * ===================================
+ */
+
+/**
+ * @brief Commit digits written directly after the end of a string
+ * @param str String appended to
+ * @param written Number of bytes written
+ * @return string_result_t Always STRING_SUCCESS
+ */
+static string_result_t string_commit_number(string_t *str, size_t written) {
+    str->length += written;
+    str->data[str->length] = '\0';
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Append a signed integer in decimal
+ * @param str String to append to
+ * @param value Value to append
+ * @return string_result_t Success or error code
+ */
+string_result_t string_append_int(string_t *str, int64_t value) {
+    if (!str) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    string_result_t result = string_ensure_capacity(str, str->length + STRING_NUMBER_MAX_LENGTH + 1);
+    if (result != STRING_SUCCESS) {
+        return result;
+    }
+
+    return string_commit_number(str, string_number_format_int(str->data + str->length, value));
+}
+
+/**
+ * @brief Append an unsigned integer in decimal
+ * @param str String to append to
+ * @param value Value to append
+ * @return string_result_t Success or error code
+ */
+string_result_t string_append_uint(string_t *str, uint64_t value) {
+    if (!str) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    string_result_t result = string_ensure_capacity(str, str->length + STRING_NUMBER_MAX_LENGTH + 1);
+    if (result != STRING_SUCCESS) {
+        return result;
+    }
+
+    return string_commit_number(str, string_number_format_uint(str->data + str->length, value));
+}
+
+/**
+ * @brief Append an unsigned integer in lowercase hexadecimal
+ * @param str String to append to
+ * @param value Value to append
+ * @return string_result_t Success or error code
+ */
+string_result_t string_append_hex(string_t *str, uint64_t value) {
+    if (!str) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    string_result_t result = string_ensure_capacity(str, str->length + STRING_NUMBER_MAX_LENGTH + 1);
+    if (result != STRING_SUCCESS) {
+        return result;
+    }
+
+    return string_commit_number(str, string_number_format_hex(str->data + str->length, value));
+}
+
+/**
+ * @brief Append a double using the shortest digits that round-trip
+ * @param str String to append to
+ * @param value Value to append
+ * @return string_result_t Success or error code
+ */
+string_result_t string_append_double(string_t *str, double value) {
+    if (!str) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    string_result_t result = string_ensure_capacity(str, str->length + STRING_NUMBER_MAX_LENGTH + 1);
+    if (result != STRING_SUCCESS) {
+        return result;
+    }
+
+    return string_commit_number(str, string_number_format_double(str->data + str->length, value));
+}
+
+/**
+ * @brief Parse the whole string as a signed decimal integer
+ * @param str String to parse
+ * @param value Receives the parsed value
+ * @return string_result_t Success or error code
+ */
+string_result_t string_to_int64(const string_t *str, int64_t *value) {
+    if (!str || !value) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    return string_number_parse_int64(str->data, str->length, value);
+}
+
+/**
+ * @brief Parse the whole string as a decimal floating-point number
+ * @param str String to parse
+ * @param value Receives the parsed value
+ * @return string_result_t Success or error code
+ */
+string_result_t string_to_double(const string_t *str, double *value) {
+    if (!str || !value) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    return string_number_parse_double(str->data, str->length, value);
+}
+
+/*
+ * ======================
+ * String view functions
+ * ======================
+ */
+
+/**
+ * @brief Create a view over a buffer
+ * @param buffer Source buffer
+ * @param length Number of bytes in the view
+ * @return string_view_t View over the buffer
+ * @details Returns an empty view for a NULL buffer
+ */
+string_view_t string_view_from_buffer(const char *buffer, size_t length) {
+    string_view_t view = {buffer ? buffer : "", buffer ? length : 0};
+    return view;
+}
+
+/**
+ * @brief Create a view over a null-terminated C string
+ * @param cstr Source C string
+ * @return string_view_t View over the C string
+ * @details Returns an empty view for a NULL C string
+ */
+string_view_t string_view_from_cstr(const char *cstr) {
+    return string_view_from_buffer(cstr, cstr ? strlen(cstr) : 0);
+}
+
+/**
+ * @brief Create a view over the content of a string
+ * @param str Source string
+ * @return string_view_t View over the string content
+ * @details Returns an empty view for a NULL string
+ */
+string_view_t string_view_from_string(const string_t *str) {
+    return str ? string_view_from_buffer(str->data, str->length) : string_view_from_buffer(NULL, 0);
+}
+
+/**
+ * @brief Create a view over part of a string
+ * @param str Source string
+ * @param pos Starting position
+ * @param count Maximum number of bytes
+ * @return string_view_t View over the clamped range
+ * @details No bytes are copied
+ */
+string_view_t string_substr_view(const string_t *str, size_t pos, size_t count) {
+    return string_view_substr(string_view_from_string(str), pos, count);
+}
+
+/**
+ * @brief Get a sub-view of a view
+ * @param view Source view
+ * @param pos Starting position
+ * @param count Maximum number of bytes
+ * @return string_view_t Sub-view clamped to the source
+ * @details Returns an empty view positioned at the end if pos is out of range
+ */
+string_view_t string_view_substr(string_view_t view, size_t pos, size_t count) {
+    if (pos > view.length) {
+        pos = view.length;
+    }
+
+    size_t available = view.length - pos;
+    if (count > available) {
+        count = available;
+    }
+
+    string_view_t result = {view.data + pos, count};
+    return result;
+}
+
+/**
+ * @brief Get the half-open range [begin, end) of a view
+ * @param view Source view
+ * @param begin First position
+ * @param end Position one past the last byte
+ * @return string_view_t Slice of the view
+ * @details The end position is clamped to the view length
+ */
+string_view_t string_view_slice(string_view_t view, size_t begin, size_t end) {
+    if (end > view.length) {
+        end = view.length;
+    }
+
+    return string_view_substr(view, begin, begin < end ? end - begin : 0);
+}
+
+/**
+ * @brief Compare two views lexicographically
+ * @param view1 First view
+ * @param view2 Second view
+ * @return int Negative, zero or positive ordering result
+ * @details Compares bytes as unsigned values, then lengths
+ */
+int string_view_compare(string_view_t view1, string_view_t view2) {
+    size_t min_len = view1.length < view2.length ? view1.length : view2.length;
+    int result = min_len > 0 ? memcmp(view1.data, view2.data, min_len) : 0;
+
+    if (result == 0) {
+        if (view1.length < view2.length) return -1;
+        if (view1.length > view2.length) return 1;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Check if two views have equal content
+ * @param view1 First view
+ * @param view2 Second view
+ * @return bool true if equal, false otherwise
+ * @details Compares lengths before any bytes
+ */
+bool string_view_equals(string_view_t view1, string_view_t view2) {
+    return view1.length == view2.length && string_bytes_equal(view1.data, view2.data, view1.length);
+}
+
+/**
+ * @brief Compare two views lexicographically ignoring ASCII case
+ * @param view1 First view
+ * @param view2 Second view
+ * @return int Negative if view1 < view2, 0 if equal, positive if view1 > view2
+ * @details Letters are folded to lowercase before bytes are compared
+ */
+int string_view_compare_icase(string_view_t view1, string_view_t view2) {
+    size_t min_len = view1.length < view2.length ? view1.length : view2.length;
+    size_t mismatch = min_len > 0 ? string_simd_mismatch_icase(view1.data, view2.data, min_len) : 0;
+
+    if (mismatch < min_len) {
+        return string_ascii_fold((unsigned char)view1.data[mismatch]) - string_ascii_fold((unsigned char)view2.data[mismatch]);
+    }
+
+    if (view1.length < view2.length) return -1;
+    if (view1.length > view2.length) return 1;
+
+    return 0;
+}
+
+/**
+ * @brief Check if two views have equal content ignoring ASCII case
+ * @param view1 First view
+ * @param view2 Second view
+ * @return bool true if equal, false otherwise
+ * @details Compares lengths before any bytes
+ */
+bool string_view_equals_icase(string_view_t view1, string_view_t view2) {
+    return view1.length == view2.length && (view1.length == 0 || string_simd_mismatch_icase(view1.data, view2.data, view1.length) == view1.length);
+}
+
+/**
+ * @brief Find first occurrence of character in view
+ * @param view View to search in
+ * @param c Character to search for
+ * @param start_pos Starting position
+ * @return size_t Position of character or STRING_NPOS if not found
+ * @details Searches forward from start_pos using the vectorized byte kernel
+ */
+size_t string_view_find_char(string_view_t view, char c, size_t start_pos) {
+    if (start_pos >= view.length) {
+        return STRING_NPOS;
+    }
+
+    size_t found = string_simd_find_byte(view.data + start_pos, view.length - start_pos, c);
+    return found == STRING_NPOS ? STRING_NPOS : start_pos + found;
+}
+
+/**
+ * @brief Find last occurrence of character in view
+ * @param view View to search in
+ * @param c Character to search for
+ * @param start_pos Starting position for reverse search (STRING_NPOS for end)
+ * @return size_t Position of character or STRING_NPOS if not found
+ * @details Searches backward from start_pos using the vectorized byte kernel
+ */
+size_t string_view_rfind_char(string_view_t view, char c, size_t start_pos) {
+    if (view.length == 0) {
+        return STRING_NPOS;
+    }
+
+    if (start_pos >= view.length) {
+        start_pos = view.length - 1;
+    }
+
+    return string_simd_rfind_byte(view.data, start_pos + 1, c);
+}
+
+/**
+ * @brief Find a view inside another view from a valid start position (untimed)
+ * @param view View to search in
+ * @param needle View to search for
+ * @param start_pos Starting position (at most view.length)
+ * @return size_t Position of needle or STRING_NPOS if not found
+ */
+static size_t string_view_find_from(string_view_t view, string_view_t needle, size_t start_pos) {
+    size_t found = string_simd_find_substr(view.data + start_pos, view.length - start_pos, needle.data, needle.length);
+    return found == STRING_NPOS ? STRING_NPOS : start_pos + found;
+}
+
+/**
+ * @brief Find first occurrence of a view inside another view
+ * @param view View to search in
+ * @param needle View to search for
+ * @param start_pos Starting position
+ * @return size_t Position of needle or STRING_NPOS if not found
+ * @details Length-aware, so needles may contain null bytes. Runs in linear time.
+ */
+size_t string_view_find(string_view_t view, string_view_t needle, size_t start_pos) {
+    if (start_pos > view.length) {
+        return STRING_NPOS;
+    }
+
+    STRING_STATS_RETURN_TIMED(size_t, STRING_STATS_OP_FIND, view.length - start_pos, string_view_find_from(view, needle, start_pos));
+}
+
+/**
+ * @brief Find first occurrence of a byte sequence in a view ignoring ASCII case
+ * @param view View to search in
+ * @param needle Bytes to search for
+ * @param start_pos Starting position
+ * @return size_t Position of match or STRING_NPOS if not found
+ * @details Searches forward from start_pos using the case-insensitive search kernel
+ */
+size_t string_view_find_icase(string_view_t view, string_view_t needle, size_t start_pos) {
+    if (start_pos > view.length) {
+        return STRING_NPOS;
+    }
+
+    size_t found = string_simd_find_substr_icase(view.data + start_pos, view.length - start_pos, needle.data, needle.length);
+    return found == STRING_NPOS ? STRING_NPOS : start_pos + found;
+}
+
+/**
+ * @brief Find first occurrence in a view of any byte from a set
+ * @param view View to search in
+ * @param chars Set of bytes
+ * @param start_pos Starting position
+ * @return size_t Position of match or STRING_NPOS if not found
+ * @details Searches forward from start_pos using the vectorized byte-set kernel
+ */
+size_t string_view_find_first_of(string_view_t view, string_view_t chars, size_t start_pos) {
+    if (start_pos >= view.length) {
+        return STRING_NPOS;
+    }
+
+    size_t found = string_simd_find_any(view.data + start_pos, view.length - start_pos, chars.data, chars.length);
+    return found == STRING_NPOS ? STRING_NPOS : start_pos + found;
+}
+
+/**
+ * @brief Find last occurrence in a view of any byte from a set
+ * @param view View to search in
+ * @param chars Set of bytes
+ * @param start_pos Starting position for reverse search (STRING_NPOS for end)
+ * @return size_t Position of match or STRING_NPOS if not found
+ * @details Searches backward from start_pos using the vectorized byte-set kernel
+ */
+size_t string_view_find_last_of(string_view_t view, string_view_t chars, size_t start_pos) {
+    if (view.length == 0) {
+        return STRING_NPOS;
+    }
+
+    if (start_pos >= view.length) {
+        start_pos = view.length - 1;
+    }
+
+    return string_simd_rfind_any(view.data, start_pos + 1, chars.data, chars.length);
+}
+
+/*
+ * ===========================
+ * Character class functions
+ * ===========================
+ */
+
+/** @brief ASCII whitespace: \t to \r are row 0 of columns 0x9 to 0xD, space is row 2 of column 0x0 */
+const string_char_class_t string_class_space = {
+    { 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01 } };
+
+/** @brief ASCII digits: row 3 of columns 0x0 to 0x9 */
+const string_char_class_t string_class_digit = {
+    { 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08 } };
+
+/**
+ * @brief Add one byte value to a character class
+ * @param cls Class to extend
+ * @param c Byte value to add
+ */
+static void string_char_class_set(string_char_class_t *cls, unsigned char c) {
+    cls->table[(c & 0x0F) | ((c >> 3) & 0x10)] |= (uint8_t)(1u << ((c >> 4) & 7));
+}
+
+/**
+ * @brief Initialize a character class from its members
+ * @param cls Class to initialize
+ * @param members Bytes that belong to the class
+ */
+void string_char_class_init(string_char_class_t *cls, string_view_t members) {
+    if (!cls) {
+        return;
+    }
+
+    memset(cls->table, 0, sizeof(cls->table));
+    for (size_t i = 0; members.data && i < members.length; ++i) {
+        string_char_class_set(cls, (unsigned char)members.data[i]);
+    }
+}
+
+/**
+ * @brief Add a range of byte values to a character class
+ * @param cls Class to extend
+ * @param first First byte value of the range
+ * @param last Last byte value of the range (inclusive)
+ */
+void string_char_class_add_range(string_char_class_t *cls, unsigned char first, unsigned char last) {
+    if (!cls) {
+        return;
+    }
+
+    for (unsigned c = first; c <= last; ++c) {
+        string_char_class_set(cls, (unsigned char)c);
+    }
+}
+
+/**
+ * @brief Check whether a byte belongs to a character class
+ * @param cls Class to test against
+ * @param c Byte to test
+ * @return bool True if c is a member
+ */
+bool string_char_class_contains(const string_char_class_t *cls, char c) {
+    if (!cls) {
+        return false;
+    }
+
+    unsigned char byte = (unsigned char)c;
+    return (cls->table[(byte & 0x0F) | ((byte >> 3) & 0x10)] >> ((byte >> 4) & 7)) & 1;
+}
+
+/**
+ * @brief Forward class scan shared by the find functions
+ * @param view View to search in
+ * @param cls Class to test against
+ * @param start_pos Starting position
+ * @param member Whether to look for a member or a non-member
+ * @return size_t Position of match or STRING_NPOS if not found
+ */
+static size_t string_view_scan_class(string_view_t view, const string_char_class_t *cls, size_t start_pos, bool member) {
+    if (!cls || start_pos >= view.length) {
+        return STRING_NPOS;
+    }
+
+    size_t found = string_simd_find_class(view.data + start_pos, view.length - start_pos, cls, member);
+    return found == STRING_NPOS ? STRING_NPOS : start_pos + found;
+}
+
+/**
+ * @brief Backward class scan shared by the rfind functions
+ * @param view View to search in
+ * @param cls Class to test against
+ * @param start_pos Starting position for reverse search (STRING_NPOS for end)
+ * @param member Whether to look for a member or a non-member
+ * @return size_t Position of match or STRING_NPOS if not found
+ */
+static size_t string_view_rscan_class(string_view_t view, const string_char_class_t *cls, size_t start_pos, bool member) {
+    if (!cls || view.length == 0) {
+        return STRING_NPOS;
+    }
+
+    if (start_pos >= view.length) {
+        start_pos = view.length - 1;
+    }
+
+    return string_simd_rfind_class(view.data, start_pos + 1, cls, member);
+}
+
+/**
+ * @brief Find the first byte of a view that belongs to a class
+ * @param view View to search in
+ * @param cls Class of bytes to search for
+ * @param start_pos Starting position
+ * @return size_t Position of match or STRING_NPOS if not found
+ */
+size_t string_view_find_class(string_view_t view, const string_char_class_t *cls, size_t start_pos) {
+    return string_view_scan_class(view, cls, start_pos, true);
+}
+
+/**
+ * @brief Find the first byte of a view that does not belong to a class
+ * @param view View to search in
+ * @param cls Class of bytes to skip
+ * @param start_pos Starting position
+ * @return size_t Position of match or STRING_NPOS if not found
+ */
+size_t string_view_find_not_class(string_view_t view, const string_char_class_t *cls, size_t start_pos) {
+    return string_view_scan_class(view, cls, start_pos, false);
+}
+
+/**
+ * @brief Find the last byte of a view that belongs to a class
+ * @param view View to search in
+ * @param cls Class of bytes to search for
+ * @param start_pos Starting position for reverse search (STRING_NPOS for end)
+ * @return size_t Position of match or STRING_NPOS if not found
+ */
+size_t string_view_rfind_class(string_view_t view, const string_char_class_t *cls, size_t start_pos) {
+    return string_view_rscan_class(view, cls, start_pos, true);
+}
+
+/**
+ * @brief Find the last byte of a view that does not belong to a class
+ * @param view View to search in
+ * @param cls Class of bytes to skip
+ * @param start_pos Starting position for reverse search (STRING_NPOS for end)
+ * @return size_t Position of match or STRING_NPOS if not found
+ */
+size_t string_view_rfind_not_class(string_view_t view, const string_char_class_t *cls, size_t start_pos) {
+    return string_view_rscan_class(view, cls, start_pos, false);
+}
+
+/**
+ * @brief Get a view without leading and trailing whitespace
+ * @param view View to trim
+ * @return string_view_t Sub-view of the input
+ */
+string_view_t string_view_trim(string_view_t view) {
+    return string_view_trim_class(view, &string_class_space);
+}
+
+/**
+ * @brief Get a view without leading and trailing bytes of a class
+ * @param view View to trim
+ * @param cls Class of bytes to remove
+ * @return string_view_t Sub-view of the input (empty if every byte is removed)
+ */
+string_view_t string_view_trim_class(string_view_t view, const string_char_class_t *cls) {
+    size_t start = string_view_find_not_class(view, cls, 0);
+    if (start == STRING_NPOS) {
+        return string_view_from_buffer(view.data, 0);
+    }
+
+    size_t end = string_view_rfind_not_class(view, cls, STRING_NPOS) + 1;
+    return string_view_from_buffer(view.data + start, end - start);
+}
+
+/** @brief Mixing constants of the view hash (wyhash secret) */
+static const uint64_t string_hash_secret[4] = {
+    0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL, 0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL};
+
+/**
+ * @brief Multiply two 64-bit values into a 128-bit product
+ * @param a Receives the low half
+ * @param b Receives the high half
+ */
+static inline void string_hash_multiply(uint64_t *a, uint64_t *b) {
+#if defined(__SIZEOF_INT128__)
+    __extension__ unsigned __int128 product = (unsigned __int128)*a * *b;
+    *a = (uint64_t)product;
+    *b = (uint64_t)(product >> 64);
+#else
+    uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t)*a, lb = (uint32_t)*b;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32);
+    uint64_t carry = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    carry += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+}
+
+/**
+ * @brief Fold the 128-bit product of two values into 64 bits
+ */
+static inline uint64_t string_hash_mix(uint64_t a, uint64_t b) {
+    string_hash_multiply(&a, &b);
+    return a ^ b;
+}
+
+/**
+ * @brief Read 8 bytes in native byte order
+ */
+static inline uint64_t string_hash_read8(const unsigned char *p) {
+    uint64_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief Read 4 bytes in native byte order
+ */
+static inline uint64_t string_hash_read4(const unsigned char *p) {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief Hash the content of a view
+ * @param view View to hash
+ * @return uint64_t 64-bit wyhash-style hash
+ * @details Inputs up to 16 bytes are read with a few overlapping loads; longer
+ *          inputs are consumed 48 bytes per step in three independent lanes.
+ *          Not suitable for cryptographic purposes.
+ */
+uint64_t string_view_hash(string_view_t view) {
+    const unsigned char *p = (const unsigned char *)view.data;
+    size_t length = view.length;
+    uint64_t seed = string_hash_mix(string_hash_secret[0], string_hash_secret[1]);
+    uint64_t a, b;
+
+    if (length <= 16) {
+        if (length >= 4) {
+            size_t middle = (length >> 3) << 2;
+            a = (string_hash_read4(p) << 32) | string_hash_read4(p + middle);
+            b = (string_hash_read4(p + length - 4) << 32) | string_hash_read4(p + length - 4 - middle);
+        } else if (length > 0) {
+            a = ((uint64_t)p[0] << 16) | ((uint64_t)p[length >> 1] << 8) | p[length - 1];
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t i = length;
+        if (i > 48) {
+            uint64_t lane1 = seed, lane2 = seed;
+            do {
+                seed = string_hash_mix(string_hash_read8(p) ^ string_hash_secret[1], string_hash_read8(p + 8) ^ seed);
+                lane1 = string_hash_mix(string_hash_read8(p + 16) ^ string_hash_secret[2], string_hash_read8(p + 24) ^ lane1);
+                lane2 = string_hash_mix(string_hash_read8(p + 32) ^ string_hash_secret[3], string_hash_read8(p + 40) ^ lane2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= lane1 ^ lane2;
+        }
+        while (i > 16) {
+            seed = string_hash_mix(string_hash_read8(p) ^ string_hash_secret[1], string_hash_read8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = string_hash_read8(p + i - 16);
+        b = string_hash_read8(p + i - 8);
+    }
+
+    a ^= string_hash_secret[1];
+    b ^= seed;
+    string_hash_multiply(&a, &b);
+    return string_hash_mix(a ^ string_hash_secret[0] ^ length, b ^ string_hash_secret[1]);
+}
+
+/**
+ * @brief Create a new string by copying the content of a view
+ * @param view Source view
+ * @return string_t* Pointer to new string or NULL on failure
+ * @details The new string owns an independent copy of the bytes
+ */
+string_t *string_create_from_view(string_view_t view) {
+    return string_create_from_buffer(view.data, view.length);
+}
+
+/**
+ * @brief Initialize a caller-owned, non-owning string over a view
+ * @param str String structure to initialize
+ * @param view View to borrow
+ * @return string_result_t Success or error code
+ * @details The resulting string is read-only and never frees the viewed bytes
+ */
+string_result_t string_init_view(string_t *str, string_view_t view) {
+    if (!str) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    if (!view.data && view.length > 0) {
+        return STRING_ERROR_INVALID_ARGUMENT;
+    }
+
+    str->data = (char *)(view.data ? view.data : "");
+    str->length = view.data ? view.length : 0;
+    str->capacity = str->length;
+    str->is_owner = false;
+    str->has_hash = false;
+    str->is_utf8 = false;
+    str->storage = STRING_STORAGE_EXTERNAL;
+    str->allocator = string_get_thread_allocator();
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Assign the content of a view to a string
+ * @param str Target string to assign to
+ * @param view Source view
+ * @return string_result_t Success or error code
+ * @details Replaces entire string content with the viewed bytes
+ */
+string_result_t string_assign_view(string_t *str, string_view_t view) {
+    return string_assign_buffer(str, view.data, view.length);
+}
+
+/**
+ * @brief Append the content of a view to a string
+ * @param str Target string to append to
+ * @param view Source view
+ * @return string_result_t Success or error code
+ * @details Adds the viewed bytes to the end of the string
+ */
+string_result_t string_append_view(string_t *str, string_view_t view) {
+    return string_append_buffer(str, view.data, view.length);
+}
+
+/*
+ * ===============================
+ * Precompiled search functions
+ * ===============================
+ */
+
+/**
+ * @brief Compile a needle for repeated searches
+ * @param pattern Pattern bytes to copy
+ * @param length Number of bytes in the pattern
+ * @return string_needle_t* Pointer to new needle or NULL on failure
+ * @details Builds the Boyer-Moore-Horspool bad-character shift table
+ */
+string_needle_t *string_needle_create(const char *pattern, size_t length) {
+    if (!pattern && length > 0) {
+        return NULL;
+    }
+
+    string_needle_t *needle = malloc(sizeof(string_needle_t) + length);
+    if (!needle) {
+        return NULL;
+    }
+
+    needle->length = length;
+    if (length > 0) {
+        memcpy(needle->pattern, pattern, length);
+    }
+
+    for (size_t i = 0; i < 256; ++i) {
+        needle->shift[i] = length;
+    }
+    for (size_t i = 0; i + 1 < length; ++i) {
+        needle->shift[(unsigned char)pattern[i]] = length - 1 - i;
+    }
+
+    return needle;
+}
+
+/**
+ * @brief Compile a null-terminated C string needle
+ * @param cstr Pattern C string
+ * @return string_needle_t* Pointer to new needle or NULL on failure
+ * @details Convenience wrapper around string_needle_create()
+ */
+string_needle_t *string_needle_create_from_cstr(const char *cstr) {
+    if (!cstr) {
+        return NULL;
+    }
+
+    return string_needle_create(cstr, strlen(cstr));
+}
+
+/**
+ * @brief Destroy a compiled needle
+ * @param needle Needle to destroy
+ * @details Safe to call with NULL
+ */
+void string_needle_destroy(string_needle_t *needle) {
+    free(needle);
+}
+
+/**
+ * @brief Find first occurrence of a compiled needle in a view
+ * @param needle Compiled needle
+ * @param view View to search in
+ * @param start_pos Starting position for search (0-based)
+ * @return size_t Position of match or STRING_NPOS if not found
+ * @details Horspool skip loop: compares the last byte first and shifts by the table
+ */
+size_t string_needle_find(const string_needle_t *needle, string_view_t view, size_t start_pos) {
+    if (!needle || start_pos > view.length) {
+        return STRING_NPOS;
+    }
+
+    size_t m = needle->length;
+    if (m == 0) {
+        return start_pos;
+    }
+
+    if (m > view.length - start_pos) {
+        return STRING_NPOS;
+    }
+
+    if (m == 1) {
+        return string_view_find_char(view, needle->pattern[0], start_pos);
+    }
+
+    const unsigned char *haystack = (const unsigned char *)view.data;
+    const unsigned char last = (unsigned char)needle->pattern[m - 1];
+    size_t pos = start_pos;
+    size_t end = view.length - m;
+
+    while (pos <= end) {
+        unsigned char c = haystack[pos + m - 1];
+        if (c == last && memcmp(haystack + pos, needle->pattern, m - 1) == 0) {
+            return pos;
+        }
+        pos += needle->shift[c];
+    }
+
+    return STRING_NPOS;
+}
+
+/**
+ * @brief Find first occurrence of a compiled needle in a string
+ * @param str String to search in
+ * @param needle Compiled needle
+ * @param start_pos Starting position for search (0-based)
+ * @return size_t Position of match or STRING_NPOS if not found
+ * @details Follows the same position rules as string_find_string()
+ */
+size_t string_find_needle(const string_t *str, const string_needle_t *needle, size_t start_pos) {
+    if (!str || !needle || start_pos >= str->length) {
+        return STRING_NPOS;
+    }
+
+    return string_needle_find(needle, string_view_from_string(str), start_pos);
+}
+
+/*
+ * ===========================
+ * String tokenizer functions
+ * ===========================
+ */
+
+/**
+ * @brief Initialize a tokenizer that splits on a single byte
+ * @param tokenizer Tokenizer to initialize
+ * @param source Input to split
+ * @param delimiter Delimiter byte
+ * @return string_result_t Success or error code
+ */
+string_result_t string_tokenizer_init(string_tokenizer_t *tokenizer, string_view_t source, char delimiter) {
+    if (!tokenizer || (!source.data && source.length > 0)) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    tokenizer->source = source;
+    tokenizer->delimiter_char = delimiter;
+    tokenizer->delimiter = string_view_from_buffer(&tokenizer->delimiter_char, 1);
+    tokenizer->position = 0;
+    tokenizer->mode = STRING_SPLIT_CHAR;
+    tokenizer->done = false;
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Initialize a tokenizer that splits on any byte of a set
+ * @param tokenizer Tokenizer to initialize
+ * @param source Input to split
+ * @param delimiters Set of delimiter bytes
+ * @return string_result_t Success or error code
+ */
+string_result_t string_tokenizer_init_any(string_tokenizer_t *tokenizer, string_view_t source, string_view_t delimiters) {
+    if (!tokenizer || (!source.data && source.length > 0) || !delimiters.data) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    if (delimiters.length == 0) {
+        return STRING_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (delimiters.length == 1) {
+        return string_tokenizer_init(tokenizer, source, delimiters.data[0]);
+    }
+
+    tokenizer->source = source;
+    tokenizer->delimiter = delimiters;
+    tokenizer->delimiter_char = '\0';
+    tokenizer->position = 0;
+    tokenizer->mode = STRING_SPLIT_ANY;
+    tokenizer->done = false;
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Initialize a tokenizer that splits on a byte sequence
+ * @param tokenizer Tokenizer to initialize
+ * @param source Input to split
+ * @param delimiter Delimiter sequence
+ * @return string_result_t Success or error code
+ */
+string_result_t string_tokenizer_init_substr(string_tokenizer_t *tokenizer, string_view_t source, string_view_t delimiter) {
+    if (!tokenizer || (!source.data && source.length > 0) || !delimiter.data) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    if (delimiter.length == 0) {
+        return STRING_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (delimiter.length == 1) {
+        return string_tokenizer_init(tokenizer, source, delimiter.data[0]);
+    }
+
+    tokenizer->source = source;
+    tokenizer->delimiter = delimiter;
+    tokenizer->delimiter_char = '\0';
+    tokenizer->position = 0;
+    tokenizer->mode = STRING_SPLIT_SUBSTR;
+    tokenizer->done = false;
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Get the next token
+ * @param tokenizer Tokenizer to advance
+ * @param token Receives a view of the token
+ * @return bool true if a token was returned
+ * @details Searches the remaining input with the kernel matching the delimiter kind
+ */
+bool string_tokenizer_next(string_tokenizer_t *tokenizer, string_view_t *token) {
+    if (!tokenizer || !token || tokenizer->done) {
+        return false;
+    }
+
+    const char *rest = tokenizer->source.data + tokenizer->position;
+    size_t rest_length = tokenizer->source.length - tokenizer->position;
+    size_t found;
+
+    switch (tokenizer->mode) {
+    case STRING_SPLIT_ANY:
+        found = string_simd_find_any(rest, rest_length, tokenizer->delimiter.data, tokenizer->delimiter.length);
+        break;
+    case STRING_SPLIT_SUBSTR:
+        found = string_simd_find_substr(rest, rest_length, tokenizer->delimiter.data, tokenizer->delimiter.length);
+        break;
+    default:
+        found = string_simd_find_byte(rest, rest_length, tokenizer->delimiter_char);
+        break;
+    }
+
+    if (found == STRING_NPOS) {
+        *token = string_view_from_buffer(rest, rest_length);
+        tokenizer->position = tokenizer->source.length;
+        tokenizer->done = true;
+    } else {
+        *token = string_view_from_buffer(rest, found);
+        tokenizer->position += found + (tokenizer->mode == STRING_SPLIT_ANY ? 1 : tokenizer->delimiter.length);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Get as many of the next tokens as fit in an array
+ * @param tokenizer Tokenizer to advance
+ * @param tokens Array receiving views of the tokens
+ * @param capacity Number of elements in the array
+ * @return size_t Number of tokens stored
+ * @details Single-byte splits record every delimiter found by one vector scan
+ */
+size_t string_tokenizer_next_batch(string_tokenizer_t *tokenizer, string_view_t *tokens, size_t capacity) {
+    if (!tokenizer || !tokens) {
+        return 0;
+    }
+
+    if (tokenizer->mode != STRING_SPLIT_CHAR) {
+        size_t count = 0;
+        while (count < capacity && string_tokenizer_next(tokenizer, &tokens[count])) {
+            count++;
+        }
+        return count;
+    }
+
+    if (tokenizer->done || capacity == 0) {
+        return 0;
+    }
+
+    const char *rest = tokenizer->source.data + tokenizer->position;
+    size_t rest_length = tokenizer->source.length - tokenizer->position;
+    size_t consumed;
+    size_t count = string_simd_split_byte(rest, rest_length, tokenizer->delimiter_char, tokens, capacity, &consumed);
+    tokenizer->position += consumed;
+
+    // Fewer delimited fields than requested: the rest of the input is the last token
+    if (count < capacity) {
+        tokens[count++] = string_view_from_buffer(rest + consumed, rest_length - consumed);
+        tokenizer->position = tokenizer->source.length;
+        tokenizer->done = true;
+    }
+
+    return count;
+}
+
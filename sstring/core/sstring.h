@@ -19,10 +19,14 @@
 #include <string.h>
 #include <ctype.h>
 #include <stdarg.h>
+#include <stdint.h>
 
 /** @brief Default initial capacity for dynamic strings */
 #define STRING_DEFAULT_CAPACITY 64
 
+/** @brief Size of the inline small-string buffer (including the null terminator) */
+#define STRING_SSO_CAPACITY 24
+
 /** @brief Growth factor for dynamic string expansion */
 #define STRING_GROWTH_FACTOR 2
 
@@ -38,19 +42,152 @@ typedef enum {
     STRING_ERROR_OUT_OF_MEMORY    = -2,  /**< Memory allocation failed */
     STRING_ERROR_INVALID_INDEX    = -3,  /**< Index is out of bounds */
     STRING_ERROR_BUFFER_TOO_SMALL = -4,  /**< Provided buffer is too small */
-    STRING_ERROR_INVALID_ARGUMENT = -5   /**< Invalid argument provided */
+    STRING_ERROR_INVALID_ARGUMENT = -5,  /**< Invalid argument provided */
+    STRING_ERROR_READ_ONLY        = -6,  /**< String does not own its memory and cannot be modified */
+    STRING_ERROR_OUT_OF_RANGE     = -7,  /**< Converted value does not fit the target type */
+    STRING_ERROR_IO               = -8,  /**< System I/O call failed (errno holds the cause) */
+    STRING_ERROR_END_OF_FILE      = -9,  /**< End of input reached before any data was read */
+    STRING_ERROR_INVALID_ENCODING = -10  /**< Input is not valid in its text encoding */
 } string_result_t;
 
+/**
+ * @brief Pluggable allocator interface for string storage
+ * @details String headers and data buffers are obtained through an allocator.
+ *          The previous size is passed to reallocate and deallocate so that
+ *          allocators which do not track allocation sizes (arenas, size-class
+ *          pools) can be plugged in.
+ */
+typedef struct {
+    void *(*allocate)(void *context, size_t size);                                   /**< Allocate size bytes */
+    void *(*reallocate)(void *context, void *ptr, size_t old_size, size_t new_size);  /**< Resize an allocation */
+    void (*deallocate)(void *context, void *ptr, size_t size);                       /**< Release an allocation */
+    void *context;                                                                   /**< Opaque state passed to callbacks */
+} string_allocator_t;
+
+/**
+ * @brief Storage kinds for string data
+ */
+typedef enum {
+    STRING_STORAGE_INLINE   = 0,  /**< Data lives in the inline small-string buffer */
+    STRING_STORAGE_HEAP     = 1,  /**< Data lives in a buffer obtained from the string's allocator */
+    STRING_STORAGE_EXTERNAL = 2,  /**< Data lives in a caller-supplied buffer that is never freed */
+    STRING_STORAGE_SHARED   = 3,  /**< Data lives in an immutable reference-counted buffer shared by clones */
+    STRING_STORAGE_MAPPED   = 4   /**< Data lives in a read-only file mapping released with the string */
+} string_storage_t;
+
+/**
+ * @brief Capacity growth policies for dynamic strings
+ * @details Growth is geometric under every policy, so appends stay amortized
+ *          constant time; a single request larger than the grown capacity is
+ *          allocated exactly.
+ */
+typedef enum {
+    STRING_GROWTH_DOUBLE       = 0,  /**< Multiply the capacity by STRING_GROWTH_FACTOR (default) */
+    STRING_GROWTH_ONE_AND_HALF = 1,  /**< Grow the capacity by half, wasting at most a third of it */
+    STRING_GROWTH_USABLE_SIZE  = 2   /**< Grow by half and claim the slack the default allocator rounds up to */
+} string_growth_t;
+
 /**
  * @brief Safe string structure
+ * @details Strings shorter than STRING_SSO_CAPACITY are stored in the inline buffer,
+ *          so no separate data allocation is needed. The data pointer always refers
+ *          to the active storage, so a string_t must not be copied by value.
  */
 typedef struct {
-    char *data;           /**< Pointer to the string data */
-    size_t length;        /**< Current length (excluding null terminator) */
-    size_t capacity;      /**< Total allocated capacity */
-    bool is_owner;        /**< Whether this string owns the memory */
+    char *data;                             /**< Pointer to the string data */
+    size_t length;                          /**< Current length (excluding null terminator) */
+    size_t capacity;                        /**< Total allocated capacity */
+    bool is_owner;                          /**< Whether this string owns the memory */
+    bool has_hash;                          /**< Whether hash holds the hash of the current content */
+    bool is_utf8;                           /**< Whether the content is known to be valid UTF-8 */
+    string_storage_t storage;               /**< Where the data currently lives */
+    const string_allocator_t *allocator;    /**< Allocator for the header and data */
+    uint64_t hash;                          /**< Cached string_view_hash() of the content */
+    char inline_data[STRING_SSO_CAPACITY];  /**< Inline storage for short strings */
 } string_t;
 
+/**
+ * @brief Vector instruction sets used by the scanning kernels
+ */
+typedef enum {
+    STRING_SIMD_NONE = 0,  /**< Portable scalar loops */
+    STRING_SIMD_SSE2 = 1,  /**< x86 SSE2 (16 bytes per step) */
+    STRING_SIMD_AVX2 = 2,  /**< x86 AVX2 (32 bytes per step) */
+    STRING_SIMD_NEON = 3   /**< ARM NEON (16 bytes per step) */
+} string_simd_t;
+
+/**
+ * @brief Non-owning view of a sequence of bytes
+ * @details A view is a pointer plus a length. The bytes are not required to be
+ *          null-terminated and must outlive the view. Views are cheap to copy and
+ *          are passed by value.
+ */
+typedef struct {
+    const char *data;  /**< Pointer to the first byte of the view */
+    size_t length;     /**< Number of bytes in the view */
+} string_view_t;
+
+/**
+ * @brief View of a string literal, with the length taken at compile time
+ * @details Accepts only string literals; embedded null bytes are kept.
+ */
+#define STRING_LIT(literal) ((string_view_t){ "" literal, sizeof(literal) - 1 })
+
+/** @brief Check if a string equals a string literal, without strlen() */
+#define string_equals_lit(str, literal) string_equals_buffer((str), "" literal, sizeof(literal) - 1)
+
+/** @brief Append a string literal to a string, without strlen() */
+#define string_append_lit(str, literal) string_append_buffer((str), "" literal, sizeof(literal) - 1)
+
+/** @brief Find a string literal in a string, without strlen() */
+#define string_find_lit(str, literal, start_pos) string_find_buffer((str), "" literal, sizeof(literal) - 1, (start_pos))
+
+/**
+ * @brief Set of byte values for the class scanning and trimming functions
+ * @details A 256-bit membership table in the layout the vector kernels look up
+ *          directly: byte c belongs to the class when bit ((c >> 4) & 7) of
+ *          table[(c & 0x0F) | ((c >> 3) & 0x10)] is set. Build one with
+ *          string_char_class_init() or use string_class_space / string_class_digit.
+ */
+typedef struct {
+    uint8_t table[32];  /**< Membership bits, by low nibble and top bit of the byte */
+} string_char_class_t;
+
+/**
+ * @brief Precompiled search pattern
+ * @details Holds a private copy of the pattern and its Boyer-Moore-Horspool shift
+ *          table, so searching for the same pattern repeatedly costs no setup.
+ */
+typedef struct {
+    size_t length;       /**< Number of bytes in the pattern */
+    size_t shift[256];   /**< Bad-character shift for each byte value */
+    char pattern[];      /**< Pattern bytes (not null-terminated) */
+} string_needle_t;
+
+/**
+ * @brief Kind of delimiter a tokenizer splits on
+ */
+typedef enum {
+    STRING_SPLIT_CHAR   = 0,  /**< A single delimiter byte */
+    STRING_SPLIT_ANY    = 1,  /**< Any byte from a delimiter set */
+    STRING_SPLIT_SUBSTR = 2   /**< A delimiter byte sequence */
+} string_split_t;
+
+/**
+ * @brief Zero-copy tokenizer state
+ * @details Initialize with one of the string_tokenizer_init*() functions. Tokens
+ *          are views into the source, so the source must outlive them. The fields
+ *          are internal and should not be modified directly.
+ */
+typedef struct {
+    string_view_t source;     /**< Input being split */
+    string_view_t delimiter;  /**< Delimiter byte, set or sequence */
+    size_t position;          /**< Offset of the next token in the source */
+    string_split_t mode;      /**< Kind of delimiter */
+    char delimiter_char;      /**< Storage for a single delimiter byte */
+    bool done;                /**< Whether the last token has been returned */
+} string_tokenizer_t;
+
 /**
  * @brief Get error message for a given error code
  * @param error The error code to get message for
@@ -71,6 +208,14 @@ const char *string_error_message(string_result_t error);
  */
 string_t *string_create_with_capacity(size_t capacity);
 
+/**
+ * @brief Create a new string bound to a specific allocator
+ * @param capacity Initial capacity for the string (minimum capacity will be applied if too small)
+ * @param allocator Allocator for the header and all data buffers (NULL selects the default)
+ * @return Pointer to newly created string, or NULL on failure
+ */
+string_t *string_create_with_allocator(size_t capacity, const string_allocator_t *allocator);
+
 /**
  * @brief Create a new empty string with default capacity
  * @return Pointer to newly created string, or NULL on failure
@@ -96,6 +241,8 @@ string_t *string_create_from_cstr(const char *cstr);
  * @brief Create a copy of an existing string
  * @param src Source string to clone
  * @return Pointer to newly created string copy, or NULL on failure
+ * @details A clone of a shared string (see string_make_shared()) references the
+ *          same buffer instead of copying it.
  */
 string_t *string_clone(const string_t *src);
 
@@ -105,6 +252,99 @@ string_t *string_clone(const string_t *src);
  */
 void string_destroy(string_t *str);
 
+/*
+ * ============================================
+ * Caller-owned string initialization functions
+ * ============================================
+ */
+
+/**
+ * @brief Initialize a caller-owned string as empty
+ * @param str String structure to initialize (on the stack or embedded in another struct)
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details The string starts in its inline buffer, so no allocation is performed.
+ *          Release it with string_deinit(), never with string_destroy().
+ */
+string_result_t string_init(string_t *str);
+
+/**
+ * @brief Initialize a caller-owned string bound to a specific allocator
+ * @param str String structure to initialize
+ * @param allocator Allocator for data buffers (NULL selects the default)
+ * @return STRING_SUCCESS on success, error code on failure
+ */
+string_result_t string_init_with_allocator(string_t *str, const string_allocator_t *allocator);
+
+/**
+ * @brief Initialize a caller-owned string on a caller-supplied buffer
+ * @param str String structure to initialize
+ * @param buffer Buffer to use as initial storage (must outlive the string)
+ * @param size Size of the buffer in bytes (including room for the null terminator)
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details The string uses the buffer until its content outgrows it, then moves to
+ *          the heap. The buffer itself is never freed by the library.
+ */
+string_result_t string_init_with_buffer(string_t *str, char *buffer, size_t size);
+
+/**
+ * @brief Release the storage of a caller-owned string
+ * @param str String to deinitialize (can be NULL)
+ * @details Frees any heap data and leaves the string empty and reusable.
+ *          The string structure itself is not freed.
+ */
+void string_deinit(string_t *str);
+
+/*
+ * =============================
+ * Allocator binding functions
+ * =============================
+ */
+
+/**
+ * @brief Get the default allocator
+ * @return Allocator backed by malloc, realloc and free
+ */
+const string_allocator_t *string_default_allocator(void);
+
+/**
+ * @brief Bind an allocator to the current thread
+ * @param allocator Allocator used by constructors on this thread (NULL restores the default)
+ * @details Every string created or initialized afterwards on this thread uses the
+ *          allocator for its header and data for its whole lifetime. Existing strings
+ *          keep the allocator they were created with.
+ */
+void string_set_thread_allocator(const string_allocator_t *allocator);
+
+/**
+ * @brief Get the allocator bound to the current thread
+ * @return Current thread allocator (never NULL)
+ */
+const string_allocator_t *string_get_thread_allocator(void);
+
+/*
+ * ========================
+ * Growth policy functions
+ * ========================
+ */
+
+/**
+ * @brief Select how strings grow when they run out of capacity
+ * @param policy Growth policy for every later reallocation
+ * @return Previous policy
+ * @details Affects all threads. STRING_GROWTH_USABLE_SIZE asks the C library for
+ *          the real size of each default-allocator block (malloc_usable_size()
+ *          or malloc_size()) and records it as capacity, so the rounding slack is
+ *          used instead of wasted; elsewhere it behaves as
+ *          STRING_GROWTH_ONE_AND_HALF.
+ */
+string_growth_t string_set_growth_policy(string_growth_t policy);
+
+/**
+ * @brief Get the active growth policy
+ * @return Current policy (STRING_GROWTH_DOUBLE unless changed)
+ */
+string_growth_t string_get_growth_policy(void);
+
 /*
  * =============================
  * String information functions
@@ -139,6 +379,28 @@ bool string_is_empty(const string_t *str);
  */
 const char *string_cstr(const string_t *str);
 
+/**
+ * @brief Check if a string is stored in its inline small-string buffer
+ * @param str String to check
+ * @return true if the content lives inline (no heap data buffer), false otherwise or if str is NULL
+ */
+bool string_is_inline(const string_t *str);
+
+/**
+ * @brief Check if a string uses a shared copy-on-write buffer
+ * @param str String to check
+ * @return true if the content lives in a reference-counted shared buffer
+ */
+bool string_is_shared(const string_t *str);
+
+/**
+ * @brief Get the number of strings referencing a shared buffer
+ * @param str String to check
+ * @return Number of strings sharing the buffer, or 0 if the string is not shared
+ * @details The value can change at any time when clones live on other threads.
+ */
+size_t string_shared_count(const string_t *str);
+
 /*
  * ==============================
  * String modification functions
@@ -153,6 +415,41 @@ const char *string_cstr(const string_t *str);
  */
 string_result_t string_reserve(string_t *str, size_t new_capacity);
 
+/**
+ * @brief Pre-size a string for its expected final length
+ * @param str String to pre-size
+ * @param expected_length Number of bytes the string is expected to hold
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Allocates exactly expected_length + 1 bytes when the current capacity
+ *          is smaller, bypassing the growth policy, so building content of a
+ *          known size needs one allocation and leaves no slack. Growing beyond
+ *          the hint later follows the policy as usual.
+ */
+string_result_t string_reserve_hint(string_t *str, size_t expected_length);
+
+/**
+ * @brief Get writable room after the content of a string
+ * @param str String to write into
+ * @param min_extra Minimum number of bytes to make room for
+ * @param spare Receives a pointer to the first byte after the content
+ * @param available Receives the number of bytes that may be written there
+ *                  (at least min_extra)
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Lets producers such as read() write straight into the string's
+ *          buffer. The content itself is unchanged; publish the written bytes
+ *          with string_commit_spare(). The pointer is invalidated by any other
+ *          modification of the string.
+ */
+string_result_t string_reserve_spare(string_t *str, size_t min_extra, char **spare, size_t *available);
+
+/**
+ * @brief Extend the content over bytes written into the spare room
+ * @param str String previously prepared with string_reserve_spare()
+ * @param written Number of bytes written after the content
+ * @return STRING_SUCCESS on success, error code on failure
+ */
+string_result_t string_commit_spare(string_t *str, size_t written);
+
 /**
  * @brief Resize a string to specified length
  * @param str String to resize
@@ -175,6 +472,18 @@ string_result_t string_clear(string_t *str);
  */
 string_result_t string_shrink_to_fit(string_t *str);
 
+/**
+ * @brief Move the content into a shared copy-on-write buffer
+ * @param str String to convert
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details After this call string_clone() and string_assign_string() share the
+ *          buffer with the new string instead of copying it. The buffer is
+ *          immutable and reference-counted with atomic operations, so clones can
+ *          be handed to other threads; the first modification of any sharer
+ *          copies the content into a private buffer (detaches) first.
+ */
+string_result_t string_make_shared(string_t *str);
+
 /*
  * ============================
  * String assignment functions
@@ -203,9 +512,62 @@ string_result_t string_assign_cstr(string_t *str, const char *cstr);
  * @param dest Destination string
  * @param src Source string
  * @return STRING_SUCCESS on success, error code on failure
+ * @details Shares the buffer instead of copying it when src is shared.
  */
 string_result_t string_assign_string(string_t *dest, const string_t *src);
 
+/*
+ * ===================================
+ * String ownership transfer functions
+ * ===================================
+ */
+
+/**
+ * @brief Create a string that takes ownership of an existing buffer
+ * @param buffer Buffer obtained from the thread allocator (malloc() by default)
+ * @param length Number of content bytes at the start of the buffer
+ * @param capacity Size of the buffer in bytes (greater than length)
+ * @return Pointer to newly created string, or NULL on failure
+ * @details The content is not copied: the string uses the buffer as its heap
+ *          storage, writes the null terminator at buffer[length] and frees the
+ *          buffer when destroyed. On failure the caller keeps ownership.
+ */
+string_t *string_adopt(char *buffer, size_t length, size_t capacity);
+
+/**
+ * @brief Hand the data buffer of a string over to the caller
+ * @param str String to release the buffer of
+ * @param length Receives the content length (can be NULL)
+ * @param capacity Receives the size of the returned buffer (can be NULL)
+ * @return Null-terminated buffer owned by the caller, or NULL on failure
+ * @details Heap data is returned without copying; inline, external and shared
+ *          content is copied into a new buffer first. The buffer comes from
+ *          the string's allocator (free it with free() for the default one) and
+ *          the string is left empty.
+ */
+char *string_release(string_t *str, size_t *length, size_t *capacity);
+
+/**
+ * @brief Exchange the contents of two strings
+ * @param str1 First string
+ * @param str2 Second string
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Runs in constant time without allocating. Each string keeps its own
+ *          allocator, so heap data can only be exchanged between strings bound
+ *          to the same allocator (STRING_ERROR_INVALID_ARGUMENT otherwise).
+ */
+string_result_t string_swap(string_t *str1, string_t *str2);
+
+/**
+ * @brief Move the content of one string into another
+ * @param dest Destination string (its previous content is released)
+ * @param src Source string (left empty)
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Transfers the data buffer without copying it; the same allocator
+ *          restriction as string_swap() applies.
+ */
+string_result_t string_move(string_t *dest, string_t *src);
+
 /*
  * ===============================
  * String concatenation functions
@@ -245,6 +607,48 @@ string_result_t string_append_string(string_t *dest, const string_t *src);
  */
 string_result_t string_append_char(string_t *str, char c);
 
+/**
+ * @brief Append several strings with a single allocation
+ * @param dest Destination string
+ * @param strings Array of strings to append (NULL entries are skipped)
+ * @param count Number of elements in the array
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details The total length is computed first, so the destination grows at most
+ *          once and each piece is copied exactly once.
+ */
+string_result_t string_concat_many(string_t *dest, const string_t *const *strings, size_t count);
+
+/**
+ * @brief Append several strings separated by a separator
+ * @param dest Destination string (clear it first to build the result from scratch)
+ * @param strings Array of strings to join (NULL entries are treated as empty)
+ * @param count Number of elements in the array
+ * @param separator Separator placed between consecutive pieces
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Sized and copied in one pass, like string_concat_many().
+ */
+string_result_t string_join(string_t *dest, const string_t *const *strings, size_t count, string_view_t separator);
+
+/**
+ * @brief Append a gather list of buffers with a single allocation
+ * @param dest Destination string
+ * @param views Array of (pointer, length) pieces, in the spirit of an iovec array
+ * @param count Number of elements in the array
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Pieces may point into the destination itself.
+ */
+string_result_t string_append_views(string_t *dest, const string_view_t *views, size_t count);
+
+/**
+ * @brief Append a gather list of buffers separated by a separator
+ * @param dest Destination string
+ * @param views Array of (pointer, length) pieces to join
+ * @param count Number of elements in the array
+ * @param separator Separator placed between consecutive pieces
+ * @return STRING_SUCCESS on success, error code on failure
+ */
+string_result_t string_join_views(string_t *dest, const string_view_t *views, size_t count, string_view_t separator);
+
 /*
  * ===========================
  * String insertion functions
@@ -352,6 +756,8 @@ int string_compare(const string_t *str1, const string_t *str2);
  * @param str String to compare
  * @param cstr C string to compare with
  * @return Negative if str < cstr, 0 if equal, positive if str > cstr
+ * @details Compares the whole length of str, so a string with embedded null
+ *          bytes is greater than the C string that ends at the first one.
  */
 int string_compare_cstr(const string_t *str, const char *cstr);
 
@@ -360,6 +766,8 @@ int string_compare_cstr(const string_t *str, const char *cstr);
  * @param str1 First string to compare
  * @param str2 Second string to compare
  * @return true if strings are equal, false otherwise
+ * @details Answers from the lengths, and from cached hashes when both strings
+ *          have one, before reading any bytes.
  */
 bool string_equals(const string_t *str1, const string_t *str2);
 
@@ -371,6 +779,52 @@ bool string_equals(const string_t *str1, const string_t *str2);
  */
 bool string_equals_cstr(const string_t *str, const char *cstr);
 
+/**
+ * @brief Check if string equals a buffer
+ * @param str String to compare
+ * @param buffer Bytes to compare with (can contain null bytes)
+ * @param length Number of bytes in the buffer
+ * @return true if the string holds exactly these bytes, false otherwise
+ */
+bool string_equals_buffer(const string_t *str, const char *buffer, size_t length);
+
+/**
+ * @brief Compare two strings lexicographically ignoring ASCII case
+ * @param str1 First string to compare
+ * @param str2 Second string to compare
+ * @return Negative if str1 < str2, 0 if equal, positive if str1 > str2
+ * @details ASCII letters compare as their lowercase form (like strcasecmp() in the
+ *          "C" locale); all other bytes compare as unsigned values. No copies are made.
+ */
+int string_compare_icase(const string_t *str1, const string_t *str2);
+
+/**
+ * @brief Check if two strings are equal ignoring ASCII case
+ * @param str1 First string to compare
+ * @param str2 Second string to compare
+ * @return true if strings are equal ignoring ASCII case, false otherwise
+ */
+bool string_equals_icase(const string_t *str1, const string_t *str2);
+
+/**
+ * @brief Hash the content of a string
+ * @param str String to hash
+ * @return Same value as string_view_hash() over the content (0 for NULL)
+ * @details Returns the cached hash when one is present, without storing anything,
+ *          so it is safe to call concurrently on a shared string.
+ */
+uint64_t string_hash(const string_t *str);
+
+/**
+ * @brief Hash the content of a string and cache the result in it
+ * @param str String to hash
+ * @return Same value as string_hash()
+ * @details Later calls to string_hash() and string_hash_cached() return the cached
+ *          value in O(1) until a modification function invalidates it. Code that
+ *          writes through str->data directly must not rely on the cache.
+ */
+uint64_t string_hash_cached(string_t *str);
+
 /*
  * ===========================
  * String searching functions
@@ -410,6 +864,28 @@ size_t string_find_cstr(const string_t *str, const char *substr, size_t start_po
  */
 size_t string_find_string(const string_t *str, const string_t *substr, size_t start_pos);
 
+/**
+ * @brief Find first occurrence of a byte sequence in string
+ * @param str String to search in
+ * @param buffer Bytes to search for (can contain null bytes)
+ * @param length Number of bytes to search for
+ * @param start_pos Position to start searching from (0-based)
+ * @return Position of first occurrence, or STRING_NPOS if not found
+ * @details Runs in linear time regardless of how repetitive the data is.
+ *          Returns STRING_NPOS if the sequence is not found or if parameters are invalid.
+ */
+size_t string_find_buffer(const string_t *str, const char *buffer, size_t length, size_t start_pos);
+
+/**
+ * @brief Find first occurrence of C string substring ignoring ASCII case
+ * @param str String to search in
+ * @param substr C string substring to search for
+ * @param start_pos Starting position for search (0-based)
+ * @return Position of substring or STRING_NPOS if not found
+ * @details Runs in linear time without making lowered copies of either string.
+ */
+size_t string_find_icase(const string_t *str, const char *substr, size_t start_pos);
+
 /**
  * @brief Find last occurrence of character in string
  * @param str String to search in
@@ -422,6 +898,41 @@ size_t string_find_string(const string_t *str, const string_t *substr, size_t st
  */
 size_t string_rfind_char(const string_t *str, char c, size_t start_pos);
 
+/**
+ * @brief Find first occurrence of any character from a set
+ * @param str String to search in
+ * @param chars Set of characters to search for (null-terminated)
+ * @param start_pos Position to start searching from (0-based)
+ * @return Position of first occurrence, or STRING_NPOS if not found
+ * @details Returns STRING_NPOS if no character of the set is found or if parameters are invalid.
+ */
+size_t string_find_first_of(const string_t *str, const char *chars, size_t start_pos);
+
+/**
+ * @brief Find last occurrence of any character from a set
+ * @param str String to search in
+ * @param chars Set of characters to search for (null-terminated)
+ * @param start_pos Position to start searching backwards from (0-based)
+ * @return Position of last occurrence, or STRING_NPOS if not found
+ * @details If start_pos is STRING_NPOS, searches from the end of the string.
+ *          Returns STRING_NPOS if no character of the set is found or if parameters are invalid.
+ */
+size_t string_find_last_of(const string_t *str, const char *chars, size_t start_pos);
+
+/**
+ * @brief Get the vector instruction set used by the searching functions
+ * @return Active instruction set, detected from the CPU on first use
+ */
+string_simd_t string_get_simd_level(void);
+
+/**
+ * @brief Limit the vector instruction set used by the searching functions
+ * @param level Requested instruction set (STRING_SIMD_NONE forces the scalar loops)
+ * @return Instruction set actually applied, clamped to what the CPU supports
+ * @details Intended for testing and benchmarking; affects all threads.
+ */
+string_simd_t string_set_simd_level(string_simd_t level);
+
 /*
  * =========================
  * String utility functions
@@ -432,8 +943,9 @@ size_t string_rfind_char(const string_t *str, char c, size_t start_pos);
  * @brief Convert string to uppercase
  * @param str String to convert to uppercase
  * @return STRING_SUCCESS on success, error code on failure
- * @details Converts all lowercase letters in the string to uppercase in-place.
- *          Non-alphabetic characters remain unchanged.
+ * @details Converts all ASCII lowercase letters in the string to uppercase in-place,
+ *          using vector instructions when available. All other bytes remain unchanged,
+ *          whatever the locale; use string_to_upper_locale() for locale-aware conversion.
  */
 string_result_t string_to_upper(string_t *str);
 
@@ -441,20 +953,74 @@ string_result_t string_to_upper(string_t *str);
  * @brief Convert string to lowercase
  * @param str String to convert to lowercase
  * @return STRING_SUCCESS on success, error code on failure
- * @details Converts all uppercase letters in the string to lowercase in-place.
- *          Non-alphabetic characters remain unchanged.
+ * @details Converts all ASCII uppercase letters in the string to lowercase in-place,
+ *          using vector instructions when available. All other bytes remain unchanged,
+ *          whatever the locale; use string_to_lower_locale() for locale-aware conversion.
  */
 string_result_t string_to_lower(string_t *str);
 
+/**
+ * @brief Convert string to uppercase using the current locale
+ * @param str String to convert to uppercase
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Converts every byte in-place with toupper(), so single-byte letters outside
+ *          ASCII are converted when the current locale defines them.
+ */
+string_result_t string_to_upper_locale(string_t *str);
+
+/**
+ * @brief Convert string to lowercase using the current locale
+ * @param str String to convert to lowercase
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Converts every byte in-place with tolower(), so single-byte letters outside
+ *          ASCII are converted when the current locale defines them.
+ */
+string_result_t string_to_lower_locale(string_t *str);
+
 /**
  * @brief Remove leading and trailing whitespace from string
  * @param str String to trim
  * @return STRING_SUCCESS on success, error code on failure
- * @details Removes whitespace characters (space, tab, newline, etc.) from both
- *          the beginning and end of the string. The string is modified in-place.
+ * @details Removes ASCII whitespace (space, \t, \n, \v, \f, \r) from both the
+ *          beginning and end of the string. The string is modified in-place;
+ *          an empty or all-whitespace string becomes empty.
  */
 string_result_t string_trim(string_t *str);
 
+/**
+ * @brief Remove leading whitespace from string
+ * @param str String to trim
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Same whitespace as string_trim(). The remaining content is moved to
+ *          the start of the buffer.
+ */
+string_result_t string_ltrim(string_t *str);
+
+/**
+ * @brief Remove trailing whitespace from string
+ * @param str String to trim
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Same whitespace as string_trim(). Only the length changes; no byte moves.
+ */
+string_result_t string_rtrim(string_t *str);
+
+/**
+ * @brief Remove leading and trailing bytes of a character class from string
+ * @param str String to trim
+ * @param cls Class of bytes to remove
+ * @return STRING_SUCCESS on success, error code on failure
+ */
+string_result_t string_trim_class(string_t *str, const string_char_class_t *cls);
+
+/**
+ * @brief Trim a string and replace each inner run of whitespace with one space
+ * @param str String to modify
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Same whitespace as string_trim(). Runs that already are a single
+ *          space are left in place, so text without extra whitespace is not copied.
+ */
+string_result_t string_collapse_whitespace(string_t *str);
+
 /**
  * @brief Replace all occurrences of a character with another character
  * @param str String to modify
@@ -466,6 +1032,141 @@ string_result_t string_trim(string_t *str);
  */
 string_result_t string_replace_char(string_t *str, char old_char, char new_char);
 
+/**
+ * @brief Replace every occurrence of a pattern
+ * @param str String to modify
+ * @param pattern Pattern to replace (non-empty, may contain null bytes)
+ * @param replacement Replacement bytes (may be empty to delete matches)
+ * @param count Receives the number of replacements made (can be NULL)
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Matches are found left to right without overlapping. The result is
+ *          built in one forward pass over the string: in place when the
+ *          replacement is no longer than the pattern, otherwise after growing the
+ *          buffer exactly once. On failure the string is left unchanged.
+ */
+string_result_t string_replace_all(string_t *str, string_view_t pattern, string_view_t replacement, size_t *count);
+
+/**
+ * @brief Replace the first occurrence of a pattern
+ * @param str String to modify
+ * @param pattern Pattern to replace (non-empty, may contain null bytes)
+ * @param replacement Replacement bytes (may be empty to delete the match)
+ * @param count Receives 1 if a replacement was made, 0 otherwise (can be NULL)
+ * @return STRING_SUCCESS on success, error code on failure
+ */
+string_result_t string_replace_first(string_t *str, string_view_t pattern, string_view_t replacement, size_t *count);
+
+/**
+ * @brief Replace every occurrence of a C string pattern
+ * @param str String to modify
+ * @param pattern Pattern C string to replace (non-empty, null-terminated)
+ * @param replacement Replacement C string (null-terminated)
+ * @return STRING_SUCCESS on success, error code on failure
+ */
+string_result_t string_replace_all_cstr(string_t *str, const char *pattern, const char *replacement);
+
+/*
+ * ========================
+ * String batch functions
+ * ========================
+ */
+
+/**
+ * @brief Convert every string of an array to lowercase
+ * @param strings Array of strings to convert
+ * @param count Number of elements in the array
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Every entry is checked before any is modified, so a NULL or read-only
+ *          entry leaves the whole batch unchanged. Same conversion as string_to_lower().
+ */
+string_result_t string_batch_to_lower(string_t *const *strings, size_t count);
+
+/**
+ * @brief Convert every string of an array to uppercase
+ * @param strings Array of strings to convert
+ * @param count Number of elements in the array
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Validated like string_batch_to_lower(). Same conversion as string_to_upper().
+ */
+string_result_t string_batch_to_upper(string_t *const *strings, size_t count);
+
+/**
+ * @brief Compare every string of an array against one key
+ * @param strings Array of strings (NULL entries compare as empty)
+ * @param count Number of elements in the array
+ * @param key Bytes to compare against
+ * @param matches Receives true or false for each element (can be NULL)
+ * @return Number of elements equal to the key
+ * @details Lengths are compared first, so only same-length entries touch their bytes.
+ */
+size_t string_batch_count_equal(const string_t *const *strings, size_t count, string_view_t key, bool *matches);
+
+/**
+ * @brief Find the first string of an array equal to a key
+ * @param strings Array of strings (NULL entries compare as empty)
+ * @param count Number of elements in the array
+ * @param key Bytes to look for
+ * @return Index of the first equal element, or STRING_NPOS if none
+ */
+size_t string_batch_find_equal(const string_t *const *strings, size_t count, string_view_t key);
+
+/**
+ * @brief Find the first string of an array that contains a byte
+ * @param strings Array of strings (NULL entries are skipped)
+ * @param count Number of elements in the array
+ * @param c Byte to search for
+ * @param position Receives the offset of the byte in that string (can be NULL)
+ * @return Index of the first string containing the byte, or STRING_NPOS if none
+ */
+size_t string_batch_find_char(const string_t *const *strings, size_t count, char c, size_t *position);
+
+/**
+ * @brief Sum the lengths of an array of strings
+ * @param strings Array of strings (NULL entries count as empty)
+ * @param count Number of elements in the array
+ * @return Total length, or SIZE_MAX if it does not fit a size_t
+ * @details Use string_concat_many() or string_join() to concatenate them.
+ */
+size_t string_batch_total_length(const string_t *const *strings, size_t count);
+
+/**
+ * @brief Compare every view of an array against one key
+ * @param views Array of views
+ * @param count Number of elements in the array
+ * @param key Bytes to compare against
+ * @param matches Receives true or false for each element (can be NULL)
+ * @return Number of elements equal to the key
+ */
+size_t string_batch_count_equal_views(const string_view_t *views, size_t count, string_view_t key, bool *matches);
+
+/**
+ * @brief Find the first view of an array equal to a key
+ * @param views Array of views
+ * @param count Number of elements in the array
+ * @param key Bytes to look for
+ * @return Index of the first equal element, or STRING_NPOS if none
+ */
+size_t string_batch_find_equal_views(const string_view_t *views, size_t count, string_view_t key);
+
+/**
+ * @brief Find the first view of an array that contains a byte
+ * @param views Array of views
+ * @param count Number of elements in the array
+ * @param c Byte to search for
+ * @param position Receives the offset of the byte in that view (can be NULL)
+ * @return Index of the first view containing the byte, or STRING_NPOS if none
+ */
+size_t string_batch_find_char_views(const string_view_t *views, size_t count, char c, size_t *position);
+
+/**
+ * @brief Sum the lengths of an array of views
+ * @param views Array of views
+ * @param count Number of elements in the array
+ * @return Total length, or SIZE_MAX if it does not fit a size_t
+ * @details Use string_append_views() or string_join_views() to concatenate them.
+ */
+size_t string_batch_total_length_views(const string_view_t *views, size_t count);
+
 /*
  * =========================
  * String copying functions
@@ -498,10 +1199,23 @@ string_result_t string_copy_to_buffer(const string_t *str, char *buffer, size_t
  * @return STRING_SUCCESS on success, error code on failure
  * @details Formats the string using printf-style formatting and stores the result
  *          in the destination string. The previous content of the string is replaced.
- *          Supports all standard printf format specifiers.
+ *          Supports all standard printf format specifiers. The output is written
+ *          directly into the spare capacity; the format is only run a second time
+ *          when it does not fit. Arguments must not point into the destination string.
+ *          On failure the string is left empty.
  */
 string_result_t string_format(string_t *str, const char *format, ...);
 
+/**
+ * @brief Format string using a va_list
+ * @param str Destination string to store formatted result
+ * @param format Printf-style format string
+ * @param args Variable argument list for format string
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Same as string_format() but takes a va_list, for use in variadic wrappers.
+ */
+string_result_t string_vformat(string_t *str, const char *format, va_list args);
+
 /**
  * @brief Append formatted text to string using printf-style formatting
  * @param str Destination string to append to
@@ -510,5 +1224,464 @@ string_result_t string_format(string_t *str, const char *format, ...);
  * @return STRING_SUCCESS on success, error code on failure
  * @details Formats text using printf-style formatting and appends it to the
  *          existing string content. Supports all standard printf format specifiers.
+ *          Arguments must not point into the destination string. On failure the
+ *          previous content is left unchanged.
  */
 string_result_t string_append_format(string_t *str, const char *format, ...);
+
+/**
+ * @brief Append formatted text to string using a va_list
+ * @param str Destination string to append to
+ * @param format Printf-style format string
+ * @param args Variable argument list for format string
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Same as string_append_format() but takes a va_list, for use in variadic wrappers.
+ */
+string_result_t string_append_vformat(string_t *str, const char *format, va_list args);
+
+/*
+ * ===================================
+ * String number conversion functions
+ * ===================================
+ */
+
+/**
+ * @brief Append a signed integer in decimal
+ * @param str String to append to
+ * @param value Value to append
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Equivalent to "%" PRId64 without printf parsing or locale lookups.
+ */
+string_result_t string_append_int(string_t *str, int64_t value);
+
+/**
+ * @brief Append an unsigned integer in decimal
+ * @param str String to append to
+ * @param value Value to append
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Equivalent to "%" PRIu64 without printf parsing or locale lookups.
+ */
+string_result_t string_append_uint(string_t *str, uint64_t value);
+
+/**
+ * @brief Append an unsigned integer in lowercase hexadecimal
+ * @param str String to append to
+ * @param value Value to append
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Equivalent to "%" PRIx64: no "0x" prefix and no padding.
+ */
+string_result_t string_append_hex(string_t *str, uint64_t value);
+
+/**
+ * @brief Append a double using the shortest digits that round-trip
+ * @param str String to append to
+ * @param value Value to append
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Writes the fewest significant digits that string_to_double() (or strtod())
+ *          reads back as exactly the same value. Uses fixed notation ("0.1", "42",
+ *          "-0.00001") for decimal exponents from -5 to 16 and scientific notation
+ *          ("1e+100", "2.5e-08") otherwise. Non-finite values are written as "nan",
+ *          "inf" and "-inf". The decimal point is always '.', whatever the locale.
+ */
+string_result_t string_append_double(string_t *str, double value);
+
+/**
+ * @brief Parse the whole string as a signed decimal integer
+ * @param str String to parse
+ * @param value Receives the parsed value (left unchanged on failure)
+ * @return STRING_SUCCESS on success, STRING_ERROR_INVALID_ARGUMENT if the string is
+ *         not an optional sign followed by digits, STRING_ERROR_OUT_OF_RANGE if the
+ *         value does not fit in int64_t
+ * @details Leading or trailing whitespace is not accepted.
+ */
+string_result_t string_to_int64(const string_t *str, int64_t *value);
+
+/**
+ * @brief Parse the whole string as a decimal floating-point number
+ * @param str String to parse
+ * @param value Receives the correctly rounded value (left unchanged on failure)
+ * @return STRING_SUCCESS on success, STRING_ERROR_INVALID_ARGUMENT if the string is
+ *         not a number, STRING_ERROR_OUT_OF_RANGE if the value overflows a double
+ * @details Accepts an optional sign, digits with an optional '.', an optional
+ *          exponent, and "inf", "infinity" or "nan" in any case. The decimal point
+ *          is always '.', whatever the locale. Leading or trailing whitespace is not
+ *          accepted.
+ */
+string_result_t string_to_double(const string_t *str, double *value);
+
+/*
+ * ======================
+ * String view functions
+ * ======================
+ */
+
+/**
+ * @brief Create a view over a buffer
+ * @param buffer Source buffer (can contain null bytes)
+ * @param length Number of bytes in the view
+ * @return View over the buffer (empty view if buffer is NULL)
+ */
+string_view_t string_view_from_buffer(const char *buffer, size_t length);
+
+/**
+ * @brief Create a view over a null-terminated C string
+ * @param cstr Source C string (null-terminated)
+ * @return View over the C string, excluding the terminator (empty view if cstr is NULL)
+ */
+string_view_t string_view_from_cstr(const char *cstr);
+
+/**
+ * @brief Create a view over the content of a string
+ * @param str Source string
+ * @return View over the string content (empty view if str is NULL)
+ * @details The view is invalidated by any operation that reallocates the string.
+ */
+string_view_t string_view_from_string(const string_t *str);
+
+/**
+ * @brief Create a view over part of a string without copying
+ * @param str Source string
+ * @param pos Starting position of the view
+ * @param count Maximum number of bytes in the view (STRING_NPOS for the rest of the string)
+ * @return View over the requested range, clamped to the string (empty view if pos is out of range)
+ */
+string_view_t string_substr_view(const string_t *str, size_t pos, size_t count);
+
+/**
+ * @brief Get a sub-view of a view
+ * @param view Source view
+ * @param pos Starting position of the sub-view
+ * @param count Maximum number of bytes in the sub-view (STRING_NPOS for the rest of the view)
+ * @return Sub-view, clamped to the source view (empty view if pos is out of range)
+ */
+string_view_t string_view_substr(string_view_t view, size_t pos, size_t count);
+
+/**
+ * @brief Get the half-open range [begin, end) of a view
+ * @param view Source view
+ * @param begin First position of the slice
+ * @param end Position one past the last byte of the slice (clamped to the view length)
+ * @return Slice of the view (empty view if begin >= end)
+ */
+string_view_t string_view_slice(string_view_t view, size_t begin, size_t end);
+
+/**
+ * @brief Compare two views lexicographically
+ * @param view1 First view to compare
+ * @param view2 Second view to compare
+ * @return Negative if view1 < view2, 0 if equal, positive if view1 > view2
+ */
+int string_view_compare(string_view_t view1, string_view_t view2);
+
+/**
+ * @brief Check if two views have equal content
+ * @param view1 First view to compare
+ * @param view2 Second view to compare
+ * @return true if the views are equal, false otherwise
+ */
+bool string_view_equals(string_view_t view1, string_view_t view2);
+
+/**
+ * @brief Compare two views lexicographically ignoring ASCII case
+ * @param view1 First view
+ * @param view2 Second view
+ * @return Negative if view1 < view2, 0 if equal, positive if view1 > view2
+ */
+int string_view_compare_icase(string_view_t view1, string_view_t view2);
+
+/**
+ * @brief Check if two views have equal content ignoring ASCII case
+ * @param view1 First view
+ * @param view2 Second view
+ * @return true if equal ignoring ASCII case, false otherwise
+ */
+bool string_view_equals_icase(string_view_t view1, string_view_t view2);
+
+/**
+ * @brief Find first occurrence of character in view
+ * @param view View to search in
+ * @param c Character to search for
+ * @param start_pos Position to start searching from (0-based)
+ * @return Position of first occurrence, or STRING_NPOS if not found
+ */
+size_t string_view_find_char(string_view_t view, char c, size_t start_pos);
+
+/**
+ * @brief Find last occurrence of character in view
+ * @param view View to search in
+ * @param c Character to search for
+ * @param start_pos Position to start searching backwards from (STRING_NPOS for the end)
+ * @return Position of last occurrence, or STRING_NPOS if not found
+ */
+size_t string_view_rfind_char(string_view_t view, char c, size_t start_pos);
+
+/**
+ * @brief Find first occurrence of a view inside another view
+ * @param view View to search in
+ * @param needle View to search for (can contain null bytes)
+ * @param start_pos Position to start searching from (0-based)
+ * @return Position of first occurrence, or STRING_NPOS if not found
+ */
+size_t string_view_find(string_view_t view, string_view_t needle, size_t start_pos);
+
+/**
+ * @brief Find first occurrence of a byte sequence in a view ignoring ASCII case
+ * @param view View to search in
+ * @param needle Bytes to search for
+ * @param start_pos Starting position
+ * @return Position of match or STRING_NPOS if not found
+ */
+size_t string_view_find_icase(string_view_t view, string_view_t needle, size_t start_pos);
+
+/**
+ * @brief Find first occurrence in a view of any byte from a set
+ * @param view View to search in
+ * @param chars Set of bytes to search for (can contain null bytes)
+ * @param start_pos Position to start searching from (0-based)
+ * @return Position of first occurrence, or STRING_NPOS if not found
+ */
+size_t string_view_find_first_of(string_view_t view, string_view_t chars, size_t start_pos);
+
+/**
+ * @brief Find last occurrence in a view of any byte from a set
+ * @param view View to search in
+ * @param chars Set of bytes to search for (can contain null bytes)
+ * @param start_pos Position to start searching backwards from (STRING_NPOS for the end)
+ * @return Position of last occurrence, or STRING_NPOS if not found
+ */
+size_t string_view_find_last_of(string_view_t view, string_view_t chars, size_t start_pos);
+
+/*
+ * ===========================
+ * Character class functions
+ * ===========================
+ */
+
+/** @brief ASCII whitespace: space, \t, \n, \v, \f and \r (isspace() in the "C" locale) */
+extern const string_char_class_t string_class_space;
+
+/** @brief ASCII decimal digits '0' to '9' */
+extern const string_char_class_t string_class_digit;
+
+/**
+ * @brief Initialize a character class from its members
+ * @param cls Class to initialize
+ * @param members Bytes that belong to the class (can contain null bytes)
+ */
+void string_char_class_init(string_char_class_t *cls, string_view_t members);
+
+/**
+ * @brief Add a range of byte values to a character class
+ * @param cls Class to extend
+ * @param first First byte value of the range
+ * @param last Last byte value of the range (inclusive)
+ */
+void string_char_class_add_range(string_char_class_t *cls, unsigned char first, unsigned char last);
+
+/**
+ * @brief Check whether a byte belongs to a character class
+ * @param cls Class to test against
+ * @param c Byte to test
+ * @return true if c is a member
+ */
+bool string_char_class_contains(const string_char_class_t *cls, char c);
+
+/**
+ * @brief Find the first byte of a view that belongs to a class
+ * @param view View to search in
+ * @param cls Class of bytes to search for
+ * @param start_pos Position to start searching from (0-based)
+ * @return Position of first member, or STRING_NPOS if not found
+ */
+size_t string_view_find_class(string_view_t view, const string_char_class_t *cls, size_t start_pos);
+
+/**
+ * @brief Find the first byte of a view that does not belong to a class
+ * @param view View to search in
+ * @param cls Class of bytes to skip
+ * @param start_pos Position to start searching from (0-based)
+ * @return Position of first non-member, or STRING_NPOS if not found
+ */
+size_t string_view_find_not_class(string_view_t view, const string_char_class_t *cls, size_t start_pos);
+
+/**
+ * @brief Find the last byte of a view that belongs to a class
+ * @param view View to search in
+ * @param cls Class of bytes to search for
+ * @param start_pos Position to start searching backwards from (STRING_NPOS for the end)
+ * @return Position of last member, or STRING_NPOS if not found
+ */
+size_t string_view_rfind_class(string_view_t view, const string_char_class_t *cls, size_t start_pos);
+
+/**
+ * @brief Find the last byte of a view that does not belong to a class
+ * @param view View to search in
+ * @param cls Class of bytes to skip
+ * @param start_pos Position to start searching backwards from (STRING_NPOS for the end)
+ * @return Position of last non-member, or STRING_NPOS if not found
+ */
+size_t string_view_rfind_not_class(string_view_t view, const string_char_class_t *cls, size_t start_pos);
+
+/**
+ * @brief Get a view without leading and trailing whitespace
+ * @param view View to trim
+ * @return Sub-view of the input; no bytes are moved
+ * @details Same whitespace as string_trim().
+ */
+string_view_t string_view_trim(string_view_t view);
+
+/**
+ * @brief Get a view without leading and trailing bytes of a class
+ * @param view View to trim
+ * @param cls Class of bytes to remove
+ * @return Sub-view of the input; no bytes are moved
+ */
+string_view_t string_view_trim_class(string_view_t view, const string_char_class_t *cls);
+
+/**
+ * @brief Hash the content of a view
+ * @param view View to hash
+ * @return 64-bit non-cryptographic hash of the bytes in the view
+ * @details wyhash-style multiply-mix hash that consumes 48 bytes per step. Values
+ *          are stable within a process but not across library versions.
+ */
+uint64_t string_view_hash(string_view_t view);
+
+/**
+ * @brief Create a new string by copying the content of a view
+ * @param view Source view
+ * @return Pointer to newly created string, or NULL on failure
+ */
+string_t *string_create_from_view(string_view_t view);
+
+/**
+ * @brief Initialize a caller-owned, non-owning string over a view
+ * @param str String structure to initialize
+ * @param view View to borrow
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details The string does not own its data (is_owner is false) and is read-only:
+ *          mutating operations return STRING_ERROR_READ_ONLY. string_cstr() only
+ *          returns a null-terminated string if the viewed bytes are followed by one.
+ *          The viewed bytes must outlive the string.
+ */
+string_result_t string_init_view(string_t *str, string_view_t view);
+
+/**
+ * @brief Assign the content of a view to a string
+ * @param str Destination string
+ * @param view Source view
+ * @return STRING_SUCCESS on success, error code on failure
+ */
+string_result_t string_assign_view(string_t *str, string_view_t view);
+
+/**
+ * @brief Append the content of a view to a string
+ * @param str Destination string
+ * @param view Source view
+ * @return STRING_SUCCESS on success, error code on failure
+ */
+string_result_t string_append_view(string_t *str, string_view_t view);
+
+/*
+ * ===============================
+ * Precompiled search functions
+ * ===============================
+ */
+
+/**
+ * @brief Compile a pattern for repeated searches
+ * @param pattern Pattern bytes (can contain null bytes, copied into the needle)
+ * @param length Number of bytes in the pattern
+ * @return Pointer to newly created needle, or NULL on failure
+ */
+string_needle_t *string_needle_create(const char *pattern, size_t length);
+
+/**
+ * @brief Compile a null-terminated C string pattern for repeated searches
+ * @param cstr Pattern C string (null-terminated)
+ * @return Pointer to newly created needle, or NULL on failure
+ */
+string_needle_t *string_needle_create_from_cstr(const char *cstr);
+
+/**
+ * @brief Destroy a compiled needle
+ * @param needle Needle to destroy (can be NULL)
+ */
+void string_needle_destroy(string_needle_t *needle);
+
+/**
+ * @brief Find first occurrence of a compiled needle in a view
+ * @param needle Compiled needle
+ * @param view View to search in
+ * @param start_pos Position to start searching from (0-based)
+ * @return Position of first occurrence, or STRING_NPOS if not found
+ */
+size_t string_needle_find(const string_needle_t *needle, string_view_t view, size_t start_pos);
+
+/**
+ * @brief Find first occurrence of a compiled needle in a string
+ * @param str String to search in
+ * @param needle Compiled needle
+ * @param start_pos Position to start searching from (0-based)
+ * @return Position of first occurrence, or STRING_NPOS if not found
+ */
+size_t string_find_needle(const string_t *str, const string_needle_t *needle, size_t start_pos);
+
+/*
+ * ===========================
+ * String tokenizer functions
+ * ===========================
+ */
+
+/**
+ * @brief Initialize a tokenizer that splits on a single byte
+ * @param tokenizer Tokenizer to initialize
+ * @param source Input to split (typically string_view_from_string())
+ * @param delimiter Delimiter byte
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Splitting follows CSV field rules: adjacent delimiters produce empty
+ *          tokens, a trailing delimiter produces a final empty token, and an empty
+ *          input produces a single empty token.
+ */
+string_result_t string_tokenizer_init(string_tokenizer_t *tokenizer, string_view_t source, char delimiter);
+
+/**
+ * @brief Initialize a tokenizer that splits on any byte of a set
+ * @param tokenizer Tokenizer to initialize
+ * @param source Input to split
+ * @param delimiters Set of delimiter bytes (non-empty, must outlive the tokenizer)
+ * @return STRING_SUCCESS on success, error code on failure
+ */
+string_result_t string_tokenizer_init_any(string_tokenizer_t *tokenizer, string_view_t source, string_view_t delimiters);
+
+/**
+ * @brief Initialize a tokenizer that splits on a byte sequence
+ * @param tokenizer Tokenizer to initialize
+ * @param source Input to split
+ * @param delimiter Delimiter sequence (non-empty, must outlive the tokenizer)
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Occurrences are found left to right without overlapping.
+ */
+string_result_t string_tokenizer_init_substr(string_tokenizer_t *tokenizer, string_view_t source, string_view_t delimiter);
+
+/**
+ * @brief Get the next token
+ * @param tokenizer Tokenizer to advance
+ * @param token Receives a view of the token
+ * @return true if a token was returned, false when the input is exhausted
+ * @details Never allocates.
+ */
+bool string_tokenizer_next(string_tokenizer_t *tokenizer, string_view_t *token);
+
+/**
+ * @brief Get as many of the next tokens as fit in an array
+ * @param tokenizer Tokenizer to advance
+ * @param tokens Array receiving views of the tokens
+ * @param capacity Number of elements in the array
+ * @return Number of tokens stored (0 when the input is exhausted)
+ * @details Single-byte splits locate every delimiter in one vectorized pass over
+ *          the input, instead of one search per token. Call again to continue
+ *          when the array was filled.
+ */
+size_t string_tokenizer_next_batch(string_tokenizer_t *tokenizer, string_view_t *tokens, size_t capacity);
+
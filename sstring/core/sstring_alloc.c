@@ -0,0 +1,440 @@
+/**
+ * @file sstring_alloc.c
+ * @brief Implementation of the arena and size-class pool allocators
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * This file implements the allocator backends declared in sstring_alloc.h.
+ * Both backends receive the allocation size on every call through the
+ * string_allocator_t interface, so neither needs per-allocation headers.
+ */
+
+#include "sstring_alloc.h"
+
+/** @brief Alignment of every arena and pool allocation */
+#define STRING_ALLOC_ALIGNMENT _Alignof(max_align_t)
+
+/** @brief Smallest pool size class */
+#define STRING_POOL_MIN_CLASS_SIZE 16
+
+/** @brief Number of pool size classes (16 to STRING_POOL_MAX_CLASS_SIZE bytes) */
+#define STRING_POOL_CLASS_COUNT 7
+
+/** @brief Size of each slab carved into pool chunks */
+#define STRING_POOL_SLAB_SIZE 16384
+
+/**
+ * @brief Arena memory block
+ */
+typedef struct string_arena_block {
+    struct string_arena_block *next;  /**< Next (older) block */
+    size_t size;                      /**< Usable size of the block */
+    size_t used;                      /**< Bytes handed out from the block */
+    max_align_t data[];               /**< Block memory */
+} string_arena_block_t;
+
+/**
+ * @brief Arena allocator state
+ */
+struct string_arena {
+    string_allocator_t allocator;  /**< Allocator interface bound to this arena */
+    string_arena_block_t *head;    /**< Block currently being filled */
+    size_t block_size;             /**< Size of regular blocks */
+    void *last;                    /**< Most recent allocation, eligible for in-place resize */
+    size_t used;                   /**< Total bytes handed out */
+};
+
+/**
+ * @brief Pool slab header
+ */
+typedef struct string_pool_slab {
+    struct string_pool_slab *next;  /**< Next slab */
+    max_align_t data[];             /**< Slab memory */
+} string_pool_slab_t;
+
+/**
+ * @brief Free chunk in a pool size class
+ */
+typedef struct string_pool_chunk {
+    struct string_pool_chunk *next;  /**< Next free chunk of the same class */
+} string_pool_chunk_t;
+
+/**
+ * @brief Size-class pool allocator state
+ */
+struct string_pool {
+    string_allocator_t allocator;                             /**< Allocator interface bound to this pool */
+    string_pool_chunk_t *free_lists[STRING_POOL_CLASS_COUNT];  /**< Recycled chunks per class */
+    unsigned char *cursor[STRING_POOL_CLASS_COUNT];            /**< Next uncarved chunk per class */
+    unsigned char *end[STRING_POOL_CLASS_COUNT];               /**< End of the current slab per class */
+    string_pool_slab_t *slabs;                                 /**< All slabs, for destruction */
+};
+
+/*
+ * ==========================
+ * Internal helper functions
+ * ==========================
+ */
+
+/**
+ * @brief Round a size up to the allocation alignment
+ * @param size Size to round
+ * @return size_t Rounded size, or 0 on overflow
+ */
+static size_t string_alloc_align(size_t size) {
+    if (size > (size_t)-1 - (STRING_ALLOC_ALIGNMENT - 1)) {
+        return 0;
+    }
+
+    return (size + STRING_ALLOC_ALIGNMENT - 1) & ~(STRING_ALLOC_ALIGNMENT - 1);
+}
+
+/*
+ * ================
+ * Arena functions
+ * ================
+ */
+
+/**
+ * @brief Arena allocator callback
+ * @details Bumps the head block, starting a new block when it is full
+ */
+static void *string_arena_allocate(void *context, size_t size) {
+    string_arena_t *arena = context;
+
+    size_t rounded = string_alloc_align(size ? size : 1);
+    if (rounded == 0) {
+        return NULL;
+    }
+
+    string_arena_block_t *block = arena->head;
+    if (!block || block->size - block->used < rounded) {
+        size_t block_size = rounded > arena->block_size ? rounded : arena->block_size;
+        if (block_size > SIZE_MAX - sizeof(string_arena_block_t)) {
+            return NULL;
+        }
+        string_arena_block_t *new_block = malloc(sizeof(string_arena_block_t) + block_size);
+        if (!new_block) {
+            return NULL;
+        }
+        new_block->size = block_size;
+        new_block->used = 0;
+
+        if (block && block_size > arena->block_size) {
+            // Dedicated block for an oversized request: keep filling the current head
+            new_block->next = block->next;
+            block->next = new_block;
+            new_block->used = rounded;
+            arena->used += rounded;
+            return new_block->data;
+        }
+
+        new_block->next = block;
+        arena->head = new_block;
+        block = new_block;
+    }
+
+    void *ptr = (unsigned char *)block->data + block->used;
+    block->used += rounded;
+    arena->used += rounded;
+    arena->last = ptr;
+
+    return ptr;
+}
+
+/**
+ * @brief Arena reallocation callback
+ * @details Grows or shrinks the most recent allocation in place when possible
+ */
+static void *string_arena_reallocate(void *context, void *ptr, size_t old_size, size_t new_size) {
+    string_arena_t *arena = context;
+
+    if (!ptr) {
+        return string_arena_allocate(context, new_size);
+    }
+
+    if (ptr == arena->last) {
+        string_arena_block_t *block = arena->head;
+        size_t offset = (size_t)((unsigned char *)ptr - (unsigned char *)block->data);
+        size_t old_rounded = block->used - offset;
+        size_t new_rounded = string_alloc_align(new_size ? new_size : 1);
+        if (new_rounded != 0 && new_rounded <= block->size - offset) {
+            block->used = offset + new_rounded;
+            arena->used = arena->used - old_rounded + new_rounded;
+            return ptr;
+        }
+    } else if (new_size <= old_size) {
+        return ptr;
+    }
+
+    void *new_ptr = string_arena_allocate(context, new_size);
+    if (!new_ptr) {
+        return NULL;
+    }
+
+    memcpy(new_ptr, ptr, old_size < new_size ? old_size : new_size);
+    return new_ptr;
+}
+
+/**
+ * @brief Arena deallocation callback
+ * @details Only the most recent allocation is given back; everything else waits for a reset
+ */
+static void string_arena_deallocate(void *context, void *ptr, size_t size) {
+    string_arena_t *arena = context;
+    (void)size;
+
+    if (ptr && ptr == arena->last) {
+        string_arena_block_t *block = arena->head;
+        size_t offset = (size_t)((unsigned char *)ptr - (unsigned char *)block->data);
+        arena->used -= block->used - offset;
+        block->used = offset;
+        arena->last = NULL;
+    }
+}
+
+/**
+ * @brief Create a new arena
+ * @param block_size Size of each memory block (default if 0)
+ * @return string_arena_t* Pointer to new arena or NULL on failure
+ * @details Blocks are allocated lazily on first use
+ */
+string_arena_t *string_arena_create(size_t block_size) {
+    string_arena_t *arena = malloc(sizeof(string_arena_t));
+    if (!arena) {
+        return NULL;
+    }
+
+    arena->allocator.allocate = string_arena_allocate;
+    arena->allocator.reallocate = string_arena_reallocate;
+    arena->allocator.deallocate = string_arena_deallocate;
+    arena->allocator.context = arena;
+    arena->head = NULL;
+    arena->block_size = string_alloc_align(block_size ? block_size : STRING_ARENA_DEFAULT_BLOCK_SIZE);
+    arena->last = NULL;
+    arena->used = 0;
+
+    return arena;
+}
+
+/**
+ * @brief Get the allocator interface of an arena
+ * @param arena Arena to query
+ * @return const string_allocator_t* Allocator bound to the arena
+ */
+const string_allocator_t *string_arena_allocator(string_arena_t *arena) {
+    return arena ? &arena->allocator : NULL;
+}
+
+/**
+ * @brief Release every allocation of an arena at once
+ * @param arena Arena to reset
+ * @details Frees all blocks but the oldest one, which is rewound for reuse
+ */
+void string_arena_reset(string_arena_t *arena) {
+    if (!arena || !arena->head) {
+        return;
+    }
+
+    string_arena_block_t *block = arena->head;
+    while (block->next) {
+        string_arena_block_t *next = block->next;
+        free(block);
+        block = next;
+    }
+
+    block->used = 0;
+    arena->head = block;
+    arena->last = NULL;
+    arena->used = 0;
+}
+
+/**
+ * @brief Get the number of bytes currently handed out by an arena
+ * @param arena Arena to query
+ * @return size_t Bytes in use
+ */
+size_t string_arena_used(const string_arena_t *arena) {
+    return arena ? arena->used : 0;
+}
+
+/**
+ * @brief Destroy an arena and all of its memory
+ * @param arena Arena to destroy
+ */
+void string_arena_destroy(string_arena_t *arena) {
+    if (!arena) {
+        return;
+    }
+
+    string_arena_block_t *block = arena->head;
+    while (block) {
+        string_arena_block_t *next = block->next;
+        free(block);
+        block = next;
+    }
+
+    free(arena);
+}
+
+/*
+ * ===============
+ * Pool functions
+ * ===============
+ */
+
+/**
+ * @brief Get the size class index for an allocation size
+ * @param size Requested size
+ * @return int Size class index, or -1 if the size is served by the heap
+ */
+static int string_pool_class(size_t size) {
+    if (size > STRING_POOL_MAX_CLASS_SIZE) {
+        return -1;
+    }
+
+    int index = 0;
+    size_t class_size = STRING_POOL_MIN_CLASS_SIZE;
+    while (class_size < size) {
+        class_size <<= 1;
+        index++;
+    }
+
+    return index;
+}
+
+/**
+ * @brief Pool allocator callback
+ * @details Pops a recycled chunk, carving a new slab when the class is exhausted
+ */
+static void *string_pool_allocate(void *context, size_t size) {
+    string_pool_t *pool = context;
+
+    int index = string_pool_class(size);
+    if (index < 0) {
+        return malloc(size);
+    }
+
+    string_pool_chunk_t *chunk = pool->free_lists[index];
+    if (chunk) {
+        pool->free_lists[index] = chunk->next;
+        return chunk;
+    }
+
+    size_t class_size = (size_t)STRING_POOL_MIN_CLASS_SIZE << index;
+    if (!pool->cursor[index] || (size_t)(pool->end[index] - pool->cursor[index]) < class_size) {
+        string_pool_slab_t *slab = malloc(sizeof(string_pool_slab_t) + STRING_POOL_SLAB_SIZE);
+        if (!slab) {
+            return NULL;
+        }
+        slab->next = pool->slabs;
+        pool->slabs = slab;
+        pool->cursor[index] = (unsigned char *)slab->data;
+        pool->end[index] = (unsigned char *)slab->data + STRING_POOL_SLAB_SIZE;
+    }
+
+    void *ptr = pool->cursor[index];
+    pool->cursor[index] += class_size;
+
+    return ptr;
+}
+
+/**
+ * @brief Pool deallocation callback
+ * @details Pushes the chunk onto its class free list
+ */
+static void string_pool_deallocate(void *context, void *ptr, size_t size) {
+    string_pool_t *pool = context;
+
+    if (!ptr) {
+        return;
+    }
+
+    int index = string_pool_class(size);
+    if (index < 0) {
+        free(ptr);
+        return;
+    }
+
+    string_pool_chunk_t *chunk = ptr;
+    chunk->next = pool->free_lists[index];
+    pool->free_lists[index] = chunk;
+}
+
+/**
+ * @brief Pool reallocation callback
+ * @details Keeps the chunk when the size class does not change
+ */
+static void *string_pool_reallocate(void *context, void *ptr, size_t old_size, size_t new_size) {
+    if (!ptr) {
+        return string_pool_allocate(context, new_size);
+    }
+
+    int old_index = string_pool_class(old_size);
+    int new_index = string_pool_class(new_size);
+    if (old_index >= 0 && old_index == new_index) {
+        return ptr;
+    }
+
+    if (old_index < 0 && new_index < 0) {
+        return realloc(ptr, new_size);
+    }
+
+    void *new_ptr = string_pool_allocate(context, new_size);
+    if (!new_ptr) {
+        return NULL;
+    }
+
+    memcpy(new_ptr, ptr, old_size < new_size ? old_size : new_size);
+    string_pool_deallocate(context, ptr, old_size);
+
+    return new_ptr;
+}
+
+/**
+ * @brief Create a new size-class pool
+ * @return string_pool_t* Pointer to new pool or NULL on failure
+ * @details Slabs are allocated lazily per size class
+ */
+string_pool_t *string_pool_create(void) {
+    string_pool_t *pool = calloc(1, sizeof(string_pool_t));
+    if (!pool) {
+        return NULL;
+    }
+
+    pool->allocator.allocate = string_pool_allocate;
+    pool->allocator.reallocate = string_pool_reallocate;
+    pool->allocator.deallocate = string_pool_deallocate;
+    pool->allocator.context = pool;
+
+    return pool;
+}
+
+/**
+ * @brief Get the allocator interface of a pool
+ * @param pool Pool to query
+ * @return const string_allocator_t* Allocator bound to the pool
+ */
+const string_allocator_t *string_pool_allocator(string_pool_t *pool) {
+    return pool ? &pool->allocator : NULL;
+}
+
+/**
+ * @brief Destroy a pool and all of its memory
+ * @param pool Pool to destroy
+ * @details Frees every slab; allocations larger than the biggest class are not tracked
+ */
+void string_pool_destroy(string_pool_t *pool) {
+    if (!pool) {
+        return;
+    }
+
+    string_pool_slab_t *slab = pool->slabs;
+    while (slab) {
+        string_pool_slab_t *next = slab->next;
+        free(slab);
+        slab = next;
+    }
+
+    free(pool);
+}
@@ -0,0 +1,101 @@
+/**
+ * @file sstring_alloc.h
+ * @brief Arena and size-class pool allocators for the safe strings library
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * This header provides allocator backends that plug into the string_allocator_t
+ * interface. The arena hands out memory by bumping a pointer and releases all of
+ * it in a single reset, which suits strings that share a lifetime (e.g. one
+ * request). The pool keeps free lists per size class so that small buffers are
+ * recycled without going back to the C library heap.
+ *
+ * Neither backend is thread-safe: bind one instance per thread with
+ * string_set_thread_allocator().
+ */
+
+#pragma once
+
+#include "sstring.h"
+
+/** @brief Default size of an arena block */
+#define STRING_ARENA_DEFAULT_BLOCK_SIZE 65536
+
+/** @brief Largest allocation served from the pool size classes */
+#define STRING_POOL_MAX_CLASS_SIZE 1024
+
+/** @brief Opaque arena allocator */
+typedef struct string_arena string_arena_t;
+
+/** @brief Opaque size-class pool allocator */
+typedef struct string_pool string_pool_t;
+
+/*
+ * ================
+ * Arena functions
+ * ================
+ */
+
+/**
+ * @brief Create a new arena
+ * @param block_size Size of each memory block (STRING_ARENA_DEFAULT_BLOCK_SIZE if 0)
+ * @return Pointer to newly created arena, or NULL on failure
+ * @details Allocations larger than the block size get a dedicated block.
+ */
+string_arena_t *string_arena_create(size_t block_size);
+
+/**
+ * @brief Get the allocator interface of an arena
+ * @param arena Arena to get the allocator of
+ * @return Allocator bound to the arena, or NULL if arena is NULL
+ */
+const string_allocator_t *string_arena_allocator(string_arena_t *arena);
+
+/**
+ * @brief Release every allocation of an arena at once
+ * @param arena Arena to reset (can be NULL)
+ * @details All strings allocated from the arena become invalid and must not be used
+ *          or destroyed afterwards. The first block is kept for reuse.
+ */
+void string_arena_reset(string_arena_t *arena);
+
+/**
+ * @brief Get the number of bytes currently handed out by an arena
+ * @param arena Arena to query
+ * @return Bytes in use (0 if arena is NULL)
+ */
+size_t string_arena_used(const string_arena_t *arena);
+
+/**
+ * @brief Destroy an arena and all of its memory
+ * @param arena Arena to destroy (can be NULL)
+ */
+void string_arena_destroy(string_arena_t *arena);
+
+/*
+ * ===============
+ * Pool functions
+ * ===============
+ */
+
+/**
+ * @brief Create a new size-class pool
+ * @return Pointer to newly created pool, or NULL on failure
+ * @details Requests up to STRING_POOL_MAX_CLASS_SIZE bytes are served from power-of-two
+ *          size classes; larger requests go to the C library heap.
+ */
+string_pool_t *string_pool_create(void);
+
+/**
+ * @brief Get the allocator interface of a pool
+ * @param pool Pool to get the allocator of
+ * @return Allocator bound to the pool, or NULL if pool is NULL
+ */
+const string_allocator_t *string_pool_allocator(string_pool_t *pool);
+
+/**
+ * @brief Destroy a pool and all of its memory
+ * @param pool Pool to destroy (can be NULL)
+ * @details Strings still allocated from the pool become invalid.
+ */
+void string_pool_destroy(string_pool_t *pool);
@@ -0,0 +1,821 @@
+/**
+ * @file sstring_array.c
+ * @brief Implementation of the contiguous string array
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * Element i occupies blob[offsets[i], offsets[i + 1]); the offsets array always
+ * holds count + 1 entries starting with 0. Offsets are 64-bit in memory and on
+ * disk, so a saved file is this exact layout preceded by a small header and
+ * mapping it only has to point the array at the right places.
+ *
+ * Sorting works on (prefix, view) pairs where the prefix holds the first eight
+ * bytes in big-endian order: most comparisons are settled by one integer
+ * compare without touching the blob.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "sstring_array.h"
+#include "sstring_io.h"
+#include "sstring_simd.h"
+
+/** @brief Number of elements allocated by the first append */
+#define STRING_ARRAY_MIN_COUNT 16
+
+/** @brief Number of blob bytes allocated by the first append */
+#define STRING_ARRAY_MIN_BYTES 256
+
+/** @brief Identifies an array file written in native byte order ("SSTRARR1") */
+#define STRING_ARRAY_FILE_MAGIC UINT64_C(0x3152524152545353)
+
+/**
+ * @brief Header of an array file, followed by the offsets and the blob
+ */
+typedef struct {
+    uint64_t magic;  /**< STRING_ARRAY_FILE_MAGIC */
+    uint64_t count;  /**< Number of elements */
+    uint64_t bytes;  /**< Size of the blob */
+} string_array_file_t;
+
+/**
+ * @brief Contiguous string array state
+ */
+struct string_array {
+    char *blob;               /**< Element bytes, back to back */
+    uint64_t *offsets;        /**< count + 1 start offsets into the blob */
+    size_t count;             /**< Number of elements */
+    size_t blob_capacity;     /**< Allocated size of the blob */
+    size_t offset_capacity;   /**< Allocated number of offsets */
+    void *mapping;            /**< File mapping backing a read-only array, or NULL */
+    size_t mapping_size;      /**< Size of the mapping */
+};
+
+/**
+ * @brief Sort key of one element
+ */
+typedef struct {
+    uint64_t prefix;      /**< First eight bytes, big-endian, zero-padded */
+    string_view_t view;   /**< Element bytes */
+} string_array_key_t;
+
+/**
+ * @brief Grow an allocation geometrically to hold a number of items
+ * @param data Pointer to the allocation (updated on success)
+ * @param capacity Pointer to the capacity in items (updated on success)
+ * @param required Number of items needed
+ * @param item_size Size of one item
+ * @param minimum Capacity of the first allocation
+ * @return bool true on success
+ */
+static bool string_array_grow(void **data, size_t *capacity, size_t required, size_t item_size, size_t minimum) {
+    if (required <= *capacity) {
+        return true;
+    }
+
+    size_t new_capacity = *capacity ? *capacity : minimum;
+    while (new_capacity < required) {
+        new_capacity = new_capacity > SIZE_MAX / 2 ? required : new_capacity * 2;
+    }
+    if (new_capacity > SIZE_MAX / item_size) {
+        return false;
+    }
+
+    void *new_data = realloc(*data, new_capacity * item_size);
+    if (!new_data) {
+        return false;
+    }
+
+    *data = new_data;
+    *capacity = new_capacity;
+
+    return true;
+}
+
+/**
+ * @brief Get the size of the blob
+ * @param array Array to query
+ * @return size_t Number of content bytes
+ */
+static size_t string_array_blob_length(const string_array_t *array) {
+    return (size_t)array->offsets[array->count];
+}
+
+/*
+ * ==========================
+ * Array lifetime functions
+ * ==========================
+ */
+
+/**
+ * @brief Create a new, empty array
+ * @return string_array_t* Pointer to new array or NULL on failure
+ */
+string_array_t *string_array_create(void) {
+    string_array_t *array = calloc(1, sizeof(string_array_t));
+    if (!array) {
+        return NULL;
+    }
+
+    array->offsets = malloc(STRING_ARRAY_MIN_COUNT * sizeof(uint64_t));
+    if (!array->offsets) {
+        free(array);
+        return NULL;
+    }
+    array->offsets[0] = 0;
+    array->offset_capacity = STRING_ARRAY_MIN_COUNT;
+
+    return array;
+}
+
+/**
+ * @brief Destroy an array
+ * @param array Array to destroy
+ */
+void string_array_destroy(string_array_t *array) {
+    if (!array) {
+        return;
+    }
+
+    if (array->mapping) {
+        munmap(array->mapping, array->mapping_size);
+    } else {
+        free(array->blob);
+        free(array->offsets);
+    }
+    free(array);
+}
+
+/**
+ * @brief Remove every element
+ * @param array Array to clear
+ * @return string_result_t Success or error code
+ */
+string_result_t string_array_clear(string_array_t *array) {
+    if (!array) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    if (array->mapping) {
+        return STRING_ERROR_READ_ONLY;
+    }
+
+    array->count = 0;
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Make room for elements without further growth
+ * @param array Array to prepare
+ * @param count Total number of elements expected
+ * @param bytes Total number of content bytes expected
+ * @return string_result_t Success or error code
+ */
+string_result_t string_array_reserve(string_array_t *array, size_t count, size_t bytes) {
+    if (!array) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    if (array->mapping) {
+        return STRING_ERROR_READ_ONLY;
+    }
+
+    if (count == SIZE_MAX ||
+        !string_array_grow((void **)&array->offsets, &array->offset_capacity, count + 1, sizeof(uint64_t), count + 1) ||
+        !string_array_grow((void **)&array->blob, &array->blob_capacity, bytes, 1, bytes)) {
+        return STRING_ERROR_OUT_OF_MEMORY;
+    }
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Get the number of elements
+ * @param array Array to query
+ * @return size_t Number of elements
+ */
+size_t string_array_count(const string_array_t *array) {
+    return array ? array->count : 0;
+}
+
+/**
+ * @brief Get the total number of content bytes
+ * @param array Array to query
+ * @return size_t Sum of the element lengths
+ */
+size_t string_array_bytes(const string_array_t *array) {
+    return array ? string_array_blob_length(array) : 0;
+}
+
+/*
+ * ==============================
+ * Array modification functions
+ * ==============================
+ */
+
+/**
+ * @brief Append an element
+ * @param array Array to append to
+ * @param view Content of the element
+ * @return string_result_t Success or error code
+ * @details A view into the blob is rebased if growing the blob moves it
+ */
+string_result_t string_array_append(string_array_t *array, string_view_t view) {
+    if (!array) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    if (!view.data && view.length > 0) {
+        return STRING_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (array->mapping) {
+        return STRING_ERROR_READ_ONLY;
+    }
+
+    size_t length = string_array_blob_length(array);
+    if (view.length > SIZE_MAX - length) {
+        return STRING_ERROR_OUT_OF_MEMORY;
+    }
+
+    bool is_self = array->blob && view.data >= array->blob && view.data < array->blob + length;
+    size_t self_offset = is_self ? (size_t)(view.data - array->blob) : 0;
+
+    if (!string_array_grow((void **)&array->offsets, &array->offset_capacity, array->count + 2, sizeof(uint64_t),
+                           STRING_ARRAY_MIN_COUNT) ||
+        !string_array_grow((void **)&array->blob, &array->blob_capacity, length + view.length, 1,
+                           STRING_ARRAY_MIN_BYTES)) {
+        return STRING_ERROR_OUT_OF_MEMORY;
+    }
+
+    if (view.length > 0) {
+        memcpy(array->blob + length, is_self ? array->blob + self_offset : view.data, view.length);
+    }
+    array->count++;
+    array->offsets[array->count] = (uint64_t)(length + view.length);
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Append a C string as an element
+ * @param array Array to append to
+ * @param cstr Content of the element
+ * @return string_result_t Success or error code
+ */
+string_result_t string_array_append_cstr(string_array_t *array, const char *cstr) {
+    if (!cstr) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    return string_array_append(array, string_view_from_cstr(cstr));
+}
+
+/**
+ * @brief Append the content of a string as an element
+ * @param array Array to append to
+ * @param str Content of the element
+ * @return string_result_t Success or error code
+ */
+string_result_t string_array_append_string(string_array_t *array, const string_t *str) {
+    if (!str) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    return string_array_append(array, string_view_from_string(str));
+}
+
+/**
+ * @brief Compare two sort keys
+ * @param a First key
+ * @param b Second key
+ * @return int Negative, zero or positive as for string_view_compare()
+ * @details Equal prefixes of elements shorter than eight bytes can hide a
+ *          difference only in length, which the full comparison resolves
+ */
+static int string_array_key_compare(const void *a, const void *b) {
+    const string_array_key_t *key1 = a;
+    const string_array_key_t *key2 = b;
+
+    if (key1->prefix != key2->prefix) {
+        return key1->prefix < key2->prefix ? -1 : 1;
+    }
+
+    return string_view_compare(key1->view, key2->view);
+}
+
+/**
+ * @brief Sort the elements in byte order
+ * @param array Array to sort
+ * @return string_result_t Success or error code
+ * @details Sorts keys with qsort(), then copies the elements into a new blob in
+ *          sorted order and swaps it in
+ */
+string_result_t string_array_sort(string_array_t *array) {
+    if (!array) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    if (array->mapping) {
+        return STRING_ERROR_READ_ONLY;
+    }
+
+    if (array->count < 2) {
+        return STRING_SUCCESS;
+    }
+
+    if (array->count > SIZE_MAX / sizeof(string_array_key_t)) {
+        return STRING_ERROR_OUT_OF_MEMORY;
+    }
+
+    size_t length = string_array_blob_length(array);
+    string_array_key_t *keys = malloc(array->count * sizeof(string_array_key_t));
+    char *blob = malloc(length ? length : 1);
+    if (!keys || !blob) {
+        free(keys);
+        free(blob);
+        return STRING_ERROR_OUT_OF_MEMORY;
+    }
+
+    for (size_t i = 0; i < array->count; ++i) {
+        string_view_t view = string_array_at(array, i);
+        uint64_t prefix = 0;
+        for (size_t j = 0; j < 8; ++j) {
+            prefix = prefix << 8 | (j < view.length ? (unsigned char)view.data[j] : 0u);
+        }
+        keys[i].prefix = prefix;
+        keys[i].view = view;
+    }
+
+    qsort(keys, array->count, sizeof(string_array_key_t), string_array_key_compare);
+
+    size_t position = 0;
+    for (size_t i = 0; i < array->count; ++i) {
+        if (keys[i].view.length > 0) {
+            memcpy(blob + position, keys[i].view.data, keys[i].view.length);
+        }
+        position += keys[i].view.length;
+        array->offsets[i + 1] = (uint64_t)position;
+    }
+
+    free(keys);
+    free(array->blob);
+    array->blob = blob;
+    array->blob_capacity = length ? length : 1;
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Remove consecutive duplicate elements
+ * @param array Array to compact
+ * @param removed Receives the number of elements removed (optional)
+ * @return string_result_t Success or error code
+ * @details Kept elements only move towards the front, so the blob and the
+ *          offsets are compacted in a single forward pass
+ */
+string_result_t string_array_unique(string_array_t *array, size_t *removed) {
+    if (removed) {
+        *removed = 0;
+    }
+
+    if (!array) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    if (array->mapping) {
+        return STRING_ERROR_READ_ONLY;
+    }
+
+    if (array->count < 2) {
+        return STRING_SUCCESS;
+    }
+
+    size_t kept = 1;
+    size_t kept_start = 0;
+    size_t kept_end = (size_t)array->offsets[1];
+    for (size_t i = 1; i < array->count; ++i) {
+        size_t start = (size_t)array->offsets[i];
+        size_t end = (size_t)array->offsets[i + 1];
+        size_t length = end - start;
+
+        if (length == kept_end - kept_start && memcmp(array->blob + start, array->blob + kept_start, length) == 0) {
+            continue;
+        }
+
+        if (start != kept_end && length > 0) {
+            memmove(array->blob + kept_end, array->blob + start, length);
+        }
+        kept_start = kept_end;
+        kept_end += length;
+        array->offsets[++kept] = (uint64_t)kept_end;
+    }
+
+    if (removed) {
+        *removed = array->count - kept;
+    }
+    array->count = kept;
+
+    return STRING_SUCCESS;
+}
+
+/*
+ * ========================
+ * Array access functions
+ * ========================
+ */
+
+/**
+ * @brief Get an element
+ * @param array Array to read
+ * @param index Index of the element
+ * @return string_view_t View of the element, empty if out of range
+ */
+string_view_t string_array_at(const string_array_t *array, size_t index) {
+    if (!array || index >= array->count) {
+        return string_view_from_buffer("", 0);
+    }
+
+    size_t start = (size_t)array->offsets[index];
+    return string_view_from_buffer(array->blob + start, (size_t)array->offsets[index + 1] - start);
+}
+
+/**
+ * @brief Find the first element equal to some bytes
+ * @param array Array to search
+ * @param view Content to look for
+ * @param start_index Index to start searching from
+ * @return size_t Index of the element or STRING_NPOS
+ * @details Compares lengths from the offsets first, so only elements of the
+ *          right length have their bytes read
+ */
+size_t string_array_find(const string_array_t *array, string_view_t view, size_t start_index) {
+    if (!array || (!view.data && view.length > 0)) {
+        return STRING_NPOS;
+    }
+
+    for (size_t i = start_index; i < array->count; ++i) {
+        size_t start = (size_t)array->offsets[i];
+        if ((size_t)array->offsets[i + 1] - start == view.length &&
+            (view.length == 0 || memcmp(array->blob + start, view.data, view.length) == 0)) {
+            return i;
+        }
+    }
+
+    return STRING_NPOS;
+}
+
+/**
+ * @brief Find an element in a sorted array by binary search
+ * @param array Array sorted in byte order
+ * @param view Content to look for
+ * @return size_t Index of an equal element or STRING_NPOS
+ */
+size_t string_array_search_sorted(const string_array_t *array, string_view_t view) {
+    if (!array || (!view.data && view.length > 0)) {
+        return STRING_NPOS;
+    }
+
+    size_t low = 0;
+    size_t high = array->count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        int result = string_view_compare(string_array_at(array, middle), view);
+        if (result == 0) {
+            return middle;
+        }
+        if (result < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return STRING_NPOS;
+}
+
+/*
+ * ======================
+ * Array batch functions
+ * ======================
+ */
+
+/**
+ * @brief Convert the ASCII letters of every element to one case
+ * @param array Array to convert
+ * @param upper Convert to uppercase (true) or lowercase (false)
+ * @return string_result_t Success or error code
+ */
+static string_result_t string_array_case(string_array_t *array, bool upper) {
+    if (!array) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    if (array->mapping) {
+        return STRING_ERROR_READ_ONLY;
+    }
+
+    size_t length = string_array_blob_length(array);
+    if (length > 0) {
+        string_simd_ascii_case(array->blob, length, upper);
+    }
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Convert every element to lowercase
+ * @param array Array to convert
+ * @return string_result_t Success or error code
+ */
+string_result_t string_array_to_lower(string_array_t *array) {
+    return string_array_case(array, false);
+}
+
+/**
+ * @brief Convert every element to uppercase
+ * @param array Array to convert
+ * @return string_result_t Success or error code
+ */
+string_result_t string_array_to_upper(string_array_t *array) {
+    return string_array_case(array, true);
+}
+
+/**
+ * @brief Compare every element against one key
+ * @param array Array to compare
+ * @param view Bytes to compare against
+ * @param matches Receives the result for each element (can be NULL)
+ * @return size_t Number of equal elements
+ */
+size_t string_array_count_equal(const string_array_t *array, string_view_t view, bool *matches) {
+    if (!array) {
+        return 0;
+    }
+
+    bool is_valid = view.data || view.length == 0;
+    size_t equal = 0;
+    for (size_t i = 0; i < array->count; ++i) {
+        size_t start = (size_t)array->offsets[i];
+        bool match = is_valid && (size_t)array->offsets[i + 1] - start == view.length &&
+                     (view.length == 0 || memcmp(array->blob + start, view.data, view.length) == 0);
+        equal += match;
+        if (matches) {
+            matches[i] = match;
+        }
+    }
+
+    return equal;
+}
+
+/**
+ * @brief Find the first element that contains a byte
+ * @param array Array to search
+ * @param c Byte to search for
+ * @param start_index Index to start searching from
+ * @param position Receives the offset of the byte in that element (can be NULL)
+ * @return size_t Index of the element or STRING_NPOS
+ * @details Empty elements own no bytes, so the match lies in the last element
+ *          whose offset is not past it.
+ */
+size_t string_array_find_char(const string_array_t *array, char c, size_t start_index, size_t *position) {
+    if (!array || start_index >= array->count) {
+        return STRING_NPOS;
+    }
+
+    size_t start = (size_t)array->offsets[start_index];
+    size_t length = string_array_blob_length(array);
+    if (start == length) {
+        return STRING_NPOS;
+    }
+
+    size_t found = string_simd_find_byte(array->blob + start, length - start, c);
+    if (found == STRING_NPOS) {
+        return STRING_NPOS;
+    }
+
+    // First offset past the match, among offsets[start_index + 1 .. count]
+    size_t offset = start + found;
+    size_t low = start_index + 1;
+    size_t high = array->count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if ((size_t)array->offsets[middle] > offset) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+
+    size_t index = low - 1;
+    if (position) {
+        *position = offset - (size_t)array->offsets[index];
+    }
+
+    return index;
+}
+
+/**
+ * @brief Append every element to a string, separated by a separator
+ * @param array Array to join
+ * @param dest Destination string
+ * @param separator Separator placed between consecutive elements
+ * @return string_result_t Success or error code
+ * @details The separator may point into dest; it is rebased once the room is reserved.
+ */
+string_result_t string_array_join(const string_array_t *array, string_t *dest, string_view_t separator) {
+    if (!array || !dest) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    if (!separator.data && separator.length > 0) {
+        return STRING_ERROR_INVALID_ARGUMENT;
+    }
+
+    size_t length = string_array_blob_length(array);
+    if (separator.length == 0 || array->count < 2) {
+        return string_append_buffer(dest, array->blob, length);
+    }
+
+    size_t separators = array->count - 1;
+    if (separator.length > (SIZE_MAX - length) / separators) {
+        return STRING_ERROR_OUT_OF_MEMORY;
+    }
+    size_t total = length + separator.length * separators;
+
+    const char *old_data = string_cstr(dest);
+    size_t old_length = string_length(dest);
+    bool is_self = separator.data >= old_data && separator.data < old_data + old_length;
+    size_t self_offset = is_self ? (size_t)(separator.data - old_data) : 0;
+
+    char *out = NULL;
+    size_t available = 0;
+    string_result_t result = string_reserve_spare(dest, total, &out, &available);
+    if (result != STRING_SUCCESS) {
+        return result;
+    }
+    if (is_self) {
+        separator.data = string_cstr(dest) + self_offset;
+    }
+
+    for (size_t i = 0; i < array->count; ++i) {
+        if (i > 0) {
+            memcpy(out, separator.data, separator.length);
+            out += separator.length;
+        }
+        size_t start = (size_t)array->offsets[i];
+        size_t size = (size_t)array->offsets[i + 1] - start;
+        if (size > 0) {
+            memcpy(out, array->blob + start, size);
+            out += size;
+        }
+    }
+
+    return string_commit_spare(dest, total);
+}
+
+/*
+ * =============================
+ * Array persistence functions
+ * =============================
+ */
+
+/**
+ * @brief Write an array to a file in its mappable format
+ * @param array Array to save
+ * @param path Path of the file
+ * @return string_result_t Success or error code
+ * @details Header, offsets and blob are written as they are in memory
+ */
+string_result_t string_array_save(const string_array_t *array, const char *path) {
+    if (!array || !path) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    FILE *file = fopen(path, "wb");
+    if (!file) {
+        return STRING_ERROR_IO;
+    }
+
+    size_t length = string_array_blob_length(array);
+    string_array_file_t header = { STRING_ARRAY_FILE_MAGIC, (uint64_t)array->count, (uint64_t)length };
+    bool is_written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                      fwrite(array->offsets, sizeof(uint64_t), array->count + 1, file) == array->count + 1 &&
+                      (length == 0 || fwrite(array->blob, 1, length, file) == length);
+
+    if (fclose(file) != 0 || !is_written) {
+        return STRING_ERROR_IO;
+    }
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Check the layout of a mapped array file
+ * @param data Start of the mapping
+ * @param size Size of the mapping
+ * @return bool true if the header matches the size and the offsets are monotonic
+ *         and within the blob
+ */
+static bool string_array_validate(const char *data, size_t size) {
+    if (size < sizeof(string_array_file_t) + sizeof(uint64_t)) {
+        return false;
+    }
+
+    string_array_file_t header;
+    memcpy(&header, data, sizeof(header));
+    size_t space = size - sizeof(string_array_file_t);
+    if (header.magic != STRING_ARRAY_FILE_MAGIC || header.count >= space / sizeof(uint64_t) ||
+        header.bytes != space - (header.count + 1) * sizeof(uint64_t)) {
+        return false;
+    }
+
+    const uint64_t *offsets = (const uint64_t *)(const void *)(data + sizeof(string_array_file_t));
+    if (offsets[0] != 0 || offsets[header.count] != header.bytes) {
+        return false;
+    }
+    for (uint64_t i = 0; i < header.count; ++i) {
+        if (offsets[i] > offsets[i + 1]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Map a file written by string_array_save() as a read-only array
+ * @param path Path of the file
+ * @param array Receives the mapped array
+ * @return string_result_t Success or error code
+ */
+string_result_t string_array_map_file(const char *path, string_array_t **array) {
+    if (!path || !array) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+    *array = NULL;
+
+    int fd = string_open_file(path);
+    if (fd < 0) {
+        return STRING_ERROR_IO;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        int saved_errno = errno;
+        close(fd);
+        errno = saved_errno;
+        return STRING_ERROR_IO;
+    }
+    if (info.st_size < (off_t)(sizeof(string_array_file_t) + sizeof(uint64_t)) ||
+        (uintmax_t)info.st_size > SIZE_MAX) {
+        close(fd);
+        return STRING_ERROR_INVALID_ARGUMENT;
+    }
+
+    size_t size = (size_t)info.st_size;
+    void *mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    int saved_errno = errno;
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        errno = saved_errno;
+        return STRING_ERROR_IO;
+    }
+
+    if (!string_array_validate(mapping, size)) {
+        munmap(mapping, size);
+        return STRING_ERROR_INVALID_ARGUMENT;
+    }
+
+    string_array_t *mapped = calloc(1, sizeof(string_array_t));
+    if (!mapped) {
+        munmap(mapping, size);
+        return STRING_ERROR_OUT_OF_MEMORY;
+    }
+
+    string_array_file_t header;
+    memcpy(&header, mapping, sizeof(header));
+    mapped->count = (size_t)header.count;
+    mapped->offsets = (uint64_t *)(void *)((char *)mapping + sizeof(string_array_file_t));
+    mapped->blob = (char *)(mapped->offsets + mapped->count + 1);
+    mapped->mapping = mapping;
+    mapped->mapping_size = size;
+    *array = mapped;
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Check whether an array is backed by a read-only file mapping
+ * @param array Array to query
+ * @return bool true for mapped arrays
+ */
+bool string_array_is_mapped(const string_array_t *array) {
+    return array && array->mapping != NULL;
+}
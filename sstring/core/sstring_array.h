@@ -0,0 +1,249 @@
+/**
+ * @file sstring_array.h
+ * @brief Contiguous string array for the safe strings library
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * This header provides a container for large numbers of strings stored in
+ * columnar form: the bytes of every element live back to back in one blob and
+ * an offsets array records where each element starts, as in Apache Arrow.
+ * A million short strings therefore take two allocations instead of two
+ * million, and scanning them walks memory sequentially.
+ *
+ * Elements are accessed as string_view_t, so every string_view_* function
+ * (compare, find, hash) works on them directly. Views point into the blob and
+ * stay valid until the array is modified or destroyed.
+ *
+ * An array can be saved to a file and mapped back read-only with mmap(), in
+ * which case loading costs no copy and no parsing beyond a bounds check of the
+ * offsets. Mapped arrays reject modification with STRING_ERROR_READ_ONLY. The
+ * file uses native byte order, so it is not portable between architectures of
+ * different endianness. An array is not thread-safe while it is modified.
+ */
+
+#pragma once
+
+#include "sstring.h"
+
+/** @brief Opaque contiguous string array */
+typedef struct string_array string_array_t;
+
+/*
+ * ==========================
+ * Array lifetime functions
+ * ==========================
+ */
+
+/**
+ * @brief Create a new, empty array
+ * @return Pointer to newly created array, or NULL on failure
+ */
+string_array_t *string_array_create(void);
+
+/**
+ * @brief Destroy an array, unmapping it if it was mapped
+ * @param array Array to destroy (can be NULL)
+ */
+void string_array_destroy(string_array_t *array);
+
+/**
+ * @brief Remove every element, keeping the storage allocated
+ * @param array Array to clear
+ * @return STRING_SUCCESS on success, error code on failure
+ */
+string_result_t string_array_clear(string_array_t *array);
+
+/**
+ * @brief Make room for elements without further growth
+ * @param array Array to prepare
+ * @param count Total number of elements expected
+ * @param bytes Total number of content bytes expected
+ * @return STRING_SUCCESS on success, error code on failure
+ */
+string_result_t string_array_reserve(string_array_t *array, size_t count, size_t bytes);
+
+/**
+ * @brief Get the number of elements
+ * @param array Array to query
+ * @return Number of elements (0 for NULL)
+ */
+size_t string_array_count(const string_array_t *array);
+
+/**
+ * @brief Get the total number of content bytes
+ * @param array Array to query
+ * @return Sum of the element lengths (0 for NULL)
+ */
+size_t string_array_bytes(const string_array_t *array);
+
+/*
+ * ==============================
+ * Array modification functions
+ * ==============================
+ */
+
+/**
+ * @brief Append an element
+ * @param array Array to append to
+ * @param view Content of the element (may point into this array)
+ * @return STRING_SUCCESS on success, error code on failure
+ */
+string_result_t string_array_append(string_array_t *array, string_view_t view);
+
+/**
+ * @brief Append a C string as an element
+ * @param array Array to append to
+ * @param cstr Content of the element (null-terminated)
+ * @return STRING_SUCCESS on success, error code on failure
+ */
+string_result_t string_array_append_cstr(string_array_t *array, const char *cstr);
+
+/**
+ * @brief Append the content of a string as an element
+ * @param array Array to append to
+ * @param str Content of the element
+ * @return STRING_SUCCESS on success, error code on failure
+ */
+string_result_t string_array_append_string(string_array_t *array, const string_t *str);
+
+/**
+ * @brief Sort the elements in byte order
+ * @param array Array to sort
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Orders elements as string_view_compare() does and rewrites the blob
+ *          in the new order, so sorted elements are also adjacent in memory.
+ *          The sort is not stable, which only matters for equal elements.
+ */
+string_result_t string_array_sort(string_array_t *array);
+
+/**
+ * @brief Remove consecutive duplicate elements
+ * @param array Array to compact
+ * @param removed Receives the number of elements removed (can be NULL)
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Keeps the first of each run of equal elements, in place. Call
+ *          string_array_sort() first to remove every duplicate.
+ */
+string_result_t string_array_unique(string_array_t *array, size_t *removed);
+
+/*
+ * ========================
+ * Array access functions
+ * ========================
+ */
+
+/**
+ * @brief Get an element
+ * @param array Array to read
+ * @param index Index of the element
+ * @return View of the element, or an empty view if the index is out of range
+ */
+string_view_t string_array_at(const string_array_t *array, size_t index);
+
+/**
+ * @brief Find the first element equal to some bytes
+ * @param array Array to search
+ * @param view Content to look for
+ * @param start_index Index to start searching from
+ * @return Index of the element, or STRING_NPOS if not found
+ */
+size_t string_array_find(const string_array_t *array, string_view_t view, size_t start_index);
+
+/**
+ * @brief Find an element in a sorted array by binary search
+ * @param array Array sorted with string_array_sort()
+ * @param view Content to look for
+ * @return Index of an equal element, or STRING_NPOS if not found
+ */
+size_t string_array_search_sorted(const string_array_t *array, string_view_t view);
+
+/*
+ * ======================
+ * Array batch functions
+ * ======================
+ */
+
+/**
+ * @brief Convert every element to lowercase
+ * @param array Array to convert
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details One vectorized pass over the blob, across element boundaries. Only
+ *          ASCII letters change, so element lengths are kept; a sorted array may
+ *          need sorting again.
+ */
+string_result_t string_array_to_lower(string_array_t *array);
+
+/**
+ * @brief Convert every element to uppercase
+ * @param array Array to convert
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details One vectorized pass over the blob, like string_array_to_lower().
+ */
+string_result_t string_array_to_upper(string_array_t *array);
+
+/**
+ * @brief Compare every element against one key
+ * @param array Array to compare
+ * @param view Bytes to compare against
+ * @param matches Receives true or false for each element (can be NULL)
+ * @return Number of elements equal to the key
+ * @details Element lengths come from the offsets, so only same-length elements
+ *          touch the blob.
+ */
+size_t string_array_count_equal(const string_array_t *array, string_view_t view, bool *matches);
+
+/**
+ * @brief Find the first element that contains a byte
+ * @param array Array to search
+ * @param c Byte to search for
+ * @param start_index Index to start searching from
+ * @param position Receives the offset of the byte in that element (can be NULL)
+ * @return Index of the element, or STRING_NPOS if not found
+ * @details Scans the blob in one vectorized pass across element boundaries and
+ *          maps the match back to its element by binary search of the offsets.
+ */
+size_t string_array_find_char(const string_array_t *array, char c, size_t start_index, size_t *position);
+
+/**
+ * @brief Append every element to a string, separated by a separator
+ * @param array Array to join
+ * @param dest Destination string
+ * @param separator Separator placed between consecutive elements (may be empty)
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details The destination grows once; with an empty separator the blob is
+ *          copied in a single append. Use string_array_bytes() for the total length.
+ */
+string_result_t string_array_join(const string_array_t *array, string_t *dest, string_view_t separator);
+
+/*
+ * =============================
+ * Array persistence functions
+ * =============================
+ */
+
+/**
+ * @brief Write an array to a file in its mappable format
+ * @param array Array to save
+ * @param path Path of the file to create or truncate
+ * @return STRING_SUCCESS on success, error code on failure
+ */
+string_result_t string_array_save(const string_array_t *array, const char *path);
+
+/**
+ * @brief Map a file written by string_array_save() as a read-only array
+ * @param path Path of the file
+ * @param array Receives the mapped array, to be released with string_array_destroy()
+ * @return STRING_SUCCESS on success, STRING_ERROR_IO if the file cannot be
+ *         opened or mapped (errno holds the cause), STRING_ERROR_INVALID_ARGUMENT
+ *         if it is not a valid array file
+ * @details Only the offsets are inspected up front; element bytes are paged in
+ *          by the kernel as they are accessed.
+ */
+string_result_t string_array_map_file(const char *path, string_array_t **array);
+
+/**
+ * @brief Check whether an array is backed by a read-only file mapping
+ * @param array Array to query
+ * @return true for arrays loaded with string_array_map_file()
+ */
+bool string_array_is_mapped(const string_array_t *array);
@@ -0,0 +1,582 @@
+/**
+ * @file sstring_buffer.c
+ * @brief Implementation of the concurrent append buffer
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * A segment's used counter only ever grows. An append owns [old, old + length)
+ * if that range fits; the one append whose range crosses the end records its
+ * start in sealed, so the segment's content is [0, min(used, sealed)) once it
+ * is full. The writer that fails then chains a new segment under the shard lock,
+ * with its own bytes already reserved so it cannot lose the race again.
+ *
+ * Taking a batch has to know that no writer still holds a pointer to the old
+ * segments. Writers announce themselves in one of two counters per shard,
+ * chosen by the parity of a buffer-wide epoch: the consumer unhooks the
+ * segments, bumps the epoch and waits for the old parity's counters to drain.
+ * Writers arriving later see the new epoch and the new (empty) segment lists.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+#include "sstring_buffer.h"
+
+/** @brief Size shards are aligned to, so that writers on different shards do not share cache lines */
+#define STRING_BUFFER_CACHE_LINE 64
+
+/**
+ * @brief Segment of appended bytes
+ */
+typedef struct string_buffer_segment {
+    struct string_buffer_segment *next;  /**< Next segment of the shard or batch */
+    size_t capacity;                     /**< Size of data */
+    atomic_size_t used;                  /**< Bytes reserved, can run past capacity */
+    atomic_size_t sealed;                /**< Start of the append that did not fit, or capacity */
+    char data[];                         /**< Appended bytes */
+} string_buffer_segment_t;
+
+/**
+ * @brief Independent part of a buffer used by a subset of the threads
+ */
+typedef struct {
+    _Alignas(STRING_BUFFER_CACHE_LINE) _Atomic(string_buffer_segment_t *) current;  /**< Segment appends go to */
+    atomic_size_t writers[2];              /**< Appends in progress, by epoch parity */
+    pthread_mutex_t lock;                  /**< Protects the list below and chaining segments */
+    string_buffer_segment_t *head;         /**< Oldest segment */
+    string_buffer_segment_t *tail;         /**< Newest segment */
+} string_buffer_shard_t;
+
+/**
+ * @brief Concurrent append buffer state
+ */
+struct string_buffer {
+    string_buffer_shard_t *shards;  /**< Shards, each on its own cache lines */
+    size_t shard_count;             /**< Number of shards */
+    size_t segment_size;            /**< Capacity of a regular segment */
+    atomic_size_t epoch;            /**< Incremented by every take */
+    pthread_mutex_t take_lock;      /**< Serializes consumers */
+};
+
+/**
+ * @brief Segments taken from a buffer
+ */
+struct string_buffer_batch {
+    string_buffer_segment_t *segments;  /**< Taken segments, in batch order */
+    size_t count;                       /**< Number of views */
+    size_t bytes;                       /**< Sum of the view lengths */
+    string_view_t views[];              /**< Content of the non-empty segments */
+};
+
+/** @brief Source of shard slots handed to threads on their first append */
+static atomic_size_t string_buffer_next_slot = 1;
+
+/** @brief Shard slot of the calling thread, 0 until its first append */
+static _Thread_local size_t string_buffer_slot = 0;
+
+/*
+ * ===========================
+ * Buffer internal functions
+ * ===========================
+ */
+
+/**
+ * @brief Get the content length of a segment that no writer is using
+ * @param segment Segment to measure
+ * @return size_t Number of valid bytes at the start of the segment
+ */
+static size_t string_buffer_segment_length(const string_buffer_segment_t *segment) {
+    size_t used = atomic_load_explicit(&segment->used, memory_order_relaxed);
+    size_t sealed = atomic_load_explicit(&segment->sealed, memory_order_relaxed);
+    return used < sealed ? used : sealed;
+}
+
+/**
+ * @brief Free a list of segments
+ * @param segment First segment of the list (can be NULL)
+ */
+static void string_buffer_free_segments(string_buffer_segment_t *segment) {
+    while (segment) {
+        string_buffer_segment_t *next = segment->next;
+        free(segment);
+        segment = next;
+    }
+}
+
+/**
+ * @brief Chain a new segment to a shard whose current segment is full
+ * @param buffer Buffer the shard belongs to
+ * @param shard Shard to extend
+ * @param full Segment the caller failed to append to (NULL for an empty shard)
+ * @param length Length of the caller's append, reserved in the new segment
+ * @param segment Receives the segment to write to
+ * @param offset Receives the offset of the caller's bytes in it
+ * @return string_result_t Success or error code
+ * @details If another writer already replaced the full segment, the caller
+ *          retries on that one instead.
+ */
+static string_result_t string_buffer_extend(string_buffer_t *buffer, string_buffer_shard_t *shard, string_buffer_segment_t *full,
+                                            size_t length, string_buffer_segment_t **segment, size_t *offset) {
+    pthread_mutex_lock(&shard->lock);
+
+    string_buffer_segment_t *current = atomic_load_explicit(&shard->current, memory_order_relaxed);
+    if (current != full) {
+        pthread_mutex_unlock(&shard->lock);
+        *segment = current;
+        *offset = STRING_NPOS;
+        return STRING_SUCCESS;
+    }
+
+    size_t capacity = length > buffer->segment_size ? length : buffer->segment_size;
+    if (capacity > SIZE_MAX - sizeof(string_buffer_segment_t)) {
+        pthread_mutex_unlock(&shard->lock);
+        return STRING_ERROR_OUT_OF_MEMORY;
+    }
+
+    string_buffer_segment_t *created = malloc(sizeof(string_buffer_segment_t) + capacity);
+    if (!created) {
+        pthread_mutex_unlock(&shard->lock);
+        return STRING_ERROR_OUT_OF_MEMORY;
+    }
+    created->next = NULL;
+    created->capacity = capacity;
+    atomic_init(&created->used, length);
+    atomic_init(&created->sealed, capacity);
+
+    if (shard->tail) {
+        shard->tail->next = created;
+    } else {
+        shard->head = created;
+    }
+    shard->tail = created;
+    atomic_store_explicit(&shard->current, created, memory_order_release);
+
+    pthread_mutex_unlock(&shard->lock);
+
+    *segment = created;
+    *offset = 0;
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Announce an append on a shard for the current epoch
+ * @param buffer Buffer being appended to
+ * @param shard Shard of the calling thread
+ * @return atomic_size_t* Counter to decrement when the append is done
+ */
+static atomic_size_t *string_buffer_enter(string_buffer_t *buffer, string_buffer_shard_t *shard) {
+    for (;;) {
+        size_t epoch = atomic_load(&buffer->epoch);
+        atomic_size_t *writers = &shard->writers[epoch & 1];
+        atomic_fetch_add(writers, 1);
+
+        // A take that started in between waits on the other counter
+        if (atomic_load(&buffer->epoch) == epoch) {
+            return writers;
+        }
+        atomic_fetch_sub_explicit(writers, 1, memory_order_release);
+    }
+}
+
+/**
+ * @brief Put taken segments back in front of a buffer's first shard
+ * @param buffer Buffer to restore into
+ * @param segments Segments to restore (can be NULL)
+ * @details Used when a take cannot complete. Every thread's appends stay in
+ *          order because earlier shards come first in the next batch.
+ */
+static void string_buffer_restore(string_buffer_t *buffer, string_buffer_segment_t *segments) {
+    if (!segments) {
+        return;
+    }
+
+    string_buffer_segment_t *last = segments;
+    while (last->next) {
+        last = last->next;
+    }
+
+    string_buffer_shard_t *shard = &buffer->shards[0];
+    pthread_mutex_lock(&shard->lock);
+    last->next = shard->head;
+    shard->head = segments;
+    if (!shard->tail) {
+        shard->tail = last;
+    }
+    pthread_mutex_unlock(&shard->lock);
+}
+
+/*
+ * ===========================
+ * Buffer lifetime functions
+ * ===========================
+ */
+
+/**
+ * @brief Create a new, empty buffer
+ * @param shard_count Number of shards (0 selects the number of online processors)
+ * @param segment_size Size of each segment (0 selects STRING_BUFFER_DEFAULT_SEGMENT)
+ * @return string_buffer_t* Pointer to newly created buffer, or NULL on failure
+ */
+string_buffer_t *string_buffer_create(size_t shard_count, size_t segment_size) {
+    if (shard_count == 0) {
+#ifdef _SC_NPROCESSORS_ONLN
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        shard_count = online > 0 ? (size_t)online : 1;
+#else
+        shard_count = 1;
+#endif
+    }
+
+    if (shard_count > SIZE_MAX / sizeof(string_buffer_shard_t)) {
+        return NULL;
+    }
+
+    string_buffer_t *buffer = calloc(1, sizeof(string_buffer_t));
+    if (!buffer) {
+        return NULL;
+    }
+
+    buffer->shards = aligned_alloc(STRING_BUFFER_CACHE_LINE, shard_count * sizeof(string_buffer_shard_t));
+    if (!buffer->shards) {
+        free(buffer);
+        return NULL;
+    }
+
+    buffer->shard_count = shard_count;
+    buffer->segment_size = segment_size ? segment_size : STRING_BUFFER_DEFAULT_SEGMENT;
+    atomic_init(&buffer->epoch, 0);
+    pthread_mutex_init(&buffer->take_lock, NULL);
+
+    for (size_t i = 0; i < shard_count; ++i) {
+        string_buffer_shard_t *shard = &buffer->shards[i];
+        atomic_init(&shard->current, NULL);
+        atomic_init(&shard->writers[0], 0);
+        atomic_init(&shard->writers[1], 0);
+        pthread_mutex_init(&shard->lock, NULL);
+        shard->head = NULL;
+        shard->tail = NULL;
+    }
+
+    return buffer;
+}
+
+/**
+ * @brief Destroy a buffer and everything still in it
+ * @param buffer Buffer to destroy (can be NULL)
+ */
+void string_buffer_destroy(string_buffer_t *buffer) {
+    if (!buffer) {
+        return;
+    }
+
+    for (size_t i = 0; i < buffer->shard_count; ++i) {
+        string_buffer_free_segments(buffer->shards[i].head);
+        pthread_mutex_destroy(&buffer->shards[i].lock);
+    }
+
+    pthread_mutex_destroy(&buffer->take_lock);
+    free(buffer->shards);
+    free(buffer);
+}
+
+/*
+ * =========================
+ * Buffer append functions
+ * =========================
+ */
+
+/**
+ * @brief Append bytes to a buffer
+ * @param buffer Buffer to append to
+ * @param view Bytes to append
+ * @return string_result_t Success or error code
+ * @details The fast path is one fetch-add on the shard's segment and a copy;
+ *          the shard lock is only taken when the segment is full.
+ */
+string_result_t string_buffer_append(string_buffer_t *buffer, string_view_t view) {
+    if (!buffer) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    if (!view.data && view.length > 0) {
+        return STRING_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (view.length == 0) {
+        return STRING_SUCCESS;
+    }
+
+    if (string_buffer_slot == 0) {
+        string_buffer_slot = atomic_fetch_add_explicit(&string_buffer_next_slot, 1, memory_order_relaxed);
+    }
+    string_buffer_shard_t *shard = &buffer->shards[string_buffer_slot % buffer->shard_count];
+
+    atomic_size_t *writers = string_buffer_enter(buffer, shard);
+    string_result_t result = STRING_SUCCESS;
+
+    string_buffer_segment_t *segment = atomic_load_explicit(&shard->current, memory_order_acquire);
+    size_t offset = STRING_NPOS;
+    while (offset == STRING_NPOS) {
+        if (segment) {
+            size_t old = atomic_fetch_add_explicit(&segment->used, view.length, memory_order_relaxed);
+            if (old < segment->capacity && view.length <= segment->capacity - old) {
+                offset = old;
+                break;
+            }
+
+            // This append crossed the end: the segment's content stops here
+            if (old < segment->capacity) {
+                atomic_store_explicit(&segment->sealed, old, memory_order_relaxed);
+            }
+        }
+
+        result = string_buffer_extend(buffer, shard, segment, view.length, &segment, &offset);
+        if (result != STRING_SUCCESS) {
+            break;
+        }
+    }
+
+    if (result == STRING_SUCCESS) {
+        memcpy(segment->data + offset, view.data, view.length);
+    }
+
+    atomic_fetch_sub_explicit(writers, 1, memory_order_release);
+
+    return result;
+}
+
+/**
+ * @brief Append a C string to a buffer
+ * @param buffer Buffer to append to
+ * @param cstr C string to append (null-terminated)
+ * @return string_result_t Success or error code
+ */
+string_result_t string_buffer_append_cstr(string_buffer_t *buffer, const char *cstr) {
+    if (!cstr) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    return string_buffer_append(buffer, string_view_from_cstr(cstr));
+}
+
+/**
+ * @brief Append formatted text to a buffer
+ * @param buffer Buffer to append to
+ * @param format Printf-style format string
+ * @param ... Arguments for the format string
+ * @return string_result_t Success or error code
+ */
+string_result_t string_buffer_append_format(string_buffer_t *buffer, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    string_result_t result = string_buffer_append_vformat(buffer, format, args);
+    va_end(args);
+
+    return result;
+}
+
+/**
+ * @brief Append formatted text to a buffer using a va_list
+ * @param buffer Buffer to append to
+ * @param format Printf-style format string
+ * @param args Variable argument list for the format string
+ * @return string_result_t Success or error code
+ * @details Formats on the stack, or once more on the heap if the output does
+ *          not fit, then appends the result in one piece.
+ */
+string_result_t string_buffer_append_vformat(string_buffer_t *buffer, const char *format, va_list args) {
+    if (!buffer || !format) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    char local[STRING_BUFFER_FORMAT_STACK];
+    va_list args_copy;
+    va_copy(args_copy, args);
+    int written = vsnprintf(local, sizeof(local), format, args_copy);
+    va_end(args_copy);
+
+    if (written < 0) {
+        return STRING_ERROR_INVALID_ARGUMENT;
+    }
+
+    if ((size_t)written < sizeof(local)) {
+        return string_buffer_append(buffer, string_view_from_buffer(local, (size_t)written));
+    }
+
+    char *heap = malloc((size_t)written + 1);
+    if (!heap) {
+        return STRING_ERROR_OUT_OF_MEMORY;
+    }
+
+    va_copy(args_copy, args);
+    vsnprintf(heap, (size_t)written + 1, format, args_copy);
+    va_end(args_copy);
+
+    string_result_t result = string_buffer_append(buffer, string_view_from_buffer(heap, (size_t)written));
+    free(heap);
+
+    return result;
+}
+
+/*
+ * ===========================
+ * Buffer consumer functions
+ * ===========================
+ */
+
+/**
+ * @brief Take everything appended to a buffer so far
+ * @param buffer Buffer to take from
+ * @param batch Receives the taken segments
+ * @return string_result_t Success or error code
+ * @details Writers are never blocked: the consumer waits only for appends
+ *          that had already started on the segments it unhooked.
+ */
+string_result_t string_buffer_take(string_buffer_t *buffer, string_buffer_batch_t **batch) {
+    if (!buffer || !batch) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    *batch = NULL;
+    pthread_mutex_lock(&buffer->take_lock);
+
+    // Unhook every shard's segments, in shard order
+    string_buffer_segment_t *segments = NULL;
+    string_buffer_segment_t *last = NULL;
+    for (size_t i = 0; i < buffer->shard_count; ++i) {
+        string_buffer_shard_t *shard = &buffer->shards[i];
+        pthread_mutex_lock(&shard->lock);
+        if (shard->head) {
+            if (last) {
+                last->next = shard->head;
+            } else {
+                segments = shard->head;
+            }
+            last = shard->tail;
+        }
+        shard->head = NULL;
+        shard->tail = NULL;
+        atomic_store(&shard->current, NULL);
+        pthread_mutex_unlock(&shard->lock);
+    }
+
+    // Wait for the appends that may still write to the unhooked segments
+    size_t epoch = atomic_fetch_add(&buffer->epoch, 1);
+    for (size_t i = 0; i < buffer->shard_count; ++i) {
+        while (atomic_load_explicit(&buffer->shards[i].writers[epoch & 1], memory_order_acquire) != 0) {
+            sched_yield();
+        }
+    }
+
+    size_t count = 0;
+    for (string_buffer_segment_t *segment = segments; segment; segment = segment->next) {
+        count += string_buffer_segment_length(segment) > 0;
+    }
+
+    string_buffer_batch_t *taken = malloc(sizeof(string_buffer_batch_t) + count * sizeof(string_view_t));
+    if (!taken) {
+        string_buffer_restore(buffer, segments);
+        pthread_mutex_unlock(&buffer->take_lock);
+        return STRING_ERROR_OUT_OF_MEMORY;
+    }
+
+    taken->segments = segments;
+    taken->count = 0;
+    taken->bytes = 0;
+    for (string_buffer_segment_t *segment = segments; segment; segment = segment->next) {
+        size_t length = string_buffer_segment_length(segment);
+        if (length > 0) {
+            taken->views[taken->count++] = string_view_from_buffer(segment->data, length);
+            taken->bytes += length;
+        }
+    }
+
+    pthread_mutex_unlock(&buffer->take_lock);
+
+    *batch = taken;
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Take everything appended to a buffer so far and append it to a string
+ * @param buffer Buffer to take from
+ * @param dest String to append to
+ * @return string_result_t Success or error code
+ */
+string_result_t string_buffer_drain(string_buffer_t *buffer, string_t *dest) {
+    if (!buffer || !dest) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    string_buffer_batch_t *batch = NULL;
+    string_result_t result = string_buffer_take(buffer, &batch);
+    if (result != STRING_SUCCESS) {
+        return result;
+    }
+
+    result = batch->bytes > SIZE_MAX - 1 - string_length(dest) ? STRING_ERROR_OUT_OF_MEMORY
+                                                                : string_reserve(dest, string_length(dest) + batch->bytes + 1);
+    if (result == STRING_SUCCESS) {
+        result = string_append_views(dest, batch->views, batch->count);
+    }
+
+    if (result != STRING_SUCCESS) {
+        pthread_mutex_lock(&buffer->take_lock);
+        string_buffer_restore(buffer, batch->segments);
+        pthread_mutex_unlock(&buffer->take_lock);
+        free(batch);
+        return result;
+    }
+
+    string_buffer_batch_destroy(batch);
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Get the number of views in a batch
+ * @param batch Batch to query
+ * @return size_t Number of non-empty segments (0 for NULL)
+ */
+size_t string_buffer_batch_count(const string_buffer_batch_t *batch) {
+    return batch ? batch->count : 0;
+}
+
+/**
+ * @brief Get the total number of bytes in a batch
+ * @param batch Batch to query
+ * @return size_t Sum of the view lengths (0 for NULL)
+ */
+size_t string_buffer_batch_bytes(const string_buffer_batch_t *batch) {
+    return batch ? batch->bytes : 0;
+}
+
+/**
+ * @brief Get one view of a batch
+ * @param batch Batch to read
+ * @param index Index of the view
+ * @return string_view_t View of a segment, or an empty view if the index is out of range
+ */
+string_view_t string_buffer_batch_at(const string_buffer_batch_t *batch, size_t index) {
+    if (!batch || index >= batch->count) {
+        return string_view_from_buffer(NULL, 0);
+    }
+
+    return batch->views[index];
+}
+
+/**
+ * @brief Release a batch and its segments
+ * @param batch Batch to destroy (can be NULL)
+ */
+void string_buffer_batch_destroy(string_buffer_batch_t *batch) {
+    if (!batch) {
+        return;
+    }
+
+    string_buffer_free_segments(batch->segments);
+    free(batch);
+}
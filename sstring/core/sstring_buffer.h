@@ -0,0 +1,162 @@
+/**
+ * @file sstring_buffer.h
+ * @brief Concurrent append buffer for the safe strings library
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * This header provides a buffer that any number of threads can append to at
+ * the same time without a lock, for uses such as collecting log lines from
+ * many producers. string_t itself stays single-threaded and pays nothing for
+ * this: the buffer is a separate type built on its own storage.
+ *
+ * The buffer is split into shards, and each thread always appends to the same
+ * shard. An append reserves its bytes with one atomic fetch-add on the shard's
+ * current segment and copies them in; only filling a segment takes the shard
+ * lock, to chain a new one. Each append stays contiguous, and appends made by
+ * one thread keep their order. Appends from different threads are grouped by
+ * shard rather than interleaved by time.
+ *
+ * A consumer takes everything appended so far, either as a batch of views
+ * (one per segment) or flattened into a string_t. Taking does not stop the
+ * writers: it swaps the segments out and waits only for the appends already
+ * in progress on them to finish.
+ */
+
+#pragma once
+
+#include "sstring.h"
+
+/** @brief Default size of each segment, in bytes */
+#define STRING_BUFFER_DEFAULT_SEGMENT ((size_t)64 * 1024)
+
+/** @brief Largest formatted append built on the stack; longer output is formatted into the heap */
+#define STRING_BUFFER_FORMAT_STACK 256
+
+/** @brief Opaque concurrent append buffer */
+typedef struct string_buffer string_buffer_t;
+
+/** @brief Opaque set of segments taken from a buffer */
+typedef struct string_buffer_batch string_buffer_batch_t;
+
+/*
+ * ===========================
+ * Buffer lifetime functions
+ * ===========================
+ */
+
+/**
+ * @brief Create a new, empty buffer
+ * @param shard_count Number of shards (0 selects the number of online processors)
+ * @param segment_size Size of each segment (0 selects STRING_BUFFER_DEFAULT_SEGMENT)
+ * @return Pointer to newly created buffer, or NULL on failure
+ * @details Appends longer than a segment get a segment of their own.
+ */
+string_buffer_t *string_buffer_create(size_t shard_count, size_t segment_size);
+
+/**
+ * @brief Destroy a buffer and everything still in it
+ * @param buffer Buffer to destroy (can be NULL); no thread may be using it
+ */
+void string_buffer_destroy(string_buffer_t *buffer);
+
+/*
+ * =========================
+ * Buffer append functions
+ * =========================
+ */
+
+/**
+ * @brief Append bytes to a buffer
+ * @param buffer Buffer to append to
+ * @param view Bytes to append
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Safe to call from any number of threads at once.
+ */
+string_result_t string_buffer_append(string_buffer_t *buffer, string_view_t view);
+
+/**
+ * @brief Append a C string to a buffer
+ * @param buffer Buffer to append to
+ * @param cstr C string to append (null-terminated)
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Safe to call from any number of threads at once.
+ */
+string_result_t string_buffer_append_cstr(string_buffer_t *buffer, const char *cstr);
+
+/**
+ * @brief Append formatted text to a buffer
+ * @param buffer Buffer to append to
+ * @param format Printf-style format string
+ * @param ... Arguments for the format string
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Safe to call from any number of threads at once. The whole output
+ *          is appended as one contiguous piece.
+ */
+string_result_t string_buffer_append_format(string_buffer_t *buffer, const char *format, ...);
+
+/**
+ * @brief Append formatted text to a buffer using a va_list
+ * @param buffer Buffer to append to
+ * @param format Printf-style format string
+ * @param args Variable argument list for the format string
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Same as string_buffer_append_format() but takes a va_list.
+ */
+string_result_t string_buffer_append_vformat(string_buffer_t *buffer, const char *format, va_list args);
+
+/*
+ * ===========================
+ * Buffer consumer functions
+ * ===========================
+ */
+
+/**
+ * @brief Take everything appended to a buffer so far
+ * @param buffer Buffer to take from
+ * @param batch Receives the taken segments, to be released with string_buffer_batch_destroy()
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Appends that complete before the call are all in the batch; appends
+ *          running concurrently land either in it or in the next one. Calls
+ *          from several consumers are serialized. On failure nothing is lost.
+ */
+string_result_t string_buffer_take(string_buffer_t *buffer, string_buffer_batch_t **batch);
+
+/**
+ * @brief Take everything appended to a buffer so far and append it to a string
+ * @param buffer Buffer to take from
+ * @param dest String to append to
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details The string grows once to its final size. On failure the content
+ *          stays in the buffer.
+ */
+string_result_t string_buffer_drain(string_buffer_t *buffer, string_t *dest);
+
+/**
+ * @brief Get the number of views in a batch
+ * @param batch Batch to query
+ * @return Number of non-empty segments (0 for NULL)
+ */
+size_t string_buffer_batch_count(const string_buffer_batch_t *batch);
+
+/**
+ * @brief Get the total number of bytes in a batch
+ * @param batch Batch to query
+ * @return Sum of the view lengths (0 for NULL)
+ */
+size_t string_buffer_batch_bytes(const string_buffer_batch_t *batch);
+
+/**
+ * @brief Get one view of a batch
+ * @param batch Batch to read
+ * @param index Index of the view
+ * @return View of a segment, or an empty view if the index is out of range
+ * @details Views are valid until the batch is destroyed. A view holds whole
+ *          appends, in the order one thread made them.
+ */
+string_view_t string_buffer_batch_at(const string_buffer_batch_t *batch, size_t index);
+
+/**
+ * @brief Release a batch and its segments
+ * @param batch Batch to destroy (can be NULL)
+ */
+void string_buffer_batch_destroy(string_buffer_batch_t *batch);
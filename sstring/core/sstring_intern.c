@@ -0,0 +1,389 @@
+/**
+ * @file sstring_intern.c
+ * @brief Implementation of the string interning pool
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * Each canonical string is a single allocation holding a read-only string_t
+ * header followed by its bytes. A shard is an open-addressing table of header
+ * pointers probed linearly from the low bits of the cached hash; the shard
+ * itself is picked by the high bits, so the two choices stay independent.
+ * Entries are never removed before the pool is destroyed, which keeps probing
+ * free of tombstones.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+
+#include "sstring_intern.h"
+
+/** @brief Number of slots allocated by the first insertion into a shard */
+#define STRING_INTERN_MIN_SLOTS 16
+
+/**
+ * @brief One independently locked part of a pool
+ */
+typedef struct {
+    pthread_rwlock_t lock;  /**< Guards the table (concurrent pools only) */
+    string_t **slots;       /**< Canonical strings (NULL for an empty slot) */
+    size_t capacity;        /**< Number of slots (zero or a power of two) */
+    size_t count;           /**< Number of occupied slots */
+} string_intern_shard_t;
+
+/**
+ * @brief Interning pool state
+ */
+struct string_intern {
+    string_intern_shard_t *shards;  /**< Shard array */
+    size_t shard_count;             /**< Number of shards (a power of two) */
+    unsigned shard_shift;           /**< Right shift selecting the shard from a hash */
+    bool is_concurrent;             /**< Whether shards are locked */
+};
+
+/**
+ * @brief Get the shard responsible for a hash
+ * @param pool Pool to search
+ * @param hash Hash of the content
+ * @return string_intern_shard_t* Shard for the hash
+ */
+static string_intern_shard_t *string_intern_shard(const string_intern_t *pool, uint64_t hash) {
+    return &pool->shards[pool->shard_count > 1 ? (size_t)(hash >> pool->shard_shift) : 0];
+}
+
+/**
+ * @brief Find a canonical string in a shard
+ * @param shard Shard to search
+ * @param content Bytes to look up
+ * @param hash Hash of the content
+ * @return string_t** Slot holding the match, or the empty slot ending the probe
+ */
+static string_t **string_intern_probe(const string_intern_shard_t *shard, string_view_t content, uint64_t hash) {
+    size_t mask = shard->capacity - 1;
+    size_t index = (size_t)hash & mask;
+
+    for (;;) {
+        string_t *entry = shard->slots[index];
+        if (!entry || (entry->hash == hash && entry->length == content.length &&
+                       memcmp(entry->data, content.data, content.length) == 0)) {
+            return &shard->slots[index];
+        }
+        index = (index + 1) & mask;
+    }
+}
+
+/**
+ * @brief Look up content in a shard without locking
+ * @param shard Shard to search
+ * @param content Bytes to look up
+ * @param hash Hash of the content
+ * @return string_t* Canonical string, or NULL if absent
+ */
+static string_t *string_intern_find(const string_intern_shard_t *shard, string_view_t content, uint64_t hash) {
+    return shard->count > 0 ? *string_intern_probe(shard, content, hash) : NULL;
+}
+
+/**
+ * @brief Double the table of a shard, or allocate its first table
+ * @param shard Shard to grow
+ * @return bool true on success
+ */
+static bool string_intern_grow(string_intern_shard_t *shard) {
+    size_t capacity = shard->capacity ? shard->capacity * 2 : STRING_INTERN_MIN_SLOTS;
+    if (capacity > SIZE_MAX / sizeof(string_t *)) {
+        return false;
+    }
+
+    string_t **slots = calloc(capacity, sizeof(string_t *));
+    if (!slots) {
+        return false;
+    }
+
+    size_t mask = capacity - 1;
+    for (size_t i = 0; i < shard->capacity; ++i) {
+        string_t *entry = shard->slots[i];
+        if (entry) {
+            size_t index = (size_t)entry->hash & mask;
+            while (slots[index]) {
+                index = (index + 1) & mask;
+            }
+            slots[index] = entry;
+        }
+    }
+
+    free(shard->slots);
+    shard->slots = slots;
+    shard->capacity = capacity;
+
+    return true;
+}
+
+/**
+ * @brief Add content to a shard that does not hold it yet
+ * @param shard Shard to insert into (write-locked if shared)
+ * @param content Bytes to copy
+ * @param hash Hash of the content
+ * @return string_t* New canonical string, or NULL on failure
+ */
+static string_t *string_intern_insert(string_intern_shard_t *shard, string_view_t content, uint64_t hash) {
+    if ((shard->count + 1) > shard->capacity / 4 * 3 && !string_intern_grow(shard)) {
+        return NULL;
+    }
+
+    if (content.length > SIZE_MAX - sizeof(string_t) - 1) {
+        return NULL;
+    }
+
+    string_t *entry = malloc(sizeof(string_t) + content.length + 1);
+    if (!entry) {
+        return NULL;
+    }
+
+    char *bytes = (char *)(entry + 1);
+    memcpy(bytes, content.data, content.length);
+    bytes[content.length] = '\0';
+
+    string_init_view(entry, string_view_from_buffer(bytes, content.length));
+    entry->allocator = string_default_allocator();
+    entry->hash = hash;
+    entry->has_hash = true;
+
+    *string_intern_probe(shard, content, hash) = entry;
+    shard->count++;
+
+    return entry;
+}
+
+/**
+ * @brief Get or add the canonical string for hashed content
+ * @param pool Pool to intern into
+ * @param content Bytes to intern
+ * @param hash Hash of the content
+ * @return const string_t* Canonical string, or NULL on failure
+ * @details Concurrent pools try a shared lock first and only take the exclusive
+ *          lock, then search again, when the content is new.
+ */
+static const string_t *string_intern_hashed(string_intern_t *pool, string_view_t content, uint64_t hash) {
+    string_intern_shard_t *shard = string_intern_shard(pool, hash);
+
+    if (!pool->is_concurrent) {
+        string_t *entry = string_intern_find(shard, content, hash);
+        return entry ? entry : string_intern_insert(shard, content, hash);
+    }
+
+    pthread_rwlock_rdlock(&shard->lock);
+    string_t *entry = string_intern_find(shard, content, hash);
+    pthread_rwlock_unlock(&shard->lock);
+    if (entry) {
+        return entry;
+    }
+
+    pthread_rwlock_wrlock(&shard->lock);
+    entry = string_intern_find(shard, content, hash);
+    if (!entry) {
+        entry = string_intern_insert(shard, content, hash);
+    }
+    pthread_rwlock_unlock(&shard->lock);
+
+    return entry;
+}
+
+/**
+ * @brief Allocate a pool with a given number of shards
+ * @param shard_count Number of shards (a power of two)
+ * @param is_concurrent Whether shards are locked
+ * @return string_intern_t* Pointer to new pool or NULL on failure
+ */
+static string_intern_t *string_intern_allocate(size_t shard_count, bool is_concurrent) {
+    string_intern_t *pool = calloc(1, sizeof(string_intern_t));
+    if (!pool) {
+        return NULL;
+    }
+
+    pool->shards = calloc(shard_count, sizeof(string_intern_shard_t));
+    if (!pool->shards) {
+        free(pool);
+        return NULL;
+    }
+
+    pool->shard_count = shard_count;
+    pool->shard_shift = 64;
+    while (shard_count > 1) {
+        pool->shard_shift--;
+        shard_count >>= 1;
+    }
+    pool->is_concurrent = is_concurrent;
+
+    if (is_concurrent) {
+        for (size_t i = 0; i < pool->shard_count; ++i) {
+            if (pthread_rwlock_init(&pool->shards[i].lock, NULL) != 0) {
+                while (i-- > 0) {
+                    pthread_rwlock_destroy(&pool->shards[i].lock);
+                }
+                free(pool->shards);
+                free(pool);
+                return NULL;
+            }
+        }
+    }
+
+    return pool;
+}
+
+/*
+ * =======================
+ * Pool lifetime functions
+ * =======================
+ */
+
+/**
+ * @brief Create a pool for use by a single thread
+ * @return string_intern_t* Pointer to new pool or NULL on failure
+ */
+string_intern_t *string_intern_create(void) {
+    return string_intern_allocate(1, false);
+}
+
+/**
+ * @brief Create a pool that can be shared between threads
+ * @param shard_count Requested number of shards
+ * @return string_intern_t* Pointer to new pool or NULL on failure
+ */
+string_intern_t *string_intern_create_concurrent(size_t shard_count) {
+    if (shard_count == 0) {
+        shard_count = STRING_INTERN_DEFAULT_SHARDS;
+    }
+
+    if (shard_count > SIZE_MAX / 2 / sizeof(string_intern_shard_t)) {
+        return NULL;
+    }
+
+    size_t rounded = 1;
+    while (rounded < shard_count) {
+        rounded <<= 1;
+    }
+
+    return string_intern_allocate(rounded, true);
+}
+
+/**
+ * @brief Destroy a pool and every canonical string it holds
+ * @param pool Pool to destroy
+ */
+void string_intern_destroy(string_intern_t *pool) {
+    if (!pool) {
+        return;
+    }
+
+    for (size_t i = 0; i < pool->shard_count; ++i) {
+        string_intern_shard_t *shard = &pool->shards[i];
+        for (size_t j = 0; j < shard->capacity; ++j) {
+            free(shard->slots[j]);
+        }
+        free(shard->slots);
+        if (pool->is_concurrent) {
+            pthread_rwlock_destroy(&shard->lock);
+        }
+    }
+
+    free(pool->shards);
+    free(pool);
+}
+
+/**
+ * @brief Get the number of distinct strings in a pool
+ * @param pool Pool to query
+ * @return size_t Number of canonical strings
+ */
+size_t string_intern_count(const string_intern_t *pool) {
+    if (!pool) {
+        return 0;
+    }
+
+    size_t count = 0;
+    for (size_t i = 0; i < pool->shard_count; ++i) {
+        string_intern_shard_t *shard = &pool->shards[i];
+        if (pool->is_concurrent) {
+            pthread_rwlock_rdlock(&shard->lock);
+        }
+        count += shard->count;
+        if (pool->is_concurrent) {
+            pthread_rwlock_unlock(&shard->lock);
+        }
+    }
+
+    return count;
+}
+
+/*
+ * =======================
+ * Interning functions
+ * =======================
+ */
+
+/**
+ * @brief Get the canonical string for some bytes, adding it if needed
+ * @param pool Pool to intern into
+ * @param content Bytes to intern
+ * @return const string_t* Canonical string or NULL on failure
+ */
+const string_t *string_intern(string_intern_t *pool, string_view_t content) {
+    if (!pool || (!content.data && content.length > 0)) {
+        return NULL;
+    }
+
+    return string_intern_hashed(pool, content, string_view_hash(content));
+}
+
+/**
+ * @brief Get the canonical string for a C string, adding it if needed
+ * @param pool Pool to intern into
+ * @param cstr C string to intern
+ * @return const string_t* Canonical string or NULL on failure
+ */
+const string_t *string_intern_cstr(string_intern_t *pool, const char *cstr) {
+    if (!cstr) {
+        return NULL;
+    }
+
+    return string_intern(pool, string_view_from_cstr(cstr));
+}
+
+/**
+ * @brief Get the canonical string for the content of a string, adding it if needed
+ * @param pool Pool to intern into
+ * @param str String to intern
+ * @return const string_t* Canonical string or NULL on failure
+ */
+const string_t *string_intern_string(string_intern_t *pool, const string_t *str) {
+    if (!pool || !str) {
+        return NULL;
+    }
+
+    return string_intern_hashed(pool, string_view_from_string(str), string_hash(str));
+}
+
+/**
+ * @brief Get the canonical string for some bytes without adding it
+ * @param pool Pool to search
+ * @param content Bytes to look up
+ * @return const string_t* Canonical string or NULL if absent
+ */
+const string_t *string_intern_lookup(const string_intern_t *pool, string_view_t content) {
+    if (!pool || (!content.data && content.length > 0)) {
+        return NULL;
+    }
+
+    uint64_t hash = string_view_hash(content);
+    string_intern_shard_t *shard = string_intern_shard(pool, hash);
+
+    if (!pool->is_concurrent) {
+        return string_intern_find(shard, content, hash);
+    }
+
+    pthread_rwlock_rdlock(&shard->lock);
+    const string_t *entry = string_intern_find(shard, content, hash);
+    pthread_rwlock_unlock(&shard->lock);
+
+    return entry;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file sstring_intern.h
+ * @brief String interning pool for the safe strings library
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * This header provides a pool that stores one canonical string per distinct
+ * content. Interning the same bytes twice returns the same pointer, so two
+ * interned strings are equal exactly when their pointers are equal, and a
+ * program holding many copies of a few distinct values keeps only one copy of
+ * each.
+ *
+ * Canonical strings are read-only (every modification function returns
+ * STRING_ERROR_READ_ONLY), carry a precomputed hash, and live until the pool is
+ * destroyed. They must not be passed to string_destroy().
+ *
+ * A pool created with string_intern_create() must be used from one thread at a
+ * time. A pool created with string_intern_create_concurrent() can be used from
+ * any number of threads: it is split into shards selected by the key hash, each
+ * guarded by a reader-writer lock, so lookups of existing values only take a
+ * shared lock and insertions into different shards never contend.
+ */
+
+#pragma once
+
+#include "sstring.h"
+
+/** @brief Number of shards used by string_intern_create_concurrent() when 0 is passed */
+#define STRING_INTERN_DEFAULT_SHARDS 16
+
+/** @brief Opaque interning pool */
+typedef struct string_intern string_intern_t;
+
+/*
+ * =======================
+ * Pool lifetime functions
+ * =======================
+ */
+
+/**
+ * @brief Create a pool for use by a single thread
+ * @return Pointer to newly created pool, or NULL on failure
+ */
+string_intern_t *string_intern_create(void);
+
+/**
+ * @brief Create a pool that can be shared between threads
+ * @param shard_count Number of independently locked shards, rounded up to a
+ *                    power of two (0 selects STRING_INTERN_DEFAULT_SHARDS)
+ * @return Pointer to newly created pool, or NULL on failure
+ */
+string_intern_t *string_intern_create_concurrent(size_t shard_count);
+
+/**
+ * @brief Destroy a pool and every canonical string it holds
+ * @param pool Pool to destroy (can be NULL)
+ * @details No thread may use the pool or its strings afterwards.
+ */
+void string_intern_destroy(string_intern_t *pool);
+
+/**
+ * @brief Get the number of distinct strings in a pool
+ * @param pool Pool to query
+ * @return Number of canonical strings (0 for NULL)
+ */
+size_t string_intern_count(const string_intern_t *pool);
+
+/*
+ * =======================
+ * Interning functions
+ * =======================
+ */
+
+/**
+ * @brief Get the canonical string for some bytes, adding it if needed
+ * @param pool Pool to intern into
+ * @param content Bytes to intern (can contain null bytes)
+ * @return Canonical read-only string, or NULL on failure
+ */
+const string_t *string_intern(string_intern_t *pool, string_view_t content);
+
+/**
+ * @brief Get the canonical string for a C string, adding it if needed
+ * @param pool Pool to intern into
+ * @param cstr C string to intern (null-terminated)
+ * @return Canonical read-only string, or NULL on failure
+ */
+const string_t *string_intern_cstr(string_intern_t *pool, const char *cstr);
+
+/**
+ * @brief Get the canonical string for the content of a string, adding it if needed
+ * @param pool Pool to intern into
+ * @param str String to intern (its cached hash is used when present)
+ * @return Canonical read-only string, or NULL on failure
+ */
+const string_t *string_intern_string(string_intern_t *pool, const string_t *str);
+
+/**
+ * @brief Get the canonical string for some bytes without adding it
+ * @param pool Pool to search
+ * @param content Bytes to look up
+ * @return Canonical string, or NULL if the content was never interned
+ */
+const string_t *string_intern_lookup(const string_intern_t *pool, string_view_t content);
@@ -0,0 +1,508 @@
+/**
+ * @file sstring_io.c
+ * @brief Implementation of file and descriptor I/O for strings
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * Reads obtain the destination room with string_reserve_spare(), let the kernel
+ * write into it and publish the bytes with string_commit_spare(), so the data
+ * is copied exactly once, by the system call. Vectored calls are built on the
+ * stack in batches of at most STRING_IO_MAX_BATCH entries.
+ */
+
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "sstring_io.h"
+
+/** @brief Number of iovec entries submitted per readv() or writev() call */
+#if defined(IOV_MAX) && IOV_MAX < STRING_IO_MAX_BATCH
+#define STRING_IO_IOV_COUNT IOV_MAX
+#else
+#define STRING_IO_IOV_COUNT STRING_IO_MAX_BATCH
+#endif
+
+/** @brief Largest byte count passed to a single read() or write() */
+#define STRING_IO_MAX_TRANSFER ((size_t)SSIZE_MAX)
+
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+/*
+ * ==========================
+ * Descriptor read functions
+ * ==========================
+ */
+
+/**
+ * @brief Get the number of bytes left to read from a regular file
+ * @param fd Descriptor to inspect
+ * @return size_t Remaining size, or 0 if unknown (pipes, sockets, errors)
+ */
+static size_t string_io_remaining(int fd) {
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size <= 0) {
+        return 0;
+    }
+
+    off_t position = lseek(fd, 0, SEEK_CUR);
+    if (position < 0 || position >= info.st_size) {
+        return 0;
+    }
+
+    uintmax_t remaining = (uintmax_t)(info.st_size - position);
+    return remaining < SIZE_MAX ? (size_t)remaining : SIZE_MAX - 1;
+}
+
+/**
+ * @brief Open a file for reading
+ * @param path Path of the file to open
+ * @return int Close-on-exec descriptor, or -1 with errno set
+ */
+int string_open_file(const char *path) {
+    if (!path) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    int fd;
+    do {
+        fd = open(path, O_RDONLY | O_CLOEXEC);
+    } while (fd < 0 && errno == EINTR);
+
+    return fd;
+}
+
+/**
+ * @brief Replace the content of a string with the whole content of a file
+ * @param str Destination string
+ * @param path Path of the file to read
+ * @return string_result_t Success or error code
+ */
+string_result_t string_read_file(string_t *str, const char *path) {
+    if (!str || !path) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    int fd = string_open_file(path);
+    if (fd < 0) {
+        return STRING_ERROR_IO;
+    }
+
+    string_result_t result = string_read_fd(str, fd);
+
+    // Report the read error, not a secondary one from close()
+    int saved_errno = errno;
+    close(fd);
+    errno = saved_errno;
+
+    return result;
+}
+
+/**
+ * @brief Replace the content of a string with everything readable from a descriptor
+ * @param str Destination string
+ * @param fd Descriptor to read until end of file
+ * @return string_result_t Success or error code
+ * @details Regular files are pre-sized to their remaining size plus one byte,
+ *          so the final zero-length read needs no growth
+ */
+string_result_t string_read_fd(string_t *str, int fd) {
+    string_result_t result = string_clear(str);
+    if (result != STRING_SUCCESS) {
+        return result;
+    }
+
+    size_t remaining = string_io_remaining(fd);
+    if (remaining > 0) {
+        result = string_reserve_hint(str, remaining + 1);
+        if (result != STRING_SUCCESS) {
+            return result;
+        }
+    }
+
+    for (;;) {
+        size_t bytes_read;
+        result = string_append_from_fd(str, fd, 0, &bytes_read);
+        if (result != STRING_SUCCESS || bytes_read == 0) {
+            return result;
+        }
+    }
+}
+
+/**
+ * @brief Append the result of one read from a descriptor
+ * @param str Destination string
+ * @param fd Descriptor to read from
+ * @param max_length Maximum number of bytes to read (0 for the spare capacity)
+ * @param bytes_read Receives the number of bytes appended (optional)
+ * @return string_result_t Success or error code
+ */
+string_result_t string_append_from_fd(string_t *str, int fd, size_t max_length, size_t *bytes_read) {
+    if (bytes_read) {
+        *bytes_read = 0;
+    }
+
+    char *spare;
+    size_t available;
+    string_result_t result = string_reserve_spare(str, max_length ? max_length : 1, &spare, &available);
+    if (result != STRING_SUCCESS) {
+        return result;
+    }
+
+    if (max_length && available > max_length) {
+        available = max_length;
+    }
+    if (available > STRING_IO_MAX_TRANSFER) {
+        available = STRING_IO_MAX_TRANSFER;
+    }
+
+    ssize_t count;
+    do {
+        count = read(fd, spare, available);
+    } while (count < 0 && errno == EINTR);
+    if (count < 0) {
+        return STRING_ERROR_IO;
+    }
+
+    if (bytes_read) {
+        *bytes_read = (size_t)count;
+    }
+
+    return string_commit_spare(str, (size_t)count);
+}
+
+/**
+ * @brief Fill the spare capacity of several strings with one readv() call
+ * @param strings Array of destination strings
+ * @param count Number of strings
+ * @param fd Descriptor to read from
+ * @param bytes_read Receives the total number of bytes read (optional)
+ * @return string_result_t Success or error code
+ * @details Bytes are handed out to the strings in order after the call returns
+ */
+string_result_t string_readv_fd(string_t *const *strings, size_t count, int fd, size_t *bytes_read) {
+    if (bytes_read) {
+        *bytes_read = 0;
+    }
+
+    if (!strings && count > 0) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    if (count > STRING_IO_IOV_COUNT) {
+        count = STRING_IO_IOV_COUNT;
+    }
+
+    struct iovec vectors[STRING_IO_IOV_COUNT];
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        char *spare;
+        size_t available;
+        string_result_t result = string_reserve_spare(strings[i], 0, &spare, &available);
+        if (result != STRING_SUCCESS) {
+            return result;
+        }
+
+        if (available > STRING_IO_MAX_TRANSFER - total) {
+            available = STRING_IO_MAX_TRANSFER - total;
+        }
+        vectors[i].iov_base = spare;
+        vectors[i].iov_len = available;
+        total += available;
+    }
+
+    if (total == 0) {
+        return count > 0 ? STRING_ERROR_BUFFER_TOO_SMALL : STRING_SUCCESS;
+    }
+
+    ssize_t result;
+    do {
+        result = readv(fd, vectors, (int)count);
+    } while (result < 0 && errno == EINTR);
+    if (result < 0) {
+        return STRING_ERROR_IO;
+    }
+
+    size_t left = (size_t)result;
+    for (size_t i = 0; i < count && left > 0; ++i) {
+        size_t landed = left < vectors[i].iov_len ? left : vectors[i].iov_len;
+        string_commit_spare(strings[i], landed);
+        left -= landed;
+    }
+
+    if (bytes_read) {
+        *bytes_read = (size_t)result;
+    }
+
+    return STRING_SUCCESS;
+}
+
+/*
+ * ===========================
+ * Descriptor write functions
+ * ===========================
+ */
+
+/**
+ * @brief Write a batch of vectors completely
+ * @param fd Descriptor to write to
+ * @param vectors Vectors to write (consumed by the call)
+ * @param count Number of vectors
+ * @return string_result_t Success or error code
+ * @details After a short write the fully written vectors are skipped and the
+ *          partially written one is advanced before resubmitting
+ */
+static string_result_t string_io_write_vectors(int fd, struct iovec *vectors, size_t count) {
+    while (count > 0) {
+        ssize_t written;
+        do {
+            written = writev(fd, vectors, (int)count);
+        } while (written < 0 && errno == EINTR);
+        if (written < 0) {
+            return STRING_ERROR_IO;
+        }
+
+        size_t left = (size_t)written;
+        while (count > 0 && left >= vectors->iov_len) {
+            left -= vectors->iov_len;
+            ++vectors;
+            --count;
+        }
+        if (count > 0) {
+            vectors->iov_base = (char *)vectors->iov_base + left;
+            vectors->iov_len -= left;
+        }
+    }
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Write the whole content of a string to a descriptor
+ * @param str String to write
+ * @param fd Descriptor to write to
+ * @return string_result_t Success or error code
+ */
+string_result_t string_write_fd(const string_t *str, int fd) {
+    if (!str) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    const char *data = str->data;
+    size_t left = str->length;
+    while (left > 0) {
+        size_t chunk = left < STRING_IO_MAX_TRANSFER ? left : STRING_IO_MAX_TRANSFER;
+        ssize_t written = write(fd, data, chunk);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return STRING_ERROR_IO;
+        }
+        data += written;
+        left -= (size_t)written;
+    }
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Write the contents of several strings to a descriptor with writev()
+ * @param strings Array of strings to write
+ * @param count Number of strings
+ * @param fd Descriptor to write to
+ * @return string_result_t Success or error code
+ * @details Empty strings are left out of the vectors; a batch whose total would
+ *          exceed the transfer limit is submitted early
+ */
+string_result_t string_writev_fd(const string_t *const *strings, size_t count, int fd) {
+    if (!strings && count > 0) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    struct iovec vectors[STRING_IO_IOV_COUNT];
+    size_t used = 0;
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (!strings[i]) {
+            return STRING_ERROR_NULL_POINTER;
+        }
+
+        size_t length = strings[i]->length;
+        if (length == 0) {
+            continue;
+        }
+        if (used == STRING_IO_IOV_COUNT || length > STRING_IO_MAX_TRANSFER - total) {
+            string_result_t result = string_io_write_vectors(fd, vectors, used);
+            if (result != STRING_SUCCESS) {
+                return result;
+            }
+            used = 0;
+            total = 0;
+        }
+        if (length > STRING_IO_MAX_TRANSFER) {
+            string_result_t result = string_write_fd(strings[i], fd);
+            if (result != STRING_SUCCESS) {
+                return result;
+            }
+            continue;
+        }
+
+        vectors[used].iov_base = strings[i]->data;
+        vectors[used].iov_len = length;
+        ++used;
+        total += length;
+    }
+
+    return string_io_write_vectors(fd, vectors, used);
+}
+
+/*
+ * =====================
+ * Line input functions
+ * =====================
+ */
+
+/**
+ * @brief Read the next line of a stream into a string
+ * @param line Destination string
+ * @param stream Stream to read from
+ * @return string_result_t Success, STRING_ERROR_END_OF_FILE, or error code
+ * @details Bytes are copied from the stream buffer straight into the spare
+ *          capacity of the line under a single stream lock
+ */
+string_result_t string_read_line(string_t *line, FILE *stream) {
+    if (!line || !stream) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    string_result_t result = string_clear(line);
+    if (result != STRING_SUCCESS) {
+        return result;
+    }
+
+    bool has_data = false;
+    int c = 0;
+    flockfile(stream);
+    while (result == STRING_SUCCESS) {
+        char *spare;
+        size_t available;
+        result = string_reserve_spare(line, 1, &spare, &available);
+        if (result != STRING_SUCCESS) {
+            break;
+        }
+
+        size_t written = 0;
+        while (written < available && (c = getc_unlocked(stream)) != EOF && c != '\n') {
+            spare[written++] = (char)c;
+        }
+        has_data = has_data || written > 0 || c == '\n';
+        string_commit_spare(line, written);
+
+        if (c == EOF) {
+            result = ferror(stream) ? STRING_ERROR_IO : has_data ? STRING_SUCCESS : STRING_ERROR_END_OF_FILE;
+            break;
+        }
+        if (c == '\n') {
+            break;
+        }
+    }
+    funlockfile(stream);
+
+    return result;
+}
+
+/*
+ * ======================
+ * File mapping functions
+ * ======================
+ */
+
+/**
+ * @brief Map a whole file as a read-only string
+ * @param path Path of the file to map
+ * @param flags Combination of string_map_flags_t hints
+ * @return string_t* Pointer to new read-only string or NULL on failure
+ * @details Reserves the file size plus at least one byte, rounded to pages, as
+ *          zero-filled anonymous memory and maps the file over its start. The
+ *          byte after the content is therefore always a readable '\0', even
+ *          when the file size is a multiple of the page size.
+ */
+string_t *string_map_file(const char *path, unsigned flags) {
+    if (!path || flags > (STRING_MAP_SEQUENTIAL | STRING_MAP_RANDOM | STRING_MAP_WILLNEED) ||
+        ((flags & STRING_MAP_SEQUENTIAL) && (flags & STRING_MAP_RANDOM))) {
+        errno = EINVAL;
+        return NULL;
+    }
+
+    int fd = string_open_file(path);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    struct stat info;
+    long page = sysconf(_SC_PAGESIZE);
+    if (fstat(fd, &info) != 0 || page <= 0) {
+        int saved_errno = errno;
+        close(fd);
+        errno = saved_errno;
+        return NULL;
+    }
+    if (!S_ISREG(info.st_mode) || (uintmax_t)info.st_size >= SIZE_MAX - (size_t)page) {
+        close(fd);
+        errno = S_ISREG(info.st_mode) ? EFBIG : EINVAL;
+        return NULL;
+    }
+
+    size_t length = (size_t)info.st_size;
+    size_t size = (length / (size_t)page + 1) * (size_t)page;
+    char *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (data != MAP_FAILED && length > 0 &&
+        mmap(data, length, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+        int saved_errno = errno;
+        munmap(data, size);
+        errno = saved_errno;
+        data = MAP_FAILED;
+    }
+    int saved_errno = errno;
+    close(fd);
+    if (data == MAP_FAILED) {
+        errno = saved_errno;
+        return NULL;
+    }
+
+    if (length > 0) {
+        if (flags & STRING_MAP_SEQUENTIAL) {
+            posix_madvise(data, length, POSIX_MADV_SEQUENTIAL);
+        } else if (flags & STRING_MAP_RANDOM) {
+            posix_madvise(data, length, POSIX_MADV_RANDOM);
+        }
+        if (flags & STRING_MAP_WILLNEED) {
+            posix_madvise(data, length, POSIX_MADV_WILLNEED);
+        }
+    }
+
+    const string_allocator_t *allocator = string_get_thread_allocator();
+    string_t *str = allocator->allocate(allocator->context, sizeof(string_t));
+    if (!str) {
+        munmap(data, size);
+        errno = ENOMEM;
+        return NULL;
+    }
+
+    string_init_view(str, string_view_from_buffer(data, length));
+    str->capacity = size;
+    str->storage = STRING_STORAGE_MAPPED;
+
+    return str;
+}
@@ -0,0 +1,165 @@
+/**
+ * @file sstring_io.h
+ * @brief File and descriptor I/O for the safe strings library
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * This header provides functions that move data between strings and POSIX file
+ * descriptors or stdio streams without an intermediate scratch buffer: reads go
+ * straight into the spare capacity of the destination string and writes come
+ * straight from the string data. Regular files are sized with fstat() first,
+ * so loading a file takes one allocation.
+ *
+ * Batches of strings can be written or read with a single writev() or readv()
+ * call. string_read_line() reads one line at a time into a string whose buffer
+ * is reused across calls, in the manner of getline().
+ *
+ * string_map_file() maps a whole file as a read-only string instead of reading
+ * it, so the search and compare functions run directly over the page cache.
+ *
+ * All functions retry reads and writes interrupted by signals. On a failing
+ * system call they return STRING_ERROR_IO and leave errno as set by the call.
+ */
+
+#pragma once
+
+#include "sstring.h"
+
+/** @brief Maximum number of strings submitted in one readv() or writev() call */
+#define STRING_IO_MAX_BATCH 256
+
+/**
+ * @brief Access pattern hints for string_map_file()
+ * @details Passed to posix_madvise(); hints never change the content.
+ */
+typedef enum {
+    STRING_MAP_NORMAL     = 0,       /**< No particular access pattern */
+    STRING_MAP_SEQUENTIAL = 1 << 0,  /**< Read ahead aggressively, pages are used once in order */
+    STRING_MAP_RANDOM     = 1 << 1,  /**< Disable read-ahead for scattered accesses */
+    STRING_MAP_WILLNEED   = 1 << 2   /**< Start reading the whole file in right away */
+} string_map_flags_t;
+
+/*
+ * ==========================
+ * Descriptor read functions
+ * ==========================
+ */
+
+/**
+ * @brief Open a file for reading
+ * @param path Path of the file to open
+ * @return Close-on-exec descriptor, or -1 with errno set on failure
+ * @details Retries an open() interrupted by a signal.
+ */
+int string_open_file(const char *path);
+
+/**
+ * @brief Replace the content of a string with the whole content of a file
+ * @param str Destination string
+ * @param path Path of the file to read
+ * @return STRING_SUCCESS on success, error code on failure
+ */
+string_result_t string_read_file(string_t *str, const char *path);
+
+/**
+ * @brief Replace the content of a string with everything readable from a descriptor
+ * @param str Destination string
+ * @param fd Descriptor to read until end of file
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details On a read error the string holds the bytes read before it.
+ */
+string_result_t string_read_fd(string_t *str, int fd);
+
+/**
+ * @brief Append the result of one read from a descriptor
+ * @param str Destination string
+ * @param fd Descriptor to read from (file, pipe or socket)
+ * @param max_length Maximum number of bytes to read (0 reads into whatever spare
+ *                   capacity the string has, growing it first if it has none)
+ * @param bytes_read Receives the number of bytes appended, 0 at end of file
+ *                   (can be NULL)
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Performs a single read() call, so it returns as soon as some data is
+ *          available; call it in a loop to drain a stream.
+ */
+string_result_t string_append_from_fd(string_t *str, int fd, size_t max_length, size_t *bytes_read);
+
+/**
+ * @brief Fill the spare capacity of several strings with one readv() call
+ * @param strings Array of destination strings
+ * @param count Number of strings (only the first STRING_IO_MAX_BATCH are filled)
+ * @param fd Descriptor to read from
+ * @param bytes_read Receives the total number of bytes read, 0 at end of file
+ *                   (can be NULL)
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Strings are filled in order and none of them grows, so reserve the
+ *          record sizes with string_reserve() beforehand. Each string is
+ *          extended by the bytes that landed in it.
+ */
+string_result_t string_readv_fd(string_t *const *strings, size_t count, int fd, size_t *bytes_read);
+
+/*
+ * ===========================
+ * Descriptor write functions
+ * ===========================
+ */
+
+/**
+ * @brief Write the whole content of a string to a descriptor
+ * @param str String to write
+ * @param fd Descriptor to write to
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Short writes are continued until every byte has been written.
+ */
+string_result_t string_write_fd(const string_t *str, int fd);
+
+/**
+ * @brief Write the contents of several strings to a descriptor with writev()
+ * @param strings Array of strings to write, in order
+ * @param count Number of strings
+ * @param fd Descriptor to write to
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Uses one system call per STRING_IO_MAX_BATCH strings unless the
+ *          descriptor accepts only part of a batch, in which case the rest is
+ *          resubmitted.
+ */
+string_result_t string_writev_fd(const string_t *const *strings, size_t count, int fd);
+
+/*
+ * =====================
+ * Line input functions
+ * =====================
+ */
+
+/**
+ * @brief Read the next line of a stream into a string
+ * @param line Destination string (its previous content is replaced, its buffer reused)
+ * @param stream Stream to read from
+ * @return STRING_SUCCESS when a line was read, STRING_ERROR_END_OF_FILE when the
+ *         stream has no more data, other error codes on failure
+ * @details The terminating '\n' is consumed but not stored; a last line without
+ *          one is still returned. Lines may contain null bytes.
+ */
+string_result_t string_read_line(string_t *line, FILE *stream);
+
+/*
+ * ======================
+ * File mapping functions
+ * ======================
+ */
+
+/**
+ * @brief Map a whole file as a read-only string
+ * @param path Path of the file to map
+ * @param flags Combination of string_map_flags_t hints (SEQUENTIAL and RANDOM
+ *              are mutually exclusive)
+ * @return Pointer to a new read-only string, or NULL on failure (errno holds
+ *         the cause)
+ * @details The content is never copied: the string refers to a private
+ *          read-only mapping of the file, followed by a null terminator, and
+ *          string_destroy() unmaps it. Every modification function returns
+ *          STRING_ERROR_READ_ONLY; use string_clone() for a writable copy.
+ *          string_capacity() reports the size of the mapping. The file must
+ *          not be truncated while it is mapped.
+ */
+string_t *string_map_file(const char *path, unsigned flags);
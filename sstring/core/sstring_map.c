@@ -0,0 +1,379 @@
+/**
+ * @file sstring_map.c
+ * @brief Implementation of the string-keyed hash map
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * The table is a power-of-two array of slots probed linearly from the low bits
+ * of the key hash. Each slot stores the full hash next to the key, so probes
+ * reject mismatches without touching key bytes and growth only moves slots.
+ * Removal shifts the following entries of the cluster back instead of leaving
+ * tombstones, so probe sequences never lengthen over time.
+ */
+
+#include "sstring_map.h"
+
+/** @brief Number of slots allocated by the first insertion */
+#define STRING_MAP_MIN_SLOTS 8
+
+/**
+ * @brief One table slot
+ */
+typedef struct {
+    uint64_t hash;  /**< Full hash of the key */
+    char *key;      /**< Private null-terminated key copy (NULL for an empty slot) */
+    size_t length;  /**< Key length */
+    void *value;    /**< Caller-owned value */
+} string_map_slot_t;
+
+/**
+ * @brief Hash map state
+ */
+struct string_map {
+    string_map_slot_t *slots;  /**< Slot array (capacity entries) */
+    size_t capacity;           /**< Number of slots (zero or a power of two) */
+    size_t count;              /**< Number of occupied slots */
+};
+
+/**
+ * @brief Check whether a table of a given size must grow to hold count entries
+ * @param capacity Number of slots
+ * @param count Number of entries
+ * @return bool true if the load factor would exceed 3/4
+ */
+static bool string_map_over_loaded(size_t capacity, size_t count) {
+    return count > capacity / 4 * 3;
+}
+
+/**
+ * @brief Find the slot holding a key, or the empty slot ending its probe sequence
+ * @param map Map to search (must have slots)
+ * @param key Key bytes
+ * @param hash Hash of the key
+ * @return size_t Index of the matching or empty slot
+ */
+static size_t string_map_probe(const string_map_t *map, string_view_t key, uint64_t hash) {
+    size_t mask = map->capacity - 1;
+    size_t index = (size_t)hash & mask;
+
+    for (;;) {
+        const string_map_slot_t *slot = &map->slots[index];
+        if (!slot->key) {
+            return index;
+        }
+        if (slot->hash == hash && slot->length == key.length && memcmp(slot->key, key.data, key.length) == 0) {
+            return index;
+        }
+        index = (index + 1) & mask;
+    }
+}
+
+/**
+ * @brief Move every entry into a new slot array
+ * @param map Map to resize
+ * @param capacity New number of slots (a power of two that holds every entry)
+ * @return string_result_t Success or error code
+ */
+static string_result_t string_map_rehash(string_map_t *map, size_t capacity) {
+    string_map_slot_t *slots = calloc(capacity, sizeof(string_map_slot_t));
+    if (!slots) {
+        return STRING_ERROR_OUT_OF_MEMORY;
+    }
+
+    size_t mask = capacity - 1;
+    for (size_t i = 0; i < map->capacity; ++i) {
+        if (map->slots[i].key) {
+            size_t index = (size_t)map->slots[i].hash & mask;
+            while (slots[index].key) {
+                index = (index + 1) & mask;
+            }
+            slots[index] = map->slots[i];
+        }
+    }
+
+    free(map->slots);
+    map->slots = slots;
+    map->capacity = capacity;
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Insert or replace an entry with a precomputed hash
+ * @param map Map to modify
+ * @param key Key bytes
+ * @param hash Hash of the key
+ * @param value Value to store
+ * @return string_result_t Success or error code
+ */
+static string_result_t string_map_put_hashed(string_map_t *map, string_view_t key, uint64_t hash, void *value) {
+    if (map->capacity > 0) {
+        string_map_slot_t *slot = &map->slots[string_map_probe(map, key, hash)];
+        if (slot->key) {
+            slot->value = value;
+            return STRING_SUCCESS;
+        }
+    }
+
+    if (map->capacity == 0 || string_map_over_loaded(map->capacity, map->count + 1)) {
+        string_result_t result = string_map_reserve(map, map->count + 1);
+        if (result != STRING_SUCCESS) {
+            return result;
+        }
+    }
+
+    char *copy = malloc(key.length + 1);
+    if (!copy) {
+        return STRING_ERROR_OUT_OF_MEMORY;
+    }
+    memcpy(copy, key.data, key.length);
+    copy[key.length] = '\0';
+
+    string_map_slot_t *slot = &map->slots[string_map_probe(map, key, hash)];
+    slot->hash = hash;
+    slot->key = copy;
+    slot->length = key.length;
+    slot->value = value;
+    map->count++;
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Look up an entry with a precomputed hash
+ * @param map Map to search
+ * @param key Key bytes
+ * @param hash Hash of the key
+ * @param value Receives the stored value when found
+ * @return bool true if the key is present
+ */
+static bool string_map_get_hashed(const string_map_t *map, string_view_t key, uint64_t hash, void **value) {
+    if (map->count == 0) {
+        return false;
+    }
+
+    const string_map_slot_t *slot = &map->slots[string_map_probe(map, key, hash)];
+    if (!slot->key) {
+        return false;
+    }
+
+    if (value) {
+        *value = slot->value;
+    }
+    return true;
+}
+
+/*
+ * ======================
+ * Map lifetime functions
+ * ======================
+ */
+
+/**
+ * @brief Create a new, empty map
+ * @return string_map_t* Pointer to new map or NULL on failure
+ * @details The slot array is allocated by the first insertion
+ */
+string_map_t *string_map_create(void) {
+    return calloc(1, sizeof(string_map_t));
+}
+
+/**
+ * @brief Destroy a map and its key copies
+ * @param map Map to destroy
+ */
+void string_map_destroy(string_map_t *map) {
+    if (!map) {
+        return;
+    }
+
+    string_map_clear(map);
+    free(map->slots);
+    free(map);
+}
+
+/**
+ * @brief Remove every entry, keeping the table allocated
+ * @param map Map to clear
+ */
+void string_map_clear(string_map_t *map) {
+    if (!map) {
+        return;
+    }
+
+    for (size_t i = 0; i < map->capacity; ++i) {
+        free(map->slots[i].key);
+        map->slots[i].key = NULL;
+    }
+    map->count = 0;
+}
+
+/**
+ * @brief Make room for a number of entries without further growth
+ * @param map Map to prepare
+ * @param count Total number of entries expected
+ * @return string_result_t Success or error code
+ */
+string_result_t string_map_reserve(string_map_t *map, size_t count) {
+    if (!map) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    size_t capacity = map->capacity ? map->capacity : STRING_MAP_MIN_SLOTS;
+    while (string_map_over_loaded(capacity, count)) {
+        if (capacity > SIZE_MAX / 2 / sizeof(string_map_slot_t)) {
+            return STRING_ERROR_OUT_OF_MEMORY;
+        }
+        capacity *= 2;
+    }
+
+    if (capacity == map->capacity) {
+        return STRING_SUCCESS;
+    }
+
+    return string_map_rehash(map, capacity);
+}
+
+/**
+ * @brief Get the number of entries
+ * @param map Map to query
+ * @return size_t Number of entries
+ */
+size_t string_map_size(const string_map_t *map) {
+    return map ? map->count : 0;
+}
+
+/*
+ * ========================
+ * Map access functions
+ * ========================
+ */
+
+/**
+ * @brief Insert an entry or replace the value of an existing key
+ * @param map Map to modify
+ * @param key Key bytes
+ * @param value Value to store
+ * @return string_result_t Success or error code
+ */
+string_result_t string_map_put(string_map_t *map, string_view_t key, void *value) {
+    if (!map || (!key.data && key.length > 0)) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    return string_map_put_hashed(map, key, string_view_hash(key), value);
+}
+
+/**
+ * @brief Insert an entry keyed by a string
+ * @param map Map to modify
+ * @param key Key string
+ * @param value Value to store
+ * @return string_result_t Success or error code
+ */
+string_result_t string_map_put_string(string_map_t *map, const string_t *key, void *value) {
+    if (!map || !key) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    return string_map_put_hashed(map, string_view_from_string(key), string_hash(key), value);
+}
+
+/**
+ * @brief Look up a key
+ * @param map Map to search
+ * @param key Key bytes
+ * @param value Receives the stored value when found
+ * @return bool true if the key is present
+ */
+bool string_map_get(const string_map_t *map, string_view_t key, void **value) {
+    if (!map || (!key.data && key.length > 0)) {
+        return false;
+    }
+
+    return string_map_get_hashed(map, key, string_view_hash(key), value);
+}
+
+/**
+ * @brief Look up a key given as a string
+ * @param map Map to search
+ * @param key Key string
+ * @param value Receives the stored value when found
+ * @return bool true if the key is present
+ */
+bool string_map_get_string(const string_map_t *map, const string_t *key, void **value) {
+    if (!map || !key) {
+        return false;
+    }
+
+    return string_map_get_hashed(map, string_view_from_string(key), string_hash(key), value);
+}
+
+/**
+ * @brief Remove an entry
+ * @param map Map to modify
+ * @param key Key bytes
+ * @param value Receives the removed value when found
+ * @return bool true if the key was present
+ * @details Later entries of the probe cluster are shifted back into the hole
+ *          whenever their home slot allows it.
+ */
+bool string_map_remove(string_map_t *map, string_view_t key, void **value) {
+    if (!map || map->count == 0 || (!key.data && key.length > 0)) {
+        return false;
+    }
+
+    size_t hole = string_map_probe(map, key, string_view_hash(key));
+    if (!map->slots[hole].key) {
+        return false;
+    }
+
+    if (value) {
+        *value = map->slots[hole].value;
+    }
+    free(map->slots[hole].key);
+    map->count--;
+
+    size_t mask = map->capacity - 1;
+    for (size_t index = (hole + 1) & mask; map->slots[index].key; index = (index + 1) & mask) {
+        // An entry may fill the hole only if the hole lies on its probe path
+        size_t home = (size_t)map->slots[index].hash & mask;
+        if (((index - home) & mask) >= ((index - hole) & mask)) {
+            map->slots[hole] = map->slots[index];
+            hole = index;
+        }
+    }
+    map->slots[hole].key = NULL;
+
+    return true;
+}
+
+/**
+ * @brief Iterate over the entries in table order
+ * @param map Map to iterate
+ * @param cursor Iteration state
+ * @param key Receives a view of the key
+ * @param value Receives the value
+ * @return bool true if an entry was returned
+ */
+bool string_map_next(const string_map_t *map, size_t *cursor, string_view_t *key, void **value) {
+    if (!map || !cursor) {
+        return false;
+    }
+
+    for (; *cursor < map->capacity; ++*cursor) {
+        const string_map_slot_t *slot = &map->slots[*cursor];
+        if (slot->key) {
+            if (key) {
+                *key = string_view_from_buffer(slot->key, slot->length);
+            }
+            if (value) {
+                *value = slot->value;
+            }
+            ++*cursor;
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file sstring_map.h
+ * @brief Hash map keyed by strings for the safe strings library
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * This header provides an open-addressing hash map from byte-string keys to
+ * caller-owned pointer values. The map keeps a private copy of every key and
+ * the full hash of every entry, so lookups compare hashes before bytes and
+ * growing the table never rehashes a key. Lookups accept views, so searching
+ * by a slice of a larger buffer never builds a temporary key; lookups by
+ * string_t reuse the hash cached by string_hash_cached().
+ *
+ * A map may be read from several threads at once, but must not be modified
+ * while other threads use it.
+ */
+
+#pragma once
+
+#include "sstring.h"
+
+/** @brief Opaque string-keyed hash map */
+typedef struct string_map string_map_t;
+
+/*
+ * ======================
+ * Map lifetime functions
+ * ======================
+ */
+
+/**
+ * @brief Create a new, empty map
+ * @return Pointer to newly created map, or NULL on failure
+ */
+string_map_t *string_map_create(void);
+
+/**
+ * @brief Destroy a map and its key copies
+ * @param map Map to destroy (can be NULL)
+ * @details Values are not touched; free them first if the map owns them.
+ */
+void string_map_destroy(string_map_t *map);
+
+/**
+ * @brief Remove every entry, keeping the table allocated
+ * @param map Map to clear
+ */
+void string_map_clear(string_map_t *map);
+
+/**
+ * @brief Make room for a number of entries without further growth
+ * @param map Map to prepare
+ * @param count Total number of entries expected
+ * @return STRING_SUCCESS on success, error code on failure
+ */
+string_result_t string_map_reserve(string_map_t *map, size_t count);
+
+/**
+ * @brief Get the number of entries
+ * @param map Map to query
+ * @return Number of entries (0 for NULL)
+ */
+size_t string_map_size(const string_map_t *map);
+
+/*
+ * ========================
+ * Map access functions
+ * ========================
+ */
+
+/**
+ * @brief Insert an entry or replace the value of an existing key
+ * @param map Map to modify
+ * @param key Key bytes (can contain null bytes, copied on first insertion)
+ * @param value Value to store
+ * @return STRING_SUCCESS on success, error code on failure
+ */
+string_result_t string_map_put(string_map_t *map, string_view_t key, void *value);
+
+/**
+ * @brief Insert an entry keyed by a string
+ * @param map Map to modify
+ * @param key Key string (its cached hash is used when present)
+ * @param value Value to store
+ * @return STRING_SUCCESS on success, error code on failure
+ */
+string_result_t string_map_put_string(string_map_t *map, const string_t *key, void *value);
+
+/**
+ * @brief Look up a key
+ * @param map Map to search
+ * @param key Key bytes
+ * @param value Receives the stored value when found (can be NULL)
+ * @return true if the key is present
+ * @details Never allocates.
+ */
+bool string_map_get(const string_map_t *map, string_view_t key, void **value);
+
+/**
+ * @brief Look up a key given as a string
+ * @param map Map to search
+ * @param key Key string (its cached hash is used when present)
+ * @param value Receives the stored value when found (can be NULL)
+ * @return true if the key is present
+ */
+bool string_map_get_string(const string_map_t *map, const string_t *key, void **value);
+
+/**
+ * @brief Remove an entry
+ * @param map Map to modify
+ * @param key Key bytes
+ * @param value Receives the removed value when found (can be NULL)
+ * @return true if the key was present
+ */
+bool string_map_remove(string_map_t *map, string_view_t key, void **value);
+
+/**
+ * @brief Iterate over the entries in table order
+ * @param map Map to iterate
+ * @param cursor Iteration state, set to 0 before the first call
+ * @param key Receives a view of the key, valid until the entry is removed (can be NULL)
+ * @param value Receives the value (can be NULL)
+ * @return true if an entry was returned, false when the iteration is complete
+ * @details The map must not be modified during an iteration.
+ */
+bool string_map_next(const string_map_t *map, size_t *cursor, string_view_t *key, void **value);
@@ -0,0 +1,433 @@
+/**
+ * @file sstring_matcher.c
+ * @brief Implementation of the multi-pattern (Aho-Corasick) matcher
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * Patterns are collected first and compiled in one step into a complete
+ * deterministic automaton. The input alphabet is compressed into the classes
+ * of bytes that actually occur in patterns (plus one class for every other
+ * byte), which keeps the transition table small for large pattern sets.
+ * Scanning is one table lookup per input byte.
+ */
+
+#include "sstring_matcher.h"
+
+/** @brief Marker for "no node" / "no pattern" */
+#define STRING_MATCHER_NONE UINT32_MAX
+
+/**
+ * @brief Stored pattern
+ */
+typedef struct {
+    char *bytes;    /**< Private copy of the pattern */
+    size_t length;  /**< Pattern length */
+    uint32_t next;  /**< Next pattern ending at the same node */
+} string_matcher_pattern_t;
+
+/**
+ * @brief Multi-pattern matcher state
+ */
+struct string_matcher {
+    string_matcher_pattern_t *patterns;  /**< Patterns in insertion order */
+    size_t pattern_count;                /**< Number of patterns */
+    size_t pattern_capacity;             /**< Allocated pattern slots */
+
+    bool is_compiled;                    /**< Whether the automaton is up to date */
+    uint16_t byte_class[256];            /**< Alphabet class of each byte value */
+    size_t class_count;                  /**< Number of alphabet classes */
+    uint32_t *delta;                     /**< Transition table (node_count x class_count) */
+    uint32_t *first_pattern;             /**< First pattern ending at each node */
+    uint32_t *output_link;               /**< Nearest proper suffix node that ends a pattern */
+    size_t node_count;                   /**< Number of automaton nodes */
+};
+
+/*
+ * ==========================
+ * Internal helper functions
+ * ==========================
+ */
+
+/**
+ * @brief Release the compiled automaton of a matcher
+ * @param matcher Matcher to reset
+ */
+static void string_matcher_discard(string_matcher_t *matcher) {
+    free(matcher->delta);
+    free(matcher->first_pattern);
+    free(matcher->output_link);
+    matcher->delta = NULL;
+    matcher->first_pattern = NULL;
+    matcher->output_link = NULL;
+    matcher->node_count = 0;
+    matcher->is_compiled = false;
+}
+
+/**
+ * @brief Report all patterns that end at a node
+ * @param matcher Compiled matcher
+ * @param node Node reached after consuming the byte at end_offset
+ * @param end_offset Stream offset of the last matched byte
+ * @param callback User callback
+ * @param user_data User callback data
+ * @return bool false if the callback asked to stop
+ */
+static bool string_matcher_report(const string_matcher_t *matcher,
+                                  uint32_t node,
+                                  size_t end_offset,
+                                  string_match_callback_t callback,
+                                  void *user_data) {
+    if (matcher->first_pattern[node] == STRING_MATCHER_NONE) {
+        node = matcher->output_link[node];
+    }
+
+    while (node != STRING_MATCHER_NONE) {
+        for (uint32_t id = matcher->first_pattern[node]; id != STRING_MATCHER_NONE; id = matcher->patterns[id].next) {
+            string_match_t match;
+            match.pattern_id = id;
+            match.length = matcher->patterns[id].length;
+            match.offset = end_offset + 1 - match.length;
+            if (!callback(&match, user_data)) {
+                return false;
+            }
+        }
+        node = matcher->output_link[node];
+    }
+
+    return true;
+}
+
+/*
+ * =====================
+ * Matcher construction
+ * =====================
+ */
+
+/**
+ * @brief Create a new, empty matcher
+ * @return string_matcher_t* Pointer to new matcher or NULL on failure
+ */
+string_matcher_t *string_matcher_create(void) {
+    return calloc(1, sizeof(string_matcher_t));
+}
+
+/**
+ * @brief Add a pattern to a matcher
+ * @param matcher Matcher to add to
+ * @param pattern Pattern bytes
+ * @param length Pattern length
+ * @param pattern_id Receives the pattern id
+ * @return string_result_t Success or error code
+ * @details Copies the pattern and invalidates any compiled automaton
+ */
+string_result_t string_matcher_add(string_matcher_t *matcher, const char *pattern, size_t length, size_t *pattern_id) {
+    if (!matcher || !pattern) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    if (length == 0 || matcher->pattern_count >= STRING_MATCHER_NONE) {
+        return STRING_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (matcher->pattern_count == matcher->pattern_capacity) {
+        size_t new_capacity = matcher->pattern_capacity ? matcher->pattern_capacity * 2 : 16;
+        string_matcher_pattern_t *patterns = realloc(matcher->patterns, new_capacity * sizeof(string_matcher_pattern_t));
+        if (!patterns) {
+            return STRING_ERROR_OUT_OF_MEMORY;
+        }
+        matcher->patterns = patterns;
+        matcher->pattern_capacity = new_capacity;
+    }
+
+    char *bytes = malloc(length);
+    if (!bytes) {
+        return STRING_ERROR_OUT_OF_MEMORY;
+    }
+    memcpy(bytes, pattern, length);
+
+    string_matcher_pattern_t *entry = &matcher->patterns[matcher->pattern_count];
+    entry->bytes = bytes;
+    entry->length = length;
+    entry->next = STRING_MATCHER_NONE;
+
+    if (pattern_id) {
+        *pattern_id = matcher->pattern_count;
+    }
+    matcher->pattern_count++;
+    string_matcher_discard(matcher);
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Add a null-terminated C string pattern to a matcher
+ * @param matcher Matcher to add to
+ * @param cstr Pattern C string
+ * @param pattern_id Receives the pattern id
+ * @return string_result_t Success or error code
+ */
+string_result_t string_matcher_add_cstr(string_matcher_t *matcher, const char *cstr, size_t *pattern_id) {
+    if (!cstr) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    return string_matcher_add(matcher, cstr, strlen(cstr), pattern_id);
+}
+
+/**
+ * @brief Add the content of a string as a pattern
+ * @param matcher Matcher to add to
+ * @param pattern Pattern string
+ * @param pattern_id Receives the pattern id
+ * @return string_result_t Success or error code
+ */
+string_result_t string_matcher_add_string(string_matcher_t *matcher, const string_t *pattern, size_t *pattern_id) {
+    if (!pattern) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    return string_matcher_add(matcher, pattern->data, pattern->length, pattern_id);
+}
+
+/**
+ * @brief Compile the added patterns into a scanning automaton
+ * @param matcher Matcher to compile
+ * @return string_result_t Success or error code
+ * @details Builds the trie, then fills failure transitions breadth-first so that
+ *          every (node, class) pair has a direct transition
+ */
+string_result_t string_matcher_compile(string_matcher_t *matcher) {
+    if (!matcher) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    string_matcher_discard(matcher);
+
+    // Alphabet compression: class 0 is every byte that never occurs in a pattern
+    memset(matcher->byte_class, 0, sizeof(matcher->byte_class));
+    size_t class_count = 1;
+    size_t max_nodes = 1;
+    for (size_t p = 0; p < matcher->pattern_count; ++p) {
+        const string_matcher_pattern_t *pattern = &matcher->patterns[p];
+        for (size_t i = 0; i < pattern->length; ++i) {
+            unsigned char c = (unsigned char)pattern->bytes[i];
+            if (matcher->byte_class[c] == 0) {
+                matcher->byte_class[c] = (uint16_t)class_count++;
+            }
+        }
+        max_nodes += pattern->length;
+    }
+    if (max_nodes >= STRING_MATCHER_NONE / class_count) {
+        return STRING_ERROR_OUT_OF_MEMORY;
+    }
+    matcher->class_count = class_count;
+
+    uint32_t *delta = malloc(max_nodes * class_count * sizeof(uint32_t));
+    uint32_t *fail = malloc(max_nodes * sizeof(uint32_t));
+    uint32_t *queue = malloc(max_nodes * sizeof(uint32_t));
+    matcher->first_pattern = malloc(max_nodes * sizeof(uint32_t));
+    matcher->output_link = malloc(max_nodes * sizeof(uint32_t));
+    if (!delta || !fail || !queue || !matcher->first_pattern || !matcher->output_link) {
+        free(delta);
+        free(fail);
+        free(queue);
+        string_matcher_discard(matcher);
+        return STRING_ERROR_OUT_OF_MEMORY;
+    }
+
+    // Build the trie; missing edges are marked and filled in below
+    size_t node_count = 1;
+    for (size_t i = 0; i < class_count; ++i) {
+        delta[i] = STRING_MATCHER_NONE;
+    }
+    matcher->first_pattern[0] = STRING_MATCHER_NONE;
+
+    for (size_t p = 0; p < matcher->pattern_count; ++p) {
+        string_matcher_pattern_t *pattern = &matcher->patterns[p];
+        uint32_t node = 0;
+        for (size_t i = 0; i < pattern->length; ++i) {
+            size_t cls = matcher->byte_class[(unsigned char)pattern->bytes[i]];
+            uint32_t next = delta[node * class_count + cls];
+            if (next == STRING_MATCHER_NONE) {
+                next = (uint32_t)node_count++;
+                for (size_t k = 0; k < class_count; ++k) {
+                    delta[next * class_count + k] = STRING_MATCHER_NONE;
+                }
+                matcher->first_pattern[next] = STRING_MATCHER_NONE;
+                delta[node * class_count + cls] = next;
+            }
+            node = next;
+        }
+
+        // Keep patterns that end at the same node in insertion order
+        pattern->next = STRING_MATCHER_NONE;
+        if (matcher->first_pattern[node] == STRING_MATCHER_NONE) {
+            matcher->first_pattern[node] = (uint32_t)p;
+        } else {
+            uint32_t id = matcher->first_pattern[node];
+            while (matcher->patterns[id].next != STRING_MATCHER_NONE) {
+                id = matcher->patterns[id].next;
+            }
+            matcher->patterns[id].next = (uint32_t)p;
+        }
+    }
+
+    // Breadth-first pass: failure links, output links and complete transitions
+    size_t head = 0, tail = 0;
+    fail[0] = 0;
+    matcher->output_link[0] = STRING_MATCHER_NONE;
+    for (size_t k = 0; k < class_count; ++k) {
+        uint32_t child = delta[k];
+        if (child == STRING_MATCHER_NONE) {
+            delta[k] = 0;
+        } else {
+            fail[child] = 0;
+            matcher->output_link[child] = STRING_MATCHER_NONE;
+            queue[tail++] = child;
+        }
+    }
+
+    while (head < tail) {
+        uint32_t node = queue[head++];
+        for (size_t k = 0; k < class_count; ++k) {
+            uint32_t child = delta[node * class_count + k];
+            uint32_t fallback = delta[fail[node] * class_count + k];
+            if (child == STRING_MATCHER_NONE) {
+                delta[node * class_count + k] = fallback;
+            } else {
+                fail[child] = fallback;
+                matcher->output_link[child] = matcher->first_pattern[fallback] != STRING_MATCHER_NONE ? fallback : matcher->output_link[fallback];
+                queue[tail++] = child;
+            }
+        }
+    }
+
+    free(fail);
+    free(queue);
+
+    matcher->delta = delta;
+    matcher->node_count = node_count;
+    matcher->is_compiled = true;
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Get the number of patterns in a matcher
+ * @param matcher Matcher to query
+ * @return size_t Number of patterns
+ */
+size_t string_matcher_pattern_count(const string_matcher_t *matcher) {
+    return matcher ? matcher->pattern_count : 0;
+}
+
+/**
+ * @brief Destroy a matcher and free its memory
+ * @param matcher Matcher to destroy
+ */
+void string_matcher_destroy(string_matcher_t *matcher) {
+    if (!matcher) {
+        return;
+    }
+
+    for (size_t p = 0; p < matcher->pattern_count; ++p) {
+        free(matcher->patterns[p].bytes);
+    }
+    free(matcher->patterns);
+    string_matcher_discard(matcher);
+    free(matcher);
+}
+
+/*
+ * =================
+ * Matcher scanning
+ * =================
+ */
+
+/**
+ * @brief Initialize a streaming scan state
+ * @param stream Stream object to initialize
+ */
+void string_matcher_stream_init(string_matcher_stream_t *stream) {
+    if (stream) {
+        stream->state = 0;
+        stream->offset = 0;
+    }
+}
+
+/**
+ * @brief Feed the next chunk of a stream to a matcher
+ * @param matcher Compiled matcher
+ * @param stream Stream state
+ * @param chunk Next chunk of input
+ * @param callback Match callback
+ * @param user_data Callback data
+ * @return string_result_t Success or error code
+ * @details If the callback stops the scan, the stream is left just after the byte
+ *          that completed the reported match
+ */
+string_result_t string_matcher_feed(const string_matcher_t *matcher,
+                                    string_matcher_stream_t *stream,
+                                    string_view_t chunk,
+                                    string_match_callback_t callback,
+                                    void *user_data) {
+    if (!matcher || !stream || !callback) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    if (!matcher->is_compiled) {
+        return STRING_ERROR_INVALID_ARGUMENT;
+    }
+
+    const unsigned char *bytes = (const unsigned char *)chunk.data;
+    const uint32_t *delta = matcher->delta;
+    const size_t class_count = matcher->class_count;
+    uint32_t state = stream->state;
+
+    for (size_t i = 0; i < chunk.length; ++i) {
+        state = delta[state * class_count + matcher->byte_class[bytes[i]]];
+        if (matcher->first_pattern[state] != STRING_MATCHER_NONE || matcher->output_link[state] != STRING_MATCHER_NONE) {
+            if (!string_matcher_report(matcher, state, stream->offset + i, callback, user_data)) {
+                stream->state = state;
+                stream->offset += i + 1;
+                return STRING_SUCCESS;
+            }
+        }
+    }
+
+    stream->state = state;
+    stream->offset += chunk.length;
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Report every match of every pattern in a view
+ * @param matcher Compiled matcher
+ * @param text View to scan
+ * @param callback Match callback
+ * @param user_data Callback data
+ * @return string_result_t Success or error code
+ */
+string_result_t string_matcher_scan(const string_matcher_t *matcher, string_view_t text, string_match_callback_t callback, void *user_data) {
+    string_matcher_stream_t stream;
+    string_matcher_stream_init(&stream);
+
+    return string_matcher_feed(matcher, &stream, text, callback, user_data);
+}
+
+/**
+ * @brief Report every match of every pattern in a string
+ * @param matcher Compiled matcher
+ * @param str String to scan
+ * @param callback Match callback
+ * @param user_data Callback data
+ * @return string_result_t Success or error code
+ */
+string_result_t string_matcher_scan_string(const string_matcher_t *matcher, const string_t *str, string_match_callback_t callback, void *user_data) {
+    if (!str) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    return string_matcher_scan(matcher, string_view_from_string(str), callback, user_data);
+}
@@ -0,0 +1,160 @@
+/**
+ * @file sstring_matcher.h
+ * @brief Multi-pattern (Aho-Corasick) matcher for the safe strings library
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * This header provides a matcher that is built once from a set of patterns and
+ * then reports every occurrence of every pattern in a single pass over the
+ * input. Patterns are byte sequences and may contain null bytes. The matcher
+ * also supports streaming input: the automaton state is kept in a caller-owned
+ * stream object, so matches that straddle chunk boundaries are still found.
+ *
+ * A compiled matcher is read-only and can be shared between threads; each
+ * thread needs its own stream object.
+ */
+
+#pragma once
+
+#include "sstring.h"
+
+/** @brief Opaque multi-pattern matcher */
+typedef struct string_matcher string_matcher_t;
+
+/**
+ * @brief A single match reported by the matcher
+ */
+typedef struct {
+    size_t pattern_id;  /**< Index of the pattern, in the order patterns were added */
+    size_t offset;      /**< Offset of the first byte of the match (from the start of the stream) */
+    size_t length;      /**< Length of the matched pattern */
+} string_match_t;
+
+/**
+ * @brief Callback invoked for every match
+ * @param match Match being reported
+ * @param user_data Pointer passed through from the scan call
+ * @return true to continue scanning, false to stop
+ */
+typedef bool (*string_match_callback_t)(const string_match_t *match, void *user_data);
+
+/**
+ * @brief Streaming scan state
+ * @details Initialize with string_matcher_stream_init() and pass the same object to
+ *          every string_matcher_feed() call for one logical input stream.
+ */
+typedef struct {
+    uint32_t state;  /**< Current automaton state */
+    size_t offset;   /**< Number of bytes fed so far */
+} string_matcher_stream_t;
+
+/*
+ * =====================
+ * Matcher construction
+ * =====================
+ */
+
+/**
+ * @brief Create a new, empty matcher
+ * @return Pointer to newly created matcher, or NULL on failure
+ */
+string_matcher_t *string_matcher_create(void);
+
+/**
+ * @brief Add a pattern to a matcher
+ * @param matcher Matcher to add the pattern to
+ * @param pattern Pattern bytes (can contain null bytes, copied into the matcher)
+ * @param length Number of bytes in the pattern (must be non-zero)
+ * @param pattern_id Receives the id of the pattern (can be NULL)
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Adding a pattern discards any previous compilation.
+ */
+string_result_t string_matcher_add(string_matcher_t *matcher, const char *pattern, size_t length, size_t *pattern_id);
+
+/**
+ * @brief Add a null-terminated C string pattern to a matcher
+ * @param matcher Matcher to add the pattern to
+ * @param cstr Pattern C string (null-terminated, non-empty)
+ * @param pattern_id Receives the id of the pattern (can be NULL)
+ * @return STRING_SUCCESS on success, error code on failure
+ */
+string_result_t string_matcher_add_cstr(string_matcher_t *matcher, const char *cstr, size_t *pattern_id);
+
+/**
+ * @brief Add the content of a string as a pattern
+ * @param matcher Matcher to add the pattern to
+ * @param pattern Pattern string (non-empty)
+ * @param pattern_id Receives the id of the pattern (can be NULL)
+ * @return STRING_SUCCESS on success, error code on failure
+ */
+string_result_t string_matcher_add_string(string_matcher_t *matcher, const string_t *pattern, size_t *pattern_id);
+
+/**
+ * @brief Compile the added patterns into a scanning automaton
+ * @param matcher Matcher to compile
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Must be called after the last pattern is added and before scanning.
+ */
+string_result_t string_matcher_compile(string_matcher_t *matcher);
+
+/**
+ * @brief Get the number of patterns in a matcher
+ * @param matcher Matcher to query
+ * @return Number of patterns (0 if matcher is NULL)
+ */
+size_t string_matcher_pattern_count(const string_matcher_t *matcher);
+
+/**
+ * @brief Destroy a matcher and free its memory
+ * @param matcher Matcher to destroy (can be NULL)
+ */
+void string_matcher_destroy(string_matcher_t *matcher);
+
+/*
+ * =================
+ * Matcher scanning
+ * =================
+ */
+
+/**
+ * @brief Report every match of every pattern in a view
+ * @param matcher Compiled matcher
+ * @param text View to scan
+ * @param callback Function called for each match, in order of match end position
+ * @param user_data Pointer passed to the callback
+ * @return STRING_SUCCESS on success, error code on failure
+ */
+string_result_t string_matcher_scan(const string_matcher_t *matcher, string_view_t text, string_match_callback_t callback, void *user_data);
+
+/**
+ * @brief Report every match of every pattern in a string
+ * @param matcher Compiled matcher
+ * @param str String to scan
+ * @param callback Function called for each match, in order of match end position
+ * @param user_data Pointer passed to the callback
+ * @return STRING_SUCCESS on success, error code on failure
+ */
+string_result_t string_matcher_scan_string(const string_matcher_t *matcher, const string_t *str, string_match_callback_t callback, void *user_data);
+
+/**
+ * @brief Initialize a streaming scan state
+ * @param stream Stream object to initialize
+ */
+void string_matcher_stream_init(string_matcher_stream_t *stream);
+
+/**
+ * @brief Feed the next chunk of a stream to a matcher
+ * @param matcher Compiled matcher
+ * @param stream Stream state carried across chunks
+ * @param chunk Next chunk of input
+ * @param callback Function called for each match
+ * @param user_data Pointer passed to the callback
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Match offsets are relative to the start of the stream, so a match that
+ *          began in an earlier chunk reports an offset inside that chunk.
+ */
+string_result_t string_matcher_feed(const string_matcher_t *matcher,
+                                    string_matcher_stream_t *stream,
+                                    string_view_t chunk,
+                                    string_match_callback_t callback,
+                                    void *user_data);
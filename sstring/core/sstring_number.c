@@ -0,0 +1,987 @@
+/**
+ * @file sstring_number.c
+ * @brief Implementation of the internal number formatting and parsing kernels
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * Integers are formatted two digits at a time from a lookup table. Doubles are
+ * formatted with the shortest digit string that reads back to the same value:
+ * integral values below 2^53 take an integer fast path, everything else goes
+ * through Loitsch's Grisu3 on 64-bit arithmetic, and the rare values Grisu3
+ * cannot decide fall back to the exact free-format algorithm of Burger and
+ * Dybvig on small fixed-size big integers. Parsing uses Clinger's exact fast path and falls back to
+ * strtod() for inputs that need more than double precision arithmetic.
+ */
+
+#include <locale.h>
+#include <math.h>
+
+#include "sstring_number.h"
+
+/** @brief Number of 32-bit words in a big integer (enough for every double) */
+#define STRING_BIGNUM_WORDS 40
+
+/** @brief Decimal digits of every value from 00 to 99 */
+static const char string_number_digit_pairs[201] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/** @brief Powers of ten that are exactly representable as doubles */
+static const double string_number_exact_pow10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/** @brief Powers of ten that fit in 32 bits */
+static const uint32_t string_number_pow10_u32[] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+
+/** @brief Decimal distance between consecutive cached powers of ten */
+#define STRING_CACHED_POWER_STEP 8
+
+/** @brief Offset of 10^0 from the first cached power of ten */
+#define STRING_CACHED_POWER_OFFSET 348
+
+/**
+ * @brief Normalized 64-bit approximation of a power of ten
+ */
+typedef struct {
+    uint64_t significand;  /**< Rounded significand with the top bit set */
+    int16_t binary_exponent;   /**< Power of two applied to the significand */
+    int16_t decimal_exponent;  /**< Power of ten being approximated */
+} string_cached_power_t;
+
+/** @brief Powers of ten from 10^-348 to 10^340 in steps of STRING_CACHED_POWER_STEP */
+static const string_cached_power_t string_cached_powers[] = {
+    {UINT64_C(0xfa8fd5a0081c0288), -1220, -348},
+    {UINT64_C(0xbaaee17fa23ebf76), -1193, -340},
+    {UINT64_C(0x8b16fb203055ac76), -1166, -332},
+    {UINT64_C(0xcf42894a5dce35ea), -1140, -324},
+    {UINT64_C(0x9a6bb0aa55653b2d), -1113, -316},
+    {UINT64_C(0xe61acf033d1a45df), -1087, -308},
+    {UINT64_C(0xab70fe17c79ac6ca), -1060, -300},
+    {UINT64_C(0xff77b1fcbebcdc4f), -1034, -292},
+    {UINT64_C(0xbe5691ef416bd60c), -1007, -284},
+    {UINT64_C(0x8dd01fad907ffc3c),  -980, -276},
+    {UINT64_C(0xd3515c2831559a83),  -954, -268},
+    {UINT64_C(0x9d71ac8fada6c9b5),  -927, -260},
+    {UINT64_C(0xea9c227723ee8bcb),  -901, -252},
+    {UINT64_C(0xaecc49914078536d),  -874, -244},
+    {UINT64_C(0x823c12795db6ce57),  -847, -236},
+    {UINT64_C(0xc21094364dfb5637),  -821, -228},
+    {UINT64_C(0x9096ea6f3848984f),  -794, -220},
+    {UINT64_C(0xd77485cb25823ac7),  -768, -212},
+    {UINT64_C(0xa086cfcd97bf97f4),  -741, -204},
+    {UINT64_C(0xef340a98172aace5),  -715, -196},
+    {UINT64_C(0xb23867fb2a35b28e),  -688, -188},
+    {UINT64_C(0x84c8d4dfd2c63f3b),  -661, -180},
+    {UINT64_C(0xc5dd44271ad3cdba),  -635, -172},
+    {UINT64_C(0x936b9fcebb25c996),  -608, -164},
+    {UINT64_C(0xdbac6c247d62a584),  -582, -156},
+    {UINT64_C(0xa3ab66580d5fdaf6),  -555, -148},
+    {UINT64_C(0xf3e2f893dec3f126),  -529, -140},
+    {UINT64_C(0xb5b5ada8aaff80b8),  -502, -132},
+    {UINT64_C(0x87625f056c7c4a8b),  -475, -124},
+    {UINT64_C(0xc9bcff6034c13053),  -449, -116},
+    {UINT64_C(0x964e858c91ba2655),  -422, -108},
+    {UINT64_C(0xdff9772470297ebd),  -396, -100},
+    {UINT64_C(0xa6dfbd9fb8e5b88f),  -369,  -92},
+    {UINT64_C(0xf8a95fcf88747d94),  -343,  -84},
+    {UINT64_C(0xb94470938fa89bcf),  -316,  -76},
+    {UINT64_C(0x8a08f0f8bf0f156b),  -289,  -68},
+    {UINT64_C(0xcdb02555653131b6),  -263,  -60},
+    {UINT64_C(0x993fe2c6d07b7fac),  -236,  -52},
+    {UINT64_C(0xe45c10c42a2b3b06),  -210,  -44},
+    {UINT64_C(0xaa242499697392d3),  -183,  -36},
+    {UINT64_C(0xfd87b5f28300ca0e),  -157,  -28},
+    {UINT64_C(0xbce5086492111aeb),  -130,  -20},
+    {UINT64_C(0x8cbccc096f5088cc),  -103,  -12},
+    {UINT64_C(0xd1b71758e219652c),   -77,   -4},
+    {UINT64_C(0x9c40000000000000),   -50,    4},
+    {UINT64_C(0xe8d4a51000000000),   -24,   12},
+    {UINT64_C(0xad78ebc5ac620000),     3,   20},
+    {UINT64_C(0x813f3978f8940984),    30,   28},
+    {UINT64_C(0xc097ce7bc90715b3),    56,   36},
+    {UINT64_C(0x8f7e32ce7bea5c70),    83,   44},
+    {UINT64_C(0xd5d238a4abe98068),   109,   52},
+    {UINT64_C(0x9f4f2726179a2245),   136,   60},
+    {UINT64_C(0xed63a231d4c4fb27),   162,   68},
+    {UINT64_C(0xb0de65388cc8ada8),   189,   76},
+    {UINT64_C(0x83c7088e1aab65db),   216,   84},
+    {UINT64_C(0xc45d1df942711d9a),   242,   92},
+    {UINT64_C(0x924d692ca61be758),   269,  100},
+    {UINT64_C(0xda01ee641a708dea),   295,  108},
+    {UINT64_C(0xa26da3999aef774a),   322,  116},
+    {UINT64_C(0xf209787bb47d6b85),   348,  124},
+    {UINT64_C(0xb454e4a179dd1877),   375,  132},
+    {UINT64_C(0x865b86925b9bc5c2),   402,  140},
+    {UINT64_C(0xc83553c5c8965d3d),   428,  148},
+    {UINT64_C(0x952ab45cfa97a0b3),   455,  156},
+    {UINT64_C(0xde469fbd99a05fe3),   481,  164},
+    {UINT64_C(0xa59bc234db398c25),   508,  172},
+    {UINT64_C(0xf6c69a72a3989f5c),   534,  180},
+    {UINT64_C(0xb7dcbf5354e9bece),   561,  188},
+    {UINT64_C(0x88fcf317f22241e2),   588,  196},
+    {UINT64_C(0xcc20ce9bd35c78a5),   614,  204},
+    {UINT64_C(0x98165af37b2153df),   641,  212},
+    {UINT64_C(0xe2a0b5dc971f303a),   667,  220},
+    {UINT64_C(0xa8d9d1535ce3b396),   694,  228},
+    {UINT64_C(0xfb9b7cd9a4a7443c),   720,  236},
+    {UINT64_C(0xbb764c4ca7a44410),   747,  244},
+    {UINT64_C(0x8bab8eefb6409c1a),   774,  252},
+    {UINT64_C(0xd01fef10a657842c),   800,  260},
+    {UINT64_C(0x9b10a4e5e9913129),   827,  268},
+    {UINT64_C(0xe7109bfba19c0c9d),   853,  276},
+    {UINT64_C(0xac2820d9623bf429),   880,  284},
+    {UINT64_C(0x80444b5e7aa7cf85),   907,  292},
+    {UINT64_C(0xbf21e44003acdd2d),   933,  300},
+    {UINT64_C(0x8e679c2f5e44ff8f),   960,  308},
+    {UINT64_C(0xd433179d9c8cb841),   986,  316},
+    {UINT64_C(0x9e19db92b4e31ba9),  1013,  324},
+    {UINT64_C(0xeb96bf6ebadf77d9),  1039,  332},
+    {UINT64_C(0xaf87023b9bf0ee6b),  1066,  340},
+};
+
+/**
+ * @brief Extended-range floating-point value with a 64-bit significand
+ */
+typedef struct {
+    uint64_t f;  /**< Significand */
+    int e;       /**< Binary exponent: value = f * 2^e */
+} string_diy_fp_t;
+
+/**
+ * @brief Fixed-size unsigned big integer
+ */
+typedef struct {
+    uint32_t word[STRING_BIGNUM_WORDS];  /**< Little-endian 32-bit words */
+    size_t size;                         /**< Number of used words (0 for zero) */
+} string_bignum_t;
+
+/*
+ * ==========================
+ * Internal helper functions
+ * ==========================
+ */
+
+/**
+ * @brief Count the decimal digits of a value
+ * @param value Value to measure
+ * @return size_t Number of digits (1 for zero)
+ */
+static size_t string_number_count_digits(uint64_t value) {
+    size_t count = 1;
+
+    for (;;) {
+        if (value < 10) return count;
+        if (value < 100) return count + 1;
+        if (value < 1000) return count + 2;
+        if (value < 10000) return count + 3;
+        value /= 10000;
+        count += 4;
+    }
+}
+
+/**
+ * @brief Set a big integer from a 64-bit value
+ * @param num Big integer to set
+ * @param value Value to store
+ */
+static void string_bignum_set(string_bignum_t *num, uint64_t value) {
+    num->size = 0;
+    while (value) {
+        num->word[num->size++] = (uint32_t)value;
+        value >>= 32;
+    }
+}
+
+/**
+ * @brief Multiply a big integer by a small factor in place
+ * @param num Big integer to multiply
+ * @param factor Factor
+ */
+static void string_bignum_mul_small(string_bignum_t *num, uint32_t factor) {
+    uint64_t carry = 0;
+
+    for (size_t i = 0; i < num->size; ++i) {
+        uint64_t product = (uint64_t)num->word[i] * factor + carry;
+        num->word[i] = (uint32_t)product;
+        carry = product >> 32;
+    }
+    if (carry) {
+        num->word[num->size++] = (uint32_t)carry;
+    }
+}
+
+/**
+ * @brief Multiply a big integer by a power of ten in place
+ * @param num Big integer to multiply
+ * @param exponent Non-negative power of ten
+ */
+static void string_bignum_mul_pow10(string_bignum_t *num, int exponent) {
+    while (exponent >= 9) {
+        string_bignum_mul_small(num, string_number_pow10_u32[9]);
+        exponent -= 9;
+    }
+    if (exponent > 0) {
+        string_bignum_mul_small(num, string_number_pow10_u32[exponent]);
+    }
+}
+
+/**
+ * @brief Shift a big integer left in place
+ * @param num Big integer to shift
+ * @param bits Number of bits to shift by
+ */
+static void string_bignum_shift_left(string_bignum_t *num, unsigned bits) {
+    if (num->size == 0) {
+        return;
+    }
+
+    size_t words = bits / 32;
+    unsigned rest = bits % 32;
+
+    if (rest) {
+        uint32_t carry = 0;
+        for (size_t i = 0; i < num->size; ++i) {
+            uint32_t word = num->word[i];
+            num->word[i] = (word << rest) | carry;
+            carry = word >> (32 - rest);
+        }
+        if (carry) {
+            num->word[num->size++] = carry;
+        }
+    }
+
+    if (words) {
+        for (size_t i = num->size; i-- > 0;) {
+            num->word[i + words] = num->word[i];
+        }
+        memset(num->word, 0, words * sizeof(uint32_t));
+        num->size += words;
+    }
+}
+
+/**
+ * @brief Compare two big integers
+ * @param a First big integer
+ * @param b Second big integer
+ * @return int Negative, zero or positive like memcmp()
+ */
+static int string_bignum_compare(const string_bignum_t *a, const string_bignum_t *b) {
+    if (a->size != b->size) {
+        return a->size < b->size ? -1 : 1;
+    }
+
+    for (size_t i = a->size; i-- > 0;) {
+        if (a->word[i] != b->word[i]) {
+            return a->word[i] < b->word[i] ? -1 : 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Add two big integers
+ * @param result Receives a + b (may not alias the operands)
+ * @param a First operand
+ * @param b Second operand
+ */
+static void string_bignum_add(string_bignum_t *result, const string_bignum_t *a, const string_bignum_t *b) {
+    const string_bignum_t *longer = a->size >= b->size ? a : b;
+    const string_bignum_t *shorter = a->size >= b->size ? b : a;
+    uint64_t carry = 0;
+
+    for (size_t i = 0; i < longer->size; ++i) {
+        uint64_t sum = (uint64_t)longer->word[i] + (i < shorter->size ? shorter->word[i] : 0) + carry;
+        result->word[i] = (uint32_t)sum;
+        carry = sum >> 32;
+    }
+    result->size = longer->size;
+    if (carry) {
+        result->word[result->size++] = (uint32_t)carry;
+    }
+}
+
+/**
+ * @brief Subtract a big integer in place
+ * @param a Minuend, receives a - b
+ * @param b Subtrahend (must not be larger than a)
+ */
+static void string_bignum_sub(string_bignum_t *a, const string_bignum_t *b) {
+    uint32_t borrow = 0;
+
+    for (size_t i = 0; i < a->size; ++i) {
+        uint64_t subtrahend = (uint64_t)(i < b->size ? b->word[i] : 0) + borrow;
+        borrow = a->word[i] < subtrahend;
+        a->word[i] = (uint32_t)((uint64_t)a->word[i] - subtrahend);
+    }
+    while (a->size && a->word[a->size - 1] == 0) {
+        a->size--;
+    }
+}
+
+/**
+ * @brief Compute ceil(exponent * log10(2)) for binary exponents of doubles
+ * @param exponent Binary exponent
+ * @return int Rounded-up decimal exponent
+ */
+static int string_number_ceil_log10_pow2(int exponent) {
+    double estimate = exponent * 0.30102999566398114;
+    int k = (int)estimate;
+
+    return estimate > k ? k + 1 : k;
+}
+
+/**
+ * @brief Multiply two extended-range values, rounding the 128-bit product to 64 bits
+ * @param a First operand
+ * @param b Second operand
+ * @return string_diy_fp_t Product
+ */
+static string_diy_fp_t string_diy_fp_multiply(string_diy_fp_t a, string_diy_fp_t b) {
+    const uint64_t mask = 0xffffffffu;
+    uint64_t ah = a.f >> 32, al = a.f & mask;
+    uint64_t bh = b.f >> 32, bl = b.f & mask;
+    uint64_t hh = ah * bh, hl = ah * bl, lh = al * bh, ll = al * bl;
+    uint64_t middle = (ll >> 32) + (hl & mask) + (lh & mask) + (UINT64_C(1) << 31);
+
+    string_diy_fp_t result;
+    result.f = hh + (hl >> 32) + (lh >> 32) + (middle >> 32);
+    result.e = a.e + b.e + 64;
+    return result;
+}
+
+/**
+ * @brief Shift an extended-range value so that the top significand bit is set
+ * @param value Value to normalize (non-zero)
+ * @return string_diy_fp_t Normalized value
+ */
+static string_diy_fp_t string_diy_fp_normalize(string_diy_fp_t value) {
+    while (!(value.f >> 63)) {
+        value.f <<= 1;
+        value.e--;
+    }
+
+    return value;
+}
+
+/**
+ * @brief Round the last generated digit towards the value and check the result is exact
+ * @return bool true if the digits are guaranteed to be the shortest correct ones
+ * @details Grisu3 "round and weed" step: all distances are in the same scaled
+ *          unit, and unit is the accumulated error bound of the 64-bit arithmetic
+ */
+static bool string_number_round_weed(char *digits,
+                                     size_t count,
+                                     uint64_t distance_too_high_w,
+                                     uint64_t unsafe_interval,
+                                     uint64_t rest,
+                                     uint64_t ten_kappa,
+                                     uint64_t unit) {
+    uint64_t small_distance = distance_too_high_w - unit;
+    uint64_t big_distance = distance_too_high_w + unit;
+
+    while (rest < small_distance && unsafe_interval - rest >= ten_kappa &&
+           (rest + ten_kappa < small_distance || small_distance - rest >= rest + ten_kappa - small_distance)) {
+        digits[count - 1]--;
+        rest += ten_kappa;
+    }
+
+    if (rest < big_distance && unsafe_interval - rest >= ten_kappa &&
+        (rest + ten_kappa < big_distance || big_distance - rest > rest + ten_kappa - big_distance)) {
+        return false;
+    }
+
+    return 2 * unit <= rest && rest <= unsafe_interval - 4 * unit;
+}
+
+/**
+ * @brief Generate the shortest digits of a positive finite double with Grisu3
+ * @param value Value to convert (positive, finite, non-zero)
+ * @param digits Receives the digits (at most 17)
+ * @param count Receives the number of digits
+ * @param point Receives the decimal point position: value ~ 0.DIGITS x 10^point
+ * @return bool false if 64-bit precision was not enough to decide (about 0.5% of doubles)
+ */
+static bool string_number_grisu3(double value, char *digits, size_t *count, int *point) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    int biased_exponent = (int)((bits >> 52) & 0x7ff);
+    string_diy_fp_t v;
+    v.f = bits & ((UINT64_C(1) << 52) - 1);
+
+    if (biased_exponent == 0) {
+        v.e = -1074;
+    } else {
+        v.f |= UINT64_C(1) << 52;
+        v.e = biased_exponent - 1075;
+    }
+
+    // Boundaries halfway to the neighbouring doubles, with the exponent of normalized w
+    string_diy_fp_t plus = { (v.f << 1) + 1, v.e - 1 };
+    plus = string_diy_fp_normalize(plus);
+    string_diy_fp_t minus;
+    if (v.f == (UINT64_C(1) << 52) && biased_exponent > 1) {
+        minus.f = (v.f << 2) - 1;
+        minus.e = v.e - 2;
+    } else {
+        minus.f = (v.f << 1) - 1;
+        minus.e = v.e - 1;
+    }
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+    string_diy_fp_t w = string_diy_fp_normalize(v);
+
+    // Pick 10^mk so that the scaled exponent lands in [-60, -32]
+    int k = string_number_ceil_log10_pow2(-60 - (w.e + 64) + 64 - 1);
+    const string_cached_power_t *cached = &string_cached_powers[(STRING_CACHED_POWER_OFFSET + k - 1) / STRING_CACHED_POWER_STEP + 1];
+    string_diy_fp_t ten_mk = { cached->significand, cached->binary_exponent };
+
+    string_diy_fp_t scaled_w = string_diy_fp_multiply(w, ten_mk);
+    string_diy_fp_t too_low = string_diy_fp_multiply(minus, ten_mk);
+    string_diy_fp_t too_high = string_diy_fp_multiply(plus, ten_mk);
+
+    // Widen the interval by the error of the multiplications
+    uint64_t unit = 1;
+    too_low.f -= unit;
+    too_high.f += unit;
+    uint64_t unsafe_interval = too_high.f - too_low.f;
+
+    int shift = -scaled_w.e;
+    uint64_t one = UINT64_C(1) << shift;
+    uint32_t integrals = (uint32_t)(too_high.f >> shift);
+    uint64_t fractionals = too_high.f & (one - 1);
+
+    uint32_t divisor = 0;
+    int kappa = 0;
+    for (int i = 9; i >= 0; --i) {
+        if (integrals >= string_number_pow10_u32[i]) {
+            divisor = string_number_pow10_u32[i];
+            kappa = i + 1;
+            break;
+        }
+    }
+    int decimal_base = -cached->decimal_exponent;
+
+    size_t length = 0;
+    while (kappa > 0) {
+        digits[length++] = (char)('0' + integrals / divisor);
+        integrals %= divisor;
+        kappa--;
+        uint64_t rest = ((uint64_t)integrals << shift) + fractionals;
+        if (rest < unsafe_interval) {
+            *count = length;
+            *point = (int)length + decimal_base + kappa;
+            return string_number_round_weed(digits, length, too_high.f - scaled_w.f, unsafe_interval, rest,
+                                            (uint64_t)divisor << shift, unit);
+        }
+        divisor /= 10;
+    }
+
+    for (;;) {
+        fractionals *= 10;
+        unit *= 10;
+        unsafe_interval *= 10;
+        digits[length++] = (char)('0' + (fractionals >> shift));
+        fractionals &= one - 1;
+        kappa--;
+        if (fractionals < unsafe_interval) {
+            *count = length;
+            *point = (int)length + decimal_base + kappa;
+            return string_number_round_weed(digits, length, (too_high.f - scaled_w.f) * unit, unsafe_interval,
+                                            fractionals, one, unit);
+        }
+    }
+}
+
+/**
+ * @brief Generate the shortest round-trip digits of a positive finite double exactly
+ * @param value Value to convert (positive, finite, non-zero)
+ * @param digits Receives the digits (at most 17)
+ * @param point Receives the decimal point position: value ~ 0.DIGITS x 10^point
+ * @return size_t Number of digits generated
+ * @details Burger and Dybvig free-format algorithm. r/s is the value being
+ *          printed, m_plus/s and m_minus/s are half the gaps to the neighbouring
+ *          doubles, and digits stop as soon as the prefix reads back uniquely.
+ */
+static size_t string_number_shortest_digits_exact(double value, char *digits, int *point) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    int biased_exponent = (int)((bits >> 52) & 0x7ff);
+    uint64_t mantissa = bits & ((UINT64_C(1) << 52) - 1);
+    int exponent;
+
+    if (biased_exponent == 0) {
+        exponent = -1074;
+    } else {
+        mantissa |= UINT64_C(1) << 52;
+        exponent = biased_exponent - 1075;
+    }
+
+    // IEEE round-half-even reads boundaries back to an even mantissa
+    bool inclusive = (mantissa & 1) == 0;
+    bool unequal_gaps = mantissa == (UINT64_C(1) << 52) && biased_exponent > 1;
+
+    string_bignum_t r, s, m_plus, m_minus, sum;
+    string_bignum_set(&r, mantissa);
+    if (exponent >= 0) {
+        string_bignum_shift_left(&r, (unsigned)exponent + (unequal_gaps ? 2 : 1));
+        string_bignum_set(&s, unequal_gaps ? 4 : 2);
+        string_bignum_set(&m_minus, 1);
+        string_bignum_shift_left(&m_minus, (unsigned)exponent);
+        string_bignum_set(&m_plus, 1);
+        string_bignum_shift_left(&m_plus, (unsigned)exponent + (unequal_gaps ? 1 : 0));
+    } else {
+        string_bignum_shift_left(&r, unequal_gaps ? 2 : 1);
+        string_bignum_set(&s, 1);
+        string_bignum_shift_left(&s, (unsigned)(-exponent) + (unequal_gaps ? 2 : 1));
+        string_bignum_set(&m_minus, 1);
+        string_bignum_set(&m_plus, unequal_gaps ? 2 : 1);
+    }
+
+    // Estimate the decimal exponent from the binary one; it is never too large
+    int bit_length = 64;
+    while (!(mantissa >> (bit_length - 1))) {
+        bit_length--;
+    }
+    int k = (int)((exponent + bit_length - 1) * 0.30102999566398114 - 1e-10);
+    if ((exponent + bit_length - 1) * 0.30102999566398114 - 1e-10 > k) {
+        k++;
+    }
+    if (k >= 0) {
+        string_bignum_mul_pow10(&s, k);
+    } else {
+        string_bignum_mul_pow10(&r, -k);
+        string_bignum_mul_pow10(&m_plus, -k);
+        string_bignum_mul_pow10(&m_minus, -k);
+    }
+
+    // Fix up the estimate so that the high boundary is below 1
+    for (;;) {
+        string_bignum_add(&sum, &r, &m_plus);
+        int cmp = string_bignum_compare(&sum, &s);
+        if (inclusive ? cmp < 0 : cmp <= 0) {
+            break;
+        }
+        string_bignum_mul_small(&s, 10);
+        k++;
+    }
+
+    size_t count = 0;
+    for (;;) {
+        string_bignum_mul_small(&r, 10);
+        string_bignum_mul_small(&m_plus, 10);
+        string_bignum_mul_small(&m_minus, 10);
+
+        int digit = 0;
+        while (string_bignum_compare(&r, &s) >= 0) {
+            string_bignum_sub(&r, &s);
+            digit++;
+        }
+
+        int low_cmp = string_bignum_compare(&r, &m_minus);
+        bool low = inclusive ? low_cmp <= 0 : low_cmp < 0;
+        string_bignum_add(&sum, &r, &m_plus);
+        int high_cmp = string_bignum_compare(&sum, &s);
+        bool high = inclusive ? high_cmp >= 0 : high_cmp > 0;
+
+        if (!low && !high) {
+            digits[count++] = (char)('0' + digit);
+            continue;
+        }
+
+        if (low && high) {
+            // Both neighbours read back correctly: pick the nearer one
+            string_bignum_shift_left(&r, 1);
+            if (string_bignum_compare(&r, &s) >= 0) {
+                digit++;
+            }
+        } else if (high) {
+            digit++;
+        }
+        digits[count++] = (char)('0' + digit);
+        break;
+    }
+
+    *point = k;
+    return count;
+}
+
+/**
+ * @brief Compare a byte range with a lowercase ASCII keyword, ignoring case
+ * @param data Input bytes
+ * @param length Number of input bytes
+ * @param keyword Lowercase keyword
+ * @return bool true if the range equals the keyword
+ */
+static bool string_number_keyword_equals(const char *data, size_t length, const char *keyword) {
+    for (size_t i = 0; i < length; ++i) {
+        char c = data[i];
+        if (c >= 'A' && c <= 'Z') {
+            c = (char)(c - 'A' + 'a');
+        }
+        if (keyword[i] == '\0' || c != keyword[i]) {
+            return false;
+        }
+    }
+
+    return keyword[length] == '\0';
+}
+
+/*
+ * ===========
+ * Formatters
+ * ===========
+ */
+
+/**
+ * @brief Format an unsigned integer in decimal
+ * @param buffer Output buffer
+ * @param value Value to format
+ * @return size_t Number of bytes written
+ * @details Writes right to left, two digits per table lookup
+ */
+size_t string_number_format_uint(char *buffer, uint64_t value) {
+    size_t count = string_number_count_digits(value);
+    char *cursor = buffer + count;
+
+    while (value >= 100) {
+        const char *pair = &string_number_digit_pairs[(value % 100) * 2];
+        value /= 100;
+        *--cursor = pair[1];
+        *--cursor = pair[0];
+    }
+    if (value >= 10) {
+        const char *pair = &string_number_digit_pairs[value * 2];
+        *--cursor = pair[1];
+        *--cursor = pair[0];
+    } else {
+        *--cursor = (char)('0' + value);
+    }
+
+    return count;
+}
+
+/**
+ * @brief Format a signed integer in decimal
+ * @param buffer Output buffer
+ * @param value Value to format
+ * @return size_t Number of bytes written
+ */
+size_t string_number_format_int(char *buffer, int64_t value) {
+    if (value < 0) {
+        buffer[0] = '-';
+        return 1 + string_number_format_uint(buffer + 1, (uint64_t)0 - (uint64_t)value);
+    }
+
+    return string_number_format_uint(buffer, (uint64_t)value);
+}
+
+/**
+ * @brief Format an unsigned integer in lowercase hexadecimal
+ * @param buffer Output buffer
+ * @param value Value to format
+ * @return size_t Number of bytes written
+ */
+size_t string_number_format_hex(char *buffer, uint64_t value) {
+    static const char hex_digits[] = "0123456789abcdef";
+    size_t count = 1;
+    while (count < 16 && (value >> (count * 4))) {
+        count++;
+    }
+
+    for (size_t i = count; i-- > 0;) {
+        buffer[i] = hex_digits[value & 0xf];
+        value >>= 4;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Format a double with the shortest digits that round-trip
+ * @param buffer Output buffer
+ * @param value Value to format
+ * @return size_t Number of bytes written
+ */
+size_t string_number_format_double(char *buffer, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    size_t length = 0;
+
+    if (((bits >> 52) & 0x7ff) == 0x7ff) {
+        if (bits & ((UINT64_C(1) << 52) - 1)) {
+            memcpy(buffer, "nan", 3);
+            return 3;
+        }
+        if (bits >> 63) {
+            buffer[length++] = '-';
+        }
+        memcpy(buffer + length, "inf", 3);
+        return length + 3;
+    }
+
+    if (bits >> 63) {
+        buffer[length++] = '-';
+        value = -value;
+    }
+
+    // Integral values that a double represents exactly
+    if (value < 9007199254740992.0 && value == (double)(uint64_t)value) {
+        return length + string_number_format_uint(buffer + length, (uint64_t)value);
+    }
+
+    char digits[24];
+    int point;
+    size_t count;
+    if (!string_number_grisu3(value, digits, &count, &point)) {
+        count = string_number_shortest_digits_exact(value, digits, &point);
+    }
+    int exponent = point - 1;
+
+    if (exponent < -5 || exponent >= 17) {
+        // Scientific notation: d[.ddd]e+XX
+        buffer[length++] = digits[0];
+        if (count > 1) {
+            buffer[length++] = '.';
+            memcpy(buffer + length, digits + 1, count - 1);
+            length += count - 1;
+        }
+        buffer[length++] = 'e';
+        buffer[length++] = exponent < 0 ? '-' : '+';
+        unsigned magnitude = (unsigned)(exponent < 0 ? -exponent : exponent);
+        if (magnitude < 10) {
+            buffer[length++] = '0';
+        }
+        length += string_number_format_uint(buffer + length, magnitude);
+    } else if (point <= 0) {
+        // 0.000ddd
+        buffer[length++] = '0';
+        buffer[length++] = '.';
+        memset(buffer + length, '0', (size_t)-point);
+        length += (size_t)-point;
+        memcpy(buffer + length, digits, count);
+        length += count;
+    } else if ((size_t)point < count) {
+        // ddd.ddd
+        memcpy(buffer + length, digits, (size_t)point);
+        length += (size_t)point;
+        buffer[length++] = '.';
+        memcpy(buffer + length, digits + point, count - (size_t)point);
+        length += count - (size_t)point;
+    } else {
+        // ddd000
+        memcpy(buffer + length, digits, count);
+        length += count;
+        memset(buffer + length, '0', (size_t)point - count);
+        length += (size_t)point - count;
+    }
+
+    return length;
+}
+
+/*
+ * ========
+ * Parsers
+ * ========
+ */
+
+/**
+ * @brief Parse a signed decimal integer
+ * @param data Input bytes
+ * @param length Number of input bytes
+ * @param value Receives the parsed value
+ * @return string_result_t Success or error code
+ * @details Accepts an optional sign followed by one or more digits, and nothing else
+ */
+string_result_t string_number_parse_int64(const char *data, size_t length, int64_t *value) {
+    size_t i = 0;
+    bool negative = false;
+
+    if (i < length && (data[i] == '+' || data[i] == '-')) {
+        negative = data[i] == '-';
+        i++;
+    }
+
+    if (i == length) {
+        return STRING_ERROR_INVALID_ARGUMENT;
+    }
+
+    uint64_t limit = negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX;
+    uint64_t magnitude = 0;
+    bool overflow = false;
+    for (; i < length; ++i) {
+        unsigned digit = (unsigned)((unsigned char)data[i] - '0');
+        if (digit > 9) {
+            return STRING_ERROR_INVALID_ARGUMENT;
+        }
+        if (magnitude > (limit - digit) / 10) {
+            overflow = true;
+        } else {
+            magnitude = magnitude * 10 + digit;
+        }
+    }
+
+    if (overflow) {
+        return STRING_ERROR_OUT_OF_RANGE;
+    }
+
+    *value = negative ? (int64_t)(0 - magnitude) : (int64_t)magnitude;
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Parse a decimal floating-point number
+ * @param data Input bytes
+ * @param length Number of input bytes
+ * @param value Receives the parsed value
+ * @return string_result_t Success or error code
+ * @details Accepts [+-] digits [. digits] [(e|E) [+-] digits], with digits on at
+ *          least one side of the point, as well as "inf", "infinity" and "nan"
+ *          in any case, and nothing else
+ */
+string_result_t string_number_parse_double(const char *data, size_t length, double *value) {
+    size_t i = 0;
+    bool negative = false;
+
+    if (i < length && (data[i] == '+' || data[i] == '-')) {
+        negative = data[i] == '-';
+        i++;
+    }
+
+    if (string_number_keyword_equals(data + i, length - i, "inf") || string_number_keyword_equals(data + i, length - i, "infinity")) {
+        *value = negative ? -HUGE_VAL : HUGE_VAL;
+        return STRING_SUCCESS;
+    }
+    if (string_number_keyword_equals(data + i, length - i, "nan")) {
+        double nan_value = 0.0;
+        uint64_t nan_bits = UINT64_C(0x7ff8000000000000) | ((uint64_t)negative << 63);
+        memcpy(&nan_value, &nan_bits, sizeof(nan_value));
+        *value = nan_value;
+        return STRING_SUCCESS;
+    }
+
+    // Scan the mantissa, keeping up to 19 significant digits exactly
+    uint64_t mantissa = 0;
+    size_t significant = 0;
+    size_t digit_count = 0;
+    long decimal_exponent = 0;
+    bool truncated = false;
+    bool seen_point = false;
+    size_t point_index = 0;
+
+    for (; i < length; ++i) {
+        char c = data[i];
+        if (c == '.' && !seen_point) {
+            seen_point = true;
+            point_index = i;
+            continue;
+        }
+        if (c < '0' || c > '9') {
+            break;
+        }
+        digit_count++;
+        if (mantissa == 0 && c == '0') {
+            if (seen_point) {
+                decimal_exponent--;
+            }
+            continue;
+        }
+        if (significant < 19) {
+            mantissa = mantissa * 10 + (uint64_t)(c - '0');
+            significant++;
+            if (seen_point) {
+                decimal_exponent--;
+            }
+        } else {
+            truncated = truncated || c != '0';
+            if (!seen_point) {
+                decimal_exponent++;
+            }
+        }
+    }
+
+    if (digit_count == 0) {
+        return STRING_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (i < length && (data[i] == 'e' || data[i] == 'E')) {
+        i++;
+        bool exponent_negative = false;
+        if (i < length && (data[i] == '+' || data[i] == '-')) {
+            exponent_negative = data[i] == '-';
+            i++;
+        }
+        if (i == length) {
+            return STRING_ERROR_INVALID_ARGUMENT;
+        }
+        long exponent = 0;
+        for (; i < length && data[i] >= '0' && data[i] <= '9'; ++i) {
+            if (exponent < 100000) {
+                exponent = exponent * 10 + (data[i] - '0');
+            }
+        }
+        decimal_exponent += exponent_negative ? -exponent : exponent;
+    }
+
+    if (i != length) {
+        return STRING_ERROR_INVALID_ARGUMENT;
+    }
+
+    // Clinger's fast path: both operands are exact, so one rounding is correct
+    if (mantissa == 0) {
+        *value = negative ? -0.0 : 0.0;
+        return STRING_SUCCESS;
+    }
+    if (!truncated && mantissa <= (UINT64_C(1) << 53) && decimal_exponent >= -22 && decimal_exponent <= 22) {
+        double result = (double)mantissa;
+        if (decimal_exponent < 0) {
+            result /= string_number_exact_pow10[-decimal_exponent];
+        } else {
+            result *= string_number_exact_pow10[decimal_exponent];
+        }
+        *value = negative ? -result : result;
+        return STRING_SUCCESS;
+    }
+
+    // Slow path: let strtod round the validated text, using the locale's decimal point
+    const char *decimal_point = localeconv()->decimal_point;
+    size_t point_length = strlen(decimal_point);
+    char local[128];
+    char *buffer = local;
+    if (length + point_length + 1 > sizeof(local)) {
+        buffer = malloc(length + point_length + 1);
+        if (!buffer) {
+            return STRING_ERROR_OUT_OF_MEMORY;
+        }
+    }
+
+    size_t out = 0;
+    for (size_t j = 0; j < length; ++j) {
+        if (seen_point && j == point_index) {
+            memcpy(buffer + out, decimal_point, point_length);
+            out += point_length;
+        } else {
+            buffer[out++] = data[j];
+        }
+    }
+    buffer[out] = '\0';
+
+    double result = strtod(buffer, NULL);
+    if (buffer != local) {
+        free(buffer);
+    }
+
+    if (result == HUGE_VAL || result == -HUGE_VAL) {
+        return STRING_ERROR_OUT_OF_RANGE;
+    }
+
+    *value = result;
+    return STRING_SUCCESS;
+}
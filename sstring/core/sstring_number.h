@@ -0,0 +1,74 @@
+/**
+ * @file sstring_number.h
+ * @brief Internal number formatting and parsing kernels for the safe strings library
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * This header is internal to the library and is not part of the public API.
+ * The formatters write into a caller-provided buffer of at least
+ * STRING_NUMBER_MAX_LENGTH bytes and never write a null terminator; the
+ * parsers accept exactly one number spanning the whole input. None of the
+ * kernels depend on the current locale.
+ */
+
+#pragma once
+
+#include "sstring.h"
+
+/** @brief Largest number of bytes written by any formatter */
+#define STRING_NUMBER_MAX_LENGTH 32
+
+/**
+ * @brief Format an unsigned integer in decimal
+ * @param buffer Output buffer (at least STRING_NUMBER_MAX_LENGTH bytes)
+ * @param value Value to format
+ * @return Number of bytes written
+ */
+size_t string_number_format_uint(char *buffer, uint64_t value);
+
+/**
+ * @brief Format a signed integer in decimal
+ * @param buffer Output buffer (at least STRING_NUMBER_MAX_LENGTH bytes)
+ * @param value Value to format
+ * @return Number of bytes written
+ */
+size_t string_number_format_int(char *buffer, int64_t value);
+
+/**
+ * @brief Format an unsigned integer in lowercase hexadecimal, without prefix
+ * @param buffer Output buffer (at least STRING_NUMBER_MAX_LENGTH bytes)
+ * @param value Value to format
+ * @return Number of bytes written
+ */
+size_t string_number_format_hex(char *buffer, uint64_t value);
+
+/**
+ * @brief Format a double with the shortest digits that round-trip
+ * @param buffer Output buffer (at least STRING_NUMBER_MAX_LENGTH bytes)
+ * @param value Value to format
+ * @return Number of bytes written
+ * @details Uses fixed notation for decimal exponents in [-5, 17) and
+ *          scientific notation ("1.5e+300") otherwise. Non-finite values are
+ *          written as "nan", "inf" and "-inf".
+ */
+size_t string_number_format_double(char *buffer, double value);
+
+/**
+ * @brief Parse a signed decimal integer
+ * @param data Input bytes
+ * @param length Number of input bytes
+ * @param value Receives the parsed value on success
+ * @return STRING_SUCCESS, STRING_ERROR_INVALID_ARGUMENT if the input is not an
+ *         integer, or STRING_ERROR_OUT_OF_RANGE if it does not fit in int64_t
+ */
+string_result_t string_number_parse_int64(const char *data, size_t length, int64_t *value);
+
+/**
+ * @brief Parse a decimal floating-point number
+ * @param data Input bytes
+ * @param length Number of input bytes
+ * @param value Receives the correctly rounded value on success
+ * @return STRING_SUCCESS, STRING_ERROR_INVALID_ARGUMENT if the input is not a
+ *         number, or STRING_ERROR_OUT_OF_RANGE if it overflows a double
+ */
+string_result_t string_number_parse_double(const char *data, size_t length, double *value);
@@ -0,0 +1,573 @@
+/**
+ * @file sstring_parallel.c
+ * @brief Implementation of the parallel search and transform functions
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * A job is a function called once per chunk index. Submitting a job publishes
+ * it under the pool lock and bumps a generation counter; workers woken by the
+ * broadcast and the caller then claim chunk indices from an atomic counter
+ * until none are left, so uneven chunks balance themselves. The caller waits
+ * until every worker has seen the generation before the job can be reused.
+ *
+ * Chunk i of a search covers match positions [begin, end) but reads up to
+ * needle_length - 1 bytes past end, which is what lets matches straddle the
+ * boundary without being found twice.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+#include "sstring_parallel.h"
+#include "sstring_simd.h"
+
+/** @brief Number of chunks per thread, so that a slow thread does not hold up the others */
+#define STRING_PAR_CHUNKS_PER_THREAD 4
+
+/**
+ * @brief Function run for each chunk of a job
+ * @param context Job state
+ * @param chunk Index of the chunk to process
+ */
+typedef void (*string_par_task_fn)(void *context, size_t chunk);
+
+/**
+ * @brief Thread pool state
+ */
+struct string_thread_pool {
+    pthread_t *workers;           /**< Worker threads */
+    size_t worker_count;          /**< Number of workers (threads minus the caller) */
+    pthread_mutex_t submit_lock;  /**< Serializes jobs from different callers */
+    pthread_mutex_t lock;         /**< Protects the fields below */
+    pthread_cond_t wake;          /**< Signals a new job or shutdown to the workers */
+    pthread_cond_t done;          /**< Signals the last worker leaving a job */
+    string_par_task_fn task;      /**< Current job */
+    void *context;                /**< State of the current job */
+    size_t chunk_count;           /**< Number of chunks in the current job */
+    atomic_size_t next_chunk;     /**< Next chunk index to claim */
+    size_t active;                /**< Workers that have not finished the current job */
+    uint64_t generation;          /**< Incremented for every job */
+    bool is_stopping;             /**< Set when the pool is destroyed */
+};
+
+/**
+ * @brief State of a parallel find
+ */
+typedef struct {
+    string_view_t view;       /**< View to search in */
+    string_view_t needle;     /**< Bytes to search for */
+    size_t start;             /**< First match position */
+    size_t chunk_size;        /**< Match positions per chunk */
+    atomic_size_t best;       /**< Leftmost match found so far */
+} string_par_find_t;
+
+/**
+ * @brief Result of counting one chunk
+ */
+typedef struct {
+    size_t count;   /**< Matches starting in the chunk, counted from its start */
+    size_t first;   /**< Position of the first match, or STRING_NPOS */
+    size_t cursor;  /**< Position after the last match, or the chunk start */
+} string_par_tally_t;
+
+/**
+ * @brief State of a parallel count
+ */
+typedef struct {
+    string_view_t view;           /**< View to search in */
+    string_view_t needle;         /**< Bytes to count */
+    size_t chunk_size;            /**< Match positions per chunk */
+    string_par_tally_t *tallies;  /**< One result per chunk */
+} string_par_count_t;
+
+/**
+ * @brief State of a parallel transform
+ */
+typedef struct {
+    char *data;                     /**< Bytes to transform */
+    size_t length;                  /**< Number of bytes */
+    size_t chunk_size;              /**< Bytes per chunk */
+    string_transform_fn transform;  /**< Function applied to each chunk */
+    void *context;                  /**< Caller data for the function */
+} string_par_transform_t;
+
+/**
+ * @brief Characters of a parallel character replacement
+ */
+typedef struct {
+    char old_char;  /**< Character to replace */
+    char new_char;  /**< Replacement character */
+} string_par_replace_t;
+
+/*
+ * ================================
+ * Thread pool internal functions
+ * ================================
+ */
+
+/**
+ * @brief Claim and run chunks of the current job until none are left
+ * @param pool Pool running the job
+ * @param task Function of the job
+ * @param context State of the job
+ * @param chunk_count Number of chunks in the job
+ */
+static void string_thread_pool_run(string_thread_pool_t *pool, string_par_task_fn task, void *context, size_t chunk_count) {
+    for (;;) {
+        size_t chunk = atomic_fetch_add_explicit(&pool->next_chunk, 1, memory_order_relaxed);
+        if (chunk >= chunk_count) {
+            return;
+        }
+        task(context, chunk);
+    }
+}
+
+/**
+ * @brief Body of a worker thread
+ * @param argument Pool the worker belongs to
+ * @return NULL
+ */
+static void *string_thread_pool_worker(void *argument) {
+    string_thread_pool_t *pool = argument;
+    uint64_t seen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (pool->generation == seen && !pool->is_stopping) {
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        }
+        if (pool->is_stopping) {
+            break;
+        }
+
+        seen = pool->generation;
+        string_par_task_fn task = pool->task;
+        void *context = pool->context;
+        size_t chunk_count = pool->chunk_count;
+        pthread_mutex_unlock(&pool->lock);
+
+        string_thread_pool_run(pool, task, context, chunk_count);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->active == 0) {
+            pthread_cond_signal(&pool->done);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    return NULL;
+}
+
+/**
+ * @brief Run a job on every thread of a pool and wait for it to finish
+ * @param pool Pool to run on (NULL runs every chunk on the caller)
+ * @param task Function called for each chunk
+ * @param context State of the job
+ * @param chunk_count Number of chunks
+ */
+static void string_thread_pool_execute(string_thread_pool_t *pool, string_par_task_fn task, void *context, size_t chunk_count) {
+    if (!pool || pool->worker_count == 0 || chunk_count < 2) {
+        for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+            task(context, chunk);
+        }
+        return;
+    }
+
+    pthread_mutex_lock(&pool->submit_lock);
+
+    pthread_mutex_lock(&pool->lock);
+    pool->task = task;
+    pool->context = context;
+    pool->chunk_count = chunk_count;
+    atomic_store_explicit(&pool->next_chunk, 0, memory_order_relaxed);
+    pool->active = pool->worker_count;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    string_thread_pool_run(pool, task, context, chunk_count);
+
+    // Workers still hold the job until they report back, even with no chunk left
+    pthread_mutex_lock(&pool->lock);
+    while (pool->active > 0) {
+        pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    pthread_mutex_unlock(&pool->submit_lock);
+}
+
+/**
+ * @brief Choose how many bytes each chunk of a job covers
+ * @param pool Pool that will run the job
+ * @param length Number of bytes or positions to split
+ * @return Chunk size, at least STRING_PAR_MIN_CHUNK
+ */
+static size_t string_par_chunk_size(const string_thread_pool_t *pool, size_t length) {
+    size_t chunks = string_thread_pool_size(pool) * STRING_PAR_CHUNKS_PER_THREAD;
+    size_t size = length / chunks + (length % chunks != 0);
+    return size < STRING_PAR_MIN_CHUNK ? STRING_PAR_MIN_CHUNK : size;
+}
+
+/*
+ * ==============================
+ * Thread pool lifetime functions
+ * ==============================
+ */
+
+/**
+ * @brief Create a thread pool
+ * @param thread_count Number of threads working on each call, including the caller
+ * @return string_thread_pool_t* Pointer to newly created pool, or NULL on failure
+ * @details A count of 0 selects the number of online processors
+ */
+string_thread_pool_t *string_thread_pool_create(size_t thread_count) {
+    if (thread_count == 0) {
+#ifdef _SC_NPROCESSORS_ONLN
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        thread_count = online > 0 ? (size_t)online : 1;
+#else
+        thread_count = 1;
+#endif
+    }
+
+    string_thread_pool_t *pool = calloc(1, sizeof(string_thread_pool_t));
+    if (!pool) {
+        return NULL;
+    }
+
+    pool->workers = calloc(thread_count > 1 ? thread_count - 1 : 1, sizeof(pthread_t));
+    if (!pool->workers) {
+        free(pool);
+        return NULL;
+    }
+
+    pthread_mutex_init(&pool->submit_lock, NULL);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->done, NULL);
+    atomic_init(&pool->next_chunk, 0);
+
+    for (size_t i = 0; i + 1 < thread_count; ++i) {
+        if (pthread_create(&pool->workers[i], NULL, string_thread_pool_worker, pool) != 0) {
+            string_thread_pool_destroy(pool);
+            return NULL;
+        }
+        pool->worker_count++;
+    }
+
+    return pool;
+}
+
+/**
+ * @brief Stop the workers and destroy a thread pool
+ * @param pool Pool to destroy (can be NULL)
+ */
+void string_thread_pool_destroy(string_thread_pool_t *pool) {
+    if (!pool) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->is_stopping = true;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (size_t i = 0; i < pool->worker_count; ++i) {
+        pthread_join(pool->workers[i], NULL);
+    }
+
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+    pthread_mutex_destroy(&pool->submit_lock);
+    free(pool->workers);
+    free(pool);
+}
+
+/**
+ * @brief Get the number of threads working on each call
+ * @param pool Pool to query
+ * @return size_t Number of threads including the caller (1 for NULL)
+ */
+size_t string_thread_pool_size(const string_thread_pool_t *pool) {
+    return pool ? pool->worker_count + 1 : 1;
+}
+
+/*
+ * ===========================
+ * Parallel search functions
+ * ===========================
+ */
+
+/**
+ * @brief Find the first match starting in one chunk
+ * @param context Find state
+ * @param chunk Index of the chunk
+ */
+static void string_par_find_chunk(void *context, size_t chunk) {
+    string_par_find_t *job = context;
+    size_t limit = job->view.length - job->needle.length + 1;
+    size_t begin = job->start + chunk * job->chunk_size;
+
+    // A match was already found before this chunk
+    if (begin >= atomic_load_explicit(&job->best, memory_order_relaxed)) {
+        return;
+    }
+
+    size_t end = limit - begin > job->chunk_size ? begin + job->chunk_size : limit;
+    size_t found = string_simd_find_substr(job->view.data + begin, end - begin + job->needle.length - 1, job->needle.data, job->needle.length);
+    if (found == STRING_NPOS) {
+        return;
+    }
+
+    size_t position = begin + found;
+    size_t best = atomic_load_explicit(&job->best, memory_order_relaxed);
+    while (position < best && !atomic_compare_exchange_weak_explicit(&job->best, &best, position, memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+/**
+ * @brief Find the first occurrence of a needle using a thread pool
+ * @param pool Pool to run on (NULL runs serially)
+ * @param view View to search in
+ * @param needle Bytes to search for
+ * @param start_pos Position to start searching from
+ * @return size_t Position of the first occurrence, or STRING_NPOS if not found
+ */
+size_t string_par_find(string_thread_pool_t *pool, string_view_t view, string_view_t needle, size_t start_pos) {
+    if (needle.length == 0 || start_pos > view.length || view.length - start_pos < needle.length) {
+        return string_view_find(view, needle, start_pos);
+    }
+
+    string_par_find_t job = { .view = view, .needle = needle, .start = start_pos };
+    size_t positions = view.length - needle.length + 1 - start_pos;
+    job.chunk_size = string_par_chunk_size(pool, positions);
+    atomic_init(&job.best, STRING_NPOS);
+
+    size_t chunk_count = positions / job.chunk_size + (positions % job.chunk_size != 0);
+    string_thread_pool_execute(pool, string_par_find_chunk, &job, chunk_count);
+
+    return atomic_load_explicit(&job.best, memory_order_relaxed);
+}
+
+/**
+ * @brief Count matches greedily from a position up to a limit
+ * @param job Count state
+ * @param position First position to search from
+ * @param end Matches must start before this position
+ * @param tally Receives the count, first match and final cursor
+ */
+static void string_par_count_range(const string_par_count_t *job, size_t position, size_t end, string_par_tally_t *tally) {
+    const char *data = job->view.data;
+    size_t needle_length = job->needle.length;
+
+    tally->count = 0;
+    tally->first = STRING_NPOS;
+    tally->cursor = position;
+
+    while (position < end) {
+        size_t found = string_simd_find_substr(data + position, end - position + needle_length - 1, job->needle.data, needle_length);
+        if (found == STRING_NPOS) {
+            break;
+        }
+
+        if (tally->count++ == 0) {
+            tally->first = position + found;
+        }
+        position += found + needle_length;
+        tally->cursor = position;
+    }
+}
+
+/**
+ * @brief Count the matches starting in one chunk
+ * @param context Count state
+ * @param chunk Index of the chunk
+ */
+static void string_par_count_chunk(void *context, size_t chunk) {
+    string_par_count_t *job = context;
+    size_t limit = job->view.length - job->needle.length + 1;
+    size_t begin = chunk * job->chunk_size;
+    size_t end = limit - begin > job->chunk_size ? begin + job->chunk_size : limit;
+
+    string_par_count_range(job, begin, end, &job->tallies[chunk]);
+}
+
+/**
+ * @brief Count the non-overlapping occurrences of a needle using a thread pool
+ * @param pool Pool to run on (NULL runs serially)
+ * @param view View to search in
+ * @param needle Bytes to count
+ * @return size_t Number of occurrences
+ * @details Chunks are counted independently from their own start, then merged
+ *          in order. A chunk is recounted only if the previous chunk's last
+ *          match runs past the chunk's first match.
+ */
+size_t string_par_count(string_thread_pool_t *pool, string_view_t view, string_view_t needle) {
+    if (needle.length == 0 || view.length < needle.length) {
+        return 0;
+    }
+
+    string_par_count_t job = { .view = view, .needle = needle };
+    size_t positions = view.length - needle.length + 1;
+    job.chunk_size = string_par_chunk_size(pool, positions);
+
+    size_t chunk_count = positions / job.chunk_size + (positions % job.chunk_size != 0);
+    string_par_tally_t single;
+    job.tallies = chunk_count > 1 ? malloc(chunk_count * sizeof(string_par_tally_t)) : &single;
+    if (!job.tallies) {
+        // Fall back to one chunk covering everything
+        job.tallies = &single;
+        job.chunk_size = positions;
+        chunk_count = 1;
+    }
+
+    string_thread_pool_execute(pool, string_par_count_chunk, &job, chunk_count);
+
+    size_t total = 0;
+    size_t cursor = 0;
+    for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+        string_par_tally_t *tally = &job.tallies[chunk];
+        if (tally->first != STRING_NPOS && cursor > tally->first) {
+            size_t begin = chunk * job.chunk_size;
+            size_t end = positions - begin > job.chunk_size ? begin + job.chunk_size : positions;
+            string_par_count_range(&job, cursor, end, tally);
+        }
+        total += tally->count;
+        if (tally->cursor > cursor) {
+            cursor = tally->cursor;
+        }
+    }
+
+    if (job.tallies != &single) {
+        free(job.tallies);
+    }
+
+    return total;
+}
+
+/*
+ * ==============================
+ * Parallel transform functions
+ * ==============================
+ */
+
+/**
+ * @brief Transform one chunk
+ * @param context Transform state
+ * @param chunk Index of the chunk
+ */
+static void string_par_transform_chunk(void *context, size_t chunk) {
+    string_par_transform_t *job = context;
+    size_t begin = chunk * job->chunk_size;
+    size_t length = job->length - begin > job->chunk_size ? job->chunk_size : job->length - begin;
+
+    job->transform(job->data + begin, length, job->context);
+}
+
+/**
+ * @brief Apply a byte-wise transform to a string in place using a thread pool
+ * @param pool Pool to run on (NULL runs serially)
+ * @param str String to modify
+ * @param transform Function applied to each chunk
+ * @param context Caller data passed to the function
+ * @return string_result_t Success or error code
+ */
+string_result_t string_par_transform(string_thread_pool_t *pool, string_t *str, string_transform_fn transform, void *context) {
+    if (!transform) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    // Committing nothing runs the usual mutation checks and detaches shared data
+    string_result_t result = string_commit_spare(str, 0);
+    if (result != STRING_SUCCESS || str->length == 0) {
+        return result;
+    }
+
+    string_par_transform_t job = { .data = str->data, .length = str->length, .transform = transform, .context = context };
+    job.chunk_size = string_par_chunk_size(pool, str->length);
+
+    size_t chunk_count = str->length / job.chunk_size + (str->length % job.chunk_size != 0);
+    string_thread_pool_execute(pool, string_par_transform_chunk, &job, chunk_count);
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Convert a chunk to uppercase
+ * @param data First byte of the chunk
+ * @param length Number of bytes in the chunk
+ * @param context Unused
+ */
+static void string_par_upper_chunk(char *data, size_t length, void *context) {
+    (void)context;
+    string_simd_ascii_case(data, length, true);
+}
+
+/**
+ * @brief Convert a chunk to lowercase
+ * @param data First byte of the chunk
+ * @param length Number of bytes in the chunk
+ * @param context Unused
+ */
+static void string_par_lower_chunk(char *data, size_t length, void *context) {
+    (void)context;
+    string_simd_ascii_case(data, length, false);
+}
+
+/**
+ * @brief Replace a character in a chunk
+ * @param data First byte of the chunk
+ * @param length Number of bytes in the chunk
+ * @param context Characters to replace, as string_par_replace_t
+ */
+static void string_par_replace_chunk(char *data, size_t length, void *context) {
+    const string_par_replace_t *replace = context;
+
+    size_t position = 0;
+    while (position < length) {
+        size_t found = string_simd_find_byte(data + position, length - position, replace->old_char);
+        if (found == STRING_NPOS) {
+            break;
+        }
+        position += found;
+        data[position++] = replace->new_char;
+    }
+}
+
+/**
+ * @brief Convert a string to uppercase using a thread pool
+ * @param pool Pool to run on (NULL runs serially)
+ * @param str String to convert
+ * @return string_result_t Success or error code
+ */
+string_result_t string_par_to_upper(string_thread_pool_t *pool, string_t *str) {
+    return string_par_transform(pool, str, string_par_upper_chunk, NULL);
+}
+
+/**
+ * @brief Convert a string to lowercase using a thread pool
+ * @param pool Pool to run on (NULL runs serially)
+ * @param str String to convert
+ * @return string_result_t Success or error code
+ */
+string_result_t string_par_to_lower(string_thread_pool_t *pool, string_t *str) {
+    return string_par_transform(pool, str, string_par_lower_chunk, NULL);
+}
+
+/**
+ * @brief Replace every occurrence of a character using a thread pool
+ * @param pool Pool to run on (NULL runs serially)
+ * @param str String to modify
+ * @param old_char Character to replace
+ * @param new_char Replacement character
+ * @return string_result_t Success or error code
+ */
+string_result_t string_par_replace_char(string_thread_pool_t *pool, string_t *str, char old_char, char new_char) {
+    string_par_replace_t replace = { old_char, new_char };
+    return string_par_transform(pool, str, string_par_replace_chunk, &replace);
+}
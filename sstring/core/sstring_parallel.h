@@ -0,0 +1,144 @@
+/**
+ * @file sstring_parallel.h
+ * @brief Parallel search and transform for the safe strings library
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * This header provides multi-threaded variants of the scanning functions for
+ * very large strings. The input is split into chunks that a reusable thread
+ * pool processes concurrently; the calling thread works on chunks too, so a
+ * pool of n threads starts n - 1 workers once and keeps them for every call.
+ *
+ * Every function returns exactly what its serial counterpart returns: matches
+ * straddling a chunk boundary are found by letting each chunk search slightly
+ * past its end, and counts are stitched together left to right. Inputs shorter
+ * than two STRING_PAR_MIN_CHUNK chunks, or a NULL pool, run on the calling
+ * thread alone.
+ *
+ * A pool can be shared by several threads; their calls are serialized.
+ */
+
+#pragma once
+
+#include "sstring.h"
+
+/** @brief Smallest number of bytes handed to one thread */
+#define STRING_PAR_MIN_CHUNK ((size_t)1 << 20)
+
+/** @brief Opaque reusable thread pool */
+typedef struct string_thread_pool string_thread_pool_t;
+
+/**
+ * @brief Function applied in place to each chunk by string_par_transform()
+ * @param data First byte of the chunk
+ * @param length Number of bytes in the chunk
+ * @param context Caller data passed to string_par_transform()
+ * @details May run concurrently on different chunks, so it must only touch
+ *          the bytes it is given.
+ */
+typedef void (*string_transform_fn)(char *data, size_t length, void *context);
+
+/*
+ * ================================
+ * Thread pool lifetime functions
+ * ================================
+ */
+
+/**
+ * @brief Create a thread pool
+ * @param thread_count Number of threads working on each call, including the
+ *                     caller (0 selects the number of online processors)
+ * @return Pointer to newly created pool, or NULL on failure
+ */
+string_thread_pool_t *string_thread_pool_create(size_t thread_count);
+
+/**
+ * @brief Stop the workers and destroy a thread pool
+ * @param pool Pool to destroy (can be NULL); no call may be using it
+ */
+void string_thread_pool_destroy(string_thread_pool_t *pool);
+
+/**
+ * @brief Get the number of threads working on each call
+ * @param pool Pool to query
+ * @return Number of threads including the caller (1 for NULL)
+ */
+size_t string_thread_pool_size(const string_thread_pool_t *pool);
+
+/*
+ * ===========================
+ * Parallel search functions
+ * ===========================
+ */
+
+/**
+ * @brief Find the first occurrence of a needle using a thread pool
+ * @param pool Pool to run on (NULL runs serially)
+ * @param view View to search in
+ * @param needle Bytes to search for
+ * @param start_pos Position to start searching from
+ * @return Position of the first occurrence, or STRING_NPOS if not found
+ * @details Same result as string_view_find(). Chunks after an already found
+ *          match are skipped.
+ */
+size_t string_par_find(string_thread_pool_t *pool, string_view_t view, string_view_t needle, size_t start_pos);
+
+/**
+ * @brief Count the non-overlapping occurrences of a needle using a thread pool
+ * @param pool Pool to run on (NULL runs serially)
+ * @param view View to search in
+ * @param needle Bytes to count (must not be empty)
+ * @return Number of occurrences found scanning left to right, as
+ *         string_replace_all() would replace them (0 for an empty needle)
+ * @details When a match crosses into the next chunk and overlaps matches found
+ *          there, that chunk is recounted from the end of the crossing match.
+ *          This only happens for needles that can overlap themselves.
+ */
+size_t string_par_count(string_thread_pool_t *pool, string_view_t view, string_view_t needle);
+
+/*
+ * ==============================
+ * Parallel transform functions
+ * ==============================
+ */
+
+/**
+ * @brief Apply a byte-wise transform to a string in place using a thread pool
+ * @param pool Pool to run on (NULL runs serially)
+ * @param str String to modify
+ * @param transform Function applied to each chunk
+ * @param context Caller data passed to the function
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details The function sees disjoint chunks in unspecified order, so it must
+ *          be independent of chunk boundaries (a per-byte mapping is).
+ */
+string_result_t string_par_transform(string_thread_pool_t *pool, string_t *str, string_transform_fn transform, void *context);
+
+/**
+ * @brief Convert a string to uppercase using a thread pool
+ * @param pool Pool to run on (NULL runs serially)
+ * @param str String to convert
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Same result as string_to_upper().
+ */
+string_result_t string_par_to_upper(string_thread_pool_t *pool, string_t *str);
+
+/**
+ * @brief Convert a string to lowercase using a thread pool
+ * @param pool Pool to run on (NULL runs serially)
+ * @param str String to convert
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Same result as string_to_lower().
+ */
+string_result_t string_par_to_lower(string_thread_pool_t *pool, string_t *str);
+
+/**
+ * @brief Replace every occurrence of a character using a thread pool
+ * @param pool Pool to run on (NULL runs serially)
+ * @param str String to modify
+ * @param old_char Character to replace
+ * @param new_char Replacement character
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details Same result as string_replace_char().
+ */
+string_result_t string_par_replace_char(string_thread_pool_t *pool, string_t *str, char old_char, char new_char);
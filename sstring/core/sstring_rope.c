@@ -0,0 +1,602 @@
+/**
+ * @file sstring_rope.c
+ * @brief Implementation of the rope (piece table)
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * The content is the in-order concatenation of pieces, each a (offset, length)
+ * range of an append-only byte store. Pieces are kept in a treap: a binary tree
+ * ordered by position whose random node priorities form a heap, which keeps the
+ * expected depth logarithmic. Every node caches the byte total of its subtree,
+ * so positions are resolved by one descent. Editing is split-and-merge: cutting
+ * the tree at a position may cut one piece in two, which is the only step that
+ * needs a new node; those nodes are allocated up front, so an edit that fails
+ * for lack of memory leaves the rope untouched.
+ */
+
+#include "sstring_rope.h"
+
+/** @brief Initial size of the byte store */
+#define STRING_ROPE_MIN_STORE 256
+
+/** @brief Number of nodes an edit may need (one cut piece plus one new piece) */
+#define STRING_ROPE_SPARE_NODES 2
+
+/**
+ * @brief Tree node holding one piece
+ */
+typedef struct string_rope_node {
+    struct string_rope_node *left;   /**< Pieces before this one */
+    struct string_rope_node *right;  /**< Pieces after this one */
+    size_t offset;                   /**< Start of the piece in the byte store */
+    size_t length;                   /**< Length of the piece */
+    size_t total;                    /**< Bytes in this subtree */
+    uint32_t priority;               /**< Random heap priority */
+} string_rope_node_t;
+
+/**
+ * @brief Rope state
+ */
+struct string_rope {
+    string_rope_node_t *root;                               /**< Piece tree */
+    char *store;                                            /**< Append-only byte store */
+    size_t store_length;                                    /**< Bytes used in the store */
+    size_t store_capacity;                                  /**< Bytes allocated for the store */
+    string_rope_node_t *spare[STRING_ROPE_SPARE_NODES];     /**< Preallocated nodes */
+    size_t spare_count;                                     /**< Number of preallocated nodes */
+    uint64_t seed;                                          /**< State of the priority generator */
+};
+
+/**
+ * @brief Get the byte total of a subtree
+ */
+static size_t string_rope_total(const string_rope_node_t *node) {
+    return node ? node->total : 0;
+}
+
+/**
+ * @brief Recompute the byte total of a node from its children
+ */
+static void string_rope_update(string_rope_node_t *node) {
+    node->total = string_rope_total(node->left) + node->length + string_rope_total(node->right);
+}
+
+/**
+ * @brief Take a preallocated node and give it a piece and a fresh priority
+ * @param rope Rope owning the spare nodes (at least one must be available)
+ * @param offset Start of the piece in the byte store
+ * @param length Length of the piece
+ * @return string_rope_node_t* Detached node
+ */
+static string_rope_node_t *string_rope_take_node(string_rope_t *rope, size_t offset, size_t length) {
+    string_rope_node_t *node = rope->spare[--rope->spare_count];
+
+    // xorshift64*
+    rope->seed ^= rope->seed >> 12;
+    rope->seed ^= rope->seed << 25;
+    rope->seed ^= rope->seed >> 27;
+
+    node->left = NULL;
+    node->right = NULL;
+    node->offset = offset;
+    node->length = length;
+    node->total = length;
+    node->priority = (uint32_t)((rope->seed * 0x2545F4914F6CDD1DULL) >> 32);
+
+    return node;
+}
+
+/**
+ * @brief Make sure an edit can take every node it may need
+ * @param rope Rope to prepare
+ * @return string_result_t Success or error code
+ */
+static string_result_t string_rope_reserve_nodes(string_rope_t *rope) {
+    while (rope->spare_count < STRING_ROPE_SPARE_NODES) {
+        string_rope_node_t *node = malloc(sizeof(string_rope_node_t));
+        if (!node) {
+            return STRING_ERROR_OUT_OF_MEMORY;
+        }
+        rope->spare[rope->spare_count++] = node;
+    }
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Free a subtree
+ */
+static void string_rope_free_tree(string_rope_node_t *node) {
+    while (node) {
+        string_rope_free_tree(node->left);
+        string_rope_node_t *right = node->right;
+        free(node);
+        node = right;
+    }
+}
+
+/**
+ * @brief Concatenate two trees
+ * @param left Tree holding the first bytes
+ * @param right Tree holding the following bytes
+ * @return string_rope_node_t* Root of the combined tree
+ */
+static string_rope_node_t *string_rope_merge(string_rope_node_t *left, string_rope_node_t *right) {
+    if (!left) {
+        return right;
+    }
+    if (!right) {
+        return left;
+    }
+
+    if (left->priority > right->priority) {
+        left->right = string_rope_merge(left->right, right);
+        string_rope_update(left);
+        return left;
+    }
+
+    right->left = string_rope_merge(left, right->left);
+    string_rope_update(right);
+    return right;
+}
+
+/**
+ * @brief Cut a tree at a byte position
+ * @param rope Rope providing a spare node if a piece must be cut
+ * @param node Tree to cut
+ * @param position Number of bytes that go to the left tree
+ * @param left Receives the tree with the first position bytes
+ * @param right Receives the tree with the remaining bytes
+ * @details Uses at most one spare node.
+ */
+static void string_rope_split(string_rope_t *rope,
+                              string_rope_node_t *node,
+                              size_t position,
+                              string_rope_node_t **left,
+                              string_rope_node_t **right) {
+    if (!node) {
+        *left = NULL;
+        *right = NULL;
+        return;
+    }
+
+    size_t left_total = string_rope_total(node->left);
+    if (position <= left_total) {
+        string_rope_split(rope, node->left, position, left, &node->left);
+        string_rope_update(node);
+        *right = node;
+        return;
+    }
+
+    position -= left_total;
+    if (position >= node->length) {
+        string_rope_split(rope, node->right, position - node->length, &node->right, right);
+        string_rope_update(node);
+        *left = node;
+        return;
+    }
+
+    // The cut falls inside this piece: keep the head here, move the tail right
+    string_rope_node_t *tail = string_rope_take_node(rope, node->offset + position, node->length - position);
+    *right = string_rope_merge(tail, node->right);
+    node->length = position;
+    node->right = NULL;
+    string_rope_update(node);
+    *left = node;
+}
+
+/**
+ * @brief Grow the piece ending at a position when it also ends the byte store
+ * @param node Tree to search
+ * @param position Insertion position
+ * @param added Number of bytes just appended to the store
+ * @param store_end Length of the store before those bytes
+ * @return bool true if a piece was extended
+ */
+static bool string_rope_extend(string_rope_node_t *node, size_t position, size_t added, size_t store_end) {
+    if (!node) {
+        return false;
+    }
+
+    bool extended;
+    size_t left_total = string_rope_total(node->left);
+    if (position <= left_total) {
+        extended = string_rope_extend(node->left, position, added, store_end);
+    } else if (position <= left_total + node->length) {
+        extended = position == left_total + node->length && node->offset + node->length == store_end;
+        if (extended) {
+            node->length += added;
+        }
+    } else {
+        extended = string_rope_extend(node->right, position - left_total - node->length, added, store_end);
+    }
+
+    if (extended) {
+        node->total += added;
+    }
+    return extended;
+}
+
+/**
+ * @brief Find the piece holding a byte position
+ * @param rope Rope to search
+ * @param position Byte position (less than the rope length)
+ * @param within Receives the offset of the position inside the piece
+ * @return const string_rope_node_t* Node holding the byte
+ */
+static const string_rope_node_t *string_rope_locate(const string_rope_t *rope, size_t position, size_t *within) {
+    const string_rope_node_t *node = rope->root;
+
+    for (;;) {
+        size_t left_total = string_rope_total(node->left);
+        if (position < left_total) {
+            node = node->left;
+        } else if (position < left_total + node->length) {
+            *within = position - left_total;
+            return node;
+        } else {
+            position -= left_total + node->length;
+            node = node->right;
+        }
+    }
+}
+
+/**
+ * @brief Make room for more bytes in the store
+ * @param rope Rope to grow
+ * @param length Number of bytes to append
+ * @return string_result_t Success or error code
+ */
+static string_result_t string_rope_reserve_store(string_rope_t *rope, size_t length) {
+    if (length > SIZE_MAX - rope->store_length) {
+        return STRING_ERROR_OUT_OF_MEMORY;
+    }
+
+    size_t required = rope->store_length + length;
+    if (required <= rope->store_capacity) {
+        return STRING_SUCCESS;
+    }
+
+    size_t capacity = rope->store_capacity ? rope->store_capacity : STRING_ROPE_MIN_STORE;
+    while (capacity < required) {
+        capacity = capacity > SIZE_MAX / 2 ? required : capacity * 2;
+    }
+
+    char *store = realloc(rope->store, capacity);
+    if (!store) {
+        return STRING_ERROR_OUT_OF_MEMORY;
+    }
+
+    rope->store = store;
+    rope->store_capacity = capacity;
+
+    return STRING_SUCCESS;
+}
+
+/*
+ * ========================
+ * Rope lifetime functions
+ * ========================
+ */
+
+/**
+ * @brief Create a new, empty rope
+ * @return string_rope_t* Pointer to new rope or NULL on failure
+ */
+string_rope_t *string_rope_create(void) {
+    string_rope_t *rope = calloc(1, sizeof(string_rope_t));
+    if (rope) {
+        rope->seed = (0x9E3779B97F4A7C15ULL ^ (uint64_t)(uintptr_t)rope) | 1;
+    }
+
+    return rope;
+}
+
+/**
+ * @brief Create a rope holding a copy of a buffer
+ * @param buffer Source buffer
+ * @param length Number of bytes to copy
+ * @return string_rope_t* Pointer to new rope or NULL on failure
+ */
+string_rope_t *string_rope_create_from_buffer(const char *buffer, size_t length) {
+    if (!buffer && length > 0) {
+        return NULL;
+    }
+
+    string_rope_t *rope = string_rope_create();
+    if (rope && string_rope_append_buffer(rope, buffer, length) != STRING_SUCCESS) {
+        string_rope_destroy(rope);
+        return NULL;
+    }
+
+    return rope;
+}
+
+/**
+ * @brief Create a rope holding a copy of a string
+ * @param str Source string
+ * @return string_rope_t* Pointer to new rope or NULL on failure
+ */
+string_rope_t *string_rope_create_from_string(const string_t *str) {
+    if (!str) {
+        return NULL;
+    }
+
+    return string_rope_create_from_buffer(str->data, str->length);
+}
+
+/**
+ * @brief Destroy a rope
+ * @param rope Rope to destroy
+ */
+void string_rope_destroy(string_rope_t *rope) {
+    if (!rope) {
+        return;
+    }
+
+    string_rope_free_tree(rope->root);
+    while (rope->spare_count > 0) {
+        free(rope->spare[--rope->spare_count]);
+    }
+    free(rope->store);
+    free(rope);
+}
+
+/**
+ * @brief Get the number of bytes in a rope
+ * @param rope Rope to query
+ * @return size_t Length in bytes
+ */
+size_t string_rope_length(const string_rope_t *rope) {
+    return rope ? string_rope_total(rope->root) : 0;
+}
+
+/*
+ * ============================
+ * Rope modification functions
+ * ============================
+ */
+
+/**
+ * @brief Insert buffer content at specified position
+ * @param rope Destination rope
+ * @param index Position to insert at
+ * @param buffer Source buffer to insert
+ * @param length Length of data to insert
+ * @return string_result_t Success or error code
+ * @details The bytes are appended to the store first; the insertion then either
+ *          extends the piece ending at index or cuts the tree and links a new piece.
+ */
+string_result_t string_rope_insert_buffer(string_rope_t *rope, size_t index, const char *buffer, size_t length) {
+    if (!rope) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    if (index > string_rope_total(rope->root)) {
+        return STRING_ERROR_INVALID_INDEX;
+    }
+
+    if (!buffer && length > 0) {
+        return STRING_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (length == 0) {
+        return STRING_SUCCESS;
+    }
+
+    string_result_t result = string_rope_reserve_nodes(rope);
+    if (result != STRING_SUCCESS) {
+        return result;
+    }
+
+    // A chunk view of this rope must be rebased if the store moves
+    bool is_self = rope->store && buffer >= rope->store && buffer < rope->store + rope->store_length;
+    size_t self_offset = is_self ? (size_t)(buffer - rope->store) : 0;
+
+    result = string_rope_reserve_store(rope, length);
+    if (result != STRING_SUCCESS) {
+        return result;
+    }
+
+    if (is_self) {
+        buffer = rope->store + self_offset;
+    }
+
+    size_t store_end = rope->store_length;
+    memcpy(rope->store + store_end, buffer, length);
+    rope->store_length += length;
+
+    if (index > 0 && string_rope_extend(rope->root, index, length, store_end)) {
+        return STRING_SUCCESS;
+    }
+
+    string_rope_node_t *left, *right;
+    string_rope_split(rope, rope->root, index, &left, &right);
+    string_rope_node_t *piece = string_rope_take_node(rope, store_end, length);
+    rope->root = string_rope_merge(string_rope_merge(left, piece), right);
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Insert C string at specified position
+ * @param rope Destination rope
+ * @param index Position to insert at
+ * @param cstr Source C string to insert
+ * @return string_result_t Success or error code
+ */
+string_result_t string_rope_insert_cstr(string_rope_t *rope, size_t index, const char *cstr) {
+    if (!cstr) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    return string_rope_insert_buffer(rope, index, cstr, strlen(cstr));
+}
+
+/**
+ * @brief Insert a string at specified position
+ * @param rope Destination rope
+ * @param index Position to insert at
+ * @param src Source string to insert
+ * @return string_result_t Success or error code
+ */
+string_result_t string_rope_insert_string(string_rope_t *rope, size_t index, const string_t *src) {
+    if (!src) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    return string_rope_insert_buffer(rope, index, src->data, src->length);
+}
+
+/**
+ * @brief Insert a single character at specified position
+ * @param rope Destination rope
+ * @param index Position to insert at
+ * @param c Character to insert
+ * @return string_result_t Success or error code
+ */
+string_result_t string_rope_insert_char(string_rope_t *rope, size_t index, char c) {
+    return string_rope_insert_buffer(rope, index, &c, 1);
+}
+
+/**
+ * @brief Append buffer content at the end of a rope
+ * @param rope Destination rope
+ * @param buffer Source buffer to append
+ * @param length Length of data to append
+ * @return string_result_t Success or error code
+ */
+string_result_t string_rope_append_buffer(string_rope_t *rope, const char *buffer, size_t length) {
+    return string_rope_insert_buffer(rope, string_rope_length(rope), buffer, length);
+}
+
+/**
+ * @brief Erase bytes from a rope at specified position
+ * @param rope Rope to modify
+ * @param index Starting position to erase from
+ * @param count Number of bytes to erase
+ * @return string_result_t Success or error code
+ * @details Cuts the erased range out of the tree; its bytes stay in the store
+ */
+string_result_t string_rope_erase(string_rope_t *rope, size_t index, size_t count) {
+    if (!rope) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    size_t length = string_rope_total(rope->root);
+    if (index >= length) {
+        return STRING_ERROR_INVALID_INDEX;
+    }
+
+    if (count == 0) {
+        return STRING_SUCCESS;
+    }
+
+    if (count > length - index) {
+        count = length - index;
+    }
+
+    string_result_t result = string_rope_reserve_nodes(rope);
+    if (result != STRING_SUCCESS) {
+        return result;
+    }
+
+    string_rope_node_t *left, *middle, *right;
+    string_rope_split(rope, rope->root, index, &left, &middle);
+    string_rope_split(rope, middle, count, &middle, &right);
+    string_rope_free_tree(middle);
+    rope->root = string_rope_merge(left, right);
+
+    return STRING_SUCCESS;
+}
+
+/*
+ * ======================
+ * Rope access functions
+ * ======================
+ */
+
+/**
+ * @brief Get the byte at specified position
+ * @param rope Rope to read
+ * @param index Position of the byte
+ * @return char Byte at index or '\0' if out of range
+ */
+char string_rope_at(const string_rope_t *rope, size_t index) {
+    if (!rope || index >= string_rope_total(rope->root)) {
+        return '\0';
+    }
+
+    size_t within;
+    const string_rope_node_t *node = string_rope_locate(rope, index, &within);
+    return rope->store[node->offset + within];
+}
+
+/**
+ * @brief Iterate over the content as contiguous chunks
+ * @param rope Rope to iterate
+ * @param cursor Byte position of the next chunk
+ * @param chunk Receives a view of the chunk
+ * @return bool true if a chunk was returned
+ */
+bool string_rope_next_chunk(const string_rope_t *rope, size_t *cursor, string_view_t *chunk) {
+    if (!rope || !cursor || !chunk || *cursor >= string_rope_total(rope->root)) {
+        return false;
+    }
+
+    size_t within;
+    const string_rope_node_t *node = string_rope_locate(rope, *cursor, &within);
+    *chunk = string_view_from_buffer(rope->store + node->offset + within, node->length - within);
+    *cursor += chunk->length;
+
+    return true;
+}
+
+/**
+ * @brief Copy a range of a rope into a string
+ * @param rope Rope to copy from
+ * @param index Starting position
+ * @param count Number of bytes to copy
+ * @param dest Destination string
+ * @return string_result_t Success or error code
+ * @details Reserves the destination once, then appends chunk by chunk
+ */
+string_result_t string_rope_substring(const string_rope_t *rope, size_t index, size_t count, string_t *dest) {
+    if (!rope || !dest) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    size_t length = string_rope_total(rope->root);
+    if (index > length) {
+        return STRING_ERROR_INVALID_INDEX;
+    }
+
+    if (count > length - index) {
+        count = length - index;
+    }
+
+    string_result_t result = string_clear(dest);
+    if (result == STRING_SUCCESS) {
+        result = string_reserve(dest, count + 1);
+    }
+
+    size_t cursor = index;
+    string_view_t chunk;
+    while (result == STRING_SUCCESS && count > 0 && string_rope_next_chunk(rope, &cursor, &chunk)) {
+        size_t take = chunk.length < count ? chunk.length : count;
+        result = string_append_buffer(dest, chunk.data, take);
+        count -= take;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Copy the whole content of a rope into a string
+ * @param rope Rope to copy from
+ * @param dest Destination string
+ * @return string_result_t Success or error code
+ */
+string_result_t string_rope_flatten(const string_rope_t *rope, string_t *dest) {
+    return string_rope_substring(rope, 0, SIZE_MAX, dest);
+}
@@ -0,0 +1,171 @@
+/**
+ * @file sstring_rope.h
+ * @brief Rope (piece table) for large editable texts in the safe strings library
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * This header provides an editable byte sequence for large documents. Unlike
+ * string_t, whose insert and erase move the whole tail, a rope keeps its
+ * content as a balanced tree of pieces referring to an append-only byte store,
+ * so insert, erase and index take logarithmic time in the number of pieces
+ * regardless of the document size. Consecutive insertions at the same place,
+ * as produced by typing, extend one piece instead of creating new ones.
+ *
+ * Inserted bytes are never moved or freed before the rope is destroyed, so
+ * erased text still occupies memory; flatten into a string_t with
+ * string_rope_flatten() and rebuild the rope when that matters. A rope is not
+ * thread-safe.
+ */
+
+#pragma once
+
+#include "sstring.h"
+
+/** @brief Opaque rope */
+typedef struct string_rope string_rope_t;
+
+/*
+ * ========================
+ * Rope lifetime functions
+ * ========================
+ */
+
+/**
+ * @brief Create a new, empty rope
+ * @return Pointer to newly created rope, or NULL on failure
+ */
+string_rope_t *string_rope_create(void);
+
+/**
+ * @brief Create a rope holding a copy of a buffer
+ * @param buffer Source buffer (can contain null bytes)
+ * @param length Number of bytes to copy
+ * @return Pointer to newly created rope, or NULL on failure
+ */
+string_rope_t *string_rope_create_from_buffer(const char *buffer, size_t length);
+
+/**
+ * @brief Create a rope holding a copy of a string
+ * @param str Source string
+ * @return Pointer to newly created rope, or NULL on failure
+ */
+string_rope_t *string_rope_create_from_string(const string_t *str);
+
+/**
+ * @brief Destroy a rope
+ * @param rope Rope to destroy (can be NULL)
+ */
+void string_rope_destroy(string_rope_t *rope);
+
+/**
+ * @brief Get the number of bytes in a rope
+ * @param rope Rope to query
+ * @return Length in bytes (0 for NULL)
+ */
+size_t string_rope_length(const string_rope_t *rope);
+
+/*
+ * ============================
+ * Rope modification functions
+ * ============================
+ */
+
+/**
+ * @brief Insert buffer content at specified position
+ * @param rope Destination rope
+ * @param index Position to insert at (0 to string_rope_length())
+ * @param buffer Source buffer to insert (may point into a chunk of this rope)
+ * @param length Length of data to insert
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details On failure the rope is left unchanged.
+ */
+string_result_t string_rope_insert_buffer(string_rope_t *rope, size_t index, const char *buffer, size_t length);
+
+/**
+ * @brief Insert C string at specified position
+ * @param rope Destination rope
+ * @param index Position to insert at
+ * @param cstr Source C string to insert (null-terminated)
+ * @return STRING_SUCCESS on success, error code on failure
+ */
+string_result_t string_rope_insert_cstr(string_rope_t *rope, size_t index, const char *cstr);
+
+/**
+ * @brief Insert a string at specified position
+ * @param rope Destination rope
+ * @param index Position to insert at
+ * @param src Source string to insert
+ * @return STRING_SUCCESS on success, error code on failure
+ */
+string_result_t string_rope_insert_string(string_rope_t *rope, size_t index, const string_t *src);
+
+/**
+ * @brief Insert a single character at specified position
+ * @param rope Destination rope
+ * @param index Position to insert at
+ * @param c Character to insert
+ * @return STRING_SUCCESS on success, error code on failure
+ */
+string_result_t string_rope_insert_char(string_rope_t *rope, size_t index, char c);
+
+/**
+ * @brief Append buffer content at the end of a rope
+ * @param rope Destination rope
+ * @param buffer Source buffer to append
+ * @param length Length of data to append
+ * @return STRING_SUCCESS on success, error code on failure
+ */
+string_result_t string_rope_append_buffer(string_rope_t *rope, const char *buffer, size_t length);
+
+/**
+ * @brief Erase bytes from a rope at specified position
+ * @param rope Rope to modify
+ * @param index Starting position to erase from
+ * @param count Number of bytes to erase (clamped to the end of the rope)
+ * @return STRING_SUCCESS on success, error code on failure
+ * @details On failure the rope is left unchanged.
+ */
+string_result_t string_rope_erase(string_rope_t *rope, size_t index, size_t count);
+
+/*
+ * ======================
+ * Rope access functions
+ * ======================
+ */
+
+/**
+ * @brief Get the byte at specified position
+ * @param rope Rope to read
+ * @param index Position of the byte
+ * @return Byte at index, or '\0' if the index is out of range
+ */
+char string_rope_at(const string_rope_t *rope, size_t index);
+
+/**
+ * @brief Iterate over the content as contiguous chunks
+ * @param rope Rope to iterate
+ * @param cursor Byte position of the next chunk, set to 0 before the first call
+ * @param chunk Receives a view of the chunk starting at the cursor
+ * @return true if a chunk was returned, false at the end of the rope
+ * @details Each call costs one tree descent. Views stay valid until the rope is
+ *          destroyed, but the rope must not be modified during an iteration.
+ */
+bool string_rope_next_chunk(const string_rope_t *rope, size_t *cursor, string_view_t *chunk);
+
+/**
+ * @brief Copy a range of a rope into a string
+ * @param rope Rope to copy from
+ * @param index Starting position
+ * @param count Number of bytes to copy (clamped to the end of the rope)
+ * @param dest Destination string (its previous content is replaced)
+ * @return STRING_SUCCESS on success, error code on failure
+ */
+string_result_t string_rope_substring(const string_rope_t *rope, size_t index, size_t count, string_t *dest);
+
+/**
+ * @brief Copy the whole content of a rope into a string
+ * @param rope Rope to copy from
+ * @param dest Destination string (its previous content is replaced)
+ * @return STRING_SUCCESS on success, error code on failure
+ */
+string_result_t string_rope_flatten(const string_rope_t *rope, string_t *dest);
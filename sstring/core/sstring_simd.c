@@ -0,0 +1,2087 @@
+/**
+ * @file sstring_simd.c
+ * @brief Implementation of the vectorized scanning kernels
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * This file contains the scalar, SSE2, AVX2 and NEON variants of the byte and
+ * byte-set scanning kernels, and the runtime CPU feature detection that picks
+ * between them. The scalar loops are always available and are used for tails
+ * and on targets without vector support.
+ */
+
+#include <stdatomic.h>
+
+#include "sstring_simd.h"
+#include "sstring_stats.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define STRING_HAVE_X86_SIMD 1
+#include <immintrin.h>
+#elif defined(__GNUC__) && defined(__aarch64__)
+#define STRING_HAVE_NEON 1
+#include <arm_neon.h>
+#endif
+
+/** @brief Active kernel level (-1 until detected) */
+static atomic_int string_simd_active = -1;
+
+/*
+ * ==========================
+ * CPU feature detection
+ * ==========================
+ */
+
+/**
+ * @brief Detect the best kernel level supported by the running CPU
+ * @return string_simd_t Highest supported level
+ */
+static string_simd_t string_simd_detect(void) {
+#if defined(STRING_HAVE_X86_SIMD)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return STRING_SIMD_AVX2;
+    }
+    return STRING_SIMD_SSE2;
+#elif defined(STRING_HAVE_NEON)
+    return STRING_SIMD_NEON;
+#else
+    return STRING_SIMD_NONE;
+#endif
+}
+
+/**
+ * @brief Get the kernel level used by scanning functions
+ * @return string_simd_t Active kernel level
+ * @details Detects CPU features on first use
+ */
+string_simd_t string_get_simd_level(void) {
+    int level = atomic_load_explicit(&string_simd_active, memory_order_relaxed);
+    if (level < 0) {
+        level = (int)string_simd_detect();
+        atomic_store_explicit(&string_simd_active, level, memory_order_relaxed);
+    }
+
+    return (string_simd_t)level;
+}
+
+/**
+ * @brief Limit the kernel level used by scanning functions
+ * @param level Requested level (clamped to what the CPU supports)
+ * @return string_simd_t Level actually applied
+ * @details Lower levels are always available, down to the scalar loops
+ */
+string_simd_t string_set_simd_level(string_simd_t level) {
+    string_simd_t supported = string_simd_detect();
+
+    bool allowed = level == STRING_SIMD_NONE || level == supported || (level == STRING_SIMD_SSE2 && supported == STRING_SIMD_AVX2);
+    if (!allowed) {
+        level = supported;
+    }
+
+    atomic_store_explicit(&string_simd_active, (int)level, memory_order_relaxed);
+    return level;
+}
+
+/*
+ * ==========================
+ * Scalar kernels
+ * ==========================
+ */
+
+/**
+ * @brief Scalar forward byte search
+ */
+static size_t string_scalar_find_byte(const char *data, size_t length, char c) {
+    for (size_t i = 0; i < length; ++i) {
+        if (data[i] == c) {
+            return i;
+        }
+    }
+
+    return STRING_NPOS;
+}
+
+/**
+ * @brief Scalar backward byte search
+ */
+static size_t string_scalar_rfind_byte(const char *data, size_t length, char c) {
+    for (size_t i = length; i > 0; --i) {
+        if (data[i - 1] == c) {
+            return i - 1;
+        }
+    }
+
+    return STRING_NPOS;
+}
+
+/**
+ * @brief Build a 256-entry membership table for a byte set
+ */
+static void string_scalar_build_table(bool table[256], const char *set, size_t set_length) {
+    memset(table, 0, 256 * sizeof(bool));
+    for (size_t i = 0; i < set_length; ++i) {
+        table[(unsigned char)set[i]] = true;
+    }
+}
+
+/**
+ * @brief Scalar forward byte-set search
+ */
+static size_t string_scalar_find_any(const char *data, size_t length, const char *set, size_t set_length) {
+    bool table[256];
+    string_scalar_build_table(table, set, set_length);
+
+    for (size_t i = 0; i < length; ++i) {
+        if (table[(unsigned char)data[i]]) {
+            return i;
+        }
+    }
+
+    return STRING_NPOS;
+}
+
+/**
+ * @brief Scalar backward byte-set search
+ */
+static size_t string_scalar_rfind_any(const char *data, size_t length, const char *set, size_t set_length) {
+    bool table[256];
+    string_scalar_build_table(table, set, set_length);
+
+    for (size_t i = length; i > 0; --i) {
+        if (table[(unsigned char)data[i - 1]]) {
+            return i - 1;
+        }
+    }
+
+    return STRING_NPOS;
+}
+
+/**
+ * @brief Test whether a byte belongs to a character class
+ */
+static inline bool string_scalar_class_member(const string_char_class_t *cls, unsigned char c) {
+    return (cls->table[(c & 0x0F) | ((c >> 3) & 0x10)] >> ((c >> 4) & 7)) & 1;
+}
+
+/**
+ * @brief Scalar forward character-class search
+ */
+static size_t string_scalar_find_class(const char *data, size_t length, const string_char_class_t *cls, bool member) {
+    for (size_t i = 0; i < length; ++i) {
+        if (string_scalar_class_member(cls, (unsigned char)data[i]) == member) {
+            return i;
+        }
+    }
+
+    return STRING_NPOS;
+}
+
+/**
+ * @brief Scalar backward character-class search
+ */
+static size_t string_scalar_rfind_class(const char *data, size_t length, const string_char_class_t *cls, bool member) {
+    for (size_t i = length; i > 0; --i) {
+        if (string_scalar_class_member(cls, (unsigned char)data[i - 1]) == member) {
+            return i - 1;
+        }
+    }
+
+    return STRING_NPOS;
+}
+
+/**
+ * @brief Fold an ASCII uppercase letter to lowercase when comparing without case
+ */
+static inline unsigned char string_fold_byte(unsigned char c, bool icase) {
+    return icase && (unsigned)(c - 'A') < 26u ? (unsigned char)(c | 0x20) : c;
+}
+
+/**
+ * @brief Scalar ASCII case conversion
+ */
+static void string_scalar_ascii_case(char *data, size_t length, bool upper) {
+    const unsigned char first = upper ? 'a' : 'A';
+
+    for (size_t i = 0; i < length; ++i) {
+        if ((unsigned)((unsigned char)data[i] - first) < 26u) {
+            data[i] = (char)(data[i] ^ 0x20);
+        }
+    }
+}
+
+/**
+ * @brief Scalar case-insensitive mismatch search
+ */
+static size_t string_scalar_mismatch_icase(const char *a, const char *b, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        if (string_fold_byte((unsigned char)a[i], true) != string_fold_byte((unsigned char)b[i], true)) {
+            return i;
+        }
+    }
+
+    return length;
+}
+
+/**
+ * @brief Scalar delimiter split
+ * @details Continues from field_start and offset so that vector kernels can finish with it
+ */
+static size_t string_scalar_split_byte(const char *data,
+                                       size_t length,
+                                       char delimiter,
+                                       string_view_t *fields,
+                                       size_t capacity,
+                                       size_t count,
+                                       size_t field_start,
+                                       size_t offset,
+                                       size_t *consumed) {
+    for (size_t i = offset; i < length && count < capacity; ++i) {
+        if (data[i] == delimiter) {
+            fields[count].data = data + field_start;
+            fields[count].length = i - field_start;
+            count++;
+            field_start = i + 1;
+        }
+    }
+
+    *consumed = field_start;
+    return count;
+}
+
+/**
+ * @brief Scalar UTF-8 validation
+ * @details Checks the well-formed sequences of Unicode table 3-7, skipping ASCII
+ *          eight bytes at a time. Validates sequences starting before stop (they
+ *          may run up to length) and leaves position after the last one, so that
+ *          vector kernels can hand over a block and take back the rest
+ */
+static size_t string_scalar_utf8_invalid(const char *data, size_t length, size_t *position, size_t stop) {
+    const unsigned char *bytes = (const unsigned char *)data;
+    size_t i = *position;
+
+    while (i < stop) {
+        if (length - i >= 8) {
+            uint64_t word;
+            memcpy(&word, bytes + i, sizeof(word));
+            if ((word & UINT64_C(0x8080808080808080)) == 0) {
+                i += 8;
+                continue;
+            }
+        }
+
+        unsigned char lead = bytes[i];
+        if (lead < 0x80) {
+            i++;
+            continue;
+        }
+
+        size_t extra;
+        unsigned char low = 0x80;
+        unsigned char high = 0xBF;
+        if (lead >= 0xC2 && lead <= 0xDF) {
+            extra = 1;
+        } else if (lead >= 0xE0 && lead <= 0xEF) {
+            extra = 2;
+            low = lead == 0xE0 ? 0xA0 : 0x80;
+            high = lead == 0xED ? 0x9F : 0xBF;
+        } else if (lead >= 0xF0 && lead <= 0xF4) {
+            extra = 3;
+            low = lead == 0xF0 ? 0x90 : 0x80;
+            high = lead == 0xF4 ? 0x8F : 0xBF;
+        } else {
+            return i;
+        }
+
+        if (length - i <= extra || bytes[i + 1] < low || bytes[i + 1] > high) {
+            return i;
+        }
+        for (size_t k = 2; k <= extra; ++k) {
+            if ((bytes[i + k] & 0xC0) != 0x80) {
+                return i;
+            }
+        }
+        i += extra + 1;
+    }
+
+    *position = i;
+    return STRING_NPOS;
+}
+
+/**
+ * @brief Scalar count of bytes that are not UTF-8 continuation bytes
+ */
+static size_t string_scalar_utf8_count(const char *data, size_t length) {
+    size_t count = 0;
+    for (size_t i = 0; i < length; ++i) {
+        count += ((unsigned char)data[i] & 0xC0) != 0x80;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Scalar ASCII widening to UTF-16
+ */
+static size_t string_scalar_ascii_to_utf16(const char *data, size_t length, uint16_t *dest) {
+    size_t i = 0;
+    for (; i < length && (unsigned char)data[i] < 0x80; ++i) {
+        dest[i] = (uint16_t)data[i];
+    }
+
+    return i;
+}
+
+/**
+ * @brief Scalar ASCII narrowing from UTF-16
+ */
+static size_t string_scalar_utf16_to_ascii(const uint16_t *units, size_t length, char *dest) {
+    size_t i = 0;
+    for (; i < length && units[i] < 0x80; ++i) {
+        dest[i] = (char)units[i];
+    }
+
+    return i;
+}
+
+/**
+ * @brief Offset a tail result by the number of bytes already scanned
+ */
+static size_t string_simd_offset(size_t base, size_t found) {
+    return found == STRING_NPOS ? STRING_NPOS : base + found;
+}
+
+/*
+ * ==========================
+ * Two-Way substring search
+ * ==========================
+ */
+
+/**
+ * @brief Compute a maximal suffix of the needle for one of the two byte orderings
+ * @param needle Needle bytes
+ * @param length Needle length (at least 1)
+ * @param reversed Use the reversed byte ordering
+ * @param icase Compare ASCII letters without case
+ * @param period Receives the period of the maximal suffix
+ * @return size_t Start of the maximal suffix
+ */
+static size_t string_two_way_max_suffix(const unsigned char *needle, size_t length, bool reversed, bool icase, size_t *period) {
+    size_t suffix = 0;
+    size_t candidate = 1;
+    size_t offset = 0;
+    size_t p = 1;
+
+    while (candidate + offset < length) {
+        unsigned char a = string_fold_byte(needle[candidate + offset], icase);
+        unsigned char b = string_fold_byte(needle[suffix + offset], icase);
+        if (a == b) {
+            if (offset + 1 == p) {
+                candidate += p;
+                offset = 0;
+            } else {
+                offset++;
+            }
+        } else if ((a < b) != reversed) {
+            candidate += offset + 1;
+            offset = 0;
+            p = candidate - suffix;
+        } else {
+            suffix = candidate++;
+            offset = 0;
+            p = 1;
+        }
+    }
+
+    *period = p;
+    return suffix;
+}
+
+/**
+ * @brief Two-Way substring search (Crochemore-Perrin)
+ * @details Runs in O(n + m) time and O(1) space, independent of the input content.
+ *          With icase, ASCII letters are folded on both sides as they are read.
+ */
+static inline size_t string_two_way_search(const char *data, size_t length, const char *needle_bytes, size_t needle_length, bool icase) {
+    const unsigned char *haystack = (const unsigned char *)data;
+    const unsigned char *needle = (const unsigned char *)needle_bytes;
+
+    if (needle_length > length) {
+        return STRING_NPOS;
+    }
+
+    // Critical factorization: the later of the two maximal suffixes
+    size_t period, period_rev;
+    size_t split = string_two_way_max_suffix(needle, needle_length, false, icase, &period);
+    size_t split_rev = string_two_way_max_suffix(needle, needle_length, true, icase, &period_rev);
+    if (split_rev >= split) {
+        split = split_rev;
+        period = period_rev;
+    }
+
+    size_t last = length - needle_length;
+
+    bool periodic = icase ? string_scalar_mismatch_icase(needle_bytes, needle_bytes + period, split) == split
+                          : memcmp(needle, needle + period, split) == 0;
+    if (periodic) {
+        // Periodic needle: remember how much of the left part is known to match
+        size_t memory = 0;
+        size_t pos = 0;
+        while (pos <= last) {
+            size_t i = split > memory ? split : memory;
+            while (i < needle_length && string_fold_byte(needle[i], icase) == string_fold_byte(haystack[pos + i], icase)) {
+                i++;
+            }
+            if (i < needle_length) {
+                pos += i - split + 1;
+                memory = 0;
+                continue;
+            }
+
+            size_t j = split;
+            while (j > memory && string_fold_byte(needle[j - 1], icase) == string_fold_byte(haystack[pos + j - 1], icase)) {
+                j--;
+            }
+            if (j <= memory) {
+                return pos;
+            }
+            pos += period;
+            memory = needle_length - period;
+        }
+    } else {
+        // Non-periodic needle: every mismatch allows a maximal shift
+        size_t shift = (split > needle_length - split ? split : needle_length - split) + 1;
+        size_t pos = 0;
+        while (pos <= last) {
+            size_t i = split;
+            while (i < needle_length && string_fold_byte(needle[i], icase) == string_fold_byte(haystack[pos + i], icase)) {
+                i++;
+            }
+            if (i < needle_length) {
+                pos += i - split + 1;
+                continue;
+            }
+
+            size_t j = split;
+            while (j > 0 && string_fold_byte(needle[j - 1], icase) == string_fold_byte(haystack[pos + j - 1], icase)) {
+                j--;
+            }
+            if (j == 0) {
+                return pos;
+            }
+            pos += shift;
+        }
+    }
+
+    return STRING_NPOS;
+}
+
+/**
+ * @brief Two-Way substring search comparing bytes exactly
+ */
+static size_t string_two_way_find(const char *data, size_t length, const char *needle, size_t needle_length) {
+    return string_two_way_search(data, length, needle, needle_length, false);
+}
+
+/**
+ * @brief Two-Way substring search ignoring ASCII case
+ */
+static size_t string_two_way_find_icase(const char *data, size_t length, const char *needle, size_t needle_length) {
+    return string_two_way_search(data, length, needle, needle_length, true);
+}
+
+#if defined(STRING_HAVE_X86_SIMD) || defined(STRING_HAVE_NEON)
+
+/*
+ * ==========================
+ * Shared lookup tables
+ * ==========================
+ */
+
+/** @brief Bit selecting a byte's row of a character class, by high nibble */
+static const uint8_t string_class_row_bits[16] = {
+    0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+};
+
+/*
+ * Each table maps a nibble to the error classes it is compatible with; a byte
+ * pair is wrong when the classes of the first byte's high and low nibbles and
+ * the second byte's high nibble share a bit. Two continuations in a row are
+ * only right after a three- or four-byte lead, which is checked separately.
+ */
+#define STRING_UTF8_TOO_SHORT      0x01  /**< Lead byte followed by a non-continuation */
+#define STRING_UTF8_TOO_LONG       0x02  /**< ASCII followed by a continuation */
+#define STRING_UTF8_OVERLONG_3     0x04  /**< E0 followed by 80..9F */
+#define STRING_UTF8_TOO_LARGE      0x08  /**< Above U+10FFFF: F4 90.., or F5..FF */
+#define STRING_UTF8_SURROGATE      0x10  /**< ED followed by A0..BF */
+#define STRING_UTF8_OVERLONG_2     0x20  /**< C0 or C1 lead */
+#define STRING_UTF8_TOO_LARGE_1000 0x40  /**< F5..FF followed by 80..8F */
+#define STRING_UTF8_OVERLONG_4     0x40  /**< F0 followed by 80..8F */
+#define STRING_UTF8_TWO_CONTS      0x80  /**< Continuation followed by a continuation */
+#define STRING_UTF8_CARRY          (STRING_UTF8_TOO_SHORT | STRING_UTF8_TOO_LONG | STRING_UTF8_TWO_CONTS)
+
+/** @brief Classes by high nibble of the first byte */
+static const uint8_t string_utf8_first_high[16] = {
+    STRING_UTF8_TOO_LONG, STRING_UTF8_TOO_LONG, STRING_UTF8_TOO_LONG, STRING_UTF8_TOO_LONG,
+    STRING_UTF8_TOO_LONG, STRING_UTF8_TOO_LONG, STRING_UTF8_TOO_LONG, STRING_UTF8_TOO_LONG,
+    STRING_UTF8_TWO_CONTS, STRING_UTF8_TWO_CONTS, STRING_UTF8_TWO_CONTS, STRING_UTF8_TWO_CONTS,
+    STRING_UTF8_TOO_SHORT | STRING_UTF8_OVERLONG_2,
+    STRING_UTF8_TOO_SHORT,
+    STRING_UTF8_TOO_SHORT | STRING_UTF8_OVERLONG_3 | STRING_UTF8_SURROGATE,
+    STRING_UTF8_TOO_SHORT | STRING_UTF8_TOO_LARGE | STRING_UTF8_TOO_LARGE_1000 | STRING_UTF8_OVERLONG_4,
+};
+
+/** @brief Classes by low nibble of the first byte */
+static const uint8_t string_utf8_first_low[16] = {
+    STRING_UTF8_CARRY | STRING_UTF8_OVERLONG_3 | STRING_UTF8_OVERLONG_2 | STRING_UTF8_OVERLONG_4,
+    STRING_UTF8_CARRY | STRING_UTF8_OVERLONG_2,
+    STRING_UTF8_CARRY,
+    STRING_UTF8_CARRY,
+    STRING_UTF8_CARRY | STRING_UTF8_TOO_LARGE,
+    STRING_UTF8_CARRY | STRING_UTF8_TOO_LARGE | STRING_UTF8_TOO_LARGE_1000,
+    STRING_UTF8_CARRY | STRING_UTF8_TOO_LARGE | STRING_UTF8_TOO_LARGE_1000,
+    STRING_UTF8_CARRY | STRING_UTF8_TOO_LARGE | STRING_UTF8_TOO_LARGE_1000,
+    STRING_UTF8_CARRY | STRING_UTF8_TOO_LARGE | STRING_UTF8_TOO_LARGE_1000,
+    STRING_UTF8_CARRY | STRING_UTF8_TOO_LARGE | STRING_UTF8_TOO_LARGE_1000,
+    STRING_UTF8_CARRY | STRING_UTF8_TOO_LARGE | STRING_UTF8_TOO_LARGE_1000,
+    STRING_UTF8_CARRY | STRING_UTF8_TOO_LARGE | STRING_UTF8_TOO_LARGE_1000,
+    STRING_UTF8_CARRY | STRING_UTF8_TOO_LARGE | STRING_UTF8_TOO_LARGE_1000,
+    STRING_UTF8_CARRY | STRING_UTF8_TOO_LARGE | STRING_UTF8_TOO_LARGE_1000 | STRING_UTF8_SURROGATE,
+    STRING_UTF8_CARRY | STRING_UTF8_TOO_LARGE | STRING_UTF8_TOO_LARGE_1000,
+    STRING_UTF8_CARRY | STRING_UTF8_TOO_LARGE | STRING_UTF8_TOO_LARGE_1000,
+};
+
+/** @brief Classes by high nibble of the second byte */
+static const uint8_t string_utf8_second_high[16] = {
+    STRING_UTF8_TOO_SHORT, STRING_UTF8_TOO_SHORT, STRING_UTF8_TOO_SHORT, STRING_UTF8_TOO_SHORT,
+    STRING_UTF8_TOO_SHORT, STRING_UTF8_TOO_SHORT, STRING_UTF8_TOO_SHORT, STRING_UTF8_TOO_SHORT,
+    STRING_UTF8_TOO_LONG | STRING_UTF8_OVERLONG_2 | STRING_UTF8_TWO_CONTS | STRING_UTF8_OVERLONG_3 | STRING_UTF8_TOO_LARGE_1000 | STRING_UTF8_OVERLONG_4,
+    STRING_UTF8_TOO_LONG | STRING_UTF8_OVERLONG_2 | STRING_UTF8_TWO_CONTS | STRING_UTF8_OVERLONG_3 | STRING_UTF8_TOO_LARGE,
+    STRING_UTF8_TOO_LONG | STRING_UTF8_OVERLONG_2 | STRING_UTF8_TWO_CONTS | STRING_UTF8_SURROGATE | STRING_UTF8_TOO_LARGE,
+    STRING_UTF8_TOO_LONG | STRING_UTF8_OVERLONG_2 | STRING_UTF8_TWO_CONTS | STRING_UTF8_SURROGATE | STRING_UTF8_TOO_LARGE,
+    STRING_UTF8_TOO_SHORT, STRING_UTF8_TOO_SHORT, STRING_UTF8_TOO_SHORT, STRING_UTF8_TOO_SHORT,
+};
+
+/** @brief Largest byte values that leave a block complete, for the last three positions of a 16- or 32-byte block */
+static const uint8_t string_utf8_max_lead[32] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF,
+};
+
+/**
+ * @brief Find where to resume scalar validation at a block that failed the vector check
+ * @details Backs up to the start of a sequence that may straddle into the block;
+ *          everything before that point already passed the vector check
+ */
+static size_t string_utf8_resume_point(const char *data, size_t block) {
+    size_t start = block < 3 ? 0 : block - 3;
+    while (start < block && ((unsigned char)data[start] & 0xC0) == 0x80) {
+        start++;
+    }
+
+    return start;
+}
+
+#endif /* STRING_HAVE_X86_SIMD || STRING_HAVE_NEON */
+
+#if defined(STRING_HAVE_X86_SIMD)
+
+/*
+ * ==========================
+ * SSE2 kernels
+ * ==========================
+ */
+
+/**
+ * @brief Compare a 16-byte block against every byte of a set
+ */
+static int string_sse2_match_set(__m128i block, const __m128i *set, size_t set_length) {
+    __m128i hits = _mm_cmpeq_epi8(block, set[0]);
+    for (size_t k = 1; k < set_length; ++k) {
+        hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, set[k]));
+    }
+
+    return _mm_movemask_epi8(hits);
+}
+
+/**
+ * @brief SSE2 forward byte search
+ */
+static size_t string_sse2_find_byte(const char *data, size_t length, char c) {
+    const __m128i needle = _mm_set1_epi8(c);
+    size_t i = 0;
+
+    for (; i + 16 <= length; i += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i *)(data + i));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+        if (mask) {
+            return i + (size_t)__builtin_ctz((unsigned)mask);
+        }
+    }
+
+    return string_simd_offset(i, string_scalar_find_byte(data + i, length - i, c));
+}
+
+/**
+ * @brief SSE2 backward byte search
+ */
+static size_t string_sse2_rfind_byte(const char *data, size_t length, char c) {
+    const __m128i needle = _mm_set1_epi8(c);
+    size_t i = length;
+
+    while (i >= 16) {
+        i -= 16;
+        __m128i block = _mm_loadu_si128((const __m128i *)(data + i));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+        if (mask) {
+            return i + 31 - (size_t)__builtin_clz((unsigned)mask);
+        }
+    }
+
+    return string_scalar_rfind_byte(data, i, c);
+}
+
+/**
+ * @brief SSE2 forward byte-set search
+ */
+static size_t string_sse2_find_any(const char *data, size_t length, const char *set, size_t set_length) {
+    __m128i needles[STRING_SIMD_MAX_SET_SIZE];
+    for (size_t k = 0; k < set_length; ++k) {
+        needles[k] = _mm_set1_epi8(set[k]);
+    }
+
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        int mask = string_sse2_match_set(_mm_loadu_si128((const __m128i *)(data + i)), needles, set_length);
+        if (mask) {
+            return i + (size_t)__builtin_ctz((unsigned)mask);
+        }
+    }
+
+    return string_simd_offset(i, string_scalar_find_any(data + i, length - i, set, set_length));
+}
+
+/**
+ * @brief SSE2 backward byte-set search
+ */
+static size_t string_sse2_rfind_any(const char *data, size_t length, const char *set, size_t set_length) {
+    __m128i needles[STRING_SIMD_MAX_SET_SIZE];
+    for (size_t k = 0; k < set_length; ++k) {
+        needles[k] = _mm_set1_epi8(set[k]);
+    }
+
+    size_t i = length;
+    while (i >= 16) {
+        i -= 16;
+        int mask = string_sse2_match_set(_mm_loadu_si128((const __m128i *)(data + i)), needles, set_length);
+        if (mask) {
+            return i + 31 - (size_t)__builtin_clz((unsigned)mask);
+        }
+    }
+
+    return string_scalar_rfind_any(data, i, set, set_length);
+}
+
+/**
+ * @brief SSE2 substring search with a first/last-byte prefilter
+ * @details Candidates are positions where both the first and the last needle byte match
+ */
+static size_t string_sse2_find_substr(const char *data, size_t length, const char *needle, size_t needle_length) {
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last = _mm_set1_epi8(needle[needle_length - 1]);
+    size_t i = 0;
+
+    for (; i + needle_length - 1 + 16 <= length; i += 16) {
+        __m128i eq_first = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(data + i)), first);
+        __m128i eq_last = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(data + i + needle_length - 1)), last);
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_and_si128(eq_first, eq_last));
+        while (mask) {
+            size_t candidate = i + (size_t)__builtin_ctz(mask);
+            if (memcmp(data + candidate + 1, needle + 1, needle_length - 2) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    return string_simd_offset(i, string_two_way_find(data + i, length - i, needle, needle_length));
+}
+
+/**
+ * @brief Flip the case of every ASCII letter of one case in a 16-byte block
+ * @details Letters from first_letter to first_letter + 25 are moved by the signed
+ *          bias to the bottom of the signed range, so one compare finds them
+ */
+static __m128i string_sse2_flip_case(__m128i block, char first_letter) {
+    __m128i shifted = _mm_add_epi8(block, _mm_set1_epi8((char)(0x80 - first_letter)));
+    __m128i letters = _mm_cmplt_epi8(shifted, _mm_set1_epi8((char)(0x80 + 26)));
+
+    return _mm_xor_si128(block, _mm_and_si128(letters, _mm_set1_epi8(0x20)));
+}
+
+/**
+ * @brief SSE2 ASCII case conversion
+ */
+static void string_sse2_ascii_case(char *data, size_t length, bool upper) {
+    const char first = upper ? 'a' : 'A';
+    size_t i = 0;
+
+    for (; i + 16 <= length; i += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i *)(data + i));
+        _mm_storeu_si128((__m128i *)(data + i), string_sse2_flip_case(block, first));
+    }
+
+    string_scalar_ascii_case(data + i, length - i, upper);
+}
+
+/**
+ * @brief SSE2 case-insensitive mismatch search
+ */
+static size_t string_sse2_mismatch_icase(const char *a, const char *b, size_t length) {
+    size_t i = 0;
+
+    for (; i + 16 <= length; i += 16) {
+        __m128i block_a = string_sse2_flip_case(_mm_loadu_si128((const __m128i *)(a + i)), 'A');
+        __m128i block_b = string_sse2_flip_case(_mm_loadu_si128((const __m128i *)(b + i)), 'A');
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(block_a, block_b)) ^ 0xffffu;
+        if (mask) {
+            return i + (size_t)__builtin_ctz(mask);
+        }
+    }
+
+    return i + string_scalar_mismatch_icase(a + i, b + i, length - i);
+}
+
+/**
+ * @brief SSE2 case-insensitive substring search with a first/last-byte prefilter
+ */
+static size_t string_sse2_find_substr_icase(const char *data, size_t length, const char *needle, size_t needle_length) {
+    const __m128i first = _mm_set1_epi8((char)string_fold_byte((unsigned char)needle[0], true));
+    const __m128i last = _mm_set1_epi8((char)string_fold_byte((unsigned char)needle[needle_length - 1], true));
+    size_t i = 0;
+
+    for (; i + needle_length - 1 + 16 <= length; i += 16) {
+        __m128i eq_first = _mm_cmpeq_epi8(string_sse2_flip_case(_mm_loadu_si128((const __m128i *)(data + i)), 'A'), first);
+        __m128i eq_last = _mm_cmpeq_epi8(string_sse2_flip_case(_mm_loadu_si128((const __m128i *)(data + i + needle_length - 1)), 'A'), last);
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_and_si128(eq_first, eq_last));
+        while (mask) {
+            size_t candidate = i + (size_t)__builtin_ctz(mask);
+            if (string_sse2_mismatch_icase(data + candidate + 1, needle + 1, needle_length - 2) == needle_length - 2) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    return string_simd_offset(i, string_two_way_find_icase(data + i, length - i, needle, needle_length));
+}
+
+/**
+ * @brief SSE2 delimiter split
+ * @details Each block's delimiter bitmask is walked bit by bit, one field per bit
+ */
+static size_t string_sse2_split_byte(const char *data, size_t length, char delimiter, string_view_t *fields, size_t capacity, size_t *consumed) {
+    const __m128i needle = _mm_set1_epi8(delimiter);
+    size_t count = 0;
+    size_t field_start = 0;
+    size_t i = 0;
+
+    for (; i + 16 <= length && count < capacity; i += 16) {
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(data + i)), needle));
+        while (mask) {
+            size_t pos = i + (size_t)__builtin_ctz(mask);
+            fields[count].data = data + field_start;
+            fields[count].length = pos - field_start;
+            field_start = pos + 1;
+            if (++count == capacity) {
+                *consumed = field_start;
+                return count;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    return string_scalar_split_byte(data, length, delimiter, fields, capacity, count, field_start, i, consumed);
+}
+
+/**
+ * @brief SSE2 UTF-8 validation
+ * @details Skips ASCII blocks; a block with other bytes is decoded by the scalar kernel
+ */
+static size_t string_sse2_utf8_invalid(const char *data, size_t length) {
+    size_t i = 0;
+
+    while (i + 16 <= length) {
+        if (!_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(data + i)))) {
+            i += 16;
+            continue;
+        }
+
+        size_t found = string_scalar_utf8_invalid(data, length, &i, i + 16);
+        if (found != STRING_NPOS) {
+            return found;
+        }
+    }
+
+    return string_scalar_utf8_invalid(data, length, &i, length);
+}
+
+/**
+ * @brief SSE2 count of bytes that are not UTF-8 continuation bytes
+ */
+static size_t string_sse2_utf8_count(const char *data, size_t length) {
+    // Continuation bytes 0x80..0xBF are exactly the signed bytes below -64
+    const __m128i threshold = _mm_set1_epi8(-65);
+    size_t count = 0;
+    size_t i = 0;
+
+    for (; i + 16 <= length; i += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i *)(data + i));
+        count += (size_t)__builtin_popcount((unsigned)_mm_movemask_epi8(_mm_cmpgt_epi8(block, threshold)));
+    }
+
+    return count + string_scalar_utf8_count(data + i, length - i);
+}
+
+/**
+ * @brief SSE2 ASCII widening to UTF-16
+ */
+static size_t string_sse2_ascii_to_utf16(const char *data, size_t length, uint16_t *dest) {
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+
+    for (; i + 16 <= length; i += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i *)(data + i));
+        if (_mm_movemask_epi8(block)) {
+            break;
+        }
+        _mm_storeu_si128((__m128i *)(dest + i), _mm_unpacklo_epi8(block, zero));
+        _mm_storeu_si128((__m128i *)(dest + i + 8), _mm_unpackhi_epi8(block, zero));
+    }
+
+    return i + string_scalar_ascii_to_utf16(data + i, length - i, dest + i);
+}
+
+/**
+ * @brief SSE2 ASCII narrowing from UTF-16
+ */
+static size_t string_sse2_utf16_to_ascii(const uint16_t *units, size_t length, char *dest) {
+    const __m128i non_ascii = _mm_set1_epi16((short)0xFF80);
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+
+    for (; i + 16 <= length; i += 16) {
+        __m128i low = _mm_loadu_si128((const __m128i *)(units + i));
+        __m128i high = _mm_loadu_si128((const __m128i *)(units + i + 8));
+        __m128i above = _mm_and_si128(_mm_or_si128(low, high), non_ascii);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(above, zero)) != 0xFFFF) {
+            break;
+        }
+        _mm_storeu_si128((__m128i *)(dest + i), _mm_packus_epi16(low, high));
+    }
+
+    return i + string_scalar_utf16_to_ascii(units + i, length - i, dest + i);
+}
+
+/*
+ * ==========================
+ * AVX2 kernels
+ * ==========================
+ */
+
+/**
+ * @brief Compare a 32-byte block against every byte of a set
+ */
+__attribute__((target("avx2"))) static unsigned string_avx2_match_set(__m256i block, const __m256i *set, size_t set_length) {
+    __m256i hits = _mm256_cmpeq_epi8(block, set[0]);
+    for (size_t k = 1; k < set_length; ++k) {
+        hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, set[k]));
+    }
+
+    return (unsigned)_mm256_movemask_epi8(hits);
+}
+
+/**
+ * @brief AVX2 forward byte search
+ * @details Scans 64 bytes per iteration and resolves the exact offset only on a hit
+ */
+__attribute__((target("avx2"))) static size_t string_avx2_find_byte(const char *data, size_t length, char c) {
+    const __m256i needle = _mm256_set1_epi8(c);
+    size_t i = 0;
+
+    for (; i + 64 <= length; i += 64) {
+        __m256i eq0 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(data + i)), needle);
+        __m256i eq1 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(data + i + 32)), needle);
+        if (!_mm256_testz_si256(_mm256_or_si256(eq0, eq1), _mm256_or_si256(eq0, eq1))) {
+            unsigned mask = (unsigned)_mm256_movemask_epi8(eq0);
+            if (mask) {
+                return i + (size_t)__builtin_ctz(mask);
+            }
+            return i + 32 + (size_t)__builtin_ctz((unsigned)_mm256_movemask_epi8(eq1));
+        }
+    }
+
+    for (; i + 32 <= length; i += 32) {
+        unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(data + i)), needle));
+        if (mask) {
+            return i + (size_t)__builtin_ctz(mask);
+        }
+    }
+
+    return string_simd_offset(i, string_sse2_find_byte(data + i, length - i, c));
+}
+
+/**
+ * @brief AVX2 backward byte search
+ */
+__attribute__((target("avx2"))) static size_t string_avx2_rfind_byte(const char *data, size_t length, char c) {
+    const __m256i needle = _mm256_set1_epi8(c);
+    size_t i = length;
+
+    while (i >= 32) {
+        i -= 32;
+        unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(data + i)), needle));
+        if (mask) {
+            return i + 31 - (size_t)__builtin_clz(mask);
+        }
+    }
+
+    return string_sse2_rfind_byte(data, i, c);
+}
+
+/**
+ * @brief AVX2 forward byte-set search
+ */
+__attribute__((target("avx2"))) static size_t string_avx2_find_any(const char *data, size_t length, const char *set, size_t set_length) {
+    __m256i needles[STRING_SIMD_MAX_SET_SIZE];
+    for (size_t k = 0; k < set_length; ++k) {
+        needles[k] = _mm256_set1_epi8(set[k]);
+    }
+
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        unsigned mask = string_avx2_match_set(_mm256_loadu_si256((const __m256i *)(data + i)), needles, set_length);
+        if (mask) {
+            return i + (size_t)__builtin_ctz(mask);
+        }
+    }
+
+    return string_simd_offset(i, string_sse2_find_any(data + i, length - i, set, set_length));
+}
+
+/**
+ * @brief AVX2 backward byte-set search
+ */
+__attribute__((target("avx2"))) static size_t string_avx2_rfind_any(const char *data, size_t length, const char *set, size_t set_length) {
+    __m256i needles[STRING_SIMD_MAX_SET_SIZE];
+    for (size_t k = 0; k < set_length; ++k) {
+        needles[k] = _mm256_set1_epi8(set[k]);
+    }
+
+    size_t i = length;
+    while (i >= 32) {
+        i -= 32;
+        unsigned mask = string_avx2_match_set(_mm256_loadu_si256((const __m256i *)(data + i)), needles, set_length);
+        if (mask) {
+            return i + 31 - (size_t)__builtin_clz(mask);
+        }
+    }
+
+    return string_sse2_rfind_any(data, i, set, set_length);
+}
+
+/**
+ * @brief AVX2 substring search with a first/last-byte prefilter
+ * @details Candidates are positions where both the first and the last needle byte match
+ */
+__attribute__((target("avx2"))) static size_t string_avx2_find_substr(const char *data, size_t length, const char *needle, size_t needle_length) {
+    const __m256i first = _mm256_set1_epi8(needle[0]);
+    const __m256i last = _mm256_set1_epi8(needle[needle_length - 1]);
+    size_t i = 0;
+
+    for (; i + needle_length - 1 + 32 <= length; i += 32) {
+        __m256i eq_first = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(data + i)), first);
+        __m256i eq_last = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(data + i + needle_length - 1)), last);
+        unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_and_si256(eq_first, eq_last));
+        while (mask) {
+            size_t candidate = i + (size_t)__builtin_ctz(mask);
+            if (memcmp(data + candidate + 1, needle + 1, needle_length - 2) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    return string_simd_offset(i, string_sse2_find_substr(data + i, length - i, needle, needle_length));
+}
+
+/**
+ * @brief Flip the case of every ASCII letter of one case in a 32-byte block
+ */
+__attribute__((target("avx2"))) static __m256i string_avx2_flip_case(__m256i block, char first_letter) {
+    __m256i shifted = _mm256_add_epi8(block, _mm256_set1_epi8((char)(0x80 - first_letter)));
+    __m256i letters = _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(0x80 + 26)), shifted);
+
+    return _mm256_xor_si256(block, _mm256_and_si256(letters, _mm256_set1_epi8(0x20)));
+}
+
+/**
+ * @brief AVX2 ASCII case conversion
+ */
+__attribute__((target("avx2"))) static void string_avx2_ascii_case(char *data, size_t length, bool upper) {
+    const char first = upper ? 'a' : 'A';
+    size_t i = 0;
+
+    for (; i + 32 <= length; i += 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i *)(data + i));
+        _mm256_storeu_si256((__m256i *)(data + i), string_avx2_flip_case(block, first));
+    }
+
+    string_sse2_ascii_case(data + i, length - i, upper);
+}
+
+/**
+ * @brief AVX2 case-insensitive mismatch search
+ */
+__attribute__((target("avx2"))) static size_t string_avx2_mismatch_icase(const char *a, const char *b, size_t length) {
+    size_t i = 0;
+
+    for (; i + 32 <= length; i += 32) {
+        __m256i block_a = string_avx2_flip_case(_mm256_loadu_si256((const __m256i *)(a + i)), 'A');
+        __m256i block_b = string_avx2_flip_case(_mm256_loadu_si256((const __m256i *)(b + i)), 'A');
+        unsigned mask = ~(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block_a, block_b));
+        if (mask) {
+            return i + (size_t)__builtin_ctz(mask);
+        }
+    }
+
+    return i + string_sse2_mismatch_icase(a + i, b + i, length - i);
+}
+
+/**
+ * @brief AVX2 case-insensitive substring search with a first/last-byte prefilter
+ */
+__attribute__((target("avx2"))) static size_t string_avx2_find_substr_icase(const char *data, size_t length, const char *needle, size_t needle_length) {
+    const __m256i first = _mm256_set1_epi8((char)string_fold_byte((unsigned char)needle[0], true));
+    const __m256i last = _mm256_set1_epi8((char)string_fold_byte((unsigned char)needle[needle_length - 1], true));
+    size_t i = 0;
+
+    for (; i + needle_length - 1 + 32 <= length; i += 32) {
+        __m256i eq_first = _mm256_cmpeq_epi8(string_avx2_flip_case(_mm256_loadu_si256((const __m256i *)(data + i)), 'A'), first);
+        __m256i eq_last = _mm256_cmpeq_epi8(string_avx2_flip_case(_mm256_loadu_si256((const __m256i *)(data + i + needle_length - 1)), 'A'), last);
+        unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_and_si256(eq_first, eq_last));
+        while (mask) {
+            size_t candidate = i + (size_t)__builtin_ctz(mask);
+            if (string_avx2_mismatch_icase(data + candidate + 1, needle + 1, needle_length - 2) == needle_length - 2) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    return string_simd_offset(i, string_sse2_find_substr_icase(data + i, length - i, needle, needle_length));
+}
+
+/**
+ * @brief AVX2 delimiter split
+ */
+__attribute__((target("avx2"))) static size_t string_avx2_split_byte(const char *data,
+                                                                     size_t length,
+                                                                     char delimiter,
+                                                                     string_view_t *fields,
+                                                                     size_t capacity,
+                                                                     size_t *consumed) {
+    const __m256i needle = _mm256_set1_epi8(delimiter);
+    size_t count = 0;
+    size_t field_start = 0;
+    size_t i = 0;
+
+    for (; i + 32 <= length && count < capacity; i += 32) {
+        unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(data + i)), needle));
+        while (mask) {
+            size_t pos = i + (size_t)__builtin_ctz(mask);
+            fields[count].data = data + field_start;
+            fields[count].length = pos - field_start;
+            field_start = pos + 1;
+            if (++count == capacity) {
+                *consumed = field_start;
+                return count;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    return string_scalar_split_byte(data, length, delimiter, fields, capacity, count, field_start, i, consumed);
+}
+
+/**
+ * @brief Test 32 bytes against a character class
+ * @details The low nibble selects a column of the class table (bytes from 0x80
+ *          up use the upper half) and the high nibble selects a bit within it.
+ *          Shuffle indices with the top bit set read zero, which keeps the two
+ *          halves apart.
+ */
+__attribute__((target("avx2"))) static inline unsigned string_avx2_match_class(__m256i block, __m256i lower, __m256i upper, __m256i rows) {
+    const __m256i top = _mm256_set1_epi8((char)0x80);
+    __m256i column = _mm256_and_si256(block, _mm256_set1_epi8((char)0x8F));
+    __m256i bits = _mm256_or_si256(_mm256_shuffle_epi8(lower, column), _mm256_shuffle_epi8(upper, _mm256_xor_si256(column, top)));
+    __m256i row = _mm256_shuffle_epi8(rows, _mm256_and_si256(_mm256_srli_epi16(block, 4), _mm256_set1_epi8(0x0F)));
+
+    return (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(bits, row), row));
+}
+
+/**
+ * @brief AVX2 forward character-class search
+ */
+__attribute__((target("avx2"))) static size_t string_avx2_find_class(const char *data, size_t length, const string_char_class_t *cls, bool member) {
+    const __m256i lower = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)cls->table));
+    const __m256i upper = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)(cls->table + 16)));
+    const __m256i rows = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)string_class_row_bits));
+    const unsigned flip = member ? 0u : ~0u;
+    size_t i = 0;
+
+    for (; i + 32 <= length; i += 32) {
+        unsigned mask = string_avx2_match_class(_mm256_loadu_si256((const __m256i *)(data + i)), lower, upper, rows) ^ flip;
+        if (mask) {
+            return i + (size_t)__builtin_ctz(mask);
+        }
+    }
+
+    return string_simd_offset(i, string_scalar_find_class(data + i, length - i, cls, member));
+}
+
+/**
+ * @brief AVX2 backward character-class search
+ */
+__attribute__((target("avx2"))) static size_t string_avx2_rfind_class(const char *data, size_t length, const string_char_class_t *cls, bool member) {
+    const __m256i lower = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)cls->table));
+    const __m256i upper = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)(cls->table + 16)));
+    const __m256i rows = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)string_class_row_bits));
+    const unsigned flip = member ? 0u : ~0u;
+    size_t i = length;
+
+    while (i >= 32) {
+        i -= 32;
+        unsigned mask = string_avx2_match_class(_mm256_loadu_si256((const __m256i *)(data + i)), lower, upper, rows) ^ flip;
+        if (mask) {
+            return i + 31 - (size_t)__builtin_clz(mask);
+        }
+    }
+
+    return string_scalar_rfind_class(data, i, cls, member);
+}
+
+/**
+ * @brief Classify the byte pairs of a 32-byte block
+ * @return Non-zero bytes where the block is not valid UTF-8 after previous
+ */
+__attribute__((target("avx2"))) static inline __m256i string_avx2_utf8_block(__m256i input, __m256i previous) {
+    const __m256i first_high = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)string_utf8_first_high));
+    const __m256i first_low = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)string_utf8_first_low));
+    const __m256i second_high = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)string_utf8_second_high));
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+
+    // Bytes 1, 2 and 3 positions back, reaching into the previous block
+    __m256i carried = _mm256_permute2x128_si256(previous, input, 0x21);
+    __m256i prev1 = _mm256_alignr_epi8(input, carried, 15);
+    __m256i prev2 = _mm256_alignr_epi8(input, carried, 14);
+    __m256i prev3 = _mm256_alignr_epi8(input, carried, 13);
+
+    __m256i classes = _mm256_and_si256(
+        _mm256_and_si256(_mm256_shuffle_epi8(first_high, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble)),
+                         _mm256_shuffle_epi8(first_low, _mm256_and_si256(prev1, nibble))),
+        _mm256_shuffle_epi8(second_high, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble)));
+
+    // Third and fourth bytes of a sequence must be the only continuation pairs
+    __m256i third = _mm256_subs_epu8(prev2, _mm256_set1_epi8((char)(0xE0 - 0x80)));
+    __m256i fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8((char)(0xF0 - 0x80)));
+    __m256i expected = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8((char)0x80));
+
+    return _mm256_xor_si256(expected, classes);
+}
+
+/**
+ * @brief AVX2 UTF-8 validation
+ * @details Checks 32 bytes per step and skips ASCII blocks; the tail is checked
+ *          zero-padded, which also catches a sequence cut short by the end
+ */
+__attribute__((target("avx2"))) static size_t string_avx2_utf8_invalid(const char *data, size_t length) {
+    const __m256i max_lead = _mm256_loadu_si256((const __m256i *)string_utf8_max_lead);
+    __m256i previous = _mm256_setzero_si256();
+    __m256i incomplete = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; i + 32 <= length; i += 32) {
+        __m256i input = _mm256_loadu_si256((const __m256i *)(data + i));
+        __m256i error = incomplete;
+        if (_mm256_movemask_epi8(input)) {
+            error = string_avx2_utf8_block(input, previous);
+            incomplete = _mm256_subs_epu8(input, max_lead);
+        } else {
+            incomplete = _mm256_setzero_si256();
+        }
+
+        if (!_mm256_testz_si256(error, error)) {
+            break;
+        }
+        previous = input;
+    }
+
+    if (i + 32 > length) {
+        __m256i error = incomplete;
+        if (i < length) {
+            char tail[32] = { 0 };
+            memcpy(tail, data + i, length - i);
+            error = string_avx2_utf8_block(_mm256_loadu_si256((const __m256i *)tail), previous);
+        }
+
+        if (_mm256_testz_si256(error, error)) {
+            return STRING_NPOS;
+        }
+    }
+
+    size_t position = string_utf8_resume_point(data, i);
+    return string_scalar_utf8_invalid(data, length, &position, length);
+}
+
+/**
+ * @brief AVX2 count of bytes that are not UTF-8 continuation bytes
+ */
+__attribute__((target("avx2"))) static size_t string_avx2_utf8_count(const char *data, size_t length) {
+    const __m256i threshold = _mm256_set1_epi8(-65);
+    size_t count = 0;
+    size_t i = 0;
+
+    for (; i + 32 <= length; i += 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i *)(data + i));
+        count += (size_t)__builtin_popcount((unsigned)_mm256_movemask_epi8(_mm256_cmpgt_epi8(block, threshold)));
+    }
+
+    return count + string_sse2_utf8_count(data + i, length - i);
+}
+
+/**
+ * @brief AVX2 ASCII widening to UTF-16
+ */
+__attribute__((target("avx2"))) static size_t string_avx2_ascii_to_utf16(const char *data, size_t length, uint16_t *dest) {
+    size_t i = 0;
+
+    for (; i + 32 <= length; i += 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i *)(data + i));
+        if (_mm256_movemask_epi8(block)) {
+            break;
+        }
+        _mm256_storeu_si256((__m256i *)(dest + i), _mm256_cvtepu8_epi16(_mm256_castsi256_si128(block)));
+        _mm256_storeu_si256((__m256i *)(dest + i + 16), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(block, 1)));
+    }
+
+    return i + string_sse2_ascii_to_utf16(data + i, length - i, dest + i);
+}
+
+#endif /* STRING_HAVE_X86_SIMD */
+
+#if defined(STRING_HAVE_NEON)
+
+/*
+ * ==========================
+ * NEON kernels
+ * ==========================
+ */
+
+/**
+ * @brief Narrow a byte comparison result to a 64-bit mask (4 bits per byte)
+ */
+static uint64_t string_neon_mask(uint8x16_t eq) {
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+}
+
+/**
+ * @brief Compare a 16-byte block against every byte of a set
+ */
+static uint64_t string_neon_match_set(uint8x16_t block, const uint8x16_t *set, size_t set_length) {
+    uint8x16_t hits = vceqq_u8(block, set[0]);
+    for (size_t k = 1; k < set_length; ++k) {
+        hits = vorrq_u8(hits, vceqq_u8(block, set[k]));
+    }
+
+    return string_neon_mask(hits);
+}
+
+/**
+ * @brief NEON forward byte search
+ */
+static size_t string_neon_find_byte(const char *data, size_t length, char c) {
+    const uint8x16_t needle = vdupq_n_u8((uint8_t)c);
+    size_t i = 0;
+
+    for (; i + 16 <= length; i += 16) {
+        uint64_t mask = string_neon_mask(vceqq_u8(vld1q_u8((const uint8_t *)data + i), needle));
+        if (mask) {
+            return i + ((size_t)__builtin_ctzll(mask) >> 2);
+        }
+    }
+
+    return string_simd_offset(i, string_scalar_find_byte(data + i, length - i, c));
+}
+
+/**
+ * @brief NEON backward byte search
+ */
+static size_t string_neon_rfind_byte(const char *data, size_t length, char c) {
+    const uint8x16_t needle = vdupq_n_u8((uint8_t)c);
+    size_t i = length;
+
+    while (i >= 16) {
+        i -= 16;
+        uint64_t mask = string_neon_mask(vceqq_u8(vld1q_u8((const uint8_t *)data + i), needle));
+        if (mask) {
+            return i + ((63 - (size_t)__builtin_clzll(mask)) >> 2);
+        }
+    }
+
+    return string_scalar_rfind_byte(data, i, c);
+}
+
+/**
+ * @brief NEON forward byte-set search
+ */
+static size_t string_neon_find_any(const char *data, size_t length, const char *set, size_t set_length) {
+    uint8x16_t needles[STRING_SIMD_MAX_SET_SIZE];
+    for (size_t k = 0; k < set_length; ++k) {
+        needles[k] = vdupq_n_u8((uint8_t)set[k]);
+    }
+
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        uint64_t mask = string_neon_match_set(vld1q_u8((const uint8_t *)data + i), needles, set_length);
+        if (mask) {
+            return i + ((size_t)__builtin_ctzll(mask) >> 2);
+        }
+    }
+
+    return string_simd_offset(i, string_scalar_find_any(data + i, length - i, set, set_length));
+}
+
+/**
+ * @brief NEON backward byte-set search
+ */
+static size_t string_neon_rfind_any(const char *data, size_t length, const char *set, size_t set_length) {
+    uint8x16_t needles[STRING_SIMD_MAX_SET_SIZE];
+    for (size_t k = 0; k < set_length; ++k) {
+        needles[k] = vdupq_n_u8((uint8_t)set[k]);
+    }
+
+    size_t i = length;
+    while (i >= 16) {
+        i -= 16;
+        uint64_t mask = string_neon_match_set(vld1q_u8((const uint8_t *)data + i), needles, set_length);
+        if (mask) {
+            return i + ((63 - (size_t)__builtin_clzll(mask)) >> 2);
+        }
+    }
+
+    return string_scalar_rfind_any(data, i, set, set_length);
+}
+
+/**
+ * @brief NEON substring search with a first/last-byte prefilter
+ * @details Candidates are positions where both the first and the last needle byte match
+ */
+static size_t string_neon_find_substr(const char *data, size_t length, const char *needle, size_t needle_length) {
+    const uint8x16_t first = vdupq_n_u8((uint8_t)needle[0]);
+    const uint8x16_t last = vdupq_n_u8((uint8_t)needle[needle_length - 1]);
+    size_t i = 0;
+
+    for (; i + needle_length - 1 + 16 <= length; i += 16) {
+        uint8x16_t eq_first = vceqq_u8(vld1q_u8((const uint8_t *)data + i), first);
+        uint8x16_t eq_last = vceqq_u8(vld1q_u8((const uint8_t *)data + i + needle_length - 1), last);
+        uint64_t mask = string_neon_mask(vandq_u8(eq_first, eq_last));
+        while (mask) {
+            size_t bit = (size_t)__builtin_ctzll(mask);
+            size_t candidate = i + (bit >> 2);
+            if (memcmp(data + candidate + 1, needle + 1, needle_length - 2) == 0) {
+                return candidate;
+            }
+            mask &= ~(0xFULL << (bit & ~(size_t)3));
+        }
+    }
+
+    return string_simd_offset(i, string_two_way_find(data + i, length - i, needle, needle_length));
+}
+
+/**
+ * @brief Flip the case of every ASCII letter of one case in a 16-byte block
+ */
+static uint8x16_t string_neon_flip_case(uint8x16_t block, uint8_t first_letter) {
+    uint8x16_t letters = vcltq_u8(vsubq_u8(block, vdupq_n_u8(first_letter)), vdupq_n_u8(26));
+
+    return veorq_u8(block, vandq_u8(letters, vdupq_n_u8(0x20)));
+}
+
+/**
+ * @brief NEON ASCII case conversion
+ */
+static void string_neon_ascii_case(char *data, size_t length, bool upper) {
+    const uint8_t first = upper ? 'a' : 'A';
+    size_t i = 0;
+
+    for (; i + 16 <= length; i += 16) {
+        uint8x16_t block = vld1q_u8((const uint8_t *)data + i);
+        vst1q_u8((uint8_t *)data + i, string_neon_flip_case(block, first));
+    }
+
+    string_scalar_ascii_case(data + i, length - i, upper);
+}
+
+/**
+ * @brief NEON case-insensitive mismatch search
+ */
+static size_t string_neon_mismatch_icase(const char *a, const char *b, size_t length) {
+    size_t i = 0;
+
+    for (; i + 16 <= length; i += 16) {
+        uint8x16_t block_a = string_neon_flip_case(vld1q_u8((const uint8_t *)a + i), 'A');
+        uint8x16_t block_b = string_neon_flip_case(vld1q_u8((const uint8_t *)b + i), 'A');
+        uint64_t mask = string_neon_mask(vmvnq_u8(vceqq_u8(block_a, block_b)));
+        if (mask) {
+            return i + ((size_t)__builtin_ctzll(mask) >> 2);
+        }
+    }
+
+    return i + string_scalar_mismatch_icase(a + i, b + i, length - i);
+}
+
+/**
+ * @brief NEON case-insensitive substring search with a first/last-byte prefilter
+ */
+static size_t string_neon_find_substr_icase(const char *data, size_t length, const char *needle, size_t needle_length) {
+    const uint8x16_t first = vdupq_n_u8(string_fold_byte((unsigned char)needle[0], true));
+    const uint8x16_t last = vdupq_n_u8(string_fold_byte((unsigned char)needle[needle_length - 1], true));
+    size_t i = 0;
+
+    for (; i + needle_length - 1 + 16 <= length; i += 16) {
+        uint8x16_t eq_first = vceqq_u8(string_neon_flip_case(vld1q_u8((const uint8_t *)data + i), 'A'), first);
+        uint8x16_t eq_last = vceqq_u8(string_neon_flip_case(vld1q_u8((const uint8_t *)data + i + needle_length - 1), 'A'), last);
+        uint64_t mask = string_neon_mask(vandq_u8(eq_first, eq_last));
+        while (mask) {
+            size_t bit = (size_t)__builtin_ctzll(mask);
+            size_t candidate = i + (bit >> 2);
+            if (string_neon_mismatch_icase(data + candidate + 1, needle + 1, needle_length - 2) == needle_length - 2) {
+                return candidate;
+            }
+            mask &= ~(0xFULL << (bit & ~(size_t)3));
+        }
+    }
+
+    return string_simd_offset(i, string_two_way_find_icase(data + i, length - i, needle, needle_length));
+}
+
+/**
+ * @brief NEON delimiter split
+ */
+static size_t string_neon_split_byte(const char *data, size_t length, char delimiter, string_view_t *fields, size_t capacity, size_t *consumed) {
+    const uint8x16_t needle = vdupq_n_u8((uint8_t)delimiter);
+    size_t count = 0;
+    size_t field_start = 0;
+    size_t i = 0;
+
+    for (; i + 16 <= length && count < capacity; i += 16) {
+        uint64_t mask = string_neon_mask(vceqq_u8(vld1q_u8((const uint8_t *)data + i), needle));
+        while (mask) {
+            size_t bit = (size_t)__builtin_ctzll(mask);
+            size_t pos = i + (bit >> 2);
+            fields[count].data = data + field_start;
+            fields[count].length = pos - field_start;
+            field_start = pos + 1;
+            if (++count == capacity) {
+                *consumed = field_start;
+                return count;
+            }
+            mask &= ~(0xFULL << (bit & ~(size_t)3));
+        }
+    }
+
+    return string_scalar_split_byte(data, length, delimiter, fields, capacity, count, field_start, i, consumed);
+}
+
+/**
+ * @brief Test 16 bytes against a character class
+ * @details Same lookup as the AVX2 kernel; table indices of 16 and above read zero
+ */
+static inline uint64_t string_neon_match_class(uint8x16_t block, uint8x16_t lower, uint8x16_t upper, uint8x16_t rows) {
+    uint8x16_t column = vandq_u8(block, vdupq_n_u8(0x8F));
+    uint8x16_t bits = vorrq_u8(vqtbl1q_u8(lower, column), vqtbl1q_u8(upper, veorq_u8(column, vdupq_n_u8(0x80))));
+    uint8x16_t row = vqtbl1q_u8(rows, vshrq_n_u8(block, 4));
+
+    return string_neon_mask(vtstq_u8(bits, row));
+}
+
+/**
+ * @brief NEON forward character-class search
+ */
+static size_t string_neon_find_class(const char *data, size_t length, const string_char_class_t *cls, bool member) {
+    const uint8x16_t lower = vld1q_u8(cls->table);
+    const uint8x16_t upper = vld1q_u8(cls->table + 16);
+    const uint8x16_t rows = vld1q_u8(string_class_row_bits);
+    const uint64_t flip = member ? 0 : ~UINT64_C(0);
+    size_t i = 0;
+
+    for (; i + 16 <= length; i += 16) {
+        uint64_t mask = string_neon_match_class(vld1q_u8((const uint8_t *)data + i), lower, upper, rows) ^ flip;
+        if (mask) {
+            return i + ((size_t)__builtin_ctzll(mask) >> 2);
+        }
+    }
+
+    return string_simd_offset(i, string_scalar_find_class(data + i, length - i, cls, member));
+}
+
+/**
+ * @brief NEON backward character-class search
+ */
+static size_t string_neon_rfind_class(const char *data, size_t length, const string_char_class_t *cls, bool member) {
+    const uint8x16_t lower = vld1q_u8(cls->table);
+    const uint8x16_t upper = vld1q_u8(cls->table + 16);
+    const uint8x16_t rows = vld1q_u8(string_class_row_bits);
+    const uint64_t flip = member ? 0 : ~UINT64_C(0);
+    size_t i = length;
+
+    while (i >= 16) {
+        i -= 16;
+        uint64_t mask = string_neon_match_class(vld1q_u8((const uint8_t *)data + i), lower, upper, rows) ^ flip;
+        if (mask) {
+            return i + ((63 - (size_t)__builtin_clzll(mask)) >> 2);
+        }
+    }
+
+    return string_scalar_rfind_class(data, i, cls, member);
+}
+
+/**
+ * @brief Classify the byte pairs of a 16-byte block
+ * @return Non-zero bytes where the block is not valid UTF-8 after previous
+ */
+static inline uint8x16_t string_neon_utf8_block(uint8x16_t input, uint8x16_t previous) {
+    const uint8x16_t first_high = vld1q_u8(string_utf8_first_high);
+    const uint8x16_t first_low = vld1q_u8(string_utf8_first_low);
+    const uint8x16_t second_high = vld1q_u8(string_utf8_second_high);
+
+    // Bytes 1, 2 and 3 positions back, reaching into the previous block
+    uint8x16_t prev1 = vextq_u8(previous, input, 15);
+    uint8x16_t prev2 = vextq_u8(previous, input, 14);
+    uint8x16_t prev3 = vextq_u8(previous, input, 13);
+
+    uint8x16_t classes = vandq_u8(vandq_u8(vqtbl1q_u8(first_high, vshrq_n_u8(prev1, 4)),
+                                           vqtbl1q_u8(first_low, vandq_u8(prev1, vdupq_n_u8(0x0F)))),
+                                  vqtbl1q_u8(second_high, vshrq_n_u8(input, 4)));
+
+    // Third and fourth bytes of a sequence must be the only continuation pairs
+    uint8x16_t third = vqsubq_u8(prev2, vdupq_n_u8(0xE0 - 0x80));
+    uint8x16_t fourth = vqsubq_u8(prev3, vdupq_n_u8(0xF0 - 0x80));
+    uint8x16_t expected = vandq_u8(vorrq_u8(third, fourth), vdupq_n_u8(0x80));
+
+    return veorq_u8(expected, classes);
+}
+
+/**
+ * @brief NEON UTF-8 validation
+ * @details Checks 16 bytes per step and skips ASCII blocks; the tail is checked
+ *          zero-padded, which also catches a sequence cut short by the end
+ */
+static size_t string_neon_utf8_invalid(const char *data, size_t length) {
+    const uint8x16_t max_lead = vld1q_u8(string_utf8_max_lead + 16);
+    uint8x16_t previous = vdupq_n_u8(0);
+    uint8x16_t incomplete = vdupq_n_u8(0);
+    size_t i = 0;
+
+    for (; i + 16 <= length; i += 16) {
+        uint8x16_t input = vld1q_u8((const uint8_t *)data + i);
+        uint8x16_t error = incomplete;
+        if (vmaxvq_u8(input) >= 0x80) {
+            error = string_neon_utf8_block(input, previous);
+            incomplete = vqsubq_u8(input, max_lead);
+        } else {
+            incomplete = vdupq_n_u8(0);
+        }
+
+        if (vmaxvq_u8(error)) {
+            break;
+        }
+        previous = input;
+    }
+
+    if (i + 16 > length) {
+        uint8x16_t error = incomplete;
+        if (i < length) {
+            uint8_t tail[16] = { 0 };
+            memcpy(tail, data + i, length - i);
+            error = string_neon_utf8_block(vld1q_u8(tail), previous);
+        }
+
+        if (!vmaxvq_u8(error)) {
+            return STRING_NPOS;
+        }
+    }
+
+    size_t position = string_utf8_resume_point(data, i);
+    return string_scalar_utf8_invalid(data, length, &position, length);
+}
+
+/**
+ * @brief NEON count of bytes that are not UTF-8 continuation bytes
+ */
+static size_t string_neon_utf8_count(const char *data, size_t length) {
+    const int8x16_t threshold = vdupq_n_s8(-65);
+    const uint8x16_t one = vdupq_n_u8(1);
+    size_t count = 0;
+    size_t i = 0;
+
+    for (; i + 16 <= length; i += 16) {
+        int8x16_t block = vreinterpretq_s8_u8(vld1q_u8((const uint8_t *)data + i));
+        count += vaddvq_u8(vandq_u8(vcgtq_s8(block, threshold), one));
+    }
+
+    return count + string_scalar_utf8_count(data + i, length - i);
+}
+
+/**
+ * @brief NEON ASCII widening to UTF-16
+ */
+static size_t string_neon_ascii_to_utf16(const char *data, size_t length, uint16_t *dest) {
+    size_t i = 0;
+
+    for (; i + 16 <= length; i += 16) {
+        uint8x16_t block = vld1q_u8((const uint8_t *)data + i);
+        if (vmaxvq_u8(block) >= 0x80) {
+            break;
+        }
+        vst1q_u16(dest + i, vmovl_u8(vget_low_u8(block)));
+        vst1q_u16(dest + i + 8, vmovl_high_u8(block));
+    }
+
+    return i + string_scalar_ascii_to_utf16(data + i, length - i, dest + i);
+}
+
+/**
+ * @brief NEON ASCII narrowing from UTF-16
+ */
+static size_t string_neon_utf16_to_ascii(const uint16_t *units, size_t length, char *dest) {
+    size_t i = 0;
+
+    for (; i + 16 <= length; i += 16) {
+        uint16x8_t low = vld1q_u16(units + i);
+        uint16x8_t high = vld1q_u16(units + i + 8);
+        if (vmaxvq_u16(vorrq_u16(low, high)) >= 0x80) {
+            break;
+        }
+        vst1q_u8((uint8_t *)dest + i, vcombine_u8(vmovn_u16(low), vmovn_u16(high)));
+    }
+
+    return i + string_scalar_utf16_to_ascii(units + i, length - i, dest + i);
+}
+
+#endif /* STRING_HAVE_NEON */
+
+/*
+ * ==========================
+ * Dispatching entry points
+ * ==========================
+ */
+
+/**
+ * @brief Find the first occurrence of a byte
+ * @param data Bytes to scan
+ * @param length Number of bytes to scan
+ * @param c Byte to search for
+ * @return size_t Offset of the first match or STRING_NPOS
+ */
+size_t string_simd_find_byte(const char *data, size_t length, char c) {
+    STRING_STATS_ADD(searches, 1);
+    STRING_STATS_ADD(bytes_scanned, length);
+
+    switch (string_get_simd_level()) {
+#if defined(STRING_HAVE_X86_SIMD)
+    case STRING_SIMD_AVX2: return string_avx2_find_byte(data, length, c);
+    case STRING_SIMD_SSE2: return string_sse2_find_byte(data, length, c);
+#endif
+#if defined(STRING_HAVE_NEON)
+    case STRING_SIMD_NEON: return string_neon_find_byte(data, length, c);
+#endif
+    default: return string_scalar_find_byte(data, length, c);
+    }
+}
+
+/**
+ * @brief Find the last occurrence of a byte
+ * @param data Bytes to scan
+ * @param length Number of bytes to scan
+ * @param c Byte to search for
+ * @return size_t Offset of the last match or STRING_NPOS
+ */
+size_t string_simd_rfind_byte(const char *data, size_t length, char c) {
+    STRING_STATS_ADD(searches, 1);
+    STRING_STATS_ADD(bytes_scanned, length);
+
+    switch (string_get_simd_level()) {
+#if defined(STRING_HAVE_X86_SIMD)
+    case STRING_SIMD_AVX2: return string_avx2_rfind_byte(data, length, c);
+    case STRING_SIMD_SSE2: return string_sse2_rfind_byte(data, length, c);
+#endif
+#if defined(STRING_HAVE_NEON)
+    case STRING_SIMD_NEON: return string_neon_rfind_byte(data, length, c);
+#endif
+    default: return string_scalar_rfind_byte(data, length, c);
+    }
+}
+
+/**
+ * @brief Find the first byte that belongs to a set
+ * @param data Bytes to scan
+ * @param length Number of bytes to scan
+ * @param set Bytes of the set
+ * @param set_length Number of bytes in the set
+ * @return size_t Offset of the first match or STRING_NPOS
+ * @details Single-byte sets use the byte kernel; large sets use the lookup table
+ */
+size_t string_simd_find_any(const char *data, size_t length, const char *set, size_t set_length) {
+    if (set_length == 0) {
+        return STRING_NPOS;
+    }
+
+    if (set_length == 1) {
+        return string_simd_find_byte(data, length, set[0]);
+    }
+
+    STRING_STATS_ADD(searches, 1);
+    STRING_STATS_ADD(bytes_scanned, length);
+
+    if (set_length > STRING_SIMD_MAX_SET_SIZE) {
+        return string_scalar_find_any(data, length, set, set_length);
+    }
+
+    switch (string_get_simd_level()) {
+#if defined(STRING_HAVE_X86_SIMD)
+    case STRING_SIMD_AVX2: return string_avx2_find_any(data, length, set, set_length);
+    case STRING_SIMD_SSE2: return string_sse2_find_any(data, length, set, set_length);
+#endif
+#if defined(STRING_HAVE_NEON)
+    case STRING_SIMD_NEON: return string_neon_find_any(data, length, set, set_length);
+#endif
+    default: return string_scalar_find_any(data, length, set, set_length);
+    }
+}
+
+/**
+ * @brief Find the last byte that belongs to a set
+ * @param data Bytes to scan
+ * @param length Number of bytes to scan
+ * @param set Bytes of the set
+ * @param set_length Number of bytes in the set
+ * @return size_t Offset of the last match or STRING_NPOS
+ * @details Single-byte sets use the byte kernel; large sets use the lookup table
+ */
+size_t string_simd_rfind_any(const char *data, size_t length, const char *set, size_t set_length) {
+    if (set_length == 0) {
+        return STRING_NPOS;
+    }
+
+    if (set_length == 1) {
+        return string_simd_rfind_byte(data, length, set[0]);
+    }
+
+    STRING_STATS_ADD(searches, 1);
+    STRING_STATS_ADD(bytes_scanned, length);
+
+    if (set_length > STRING_SIMD_MAX_SET_SIZE) {
+        return string_scalar_rfind_any(data, length, set, set_length);
+    }
+
+    switch (string_get_simd_level()) {
+#if defined(STRING_HAVE_X86_SIMD)
+    case STRING_SIMD_AVX2: return string_avx2_rfind_any(data, length, set, set_length);
+    case STRING_SIMD_SSE2: return string_sse2_rfind_any(data, length, set, set_length);
+#endif
+#if defined(STRING_HAVE_NEON)
+    case STRING_SIMD_NEON: return string_neon_rfind_any(data, length, set, set_length);
+#endif
+    default: return string_scalar_rfind_any(data, length, set, set_length);
+    }
+}
+
+/**
+ * @brief Find the first byte whose membership in a class matches
+ * @param data Bytes to scan
+ * @param length Number of bytes to scan
+ * @param cls Character class to test against
+ * @param member True to find a member, false to find a non-member
+ * @return size_t Offset of the first match or STRING_NPOS
+ * @details SSE2 has no byte shuffle for the table lookup and uses the scalar loop
+ */
+size_t string_simd_find_class(const char *data, size_t length, const string_char_class_t *cls, bool member) {
+    STRING_STATS_ADD(searches, 1);
+    STRING_STATS_ADD(bytes_scanned, length);
+
+    switch (string_get_simd_level()) {
+#if defined(STRING_HAVE_X86_SIMD)
+    case STRING_SIMD_AVX2: return string_avx2_find_class(data, length, cls, member);
+#endif
+#if defined(STRING_HAVE_NEON)
+    case STRING_SIMD_NEON: return string_neon_find_class(data, length, cls, member);
+#endif
+    default: return string_scalar_find_class(data, length, cls, member);
+    }
+}
+
+/**
+ * @brief Find the last byte whose membership in a class matches
+ * @param data Bytes to scan
+ * @param length Number of bytes to scan
+ * @param cls Character class to test against
+ * @param member True to find a member, false to find a non-member
+ * @return size_t Offset of the last match or STRING_NPOS
+ */
+size_t string_simd_rfind_class(const char *data, size_t length, const string_char_class_t *cls, bool member) {
+    STRING_STATS_ADD(searches, 1);
+    STRING_STATS_ADD(bytes_scanned, length);
+
+    switch (string_get_simd_level()) {
+#if defined(STRING_HAVE_X86_SIMD)
+    case STRING_SIMD_AVX2: return string_avx2_rfind_class(data, length, cls, member);
+#endif
+#if defined(STRING_HAVE_NEON)
+    case STRING_SIMD_NEON: return string_neon_rfind_class(data, length, cls, member);
+#endif
+    default: return string_scalar_rfind_class(data, length, cls, member);
+    }
+}
+
+/**
+ * @brief Find the first occurrence of a byte sequence
+ * @param data Bytes to scan
+ * @param length Number of bytes to scan
+ * @param needle Bytes to search for
+ * @param needle_length Number of bytes in the needle
+ * @return size_t Offset of the first match or STRING_NPOS
+ * @details Empty needles match at offset 0
+ */
+size_t string_simd_find_substr(const char *data, size_t length, const char *needle, size_t needle_length) {
+    if (needle_length == 0) {
+        return 0;
+    }
+
+    if (needle_length > length) {
+        return STRING_NPOS;
+    }
+
+    if (needle_length == 1) {
+        return string_simd_find_byte(data, length, needle[0]);
+    }
+
+    STRING_STATS_ADD(searches, 1);
+    STRING_STATS_ADD(bytes_scanned, length);
+
+    if (needle_length <= STRING_SIMD_MAX_PREFILTER_NEEDLE) {
+        switch (string_get_simd_level()) {
+#if defined(STRING_HAVE_X86_SIMD)
+        case STRING_SIMD_AVX2: return string_avx2_find_substr(data, length, needle, needle_length);
+        case STRING_SIMD_SSE2: return string_sse2_find_substr(data, length, needle, needle_length);
+#endif
+#if defined(STRING_HAVE_NEON)
+        case STRING_SIMD_NEON: return string_neon_find_substr(data, length, needle, needle_length);
+#endif
+        default: break;
+        }
+    }
+
+    return string_two_way_find(data, length, needle, needle_length);
+}
+
+/**
+ * @brief Convert ASCII letters to one case in place
+ * @param data Bytes to convert
+ * @param length Number of bytes to convert
+ * @param upper Convert to uppercase (true) or lowercase (false)
+ */
+void string_simd_ascii_case(char *data, size_t length, bool upper) {
+    switch (string_get_simd_level()) {
+#if defined(STRING_HAVE_X86_SIMD)
+    case STRING_SIMD_AVX2: string_avx2_ascii_case(data, length, upper); break;
+    case STRING_SIMD_SSE2: string_sse2_ascii_case(data, length, upper); break;
+#endif
+#if defined(STRING_HAVE_NEON)
+    case STRING_SIMD_NEON: string_neon_ascii_case(data, length, upper); break;
+#endif
+    default: string_scalar_ascii_case(data, length, upper); break;
+    }
+}
+
+/**
+ * @brief Find the first position where two byte ranges differ ignoring ASCII case
+ * @param a First byte range
+ * @param b Second byte range
+ * @param length Number of bytes to compare
+ * @return size_t Offset of the first difference, or length if none
+ */
+size_t string_simd_mismatch_icase(const char *a, const char *b, size_t length) {
+    switch (string_get_simd_level()) {
+#if defined(STRING_HAVE_X86_SIMD)
+    case STRING_SIMD_AVX2: return string_avx2_mismatch_icase(a, b, length);
+    case STRING_SIMD_SSE2: return string_sse2_mismatch_icase(a, b, length);
+#endif
+#if defined(STRING_HAVE_NEON)
+    case STRING_SIMD_NEON: return string_neon_mismatch_icase(a, b, length);
+#endif
+    default: return string_scalar_mismatch_icase(a, b, length);
+    }
+}
+
+/**
+ * @brief Find the first occurrence of a byte sequence ignoring ASCII case
+ * @param data Bytes to scan
+ * @param length Number of bytes to scan
+ * @param needle Bytes to search for
+ * @param needle_length Number of bytes in the needle
+ * @return size_t Offset of the first match or STRING_NPOS
+ * @details Empty needles match at offset 0
+ */
+size_t string_simd_find_substr_icase(const char *data, size_t length, const char *needle, size_t needle_length) {
+    if (needle_length == 0) {
+        return 0;
+    }
+
+    if (needle_length > length) {
+        return STRING_NPOS;
+    }
+
+    if (needle_length == 1) {
+        char cases[2] = { needle[0], needle[0] };
+        if ((unsigned)(string_fold_byte((unsigned char)needle[0], true) - 'a') < 26u) {
+            cases[0] = (char)(needle[0] | 0x20);
+            cases[1] = (char)(needle[0] & ~0x20);
+        }
+        return string_simd_find_any(data, length, cases, cases[0] == cases[1] ? 1 : 2);
+    }
+
+    STRING_STATS_ADD(searches, 1);
+    STRING_STATS_ADD(bytes_scanned, length);
+
+    if (needle_length <= STRING_SIMD_MAX_PREFILTER_NEEDLE) {
+        switch (string_get_simd_level()) {
+#if defined(STRING_HAVE_X86_SIMD)
+        case STRING_SIMD_AVX2: return string_avx2_find_substr_icase(data, length, needle, needle_length);
+        case STRING_SIMD_SSE2: return string_sse2_find_substr_icase(data, length, needle, needle_length);
+#endif
+#if defined(STRING_HAVE_NEON)
+        case STRING_SIMD_NEON: return string_neon_find_substr_icase(data, length, needle, needle_length);
+#endif
+        default: break;
+        }
+    }
+
+    return string_two_way_find_icase(data, length, needle, needle_length);
+}
+
+/**
+ * @brief Record every field terminated by a delimiter byte
+ * @param data Bytes to split
+ * @param length Number of bytes to split
+ * @param delimiter Delimiter byte
+ * @param fields Array receiving the fields
+ * @param capacity Number of elements in the array
+ * @param consumed Receives the offset after the last delimiter recorded
+ * @return size_t Number of fields recorded
+ */
+size_t string_simd_split_byte(const char *data, size_t length, char delimiter, string_view_t *fields, size_t capacity, size_t *consumed) {
+    switch (string_get_simd_level()) {
+#if defined(STRING_HAVE_X86_SIMD)
+    case STRING_SIMD_AVX2: return string_avx2_split_byte(data, length, delimiter, fields, capacity, consumed);
+    case STRING_SIMD_SSE2: return string_sse2_split_byte(data, length, delimiter, fields, capacity, consumed);
+#endif
+#if defined(STRING_HAVE_NEON)
+    case STRING_SIMD_NEON: return string_neon_split_byte(data, length, delimiter, fields, capacity, consumed);
+#endif
+    default: return string_scalar_split_byte(data, length, delimiter, fields, capacity, 0, 0, 0, consumed);
+    }
+}
+
+/**
+ * @brief Find the first invalid UTF-8 sequence
+ * @param data Bytes to check
+ * @param length Number of bytes to check
+ * @return size_t Offset of the first invalid or truncated sequence, or STRING_NPOS
+ */
+size_t string_simd_utf8_invalid(const char *data, size_t length) {
+    switch (string_get_simd_level()) {
+#if defined(STRING_HAVE_X86_SIMD)
+    case STRING_SIMD_AVX2: return string_avx2_utf8_invalid(data, length);
+    case STRING_SIMD_SSE2: return string_sse2_utf8_invalid(data, length);
+#endif
+#if defined(STRING_HAVE_NEON)
+    case STRING_SIMD_NEON: return string_neon_utf8_invalid(data, length);
+#endif
+    default: {
+        size_t position = 0;
+        return string_scalar_utf8_invalid(data, length, &position, length);
+    }
+    }
+}
+
+/**
+ * @brief Count the bytes that are not UTF-8 continuation bytes
+ * @param data Bytes to scan
+ * @param length Number of bytes to scan
+ * @return size_t Number of lead and ASCII bytes
+ */
+size_t string_simd_utf8_count(const char *data, size_t length) {
+    switch (string_get_simd_level()) {
+#if defined(STRING_HAVE_X86_SIMD)
+    case STRING_SIMD_AVX2: return string_avx2_utf8_count(data, length);
+    case STRING_SIMD_SSE2: return string_sse2_utf8_count(data, length);
+#endif
+#if defined(STRING_HAVE_NEON)
+    case STRING_SIMD_NEON: return string_neon_utf8_count(data, length);
+#endif
+    default: return string_scalar_utf8_count(data, length);
+    }
+}
+
+/**
+ * @brief Widen leading ASCII bytes to UTF-16 code units
+ * @param data Bytes to convert
+ * @param length Number of bytes available
+ * @param dest Receives the code units
+ * @return size_t Number of bytes converted
+ */
+size_t string_simd_ascii_to_utf16(const char *data, size_t length, uint16_t *dest) {
+    switch (string_get_simd_level()) {
+#if defined(STRING_HAVE_X86_SIMD)
+    case STRING_SIMD_AVX2: return string_avx2_ascii_to_utf16(data, length, dest);
+    case STRING_SIMD_SSE2: return string_sse2_ascii_to_utf16(data, length, dest);
+#endif
+#if defined(STRING_HAVE_NEON)
+    case STRING_SIMD_NEON: return string_neon_ascii_to_utf16(data, length, dest);
+#endif
+    default: return string_scalar_ascii_to_utf16(data, length, dest);
+    }
+}
+
+/**
+ * @brief Narrow leading ASCII UTF-16 code units to bytes
+ * @param units Code units to convert
+ * @param length Number of code units available
+ * @param dest Receives the bytes
+ * @return size_t Number of units converted
+ * @details AVX2 uses the SSE2 kernel: its pack instruction works per 128-bit lane
+ */
+size_t string_simd_utf16_to_ascii(const uint16_t *units, size_t length, char *dest) {
+    switch (string_get_simd_level()) {
+#if defined(STRING_HAVE_X86_SIMD)
+    case STRING_SIMD_AVX2:
+    case STRING_SIMD_SSE2: return string_sse2_utf16_to_ascii(units, length, dest);
+#endif
+#if defined(STRING_HAVE_NEON)
+    case STRING_SIMD_NEON: return string_neon_utf16_to_ascii(units, length, dest);
+#endif
+    default: return string_scalar_utf16_to_ascii(units, length, dest);
+    }
+}
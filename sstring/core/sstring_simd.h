@@ -0,0 +1,173 @@
+/**
+ * @file sstring_simd.h
+ * @brief Internal vectorized scanning kernels for the safe strings library
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * This header is internal to the library and is not part of the public API.
+ * Each kernel has a scalar implementation plus SSE2/AVX2 (x86) and NEON (ARM)
+ * variants; the variant is chosen at runtime from the level reported by
+ * string_get_simd_level().
+ */
+
+#pragma once
+
+#include "sstring.h"
+
+/** @brief Largest character set scanned with vector compares (larger sets use a lookup table) */
+#define STRING_SIMD_MAX_SET_SIZE 16
+
+/** @brief Longest needle searched with the first/last-byte vector prefilter (longer needles use Two-Way) */
+#define STRING_SIMD_MAX_PREFILTER_NEEDLE 32
+
+/**
+ * @brief Find the first occurrence of a byte
+ * @param data Bytes to scan
+ * @param length Number of bytes to scan
+ * @param c Byte to search for
+ * @return Offset of the first match, or STRING_NPOS if not found
+ */
+size_t string_simd_find_byte(const char *data, size_t length, char c);
+
+/**
+ * @brief Find the last occurrence of a byte
+ * @param data Bytes to scan
+ * @param length Number of bytes to scan
+ * @param c Byte to search for
+ * @return Offset of the last match, or STRING_NPOS if not found
+ */
+size_t string_simd_rfind_byte(const char *data, size_t length, char c);
+
+/**
+ * @brief Find the first byte that belongs to a set
+ * @param data Bytes to scan
+ * @param length Number of bytes to scan
+ * @param set Bytes of the set (can contain null bytes)
+ * @param set_length Number of bytes in the set
+ * @return Offset of the first match, or STRING_NPOS if not found
+ */
+size_t string_simd_find_any(const char *data, size_t length, const char *set, size_t set_length);
+
+/**
+ * @brief Find the last byte that belongs to a set
+ * @param data Bytes to scan
+ * @param length Number of bytes to scan
+ * @param set Bytes of the set (can contain null bytes)
+ * @param set_length Number of bytes in the set
+ * @return Offset of the last match, or STRING_NPOS if not found
+ */
+size_t string_simd_rfind_any(const char *data, size_t length, const char *set, size_t set_length);
+
+/**
+ * @brief Find the first byte that is, or is not, in a character class
+ * @param data Bytes to scan
+ * @param length Number of bytes to scan
+ * @param cls Character class to test against
+ * @param member True to find a member, false to find a non-member
+ * @return Offset of the first match, or STRING_NPOS if not found
+ */
+size_t string_simd_find_class(const char *data, size_t length, const string_char_class_t *cls, bool member);
+
+/**
+ * @brief Find the last byte that is, or is not, in a character class
+ * @param data Bytes to scan
+ * @param length Number of bytes to scan
+ * @param cls Character class to test against
+ * @param member True to find a member, false to find a non-member
+ * @return Offset of the last match, or STRING_NPOS if not found
+ */
+size_t string_simd_rfind_class(const char *data, size_t length, const string_char_class_t *cls, bool member);
+
+/**
+ * @brief Find the first occurrence of a byte sequence
+ * @param data Bytes to scan
+ * @param length Number of bytes to scan
+ * @param needle Bytes to search for (can contain null bytes)
+ * @param needle_length Number of bytes in the needle
+ * @return Offset of the first match, or STRING_NPOS if not found
+ * @details Short needles use a vectorized first/last-byte prefilter verified with memcmp;
+ *          long needles (and the scalar level) use the linear-time Two-Way algorithm.
+ */
+size_t string_simd_find_substr(const char *data, size_t length, const char *needle, size_t needle_length);
+
+/**
+ * @brief Convert ASCII letters to one case in place
+ * @param data Bytes to convert
+ * @param length Number of bytes to convert
+ * @param upper Convert to uppercase (true) or lowercase (false)
+ * @details Bytes outside 'A'-'Z' / 'a'-'z' are left unchanged, whatever the locale.
+ */
+void string_simd_ascii_case(char *data, size_t length, bool upper);
+
+/**
+ * @brief Find the first position where two byte ranges differ ignoring ASCII case
+ * @param a First byte range
+ * @param b Second byte range
+ * @param length Number of bytes to compare
+ * @return Offset of the first difference, or length if the ranges are equal
+ */
+size_t string_simd_mismatch_icase(const char *a, const char *b, size_t length);
+
+/**
+ * @brief Find the first occurrence of a byte sequence ignoring ASCII case
+ * @param data Bytes to scan
+ * @param length Number of bytes to scan
+ * @param needle Bytes to search for (can contain null bytes)
+ * @param needle_length Number of bytes in the needle
+ * @return Offset of the first match, or STRING_NPOS if not found
+ * @details Uses the same prefilter / Two-Way split as string_simd_find_substr(),
+ *          with ASCII letters folded as they are compared.
+ */
+size_t string_simd_find_substr_icase(const char *data, size_t length, const char *needle, size_t needle_length);
+
+/**
+ * @brief Record every field terminated by a delimiter byte
+ * @param data Bytes to split
+ * @param length Number of bytes to split
+ * @param delimiter Delimiter byte
+ * @param fields Array receiving a view of each field before a delimiter
+ * @param capacity Number of elements in the array
+ * @param consumed Receives the offset after the last delimiter recorded
+ * @return Number of fields recorded; fewer than capacity means no further delimiter exists
+ * @details The unterminated tail (from consumed to length) is not recorded.
+ */
+size_t string_simd_split_byte(const char *data, size_t length, char delimiter, string_view_t *fields, size_t capacity, size_t *consumed);
+
+/**
+ * @brief Find the first invalid UTF-8 sequence
+ * @param data Bytes to check
+ * @param length Number of bytes to check
+ * @return Offset of the first byte of the first invalid or truncated sequence,
+ *         or STRING_NPOS if the bytes are valid UTF-8
+ * @details AVX2 and NEON check whole blocks with the lookup-table method of
+ *          Keiser and Lemire (three nibble lookups per byte pair) and decode
+ *          only from the first failing block on to locate the error. SSE2 has
+ *          no byte shuffle, so it only skips ASCII blocks.
+ */
+size_t string_simd_utf8_invalid(const char *data, size_t length);
+
+/**
+ * @brief Count the bytes that are not UTF-8 continuation bytes
+ * @param data Bytes to scan
+ * @param length Number of bytes to scan
+ * @return Number of code points, if the bytes are valid UTF-8
+ */
+size_t string_simd_utf8_count(const char *data, size_t length);
+
+/**
+ * @brief Widen leading ASCII bytes to UTF-16 code units
+ * @param data Bytes to convert
+ * @param length Number of bytes available
+ * @param dest Receives one code unit per converted byte (room for length units)
+ * @return Number of bytes converted, stopping at the first non-ASCII byte
+ */
+size_t string_simd_ascii_to_utf16(const char *data, size_t length, uint16_t *dest);
+
+/**
+ * @brief Narrow leading ASCII UTF-16 code units to bytes
+ * @param units Code units to convert
+ * @param length Number of code units available
+ * @param dest Receives one byte per converted unit (room for length bytes)
+ * @return Number of units converted, stopping at the first unit above 0x7F
+ */
+size_t string_simd_utf16_to_ascii(const uint16_t *units, size_t length, char *dest);
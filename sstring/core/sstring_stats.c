@@ -0,0 +1,383 @@
+/**
+ * @file sstring_stats.c
+ * @brief Implementation of the optional instrumentation counters
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * Each thread gets a counter block on its first counted operation. The block is
+ * linked into a process-wide list so that string_stats_snapshot_all() can sum
+ * it, and a thread-specific key destructor folds it into the retired totals
+ * when the thread exits. Only the owning thread writes a block; relaxed atomic
+ * loads and stores keep the concurrent reads defined without a locked add.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+
+#include "sstring_stats.h"
+
+/** @brief Number of uint64_t counters in string_stats_t */
+#define STRING_STATS_COUNTERS (sizeof(string_stats_t) / sizeof(uint64_t))
+
+#if defined(STRING_ENABLE_STATS)
+
+/**
+ * @brief Counters of one thread
+ */
+typedef struct string_stats_block {
+    _Atomic uint64_t values[STRING_STATS_COUNTERS];  /**< Counters, in string_stats_t order */
+    struct string_stats_block *prev;                 /**< Previous live block */
+    struct string_stats_block *next;                 /**< Next live block */
+} string_stats_block_t;
+
+/** @brief Protects the list of live blocks and the retired totals */
+static pthread_mutex_t string_stats_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/** @brief Blocks of running threads */
+static string_stats_block_t *string_stats_threads = NULL;
+
+/** @brief Counters of threads that have exited */
+static uint64_t string_stats_retired[STRING_STATS_COUNTERS];
+
+/** @brief Key whose destructor retires a thread's block */
+static pthread_key_t string_stats_key;
+static pthread_once_t string_stats_key_once = PTHREAD_ONCE_INIT;
+
+/** @brief Block of the calling thread, created on first use */
+static _Thread_local string_stats_block_t *string_stats_local = NULL;
+
+static _Atomic(string_stats_hook_t) string_stats_hook = NULL;
+static _Atomic(void *) string_stats_hook_context = NULL;
+
+/*
+ * ==========================
+ * Internal helper functions
+ * ==========================
+ */
+
+/**
+ * @brief Fold an exiting thread's block into the retired totals
+ * @param arg Block of the exiting thread
+ */
+static void string_stats_retire(void *arg) {
+    string_stats_block_t *block = arg;
+
+    pthread_mutex_lock(&string_stats_lock);
+    for (size_t i = 0; i < STRING_STATS_COUNTERS; ++i) {
+        string_stats_retired[i] += atomic_load_explicit(&block->values[i], memory_order_relaxed);
+    }
+    if (block->prev) {
+        block->prev->next = block->next;
+    } else {
+        string_stats_threads = block->next;
+    }
+    if (block->next) {
+        block->next->prev = block->prev;
+    }
+    pthread_mutex_unlock(&string_stats_lock);
+
+    string_stats_local = NULL;
+    free(block);
+}
+
+/**
+ * @brief Create the key that retires thread blocks
+ */
+static void string_stats_create_key(void) {
+    pthread_key_create(&string_stats_key, string_stats_retire);
+}
+
+/**
+ * @brief Get the block of the calling thread
+ * @return Block, or NULL if it could not be allocated (the counts are dropped)
+ */
+static string_stats_block_t *string_stats_block(void) {
+    if (string_stats_local) {
+        return string_stats_local;
+    }
+
+    pthread_once(&string_stats_key_once, string_stats_create_key);
+
+    string_stats_block_t *block = malloc(sizeof(*block));
+    if (!block) {
+        return NULL;
+    }
+    for (size_t i = 0; i < STRING_STATS_COUNTERS; ++i) {
+        atomic_init(&block->values[i], 0);
+    }
+
+    pthread_mutex_lock(&string_stats_lock);
+    block->prev = NULL;
+    block->next = string_stats_threads;
+    if (string_stats_threads) {
+        string_stats_threads->prev = block;
+    }
+    string_stats_threads = block;
+    pthread_mutex_unlock(&string_stats_lock);
+
+    pthread_setspecific(string_stats_key, block);
+    string_stats_local = block;
+
+    return block;
+}
+
+/**
+ * @brief Read the monotonic clock
+ * @return Nanoseconds
+ */
+static uint64_t string_stats_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/*
+ * ================================
+ * Instrumentation site functions
+ * ================================
+ */
+
+/**
+ * @brief Add to a counter of the calling thread
+ * @param counter Index of the counter in string_stats_t
+ * @param amount Amount to add
+ */
+void string_stats_add(size_t counter, uint64_t amount) {
+    string_stats_block_t *block = string_stats_block();
+    if (!block || counter >= STRING_STATS_COUNTERS) {
+        return;
+    }
+
+    // Only this thread writes the block, so a plain load and store suffice
+    uint64_t value = atomic_load_explicit(&block->values[counter], memory_order_relaxed);
+    atomic_store_explicit(&block->values[counter], value + amount, memory_order_relaxed);
+}
+
+/**
+ * @brief Record the utilization of a heap buffer in the histogram
+ * @param length Content length
+ * @param capacity Buffer capacity (the terminator counts as used)
+ */
+void string_stats_utilization(size_t length, size_t capacity) {
+    if (capacity == 0) {
+        return;
+    }
+
+    size_t used = length < capacity ? length + 1 : capacity;
+    size_t bucket = (size_t)((double)used / (double)capacity * STRING_STATS_UTILIZATION_BUCKETS);
+    if (bucket >= STRING_STATS_UTILIZATION_BUCKETS) {
+        bucket = STRING_STATS_UTILIZATION_BUCKETS - 1;
+    }
+
+    string_stats_add(offsetof(string_stats_t, utilization) / sizeof(uint64_t) + bucket, 1);
+}
+
+/**
+ * @brief Read the clock at the start of a timed operation
+ * @return uint64_t Start time in nanoseconds, or 0 if no hook is installed
+ */
+uint64_t string_stats_begin(void) {
+    if (!atomic_load_explicit(&string_stats_hook, memory_order_acquire)) {
+        return 0;
+    }
+
+    // 0 means "not timed", so a clock reading of exactly 0 is nudged
+    uint64_t now = string_stats_now();
+    return now ? now : 1;
+}
+
+/**
+ * @brief Report a timed operation to the hook
+ * @param op Operation that completed
+ * @param started Value returned by string_stats_begin()
+ * @param bytes Size of the operation's input
+ */
+void string_stats_end(string_stats_op_t op, uint64_t started, size_t bytes) {
+    if (!started) {
+        return;
+    }
+
+    string_stats_hook_t hook = atomic_load_explicit(&string_stats_hook, memory_order_acquire);
+    if (hook) {
+        uint64_t now = string_stats_now();
+        hook(op, now > started ? now - started : 0, bytes,
+             atomic_load_explicit(&string_stats_hook_context, memory_order_relaxed));
+    }
+}
+
+/*
+ * ================
+ * Stats functions
+ * ================
+ */
+
+/**
+ * @brief Check whether the library was built with instrumentation
+ * @return bool Always true in this build
+ */
+bool string_stats_enabled(void) {
+    return true;
+}
+
+/**
+ * @brief Read the counters of the calling thread
+ * @param stats Receives the counters
+ * @details A thread that never counted anything reads all zeros
+ */
+void string_stats_snapshot(string_stats_t *stats) {
+    if (!stats) {
+        return;
+    }
+
+    uint64_t values[STRING_STATS_COUNTERS] = {0};
+    string_stats_block_t *block = string_stats_local;
+    if (block) {
+        for (size_t i = 0; i < STRING_STATS_COUNTERS; ++i) {
+            values[i] = atomic_load_explicit(&block->values[i], memory_order_relaxed);
+        }
+    }
+    memcpy(stats, values, sizeof(*stats));
+}
+
+/**
+ * @brief Read the counters summed over every thread
+ * @param stats Receives the counters
+ * @details Live blocks are read under the list lock, so none can be retired mid-sum
+ */
+void string_stats_snapshot_all(string_stats_t *stats) {
+    if (!stats) {
+        return;
+    }
+
+    uint64_t values[STRING_STATS_COUNTERS];
+    pthread_mutex_lock(&string_stats_lock);
+    memcpy(values, string_stats_retired, sizeof(values));
+    for (string_stats_block_t *block = string_stats_threads; block; block = block->next) {
+        for (size_t i = 0; i < STRING_STATS_COUNTERS; ++i) {
+            values[i] += atomic_load_explicit(&block->values[i], memory_order_relaxed);
+        }
+    }
+    pthread_mutex_unlock(&string_stats_lock);
+    memcpy(stats, values, sizeof(*stats));
+}
+
+/**
+ * @brief Reset the counters of the calling thread to zero
+ */
+void string_stats_reset(void) {
+    string_stats_block_t *block = string_stats_local;
+    if (!block) {
+        return;
+    }
+
+    for (size_t i = 0; i < STRING_STATS_COUNTERS; ++i) {
+        atomic_store_explicit(&block->values[i], 0, memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Add the utilization of a live heap string to the histogram
+ * @param str String to sample
+ */
+void string_stats_sample(const string_t *str) {
+    if (str && str->storage == STRING_STORAGE_HEAP) {
+        string_stats_utilization(str->length, str->capacity);
+    }
+}
+
+/**
+ * @brief Install the per-call timing hook
+ * @param hook Hook to install, or NULL to stop timing
+ * @param context Context pointer passed to the hook
+ * @details The context is published before the hook, so a reader that sees the
+ *          new hook also sees its context
+ */
+void string_stats_set_hook(string_stats_hook_t hook, void *context) {
+    atomic_store_explicit(&string_stats_hook_context, context, memory_order_relaxed);
+    atomic_store_explicit(&string_stats_hook, hook, memory_order_release);
+}
+
+#else
+
+/*
+ * ===================================================
+ * Stats functions (built without STRING_ENABLE_STATS)
+ * ===================================================
+ */
+
+// Nothing is counted: snapshots read as zeros and hooks are accepted but never called
+
+void string_stats_add(size_t counter, uint64_t amount) {
+    (void)counter;
+    (void)amount;
+}
+
+void string_stats_utilization(size_t length, size_t capacity) {
+    (void)length;
+    (void)capacity;
+}
+
+uint64_t string_stats_begin(void) {
+    return 0;
+}
+
+void string_stats_end(string_stats_op_t op, uint64_t started, size_t bytes) {
+    (void)op;
+    (void)started;
+    (void)bytes;
+}
+
+bool string_stats_enabled(void) {
+    return false;
+}
+
+void string_stats_snapshot(string_stats_t *stats) {
+    if (stats) {
+        memset(stats, 0, sizeof(*stats));
+    }
+}
+
+void string_stats_snapshot_all(string_stats_t *stats) {
+    string_stats_snapshot(stats);
+}
+
+void string_stats_reset(void) {
+}
+
+void string_stats_sample(const string_t *str) {
+    (void)str;
+}
+
+void string_stats_set_hook(string_stats_hook_t hook, void *context) {
+    (void)hook;
+    (void)context;
+}
+
+#endif
+
+/**
+ * @brief Get the name of an instrumented operation
+ * @param op Operation
+ * @return const char* Static lowercase name, or "unknown"
+ */
+const char *string_stats_op_name(string_stats_op_t op) {
+    switch (op) {
+        case STRING_STATS_OP_APPEND:
+            return "append";
+        case STRING_STATS_OP_INSERT:
+            return "insert";
+        case STRING_STATS_OP_ERASE:
+            return "erase";
+        case STRING_STATS_OP_REPLACE:
+            return "replace";
+        case STRING_STATS_OP_FORMAT:
+            return "format";
+        case STRING_STATS_OP_FIND:
+            return "find";
+    }
+
+    return "unknown";
+}
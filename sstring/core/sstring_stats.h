@@ -0,0 +1,185 @@
+/**
+ * @file sstring_stats.h
+ * @brief Optional allocation and operation instrumentation for the safe strings library
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * When the library is built with STRING_ENABLE_STATS defined, string operations
+ * update per-thread counters: allocations and reallocations of string buffers,
+ * bytes copied into strings, memmoves done by insert, erase, trim and replace,
+ * and bytes handed to the search kernels. Heap buffers also record how full
+ * they were when released, as a capacity-utilization histogram.
+ *
+ * Without STRING_ENABLE_STATS (the default) the counting sites compile to
+ * nothing, snapshots read as all zeros and timing hooks are never called; the
+ * functions below stay available so that callers build either way.
+ *
+ * Counters are written only by their own thread. string_stats_snapshot_all()
+ * sums every thread, including threads that already exited.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+#include "sstring.h"
+
+/** @brief Number of buckets in the capacity-utilization histogram (10% each) */
+#define STRING_STATS_UTILIZATION_BUCKETS 10
+
+/**
+ * @brief Counter values of one thread, or of the whole process
+ * @details Every field is a uint64_t, so that the counters can be handled as an array.
+ */
+typedef struct {
+    uint64_t allocations;      /**< String headers and buffers obtained from an allocator */
+    uint64_t reallocations;    /**< Buffers resized through the allocator's reallocate */
+    uint64_t bytes_allocated;  /**< Bytes requested by allocations and reallocations */
+    uint64_t bytes_copied;     /**< Bytes copied into string buffers */
+    uint64_t memmoves;         /**< Content shifts by insert, erase, trim and replace */
+    uint64_t bytes_moved;      /**< Bytes shifted by those memmoves */
+    uint64_t searches;         /**< Calls into the search kernels */
+    uint64_t bytes_scanned;    /**< Bytes handed to the search kernels */
+    uint64_t utilization[STRING_STATS_UTILIZATION_BUCKETS];  /**< Released heap buffers by (length + 1) / capacity, in 10% steps */
+} string_stats_t;
+
+/**
+ * @brief Operations reported to the timing hook
+ */
+typedef enum {
+    STRING_STATS_OP_APPEND = 0,   /**< string_append_buffer() and the appends built on it */
+    STRING_STATS_OP_INSERT = 1,   /**< string_insert_buffer() and the inserts built on it */
+    STRING_STATS_OP_ERASE = 2,    /**< string_erase() */
+    STRING_STATS_OP_REPLACE = 3,  /**< string_replace_all() and string_replace_first() */
+    STRING_STATS_OP_FORMAT = 4,   /**< string_append_vformat() and string_append_format() */
+    STRING_STATS_OP_FIND = 5      /**< string_view_find() and the finds built on it */
+} string_stats_op_t;
+
+/**
+ * @brief Timing hook called after each instrumented operation
+ * @param op Operation that completed
+ * @param nanoseconds Time spent in the operation (monotonic clock)
+ * @param bytes Size of the operation's input (bytes appended, inserted, erased or searched; the result length for replace and 0 for format)
+ * @param context Context pointer given to string_stats_set_hook()
+ * @details Called on the thread that ran the operation. The hook must not call
+ *          instrumented string functions itself.
+ */
+typedef void (*string_stats_hook_t)(string_stats_op_t op, uint64_t nanoseconds, size_t bytes, void *context);
+
+/*
+ * ================
+ * Stats functions
+ * ================
+ */
+
+/**
+ * @brief Check whether the library was built with instrumentation
+ * @return true if STRING_ENABLE_STATS was defined when building the library
+ */
+bool string_stats_enabled(void);
+
+/**
+ * @brief Read the counters of the calling thread
+ * @param stats Receives the counters (ignored if NULL)
+ */
+void string_stats_snapshot(string_stats_t *stats);
+
+/**
+ * @brief Read the counters summed over every thread
+ * @param stats Receives the counters (ignored if NULL)
+ * @details Includes threads that have exited. Counters of running threads are
+ *          read while they may still be changing, so the sum is approximate.
+ */
+void string_stats_snapshot_all(string_stats_t *stats);
+
+/**
+ * @brief Reset the counters of the calling thread to zero
+ * @details Other threads' counters are left alone; take a snapshot and subtract
+ *          to measure a process-wide interval.
+ */
+void string_stats_reset(void);
+
+/**
+ * @brief Add the utilization of a live string to the histogram
+ * @param str String to sample (ignored if NULL or not heap-allocated)
+ * @details Released heap buffers are sampled automatically; this samples strings
+ *          that are still alive, e.g. at the end of a benchmark.
+ */
+void string_stats_sample(const string_t *str);
+
+/**
+ * @brief Install the per-call timing hook
+ * @param hook Hook to install, or NULL to stop timing
+ * @param context Context pointer passed to the hook
+ * @details Operations only read the clock while a hook is installed. Install the
+ *          hook before other threads start using strings, or accept that a call
+ *          racing with the change may be reported to either hook.
+ */
+void string_stats_set_hook(string_stats_hook_t hook, void *context);
+
+/**
+ * @brief Get the name of an instrumented operation
+ * @param op Operation
+ * @return Static lowercase name (e.g. "append"), or "unknown"
+ */
+const char *string_stats_op_name(string_stats_op_t op);
+
+/*
+ * =====================================
+ * Instrumentation sites (library use)
+ * =====================================
+ */
+
+/**
+ * @brief Add to a counter of the calling thread
+ * @param counter Index of the counter, in uint64_t units from the start of string_stats_t
+ * @param amount Amount to add
+ */
+void string_stats_add(size_t counter, uint64_t amount);
+
+/**
+ * @brief Record the utilization of a heap buffer in the histogram
+ * @param length Content length
+ * @param capacity Buffer capacity
+ */
+void string_stats_utilization(size_t length, size_t capacity);
+
+/**
+ * @brief Read the clock at the start of a timed operation
+ * @return Start time in nanoseconds, or 0 if no hook is installed
+ */
+uint64_t string_stats_begin(void);
+
+/**
+ * @brief Report a timed operation to the hook
+ * @param op Operation that completed
+ * @param started Value returned by string_stats_begin()
+ * @param bytes Size of the operation's input
+ */
+void string_stats_end(string_stats_op_t op, uint64_t started, size_t bytes);
+
+#if defined(STRING_ENABLE_STATS)
+
+/** @brief Add an amount to one of the string_stats_t counters of the calling thread */
+#define STRING_STATS_ADD(field, amount) \
+    string_stats_add(offsetof(string_stats_t, field) / sizeof(uint64_t), (uint64_t)(amount))
+
+/** @brief Record the utilization of a heap buffer being released */
+#define STRING_STATS_UTILIZATION(length, capacity) string_stats_utilization((length), (capacity))
+
+/** @brief Evaluate call, report its duration as op and return its result */
+#define STRING_STATS_RETURN_TIMED(type, op, bytes, call)             \
+    do {                                                             \
+        uint64_t string_stats_started_ = string_stats_begin();       \
+        type string_stats_result_ = (call);                          \
+        string_stats_end((op), string_stats_started_, (bytes));      \
+        return string_stats_result_;                                 \
+    } while (0)
+
+#else
+
+#define STRING_STATS_ADD(field, amount) ((void)0)
+#define STRING_STATS_UTILIZATION(length, capacity) ((void)0)
+#define STRING_STATS_RETURN_TIMED(type, op, bytes, call) return (call)
+
+#endif
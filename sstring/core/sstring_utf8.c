@@ -0,0 +1,546 @@
+/**
+ * @file sstring_utf8.c
+ * @brief Implementation of UTF-8 validation, indexing and transcoding
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * Scans over whole strings go through the vector kernels: validation, code
+ * point counting and the ASCII runs of UTF-16 conversion. Multi-byte sequences
+ * are decoded one at a time by the scalar helpers here, which may assume input
+ * that has already been validated.
+ *
+ * Appends size their output in a first pass over the input, so the string
+ * grows once and is left unchanged when the input turns out to be invalid.
+ */
+
+#include "sstring_utf8.h"
+#include "sstring_simd.h"
+
+/** @brief Number of bytes counted per step while looking for a code point */
+#define STRING_UTF8_INDEX_BLOCK 256
+
+/*
+ * ===================
+ * Encoding helpers
+ * ===================
+ */
+
+/**
+ * @brief Get the number of UTF-8 bytes needed for a code point
+ * @param code_point Code point to measure
+ * @return size_t 1 to 4, or 0 for surrogates and values above U+10FFFF
+ */
+static size_t string_utf8_width(uint32_t code_point) {
+    if (code_point < 0x80) {
+        return 1;
+    }
+    if (code_point < 0x800) {
+        return 2;
+    }
+    if (code_point >= 0xD800 && code_point <= 0xDFFF) {
+        return 0;
+    }
+    if (code_point < 0x10000) {
+        return 3;
+    }
+
+    return code_point <= 0x10FFFF ? 4 : 0;
+}
+
+/**
+ * @brief Encode a code point as UTF-8
+ * @param code_point Unicode scalar value
+ * @param dest Receives string_utf8_width() bytes
+ * @return size_t Number of bytes written
+ */
+static size_t string_utf8_encode(uint32_t code_point, char *dest) {
+    size_t width = string_utf8_width(code_point);
+    switch (width) {
+    case 1:
+        dest[0] = (char)code_point;
+        break;
+    case 2:
+        dest[0] = (char)(0xC0 | (code_point >> 6));
+        dest[1] = (char)(0x80 | (code_point & 0x3F));
+        break;
+    case 3:
+        dest[0] = (char)(0xE0 | (code_point >> 12));
+        dest[1] = (char)(0x80 | ((code_point >> 6) & 0x3F));
+        dest[2] = (char)(0x80 | (code_point & 0x3F));
+        break;
+    case 4:
+        dest[0] = (char)(0xF0 | (code_point >> 18));
+        dest[1] = (char)(0x80 | ((code_point >> 12) & 0x3F));
+        dest[2] = (char)(0x80 | ((code_point >> 6) & 0x3F));
+        dest[3] = (char)(0x80 | (code_point & 0x3F));
+        break;
+    default:
+        break;
+    }
+
+    return width;
+}
+
+/**
+ * @brief Get the length of the sequence a lead byte announces
+ * @param lead First byte of a sequence
+ * @return size_t 1 to 4, or 0 if the byte cannot start a sequence
+ */
+static size_t string_utf8_sequence_length(unsigned char lead) {
+    if (lead < 0x80) {
+        return 1;
+    }
+    if (lead < 0xC2) {
+        return 0;
+    }
+    if (lead < 0xE0) {
+        return 2;
+    }
+    if (lead < 0xF0) {
+        return 3;
+    }
+
+    return lead < 0xF5 ? 4 : 0;
+}
+
+/**
+ * @brief Decode a sequence from input already known to be valid
+ * @param bytes Start of the sequence
+ * @param width Receives the length of the sequence
+ * @return uint32_t Decoded code point
+ */
+static uint32_t string_utf8_decode_valid(const unsigned char *bytes, size_t *width) {
+    unsigned char lead = bytes[0];
+    if (lead < 0x80) {
+        *width = 1;
+        return lead;
+    }
+    if (lead < 0xE0) {
+        *width = 2;
+        return ((uint32_t)(lead & 0x1F) << 6) | (bytes[1] & 0x3F);
+    }
+    if (lead < 0xF0) {
+        *width = 3;
+        return ((uint32_t)(lead & 0x0F) << 12) | ((uint32_t)(bytes[1] & 0x3F) << 6) | (bytes[2] & 0x3F);
+    }
+
+    *width = 4;
+    return ((uint32_t)(lead & 0x07) << 18) | ((uint32_t)(bytes[1] & 0x3F) << 12) |
+           ((uint32_t)(bytes[2] & 0x3F) << 6) | (bytes[3] & 0x3F);
+}
+
+/**
+ * @brief Count the bytes that start four-byte sequences
+ * @param data Valid UTF-8 bytes
+ * @param length Number of bytes
+ * @return size_t Number of code points above U+FFFF
+ */
+static size_t string_utf8_count_supplementary(const char *data, size_t length) {
+    size_t count = 0;
+    for (size_t i = 0; i < length; ++i) {
+        count += (unsigned char)data[i] >= 0xF0;
+    }
+
+    return count;
+}
+
+/*
+ * ===================
+ * UTF-8 validation
+ * ===================
+ */
+
+/**
+ * @brief Find the first byte that does not start a well-formed UTF-8 sequence
+ * @param view Bytes to check
+ * @return size_t Offset of the first invalid sequence, or STRING_NPOS
+ */
+size_t string_utf8_find_invalid(string_view_t view) {
+    if (!view.data || view.length == 0) {
+        return STRING_NPOS;
+    }
+
+    return string_simd_utf8_invalid(view.data, view.length);
+}
+
+/**
+ * @brief Check whether a view is valid UTF-8
+ * @param view Bytes to check
+ * @return bool True if the view is valid UTF-8
+ */
+bool string_utf8_is_valid(string_view_t view) {
+    return string_utf8_find_invalid(view) == STRING_NPOS;
+}
+
+/**
+ * @brief Check whether a string is valid UTF-8
+ * @param str String to check
+ * @return bool True if the string is valid UTF-8
+ */
+bool string_is_utf8(const string_t *str) {
+    if (!str) {
+        return false;
+    }
+
+    return str->is_utf8 || string_utf8_is_valid(string_view_from_string(str));
+}
+
+/**
+ * @brief Check whether a string is valid UTF-8 and remember the answer
+ * @param str String to check
+ * @return bool True if the string is valid UTF-8
+ */
+bool string_check_utf8(string_t *str) {
+    if (!string_is_utf8(str)) {
+        return false;
+    }
+
+    str->is_utf8 = true;
+    return true;
+}
+
+/**
+ * @brief Create a new string from UTF-8 bytes
+ * @param data Bytes to copy
+ * @param length Number of bytes
+ * @return string_t* Pointer to new string or NULL if invalid or on failure
+ */
+string_t *string_create_from_utf8(const char *data, size_t length) {
+    if (!data && length > 0) {
+        return NULL;
+    }
+    if (!string_utf8_is_valid(string_view_from_buffer(data, length))) {
+        return NULL;
+    }
+
+    string_t *str = string_create_from_buffer(data, length);
+    if (str) {
+        str->is_utf8 = true;
+    }
+
+    return str;
+}
+
+/*
+ * ====================
+ * UTF-8 code points
+ * ====================
+ */
+
+/**
+ * @brief Count the code points of a view
+ * @param view Valid UTF-8 bytes
+ * @return size_t Number of code points
+ */
+size_t string_utf8_length(string_view_t view) {
+    if (!view.data) {
+        return 0;
+    }
+
+    return string_simd_utf8_count(view.data, view.length);
+}
+
+/**
+ * @brief Find the byte offset of a code point
+ * @param view Valid UTF-8 bytes
+ * @param index Index of the code point
+ * @return size_t Byte offset, the view length for index == count, or STRING_NPOS
+ * @details Whole blocks are skipped by counting their sequence starts; only the
+ *          block holding the code point is walked byte by byte
+ */
+size_t string_utf8_offset(string_view_t view, size_t index) {
+    if (!view.data) {
+        return index == 0 ? 0 : STRING_NPOS;
+    }
+
+    size_t position = 0;
+    while (view.length - position >= STRING_UTF8_INDEX_BLOCK) {
+        size_t count = string_simd_utf8_count(view.data + position, STRING_UTF8_INDEX_BLOCK);
+        if (count > index) {
+            break;
+        }
+        index -= count;
+        position += STRING_UTF8_INDEX_BLOCK;
+    }
+
+    for (; position < view.length; ++position) {
+        if (((unsigned char)view.data[position] & 0xC0) != 0x80) {
+            if (index == 0) {
+                return position;
+            }
+            index--;
+        }
+    }
+
+    return index == 0 ? view.length : STRING_NPOS;
+}
+
+/**
+ * @brief Decode the code point at an offset and advance past it
+ * @param view Bytes to decode from
+ * @param offset Byte offset, advanced past the sequence on success
+ * @param code_point Receives the decoded code point
+ * @return string_result_t Success or error code
+ */
+string_result_t string_utf8_decode(string_view_t view, size_t *offset, uint32_t *code_point) {
+    if (!offset || !code_point || (!view.data && view.length > 0)) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+    if (*offset >= view.length) {
+        return STRING_ERROR_INVALID_INDEX;
+    }
+
+    const char *bytes = view.data + *offset;
+    size_t width = string_utf8_sequence_length((unsigned char)bytes[0]);
+    if (width == 0 || width > view.length - *offset || string_simd_utf8_invalid(bytes, width) != STRING_NPOS) {
+        return STRING_ERROR_INVALID_ENCODING;
+    }
+
+    *code_point = string_utf8_decode_valid((const unsigned char *)bytes, &width);
+    *offset += width;
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Append one code point encoded as UTF-8
+ * @param str String to append to
+ * @param code_point Unicode scalar value to encode
+ * @return string_result_t Success or error code
+ */
+string_result_t string_append_code_point(string_t *str, uint32_t code_point) {
+    if (!str) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    char encoded[4];
+    size_t width = string_utf8_encode(code_point, encoded);
+    if (width == 0) {
+        return STRING_ERROR_INVALID_ENCODING;
+    }
+
+    bool was_utf8 = str->is_utf8 || str->length == 0;
+    string_result_t result = string_append_buffer(str, encoded, width);
+    if (result == STRING_SUCCESS) {
+        str->is_utf8 = was_utf8;
+    }
+
+    return result;
+}
+
+/*
+ * ===================
+ * UTF transcoding
+ * ===================
+ */
+
+/**
+ * @brief Check a string is valid UTF-8, trusting the validated bit
+ * @param str String to check
+ * @param length Set to 0 when the string is invalid
+ * @return string_result_t Success or error code
+ */
+static string_result_t string_utf8_require_valid(const string_t *str, size_t *length) {
+    if (!str || !length) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+    if (!string_is_utf8(str)) {
+        *length = 0;
+        return STRING_ERROR_INVALID_ENCODING;
+    }
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Convert a string to UTF-16
+ * @param str UTF-8 string to convert
+ * @param dest Destination code units (can be NULL)
+ * @param capacity Number of code units dest can hold
+ * @param length Receives the required number of code units
+ * @return string_result_t Success or error code
+ * @details ASCII runs are widened by the vector kernel while dest has room; once
+ *          it is full the rest is only counted
+ */
+string_result_t string_to_utf16(const string_t *str, uint16_t *dest, size_t capacity, size_t *length) {
+    string_result_t result = string_utf8_require_valid(str, length);
+    if (result != STRING_SUCCESS) {
+        return result;
+    }
+    if (!dest) {
+        capacity = 0;
+    }
+
+    const unsigned char *bytes = (const unsigned char *)str->data;
+    size_t i = 0;
+    size_t out = 0;
+    while (i < str->length) {
+        if (out >= capacity) {
+            size_t rest = str->length - i;
+            out += string_simd_utf8_count(str->data + i, rest) + string_utf8_count_supplementary(str->data + i, rest);
+            break;
+        }
+
+        size_t room = capacity - out < str->length - i ? capacity - out : str->length - i;
+        size_t ascii = string_simd_ascii_to_utf16(str->data + i, room, dest + out);
+        i += ascii;
+        out += ascii;
+        if (ascii == room) {
+            continue;
+        }
+
+        size_t width;
+        uint32_t code_point = string_utf8_decode_valid(bytes + i, &width);
+        i += width;
+        if (code_point < 0x10000) {
+            dest[out++] = (uint16_t)code_point;
+        } else if (capacity - out >= 2) {
+            code_point -= 0x10000;
+            dest[out++] = (uint16_t)(0xD800 | (code_point >> 10));
+            dest[out++] = (uint16_t)(0xDC00 | (code_point & 0x3FF));
+        } else {
+            out += 2;
+        }
+    }
+
+    *length = out;
+    return dest && out > capacity ? STRING_ERROR_BUFFER_TOO_SMALL : STRING_SUCCESS;
+}
+
+/**
+ * @brief Convert a string to UTF-32
+ * @param str UTF-8 string to convert
+ * @param dest Destination code points (can be NULL)
+ * @param capacity Number of code points dest can hold
+ * @param length Receives the required number of code points
+ * @return string_result_t Success or error code
+ */
+string_result_t string_to_utf32(const string_t *str, uint32_t *dest, size_t capacity, size_t *length) {
+    string_result_t result = string_utf8_require_valid(str, length);
+    if (result != STRING_SUCCESS) {
+        return result;
+    }
+
+    size_t required = string_simd_utf8_count(str->data, str->length);
+    *length = required;
+    if (!dest) {
+        return STRING_SUCCESS;
+    }
+    if (capacity < required) {
+        return STRING_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    const unsigned char *bytes = (const unsigned char *)str->data;
+    size_t i = 0;
+    for (size_t out = 0; out < required; ++out) {
+        size_t width;
+        dest[out] = string_utf8_decode_valid(bytes + i, &width);
+        i += width;
+    }
+
+    return STRING_SUCCESS;
+}
+
+/**
+ * @brief Append UTF-16 code units converted to UTF-8
+ * @param str String to append to
+ * @param units Code units to convert
+ * @param count Number of code units
+ * @return string_result_t Success or error code
+ */
+string_result_t string_append_utf16(string_t *str, const uint16_t *units, size_t count) {
+    if (!str || (!units && count > 0)) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    // Size the output and reject unpaired surrogates before touching the string
+    size_t bytes = 0;
+    for (size_t i = 0; i < count; ++i) {
+        uint16_t unit = units[i];
+        if (unit < 0x80) {
+            bytes += 1;
+        } else if (unit < 0x800) {
+            bytes += 2;
+        } else if (unit < 0xD800 || unit > 0xDFFF) {
+            bytes += 3;
+        } else if (unit <= 0xDBFF && i + 1 < count && units[i + 1] >= 0xDC00 && units[i + 1] <= 0xDFFF) {
+            bytes += 4;
+            i++;
+        } else {
+            return STRING_ERROR_INVALID_ENCODING;
+        }
+    }
+
+    bool was_utf8 = str->is_utf8 || str->length == 0;
+    char *spare;
+    size_t available;
+    string_result_t result = string_reserve_spare(str, bytes, &spare, &available);
+    if (result != STRING_SUCCESS) {
+        return result;
+    }
+
+    size_t written = 0;
+    for (size_t i = 0; i < count;) {
+        size_t ascii = string_simd_utf16_to_ascii(units + i, count - i, spare + written);
+        i += ascii;
+        written += ascii;
+        if (i == count) {
+            break;
+        }
+
+        uint32_t code_point = units[i++];
+        if (code_point >= 0xD800 && code_point <= 0xDBFF) {
+            code_point = 0x10000 + ((code_point - 0xD800) << 10) + (units[i++] - 0xDC00u);
+        }
+        written += string_utf8_encode(code_point, spare + written);
+    }
+
+    result = string_commit_spare(str, written);
+    if (result == STRING_SUCCESS) {
+        str->is_utf8 = was_utf8;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Append UTF-32 code points converted to UTF-8
+ * @param str String to append to
+ * @param code_points Code points to convert
+ * @param count Number of code points
+ * @return string_result_t Success or error code
+ */
+string_result_t string_append_utf32(string_t *str, const uint32_t *code_points, size_t count) {
+    if (!str || (!code_points && count > 0)) {
+        return STRING_ERROR_NULL_POINTER;
+    }
+
+    size_t bytes = 0;
+    for (size_t i = 0; i < count; ++i) {
+        size_t width = string_utf8_width(code_points[i]);
+        if (width == 0) {
+            return STRING_ERROR_INVALID_ENCODING;
+        }
+        bytes += width;
+    }
+
+    bool was_utf8 = str->is_utf8 || str->length == 0;
+    char *spare;
+    size_t available;
+    string_result_t result = string_reserve_spare(str, bytes, &spare, &available);
+    if (result != STRING_SUCCESS) {
+        return result;
+    }
+
+    size_t written = 0;
+    for (size_t i = 0; i < count; ++i) {
+        written += string_utf8_encode(code_points[i], spare + written);
+    }
+
+    result = string_commit_spare(str, written);
+    if (result == STRING_SUCCESS) {
+        str->is_utf8 = was_utf8;
+    }
+
+    return result;
+}
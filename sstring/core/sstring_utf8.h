@@ -0,0 +1,170 @@
+/**
+ * @file sstring_utf8.h
+ * @brief UTF-8 validation, indexing and transcoding for the safe strings library
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * This header provides functions that treat string content as UTF-8 text:
+ * checking that bytes are well formed, counting and locating code points, and
+ * converting to and from UTF-16 and UTF-32 buffers. The core string functions
+ * stay byte-oriented; nothing here changes how they behave.
+ *
+ * Validation follows Unicode table 3-7: overlong forms, surrogates, values
+ * above U+10FFFF and sequences cut short by the end of input are all rejected.
+ * The scans run on the vector kernels of sstring_simd.h, which handle ASCII a
+ * whole block at a time.
+ *
+ * A string remembers when it has been validated (string_check_utf8(),
+ * string_create_from_utf8() and the transcoding appends set the bit), so
+ * conversions from it skip validation. Any modification clears the bit again.
+ */
+
+#pragma once
+
+#include "sstring.h"
+
+/*
+ * ===================
+ * UTF-8 validation
+ * ===================
+ */
+
+/**
+ * @brief Find the first byte that does not start a well-formed UTF-8 sequence
+ * @param view Bytes to check
+ * @return Offset of the first invalid or truncated sequence, or STRING_NPOS if the view is valid
+ */
+size_t string_utf8_find_invalid(string_view_t view);
+
+/**
+ * @brief Check whether a view is valid UTF-8
+ * @param view Bytes to check
+ * @return true if every byte belongs to a well-formed sequence
+ */
+bool string_utf8_is_valid(string_view_t view);
+
+/**
+ * @brief Check whether a string is valid UTF-8
+ * @param str String to check
+ * @return true if the string is valid UTF-8, false if not or if NULL
+ * @details Returns immediately for strings already known to be valid; does not
+ *          record the result (see string_check_utf8()).
+ */
+bool string_is_utf8(const string_t *str);
+
+/**
+ * @brief Check whether a string is valid UTF-8 and remember the answer
+ * @param str String to check
+ * @return true if the string is valid UTF-8, false if not or if NULL
+ * @details A valid string is marked so that later checks and conversions skip
+ *          the scan until the string is modified.
+ */
+bool string_check_utf8(string_t *str);
+
+/**
+ * @brief Create a new string from UTF-8 bytes
+ * @param data Bytes to copy
+ * @param length Number of bytes
+ * @return Pointer to newly created string marked as valid UTF-8, or NULL if the
+ *         bytes are not valid UTF-8 or on allocation failure
+ */
+string_t *string_create_from_utf8(const char *data, size_t length);
+
+/*
+ * ====================
+ * UTF-8 code points
+ * ====================
+ */
+
+/**
+ * @brief Count the code points of a view
+ * @param view Valid UTF-8 bytes
+ * @return Number of code points
+ * @details Counts the bytes that are not continuation bytes, so the result for
+ *          invalid input is the number of sequence starts.
+ */
+size_t string_utf8_length(string_view_t view);
+
+/**
+ * @brief Find the byte offset of a code point
+ * @param view Valid UTF-8 bytes
+ * @param index Index of the code point
+ * @return Byte offset of the code point, the view length when index equals the
+ *         code point count, or STRING_NPOS when index is beyond it
+ */
+size_t string_utf8_offset(string_view_t view, size_t index);
+
+/**
+ * @brief Decode the code point at an offset and advance past it
+ * @param view Bytes to decode from
+ * @param offset In: byte offset of the sequence; out: offset of the next one
+ * @param code_point Receives the decoded code point
+ * @return STRING_SUCCESS on success, STRING_ERROR_INVALID_INDEX at the end of
+ *         the view, STRING_ERROR_INVALID_ENCODING if the sequence is not well formed
+ */
+string_result_t string_utf8_decode(string_view_t view, size_t *offset, uint32_t *code_point);
+
+/**
+ * @brief Append one code point encoded as UTF-8
+ * @param str String to append to
+ * @param code_point Unicode scalar value to encode
+ * @return STRING_SUCCESS on success, STRING_ERROR_INVALID_ENCODING for
+ *         surrogates and values above U+10FFFF, other error code on failure
+ */
+string_result_t string_append_code_point(string_t *str, uint32_t code_point);
+
+/*
+ * ===================
+ * UTF transcoding
+ * ===================
+ */
+
+/**
+ * @brief Convert a string to UTF-16
+ * @param str UTF-8 string to convert
+ * @param dest Receives the code units (can be NULL to query the length)
+ * @param capacity Number of code units dest can hold
+ * @param length Receives the number of code units the conversion needs
+ * @return STRING_SUCCESS on success, STRING_ERROR_BUFFER_TOO_SMALL if capacity
+ *         is less than *length, STRING_ERROR_INVALID_ENCODING if the string is
+ *         not valid UTF-8 (with *length set to 0)
+ * @details Code points above U+FFFF become surrogate pairs. No terminator is written.
+ */
+string_result_t string_to_utf16(const string_t *str, uint16_t *dest, size_t capacity, size_t *length);
+
+/**
+ * @brief Convert a string to UTF-32
+ * @param str UTF-8 string to convert
+ * @param dest Receives the code points (can be NULL to query the length)
+ * @param capacity Number of code points dest can hold
+ * @param length Receives the number of code points the conversion needs
+ * @return STRING_SUCCESS on success, STRING_ERROR_BUFFER_TOO_SMALL if capacity
+ *         is less than *length, STRING_ERROR_INVALID_ENCODING if the string is
+ *         not valid UTF-8 (with *length set to 0)
+ * @details No terminator is written.
+ */
+string_result_t string_to_utf32(const string_t *str, uint32_t *dest, size_t capacity, size_t *length);
+
+/**
+ * @brief Append UTF-16 code units converted to UTF-8
+ * @param str String to append to
+ * @param units Code units to convert
+ * @param count Number of code units
+ * @return STRING_SUCCESS on success, STRING_ERROR_INVALID_ENCODING for unpaired
+ *         surrogates, other error code on failure
+ * @details The input is checked before anything is appended, so on failure the
+ *          string is unchanged. A string that was valid UTF-8 stays marked so.
+ */
+string_result_t string_append_utf16(string_t *str, const uint16_t *units, size_t count);
+
+/**
+ * @brief Append UTF-32 code points converted to UTF-8
+ * @param str String to append to
+ * @param code_points Code points to convert
+ * @param count Number of code points
+ * @return STRING_SUCCESS on success, STRING_ERROR_INVALID_ENCODING for
+ *         surrogates and values above U+10FFFF, other error code on failure
+ * @details The input is checked before anything is appended, so on failure the
+ *          string is unchanged. A string that was valid UTF-8 stays marked so.
+ */
+string_result_t string_append_utf32(string_t *str, const uint32_t *code_points, size_t count);
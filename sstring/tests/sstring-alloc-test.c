@@ -0,0 +1,132 @@
+/**
+ * @file sstring-alloc-test.c
+ * @brief Test suite for the safe strings allocator backends
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * This file contains unit tests for the pluggable allocator interface,
+ * the arena allocator and the size-class pool allocator.
+ */
+
+#include <assert.h>
+
+#include "sstring.h"
+#include "sstring_alloc.h"
+
+/**
+ * @brief Test function for arena-backed strings
+ * @details Tests arena functionality including:
+ *          - Creating strings bound to an arena
+ *          - Growth through the arena allocator
+ *          - Releasing all strings with a single reset
+ */
+void test_arena(void) {
+    printf("Testing arena allocator...\n");
+
+    string_arena_t *arena = string_arena_create(256);
+    assert(arena != NULL);
+    const string_allocator_t *allocator = string_arena_allocator(arena);
+    assert(allocator != NULL);
+
+    // Test explicit binding
+    string_t *str = string_create_with_allocator(0, allocator);
+    assert(str != NULL);
+    assert(string_append_cstr(str, "arena") == STRING_SUCCESS);
+    assert(string_equals_cstr(str, "arena"));
+    assert(string_arena_used(arena) > 0);
+
+    // Test growth past the block size
+    for (int i = 0; i < 100; ++i) {
+        assert(string_append_cstr(str, "-growing") == STRING_SUCCESS);
+    }
+    assert(string_length(str) == 5 + 100 * 8);
+    assert(string_find_cstr(str, "arena-growing", 0) == 0);
+
+    // Test a request whose block size would overflow is refused
+    assert(allocator->allocate(allocator->context, SIZE_MAX - 32) == NULL);
+    assert(string_length(str) == 5 + 100 * 8);
+
+    // Test thread binding and one-shot release
+    string_set_thread_allocator(allocator);
+    assert(string_get_thread_allocator() == allocator);
+    for (int i = 0; i < 50; ++i) {
+        string_t *tmp = string_create_from_cstr("short-lived request string");
+        assert(tmp != NULL);
+        assert(tmp->allocator == allocator);
+    }
+    string_set_thread_allocator(NULL);
+    assert(string_get_thread_allocator() == string_default_allocator());
+
+    string_arena_reset(arena);
+    assert(string_arena_used(arena) == 0);
+
+    // Test arena is reusable after reset
+    string_t *again = string_create_with_allocator(0, allocator);
+    assert(string_assign_cstr(again, "reused") == STRING_SUCCESS);
+    assert(string_equals_cstr(again, "reused"));
+    string_destroy(again);
+
+    string_arena_destroy(arena);
+    string_arena_destroy(NULL);
+    assert(string_arena_allocator(NULL) == NULL);
+
+    printf("✅ Arena allocator tests passed\n");
+}
+
+/**
+ * @brief Test function for pool-backed strings
+ * @details Tests pool functionality including:
+ *          - Recycling chunks of the same size class
+ *          - Growth across size classes and past the largest class
+ *          - Caller-owned strings bound to a pool
+ */
+void test_pool(void) {
+    printf("Testing pool allocator...\n");
+
+    string_pool_t *pool = string_pool_create();
+    assert(pool != NULL);
+    const string_allocator_t *allocator = string_pool_allocator(pool);
+
+    // Test chunk recycling
+    string_t *str1 = string_create_with_allocator(100, allocator);
+    assert(str1 != NULL);
+    char *first_data = str1->data;
+    string_destroy(str1);
+    string_t *str2 = string_create_with_allocator(100, allocator);
+    assert(str2->data == first_data || (char *)str2 == first_data);
+    string_destroy(str2);
+
+    // Test growth across classes and into the heap
+    string_t str;
+    assert(string_init_with_allocator(&str, allocator) == STRING_SUCCESS);
+    for (int i = 0; i < 300; ++i) {
+        assert(string_append_cstr(&str, "pool") == STRING_SUCCESS);
+    }
+    assert(string_length(&str) == 1200);
+    assert(string_capacity(&str) > STRING_POOL_MAX_CLASS_SIZE);
+    assert(string_resize(&str, 40) == STRING_SUCCESS);
+    assert(string_shrink_to_fit(&str) == STRING_SUCCESS);
+    assert(string_find_cstr(&str, "poolpool", 0) == 0);
+    string_deinit(&str);
+
+    string_pool_destroy(pool);
+    string_pool_destroy(NULL);
+
+    printf("✅ Pool allocator tests passed\n");
+}
+
+/**
+ * @brief Main test runner function
+ * @details Executes all allocator test suites
+ * @return int Returns 0 on successful completion of all tests
+ */
+int main(void) {
+    printf("Running strings allocator tests...\n\n");
+
+    test_arena();
+    test_pool();
+
+    printf("\n🎉 All allocator tests passed!\n");
+
+    return 0;
+}
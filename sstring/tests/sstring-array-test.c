@@ -0,0 +1,319 @@
+/**
+ * @file sstring-array-test.c
+ * @brief Test suite for the safe strings contiguous array
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * This file contains unit tests for the contiguous string array, covering
+ * appends and view access, sorting and deduplication, and saving and mapping
+ * array files.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <assert.h>
+#include <errno.h>
+#include <unistd.h>
+
+#include "sstring.h"
+#include "sstring_array.h"
+
+/**
+ * @brief Test function for basic array operations
+ * @details Tests array functionality including:
+ *          - Appending views, C strings and strings
+ *          - Empty and binary elements
+ *          - Elements used with the view functions
+ *          - Appending an element of the array itself
+ */
+void test_array_basic(void) {
+    printf("Testing string arrays...\n");
+
+    string_array_t *array = string_array_create();
+    assert(array != NULL);
+    assert(string_array_count(array) == 0 && string_array_bytes(array) == 0);
+
+    string_t *str = string_create_from_cstr("gamma");
+    assert(string_array_append_cstr(array, "alpha") == STRING_SUCCESS);
+    assert(string_array_append(array, string_view_from_buffer("be\0ta", 5)) == STRING_SUCCESS);
+    assert(string_array_append_cstr(array, "") == STRING_SUCCESS);
+    assert(string_array_append_string(array, str) == STRING_SUCCESS);
+    assert(string_array_count(array) == 4 && string_array_bytes(array) == 15);
+
+    // Test elements work with the view functions
+    string_view_t element = string_array_at(array, 1);
+    assert(element.length == 5 && memcmp(element.data, "be\0ta", 5) == 0);
+    assert(string_array_at(array, 2).length == 0);
+    assert(string_view_equals(string_array_at(array, 3), string_view_from_string(str)));
+    assert(string_view_compare(string_array_at(array, 0), string_array_at(array, 3)) < 0);
+    assert(string_view_find(string_array_at(array, 0), string_view_from_cstr("ph"), 0) == 2);
+    assert(string_array_at(array, 4).length == 0 && string_array_at(NULL, 0).length == 0);
+
+    // Test element lookup
+    assert(string_array_find(array, string_view_from_cstr("gamma"), 0) == 3);
+    assert(string_array_find(array, string_view_from_cstr(""), 0) == 2);
+    assert(string_array_find(array, string_view_from_cstr("alpha"), 1) == STRING_NPOS);
+    assert(string_array_find(array, string_view_from_cstr("delta"), 0) == STRING_NPOS);
+
+    // Test appending an element of the array while the blob grows
+    for (size_t i = 0; i < 200; ++i) {
+        assert(string_array_append(array, string_array_at(array, i % 4)) == STRING_SUCCESS);
+    }
+    assert(string_array_count(array) == 204);
+    assert(string_view_equals(string_array_at(array, 203), string_view_from_cstr("gamma")));
+    assert(string_view_equals(string_array_at(array, 200), string_view_from_cstr("alpha")));
+
+    // Test reserve and clear
+    assert(string_array_reserve(array, 10000, 100000) == STRING_SUCCESS);
+    assert(string_array_clear(array) == STRING_SUCCESS);
+    assert(string_array_count(array) == 0 && string_array_bytes(array) == 0);
+    assert(string_array_append_cstr(array, "again") == STRING_SUCCESS);
+    assert(string_view_equals(string_array_at(array, 0), string_view_from_cstr("again")));
+
+    // Test invalid input
+    assert(string_array_append(NULL, string_view_from_cstr("x")) == STRING_ERROR_NULL_POINTER);
+    string_view_t invalid = { NULL, 3 };
+    assert(string_array_append(array, invalid) == STRING_ERROR_INVALID_ARGUMENT);
+    assert(string_array_append_cstr(array, NULL) == STRING_ERROR_NULL_POINTER);
+    assert(string_array_count(NULL) == 0);
+
+    string_destroy(str);
+    string_array_destroy(array);
+    string_array_destroy(NULL);
+
+    printf("✅ String array tests passed\n");
+}
+
+/**
+ * @brief Test function for sorting and deduplication
+ * @details Tests bulk operations including:
+ *          - Byte order matching string_view_compare()
+ *          - Elements sharing long prefixes and prefixes of each other
+ *          - Removing duplicates after sorting
+ *          - Binary search in a sorted array
+ */
+void test_array_sort(void) {
+    printf("Testing array sorting...\n");
+
+    string_array_t *array = string_array_create();
+    char key[32];
+    for (size_t i = 0; i < 5000; ++i) {
+        size_t value = (i * 7919) % 1000;
+        int length = snprintf(key, sizeof(key), "customer-%zu", value);
+        assert(string_array_append(array, string_view_from_buffer(key, (size_t)length)) == STRING_SUCCESS);
+    }
+    assert(string_array_append_cstr(array, "") == STRING_SUCCESS);
+    assert(string_array_append_cstr(array, "customer") == STRING_SUCCESS);
+    assert(string_array_append(array, string_view_from_buffer("customer\0", 9)) == STRING_SUCCESS);
+    assert(string_array_append_cstr(array, "\xff") == STRING_SUCCESS);
+    size_t bytes = string_array_bytes(array);
+
+    assert(string_array_sort(array) == STRING_SUCCESS);
+    assert(string_array_count(array) == 5004 && string_array_bytes(array) == bytes);
+    for (size_t i = 1; i < string_array_count(array); ++i) {
+        assert(string_view_compare(string_array_at(array, i - 1), string_array_at(array, i)) <= 0);
+    }
+    assert(string_array_at(array, 0).length == 0);
+    assert(string_view_equals(string_array_at(array, 1), string_view_from_cstr("customer")));
+    assert(string_array_at(array, 2).length == 9);
+    assert(string_view_equals(string_array_at(array, 5003), string_view_from_cstr("\xff")));
+
+    // Test duplicates collapse to one element each
+    size_t removed = 0;
+    assert(string_array_unique(array, &removed) == STRING_SUCCESS);
+    assert(removed == 4000 && string_array_count(array) == 1004);
+    for (size_t i = 1; i < string_array_count(array); ++i) {
+        assert(string_view_compare(string_array_at(array, i - 1), string_array_at(array, i)) < 0);
+    }
+    assert(string_array_unique(array, &removed) == STRING_SUCCESS && removed == 0);
+
+    // Test binary search
+    assert(string_array_search_sorted(array, string_view_from_cstr("customer-512")) != STRING_NPOS);
+    size_t index = string_array_search_sorted(array, string_view_from_cstr("customer-999"));
+    assert(string_view_equals(string_array_at(array, index), string_view_from_cstr("customer-999")));
+    assert(string_array_search_sorted(array, string_view_from_cstr("customer-1000")) == STRING_NPOS);
+    assert(string_array_search_sorted(array, string_view_from_cstr("")) == 0);
+
+    // Test unsorted runs keep the first of each run only
+    string_array_t *runs = string_array_create();
+    const char *values[] = { "b", "b", "a", "a", "a", "b", "", "" };
+    for (size_t i = 0; i < 8; ++i) {
+        assert(string_array_append_cstr(runs, values[i]) == STRING_SUCCESS);
+    }
+    assert(string_array_unique(runs, NULL) == STRING_SUCCESS);
+    assert(string_array_count(runs) == 4 && string_array_bytes(runs) == 3);
+    assert(string_view_equals(string_array_at(runs, 1), string_view_from_cstr("a")));
+    assert(string_view_equals(string_array_at(runs, 2), string_view_from_cstr("b")));
+    assert(string_array_at(runs, 3).length == 0);
+
+    string_array_destroy(runs);
+    string_array_destroy(array);
+
+    printf("✅ Array sorting tests passed\n");
+}
+
+/**
+ * @brief Test function for batch operations over arrays
+ * @details Tests batch functionality including:
+ *          - Case conversion of the whole blob
+ *          - Comparing every element against one key
+ *          - Finding a byte across element boundaries
+ *          - Joining with and without a separator
+ */
+void test_array_batch(void) {
+    printf("Testing array batch operations...\n");
+
+    string_array_t *array = string_array_create();
+    const char *items[] = { "Apple", "", "BANANA", "cherry", "", "apple", "Date:Fig" };
+    for (size_t i = 0; i < sizeof(items) / sizeof(items[0]); ++i) {
+        assert(string_array_append_cstr(array, items[i]) == STRING_SUCCESS);
+    }
+
+    // Test case conversion keeps every element in place
+    assert(string_array_to_lower(array) == STRING_SUCCESS);
+    assert(string_view_equals(string_array_at(array, 2), string_view_from_cstr("banana")));
+    assert(string_view_equals(string_array_at(array, 6), string_view_from_cstr("date:fig")));
+    assert(string_array_count(array) == 7 && string_array_at(array, 4).length == 0);
+
+    // Test comparing against one key
+    bool matches[7];
+    assert(string_array_count_equal(array, string_view_from_cstr("apple"), matches) == 2);
+    assert(matches[0] && !matches[1] && matches[5] && !matches[6]);
+    assert(string_array_count_equal(array, string_view_from_cstr(""), NULL) == 2);
+    string_view_t invalid = { NULL, 5 };
+    assert(string_array_count_equal(array, invalid, NULL) == 0);
+    assert(string_array_count_equal(NULL, string_view_from_cstr("apple"), NULL) == 0);
+
+    // Test a byte found in the blob maps back to its element, skipping empty ones
+    size_t position = 0;
+    assert(string_array_find_char(array, 'b', 0, &position) == 2 && position == 0);
+    assert(string_array_find_char(array, 'e', 0, &position) == 0 && position == 4);
+    assert(string_array_find_char(array, 'e', 1, &position) == 3 && position == 2);
+    assert(string_array_find_char(array, 'a', 4, &position) == 5 && position == 0);
+    assert(string_array_find_char(array, ':', 0, &position) == 6 && position == 4);
+    assert(string_array_find_char(array, 'z', 0, NULL) == STRING_NPOS);
+    assert(string_array_find_char(array, 'a', 7, NULL) == STRING_NPOS);
+
+    // Test joining
+    string_t *joined = string_create_from_cstr("[");
+    assert(string_array_join(array, joined, string_view_from_cstr("")) == STRING_SUCCESS);
+    assert(string_equals_cstr(joined, "[applebananacherryappledate:fig"));
+    assert(string_clear(joined) == STRING_SUCCESS);
+    assert(string_array_join(array, joined, string_view_from_cstr(", ")) == STRING_SUCCESS);
+    assert(string_equals_cstr(joined, "apple, , banana, cherry, , apple, date:fig"));
+
+    // Test a separator viewing the destination itself
+    string_t *self = string_create_from_cstr("|");
+    assert(string_array_join(array, self, string_view_from_string(self)) == STRING_SUCCESS);
+    assert(string_equals_cstr(self, "|apple||banana|cherry||apple|date:fig"));
+
+    assert(string_array_to_upper(array) == STRING_SUCCESS);
+    assert(string_array_find(array, string_view_from_cstr("CHERRY"), 0) == 3);
+    assert(string_array_to_upper(NULL) == STRING_ERROR_NULL_POINTER);
+    assert(string_array_join(NULL, joined, string_view_from_cstr(",")) == STRING_ERROR_NULL_POINTER);
+    assert(string_array_join(array, NULL, string_view_from_cstr(",")) == STRING_ERROR_NULL_POINTER);
+
+    // Test an empty array
+    string_array_t *empty = string_array_create();
+    assert(string_array_to_lower(empty) == STRING_SUCCESS);
+    assert(string_array_find_char(empty, 'a', 0, NULL) == STRING_NPOS);
+    assert(string_clear(joined) == STRING_SUCCESS);
+    assert(string_array_join(empty, joined, string_view_from_cstr(",")) == STRING_SUCCESS);
+    assert(string_length(joined) == 0);
+
+    string_array_destroy(empty);
+    string_destroy(self);
+    string_destroy(joined);
+    string_array_destroy(array);
+
+    printf("✅ Array batch operation tests passed\n");
+}
+
+/**
+ * @brief Test function for saving and mapping arrays
+ * @details Tests persistence functionality including:
+ *          - Round trip through a mapped file
+ *          - Read-only mapped arrays
+ *          - Rejecting truncated and foreign files
+ */
+void test_array_mapping(void) {
+    printf("Testing array mapping...\n");
+
+    string_array_t *array = string_array_create();
+    for (size_t i = 0; i < 1000; ++i) {
+        char key[32];
+        int length = snprintf(key, sizeof(key), "row-%zu", i * i);
+        assert(string_array_append(array, string_view_from_buffer(key, (size_t)length)) == STRING_SUCCESS);
+    }
+    assert(string_array_append_cstr(array, "") == STRING_SUCCESS);
+
+    char path[] = "/tmp/sstring-array-XXXXXX";
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    assert(close(fd) == 0);
+    assert(string_array_save(array, path) == STRING_SUCCESS);
+
+    // Test the mapped array matches the saved one
+    string_array_t *mapped = NULL;
+    assert(string_array_map_file(path, &mapped) == STRING_SUCCESS);
+    assert(string_array_is_mapped(mapped) && !string_array_is_mapped(array));
+    assert(string_array_count(mapped) == 1001);
+    assert(string_array_bytes(mapped) == string_array_bytes(array));
+    for (size_t i = 0; i < 1001; ++i) {
+        assert(string_view_equals(string_array_at(mapped, i), string_array_at(array, i)));
+    }
+    assert(string_array_find(mapped, string_view_from_cstr("row-998001"), 0) == 999);
+
+    // Test mapped arrays are read-only
+    assert(string_array_append_cstr(mapped, "x") == STRING_ERROR_READ_ONLY);
+    assert(string_array_sort(mapped) == STRING_ERROR_READ_ONLY);
+    assert(string_array_unique(mapped, NULL) == STRING_ERROR_READ_ONLY);
+    assert(string_array_clear(mapped) == STRING_ERROR_READ_ONLY);
+    assert(string_array_to_lower(mapped) == STRING_ERROR_READ_ONLY);
+    string_array_destroy(mapped);
+
+    // Test a truncated file is rejected
+    assert(truncate(path, 100) == 0);
+    assert(string_array_map_file(path, &mapped) == STRING_ERROR_INVALID_ARGUMENT && mapped == NULL);
+    FILE *file = fopen(path, "wb");
+    assert(file != NULL);
+    assert(fputs("this is not an array file at all", file) >= 0);
+    assert(fclose(file) == 0);
+    assert(string_array_map_file(path, &mapped) == STRING_ERROR_INVALID_ARGUMENT);
+    assert(unlink(path) == 0);
+    assert(string_array_map_file(path, &mapped) == STRING_ERROR_IO && errno == ENOENT);
+
+    // Test an empty array round trip
+    string_array_t *empty = string_array_create();
+    assert(string_array_save(empty, path) == STRING_SUCCESS);
+    assert(string_array_map_file(path, &mapped) == STRING_SUCCESS);
+    assert(string_array_count(mapped) == 0);
+    assert(unlink(path) == 0);
+
+    assert(string_array_map_file(NULL, &mapped) == STRING_ERROR_NULL_POINTER);
+    assert(string_array_save(NULL, path) == STRING_ERROR_NULL_POINTER);
+
+    string_array_destroy(mapped);
+    string_array_destroy(empty);
+    string_array_destroy(array);
+
+    printf("✅ Array mapping tests passed\n");
+}
+
+/**
+ * @brief Main test runner function
+ * @details Executes all string array test suites
+ * @return int Returns 0 on successful completion of all tests
+ */
+int main(void) {
+    printf("Running strings array tests...\n\n");
+
+    test_array_basic();
+    test_array_sort();
+    test_array_batch();
+    test_array_mapping();
+
+    printf("\n🎉 All array tests passed!\n");
+
+    return 0;
+}
@@ -0,0 +1,223 @@
+/**
+ * @file sstring-buffer-test.c
+ * @brief Test suite for the safe strings concurrent append buffer
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * This file contains unit tests for the concurrent append buffer, covering
+ * single-threaded appends and batches, and many writers racing a consumer
+ * without losing, duplicating or reordering any line.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "sstring.h"
+#include "sstring_buffer.h"
+
+/** @brief Number of writer threads in the concurrency test */
+#define TEST_WRITERS 8
+
+/** @brief Number of lines appended by each writer */
+#define TEST_LINES 20000
+
+/**
+ * @brief State shared by the writers and the consumer
+ */
+typedef struct {
+    string_buffer_t *buffer;  /**< Buffer under test */
+    size_t id;                /**< Writer number */
+} test_writer_t;
+
+/**
+ * @brief Body of a writer thread
+ * @param argument Writer state
+ * @return NULL
+ */
+static void *test_writer(void *argument) {
+    test_writer_t *writer = argument;
+    for (size_t line = 0; line < TEST_LINES; ++line) {
+        if (line % 1000 == 999) {
+            // Longer than a segment, so it gets one of its own
+            char padding[300];
+            memset(padding, '=', sizeof(padding) - 1);
+            padding[sizeof(padding) - 1] = '\0';
+            assert(string_buffer_append_format(writer->buffer, "%zu %zu %s\n", writer->id, line, padding) == STRING_SUCCESS);
+        } else {
+            assert(string_buffer_append_format(writer->buffer, "%zu %zu\n", writer->id, line) == STRING_SUCCESS);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Check every writer's lines appear once each, in order
+ * @param output Everything taken from the buffer
+ */
+static void check_lines(const string_t *output) {
+    size_t next[TEST_WRITERS] = { 0 };
+    const char *cursor = string_cstr(output);
+    const char *end = cursor + string_length(output);
+
+    while (cursor < end) {
+        char *after = NULL;
+        size_t id = strtoul(cursor, &after, 10);
+        size_t line = strtoul(after, &after, 10);
+        assert(id < TEST_WRITERS && line == next[id]);
+        next[id]++;
+
+        const char *newline = memchr(after, '\n', (size_t)(end - after));
+        assert(newline != NULL);
+        cursor = newline + 1;
+    }
+
+    for (size_t id = 0; id < TEST_WRITERS; ++id) {
+        assert(next[id] == TEST_LINES);
+    }
+}
+
+/**
+ * @brief Test function for single-threaded buffer use
+ * @details Tests buffer functionality including:
+ *          - Appending views, C strings and formatted text
+ *          - Batches of views and draining into a string
+ *          - Appends longer than a segment
+ *          - Invalid input handling
+ */
+void test_buffer_basic(void) {
+    printf("Testing concurrent buffer basics...\n");
+
+    string_buffer_t *buffer = string_buffer_create(2, 16);
+    assert(buffer != NULL);
+
+    // Test an empty take
+    string_buffer_batch_t *batch = NULL;
+    assert(string_buffer_take(buffer, &batch) == STRING_SUCCESS);
+    assert(string_buffer_batch_count(batch) == 0 && string_buffer_batch_bytes(batch) == 0);
+    assert(string_buffer_batch_at(batch, 0).length == 0);
+    string_buffer_batch_destroy(batch);
+
+    // Test appends spread over several segments keep their order
+    assert(string_buffer_append_cstr(buffer, "hello ") == STRING_SUCCESS);
+    assert(string_buffer_append(buffer, string_view_from_buffer("wo\0rld", 6)) == STRING_SUCCESS);
+    assert(string_buffer_append_format(buffer, " %d-%s", 42, "answer") == STRING_SUCCESS);
+    assert(string_buffer_append_cstr(buffer, "") == STRING_SUCCESS);
+    assert(string_buffer_append_cstr(buffer, " and a piece longer than a segment") == STRING_SUCCESS);
+
+    const char expected[] = "hello wo\0rld 42-answer and a piece longer than a segment";
+    assert(string_buffer_take(buffer, &batch) == STRING_SUCCESS);
+    assert(string_buffer_batch_bytes(batch) == sizeof(expected) - 1);
+    assert(string_buffer_batch_count(batch) >= 2);
+
+    string_t *joined = string_create();
+    for (size_t i = 0; i < string_buffer_batch_count(batch); ++i) {
+        assert(string_append_view(joined, string_buffer_batch_at(batch, i)) == STRING_SUCCESS);
+    }
+    assert(string_length(joined) == sizeof(expected) - 1);
+    assert(memcmp(string_cstr(joined), expected, sizeof(expected) - 1) == 0);
+    string_buffer_batch_destroy(batch);
+
+    // Test the buffer is empty after a take and can be drained into a string
+    assert(string_buffer_append_cstr(buffer, "!") == STRING_SUCCESS);
+    assert(string_buffer_drain(buffer, joined) == STRING_SUCCESS);
+    assert(string_length(joined) == sizeof(expected));
+    assert(string_cstr(joined)[sizeof(expected) - 1] == '!');
+    assert(string_buffer_drain(buffer, joined) == STRING_SUCCESS);
+    assert(string_length(joined) == sizeof(expected));
+
+    // Test formatted output longer than the stack buffer
+    string_t *long_text = string_create();
+    assert(string_resize(long_text, STRING_BUFFER_FORMAT_STACK * 3) == STRING_SUCCESS);
+    memset(long_text->data, 'z', STRING_BUFFER_FORMAT_STACK * 3);
+    assert(string_buffer_append_format(buffer, "<%s>", string_cstr(long_text)) == STRING_SUCCESS);
+    string_t *drained = string_create();
+    assert(string_buffer_drain(buffer, drained) == STRING_SUCCESS);
+    assert(string_length(drained) == STRING_BUFFER_FORMAT_STACK * 3 + 2);
+    assert(string_cstr(drained)[0] == '<' && string_cstr(drained)[string_length(drained) - 1] == '>');
+
+    // Test invalid input
+    string_view_t invalid = { NULL, 3 };
+    assert(string_buffer_append(buffer, invalid) == STRING_ERROR_INVALID_ARGUMENT);
+    assert(string_buffer_append(NULL, string_view_from_cstr("x")) == STRING_ERROR_NULL_POINTER);
+    assert(string_buffer_append_cstr(buffer, NULL) == STRING_ERROR_NULL_POINTER);
+    assert(string_buffer_append_format(buffer, NULL) == STRING_ERROR_NULL_POINTER);
+    assert(string_buffer_take(NULL, &batch) == STRING_ERROR_NULL_POINTER);
+    assert(string_buffer_drain(buffer, NULL) == STRING_ERROR_NULL_POINTER);
+    assert(string_buffer_batch_count(NULL) == 0);
+
+    string_destroy(drained);
+    string_destroy(long_text);
+    string_destroy(joined);
+    string_buffer_destroy(buffer);
+    string_buffer_destroy(NULL);
+    string_buffer_batch_destroy(NULL);
+
+    printf("✅ Concurrent buffer basic tests passed\n");
+}
+
+/**
+ * @brief Test function for concurrent writers and a consumer
+ * @details Tests concurrency including:
+ *          - Many writers appending lines at once
+ *          - A consumer taking batches while they write
+ *          - No line lost, duplicated, split or reordered per writer
+ */
+void test_buffer_concurrent(void) {
+    printf("Testing concurrent buffer writers...\n");
+
+    // Few shards and small segments force shared shards and frequent chaining
+    string_buffer_t *buffer = string_buffer_create(3, 256);
+    test_writer_t writers[TEST_WRITERS];
+    pthread_t threads[TEST_WRITERS];
+    for (size_t i = 0; i < TEST_WRITERS; ++i) {
+        writers[i].buffer = buffer;
+        writers[i].id = i;
+        assert(pthread_create(&threads[i], NULL, test_writer, &writers[i]) == 0);
+    }
+
+    // Take batches while the writers run; each view holds whole lines
+    string_t *output = string_create();
+    for (size_t round = 0; round < 200; ++round) {
+        string_buffer_batch_t *batch = NULL;
+        assert(string_buffer_take(buffer, &batch) == STRING_SUCCESS);
+        for (size_t i = 0; i < string_buffer_batch_count(batch); ++i) {
+            string_view_t view = string_buffer_batch_at(batch, i);
+            assert(view.data[view.length - 1] == '\n');
+            assert(string_append_view(output, view) == STRING_SUCCESS);
+        }
+        string_buffer_batch_destroy(batch);
+    }
+
+    for (size_t i = 0; i < TEST_WRITERS; ++i) {
+        assert(pthread_join(threads[i], NULL) == 0);
+    }
+    assert(string_buffer_drain(buffer, output) == STRING_SUCCESS);
+
+    // Each writer's lines are ordered within a batch and batches are in order,
+    // so every writer's lines must read 0, 1, 2, ...
+    check_lines(output);
+
+    string_destroy(output);
+    string_buffer_destroy(buffer);
+
+    printf("✅ Concurrent buffer writer tests passed\n");
+}
+
+/**
+ * @brief Main test runner function
+ * @details Executes all concurrent buffer test suites
+ * @return int Returns 0 on successful completion of all tests
+ */
+int main(void) {
+    printf("Running strings buffer tests...\n\n");
+
+    test_buffer_basic();
+    test_buffer_concurrent();
+
+    printf("\n🎉 All buffer tests passed!\n");
+
+    return 0;
+}
@@ -0,0 +1,163 @@
+/**
+ * @file sstring-intern-test.c
+ * @brief Test suite for the safe strings interning pool
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * This file contains unit tests for the interning pool, covering canonical
+ * pointers, read-only canonical strings, and concurrent interning from
+ * several threads.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <assert.h>
+#include <pthread.h>
+
+#include "sstring.h"
+#include "sstring_intern.h"
+
+/** @brief Number of threads used by the concurrency test */
+#define INTERN_THREADS 8
+
+/** @brief Number of distinct tags interned by each thread */
+#define INTERN_TAGS 2000
+
+/**
+ * @brief Work shared by the interning threads
+ */
+typedef struct {
+    string_intern_t *pool;                /**< Shared pool */
+    const string_t *results[INTERN_TAGS]; /**< Canonical string of each tag, as seen by this thread */
+    unsigned seed;                        /**< Order in which this thread visits the tags */
+} intern_worker_t;
+
+/**
+ * @brief Thread body interning every tag in a thread-specific order
+ * @param arg Pointer to an intern_worker_t
+ * @return void* Always NULL
+ */
+static void *intern_worker(void *arg) {
+    intern_worker_t *worker = arg;
+    char tag[32];
+
+    for (size_t i = 0; i < INTERN_TAGS; ++i) {
+        size_t index = (i * 7919 + worker->seed) % INTERN_TAGS;
+        int length = snprintf(tag, sizeof(tag), "host=node-%zu", index);
+        worker->results[index] = string_intern(worker->pool, string_view_from_buffer(tag, (size_t)length));
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Test function for interning
+ * @details Tests interning functionality including:
+ *          - One canonical pointer per distinct content
+ *          - Interning from views, C strings and strings
+ *          - Read-only canonical strings with cached hashes
+ */
+void test_intern_basic(void) {
+    printf("Testing interning...\n");
+
+    string_intern_t *pool = string_intern_create();
+    assert(pool != NULL);
+
+    // Test the same content always maps to the same pointer
+    const string_t *a = string_intern_cstr(pool, "region=eu-west");
+    const char *line = "tags: region=eu-west,env=prod";
+    const string_t *b = string_intern(pool, string_view_from_buffer(line + 6, 14));
+    string_t *copy = string_create_from_cstr("region=eu-west");
+    const string_t *c = string_intern_string(pool, copy);
+    assert(a != NULL && a == b && b == c);
+    assert(string_equals(a, b));
+    assert(string_equals(a, copy) && a != copy);
+    assert(string_intern_count(pool) == 1);
+
+    const string_t *other = string_intern_cstr(pool, "env=prod");
+    const string_t *empty = string_intern_cstr(pool, "");
+    const string_t *binary = string_intern(pool, string_view_from_buffer("env=prod\0", 9));
+    assert(other != a && empty != other && binary != other);
+    assert(string_length(binary) == 9 && string_length(empty) == 0);
+    assert(string_intern_count(pool) == 4);
+
+    // Test lookups never insert
+    assert(string_intern_lookup(pool, string_view_from_cstr("env=prod")) == other);
+    assert(string_intern_lookup(pool, string_view_from_cstr("env=dev")) == NULL);
+    assert(string_intern_count(pool) == 4);
+
+    // Test canonical strings are immutable and pre-hashed
+    assert(string_hash(a) == string_view_hash(string_view_from_cstr("region=eu-west")));
+    assert(string_append_char((string_t *)a, '!') == STRING_ERROR_READ_ONLY);
+    assert(string_equals_cstr(a, "region=eu-west"));
+
+    // Test invalid input
+    assert(string_intern(NULL, string_view_from_cstr("x")) == NULL);
+    assert(string_intern_cstr(pool, NULL) == NULL);
+    assert(string_intern_string(pool, NULL) == NULL);
+    assert(string_intern_lookup(NULL, string_view_from_cstr("x")) == NULL);
+    assert(string_intern_count(NULL) == 0);
+
+    string_destroy(copy);
+    string_intern_destroy(pool);
+    string_intern_destroy(NULL);
+
+    printf("✅ Interning tests passed\n");
+}
+
+/**
+ * @brief Test function for concurrent interning
+ * @details Tests that threads interning overlapping tag sets in different orders
+ *          all receive the same canonical pointers
+ */
+void test_intern_concurrent(void) {
+    printf("Testing concurrent interning...\n");
+
+    string_intern_t *pool = string_intern_create_concurrent(0);
+    assert(pool != NULL);
+
+    static intern_worker_t workers[INTERN_THREADS];
+    pthread_t threads[INTERN_THREADS];
+    for (unsigned i = 0; i < INTERN_THREADS; ++i) {
+        workers[i].pool = pool;
+        workers[i].seed = i * 131;
+        assert(pthread_create(&threads[i], NULL, intern_worker, &workers[i]) == 0);
+    }
+    for (unsigned i = 0; i < INTERN_THREADS; ++i) {
+        assert(pthread_join(threads[i], NULL) == 0);
+    }
+
+    assert(string_intern_count(pool) == INTERN_TAGS);
+    for (size_t tag = 0; tag < INTERN_TAGS; ++tag) {
+        assert(workers[0].results[tag] != NULL);
+        for (unsigned i = 1; i < INTERN_THREADS; ++i) {
+            assert(workers[i].results[tag] == workers[0].results[tag]);
+        }
+    }
+    assert(string_intern_lookup(pool, string_view_from_cstr("host=node-42")) == workers[3].results[42]);
+
+    string_intern_destroy(pool);
+
+    // Test an odd shard count is rounded up and still works
+    pool = string_intern_create_concurrent(3);
+    assert(string_intern_cstr(pool, "a") == string_intern_cstr(pool, "a"));
+    string_intern_destroy(pool);
+
+    printf("✅ Concurrent interning tests passed\n");
+}
+
+/**
+ * @brief Main test runner function
+ * @details Executes all interning test suites
+ * @return int Returns 0 on successful completion of all tests
+ */
+int main(void) {
+    printf("Running strings interning tests...\n\n");
+
+    test_intern_basic();
+    test_intern_concurrent();
+
+    printf("\n🎉 All interning tests passed!\n");
+
+    return 0;
+}
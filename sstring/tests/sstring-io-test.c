@@ -0,0 +1,314 @@
+/**
+ * @file sstring-io-test.c
+ * @brief Test suite for the safe strings file and descriptor I/O
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * This file contains unit tests for reading files and descriptors into strings,
+ * vectored reads and writes, line input from streams, and files mapped as
+ * read-only strings.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "sstring.h"
+#include "sstring_io.h"
+
+/**
+ * @brief Create a temporary file with some content
+ * @param path Receives the path of the file (at least 32 bytes)
+ * @param data Content to write
+ * @param length Number of bytes to write
+ */
+static void io_make_file(char *path, const char *data, size_t length) {
+    strcpy(path, "/tmp/sstring-io-XXXXXX");
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    assert(write(fd, data, length) == (ssize_t)length);
+    assert(close(fd) == 0);
+}
+
+/**
+ * @brief Test function for reading files and descriptors
+ * @details Tests read functionality including:
+ *          - Loading a file in a single exactly sized allocation
+ *          - Reading from the current offset of a descriptor
+ *          - Draining a pipe with single reads
+ *          - Reporting missing files and bad descriptors
+ */
+void test_io_read(void) {
+    printf("Testing descriptor reads...\n");
+
+    // Test a whole file is loaded with its bytes intact
+    char content[10000];
+    for (size_t i = 0; i < sizeof(content); ++i) {
+        content[i] = (char)(i * 31);
+    }
+    char path[32];
+    io_make_file(path, content, sizeof(content));
+
+    string_t *str = string_create_from_cstr("previous content");
+    assert(string_read_file(str, path) == STRING_SUCCESS);
+    assert(string_length(str) == sizeof(content));
+    assert(memcmp(string_cstr(str), content, sizeof(content)) == 0);
+    assert(string_capacity(str) == sizeof(content) + 2);
+
+    // Test reading starts at the descriptor offset
+    int fd = open(path, O_RDONLY);
+    assert(fd >= 0 && lseek(fd, 9990, SEEK_SET) == 9990);
+    assert(string_read_fd(str, fd) == STRING_SUCCESS);
+    assert(string_length(str) == 10 && memcmp(string_cstr(str), content + 9990, 10) == 0);
+    assert(close(fd) == 0);
+    assert(unlink(path) == 0);
+
+    // Test single reads from a pipe append and report end of file
+    int pipe_fds[2];
+    assert(pipe(pipe_fds) == 0);
+    assert(write(pipe_fds[1], "GET / HTTP/1.1\r\n", 16) == 16);
+    size_t bytes_read = 0;
+    assert(string_assign_cstr(str, ">") == STRING_SUCCESS);
+    assert(string_append_from_fd(str, pipe_fds[0], 4, &bytes_read) == STRING_SUCCESS);
+    assert(bytes_read == 4 && string_equals_cstr(str, ">GET "));
+    assert(string_append_from_fd(str, pipe_fds[0], 0, &bytes_read) == STRING_SUCCESS);
+    assert(bytes_read == 12 && string_equals_cstr(str, ">GET / HTTP/1.1\r\n"));
+    assert(close(pipe_fds[1]) == 0);
+    assert(string_append_from_fd(str, pipe_fds[0], 0, &bytes_read) == STRING_SUCCESS);
+    assert(bytes_read == 0 && string_length(str) == 17);
+    assert(close(pipe_fds[0]) == 0);
+
+    // Test a pipe without a known size is drained completely
+    assert(pipe(pipe_fds) == 0);
+    assert(write(pipe_fds[1], content, 3000) == 3000);
+    assert(close(pipe_fds[1]) == 0);
+    assert(string_read_fd(str, pipe_fds[0]) == STRING_SUCCESS);
+    assert(string_length(str) == 3000 && memcmp(string_cstr(str), content, 3000) == 0);
+    assert(close(pipe_fds[0]) == 0);
+
+    // Test failures keep errno
+    assert(string_read_file(str, "/nonexistent/sstring-io") == STRING_ERROR_IO && errno == ENOENT);
+    assert(string_read_fd(str, -1) == STRING_ERROR_IO && errno == EBADF);
+    assert(string_read_file(NULL, path) == STRING_ERROR_NULL_POINTER);
+    assert(string_read_file(str, NULL) == STRING_ERROR_NULL_POINTER);
+    assert(string_open_file("/nonexistent/sstring-io") == -1 && errno == ENOENT);
+    assert(string_open_file(NULL) == -1 && errno == EINVAL);
+    string_t view;
+    assert(string_init_view(&view, string_view_from_cstr("fixed")) == STRING_SUCCESS);
+    assert(string_read_fd(&view, 0) == STRING_ERROR_READ_ONLY);
+
+    string_destroy(str);
+
+    printf("✅ Descriptor read tests passed\n");
+}
+
+/**
+ * @brief Test function for writing and vectored I/O
+ * @details Tests write functionality including:
+ *          - Writing one string and batches of strings
+ *          - Batches larger than one vectored call
+ *          - Scattering one read over the spare room of several strings
+ */
+void test_io_vectored(void) {
+    printf("Testing vectored I/O...\n");
+
+    int pipe_fds[2];
+    assert(pipe(pipe_fds) == 0);
+
+    // Test a batch of strings arrives in order
+    string_t *parts[600];
+    string_t *expected = string_create();
+    for (size_t i = 0; i < 600; ++i) {
+        parts[i] = string_create();
+        if (i % 7 != 0) {
+            assert(string_append_uint(parts[i], i) == STRING_SUCCESS);
+            assert(string_append_char(parts[i], ',') == STRING_SUCCESS);
+        }
+        assert(string_append_string(expected, parts[i]) == STRING_SUCCESS);
+    }
+    string_t *head = string_create_from_cstr("head:");
+    assert(string_write_fd(head, pipe_fds[1]) == STRING_SUCCESS);
+    assert(string_writev_fd((const string_t *const *)parts, 600, pipe_fds[1]) == STRING_SUCCESS);
+    assert(close(pipe_fds[1]) == 0);
+
+    string_t *received = string_create();
+    assert(string_read_fd(received, pipe_fds[0]) == STRING_SUCCESS);
+    assert(string_length(received) == 5 + string_length(expected));
+    assert(memcmp(string_cstr(received), "head:", 5) == 0);
+    assert(memcmp(string_cstr(received) + 5, string_cstr(expected), string_length(expected)) == 0);
+    assert(close(pipe_fds[0]) == 0);
+
+    // Test one readv fills fixed-size records in order
+    assert(pipe(pipe_fds) == 0);
+    assert(write(pipe_fds[1], "AAAABBBBCC", 10) == 10);
+    char storage[3][5];
+    string_t records[3];
+    string_t *targets[3];
+    for (size_t i = 0; i < 3; ++i) {
+        assert(string_init_with_buffer(&records[i], storage[i], sizeof(storage[i])) == STRING_SUCCESS);
+        targets[i] = &records[i];
+    }
+    assert(string_append_char(&records[0], '0') == STRING_SUCCESS);
+    size_t bytes_read = 0;
+    assert(string_readv_fd(targets, 3, pipe_fds[0], &bytes_read) == STRING_SUCCESS);
+    assert(bytes_read == 10);
+    assert(string_equals_cstr(&records[0], "0AAA") && string_cstr(&records[0]) == storage[0]);
+    assert(string_equals_cstr(&records[1], "ABBB"));
+    assert(string_equals_cstr(&records[2], "BCC"));
+    assert(close(pipe_fds[1]) == 0);
+    assert(string_readv_fd(targets, 3, pipe_fds[0], &bytes_read) == STRING_SUCCESS);
+    assert(bytes_read == 0);
+    assert(close(pipe_fds[0]) == 0);
+
+    // Test invalid input
+    assert(string_write_fd(NULL, 1) == STRING_ERROR_NULL_POINTER);
+    assert(string_writev_fd(NULL, 1, 1) == STRING_ERROR_NULL_POINTER);
+    assert(string_writev_fd(NULL, 0, 1) == STRING_SUCCESS);
+    assert(string_write_fd(head, -1) == STRING_ERROR_IO && errno == EBADF);
+
+    for (size_t i = 0; i < 600; ++i) {
+        string_destroy(parts[i]);
+    }
+    for (size_t i = 0; i < 3; ++i) {
+        string_deinit(&records[i]);
+    }
+    string_destroy(expected);
+    string_destroy(head);
+    string_destroy(received);
+
+    printf("✅ Vectored I/O tests passed\n");
+}
+
+/**
+ * @brief Test function for line input
+ * @details Tests line reading functionality including:
+ *          - Lines with and without a final newline
+ *          - Empty lines and embedded null bytes
+ *          - Lines longer than the current capacity
+ *          - End of file reporting
+ */
+void test_io_read_line(void) {
+    printf("Testing line input...\n");
+
+    char long_line[5000];
+    memset(long_line, 'L', sizeof(long_line));
+    FILE *stream = tmpfile();
+    assert(stream != NULL);
+    assert(fwrite("first\n\nwith\0null\n", 1, 17, stream) == 17);
+    assert(fwrite(long_line, 1, sizeof(long_line), stream) == sizeof(long_line));
+    assert(fwrite("\nlast", 1, 5, stream) == 5);
+    rewind(stream);
+
+    string_t line;
+    assert(string_init(&line) == STRING_SUCCESS);
+    assert(string_read_line(&line, stream) == STRING_SUCCESS);
+    assert(string_equals_cstr(&line, "first"));
+    assert(string_read_line(&line, stream) == STRING_SUCCESS);
+    assert(string_is_empty(&line));
+    assert(string_read_line(&line, stream) == STRING_SUCCESS);
+    assert(string_length(&line) == 9 && memcmp(string_cstr(&line), "with\0null", 9) == 0);
+    assert(string_read_line(&line, stream) == STRING_SUCCESS);
+    assert(string_length(&line) == sizeof(long_line));
+    assert(memcmp(string_cstr(&line), long_line, sizeof(long_line)) == 0);
+
+    // Test the buffer is reused and the last line needs no newline
+    const char *buffer = string_cstr(&line);
+    assert(string_read_line(&line, stream) == STRING_SUCCESS);
+    assert(string_equals_cstr(&line, "last") && string_cstr(&line) == buffer);
+    assert(string_read_line(&line, stream) == STRING_ERROR_END_OF_FILE);
+    assert(string_is_empty(&line));
+    assert(string_read_line(&line, stream) == STRING_ERROR_END_OF_FILE);
+
+    assert(string_read_line(NULL, stream) == STRING_ERROR_NULL_POINTER);
+    assert(string_read_line(&line, NULL) == STRING_ERROR_NULL_POINTER);
+
+    fclose(stream);
+    string_deinit(&line);
+
+    printf("✅ Line input tests passed\n");
+}
+
+/**
+ * @brief Test function for mapping files as strings
+ * @details Tests file mapping functionality including:
+ *          - Searching and comparing directly over the mapping
+ *          - A null terminator after contents filling whole pages
+ *          - Read-only mapped strings and writable clones
+ *          - Empty files and invalid arguments
+ */
+void test_io_map_file(void) {
+    printf("Testing file mapping...\n");
+
+    // Test a file of exactly one page still reads as a C string
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    char *content = malloc(page);
+    assert(content != NULL);
+    memset(content, 'a', page);
+    memcpy(content + page - 6, "needle", 6);
+    char path[32];
+    io_make_file(path, content, page);
+
+    string_t *mapped = string_map_file(path, STRING_MAP_SEQUENTIAL | STRING_MAP_WILLNEED);
+    assert(mapped != NULL);
+    assert(string_length(mapped) == page && string_capacity(mapped) > page);
+    assert(string_cstr(mapped)[page] == '\0' && strlen(string_cstr(mapped)) == page);
+    assert(string_find_cstr(mapped, "needle", 0) == page - 6);
+    assert(string_rfind_char(mapped, 'a', STRING_NPOS) == page - 7);
+    assert(string_view_equals(string_view_from_string(mapped), string_view_from_buffer(content, page)));
+
+    // Test modifications are refused and clones are writable copies
+    assert(string_append_char(mapped, '!') == STRING_ERROR_READ_ONLY);
+    assert(string_set_at(mapped, 0, 'b') == STRING_ERROR_READ_ONLY);
+    assert(string_clear(mapped) == STRING_ERROR_READ_ONLY);
+    string_t *copy = string_clone(mapped);
+    assert(string_equals(copy, mapped) && string_cstr(copy) != string_cstr(mapped));
+    assert(string_append_char(copy, '!') == STRING_SUCCESS);
+    string_destroy(mapped);
+    assert(string_length(copy) == page + 1);
+    string_destroy(copy);
+
+    // Test a short file and the random access hint
+    assert(unlink(path) == 0);
+    io_make_file(path, "short", 5);
+    mapped = string_map_file(path, STRING_MAP_RANDOM);
+    assert(mapped != NULL && string_equals_cstr(mapped, "short"));
+    string_destroy(mapped);
+
+    // Test an empty file maps to an empty string
+    assert(truncate(path, 0) == 0);
+    mapped = string_map_file(path, STRING_MAP_NORMAL);
+    assert(mapped != NULL && string_is_empty(mapped) && string_cstr(mapped)[0] == '\0');
+    string_destroy(mapped);
+    assert(unlink(path) == 0);
+
+    // Test failures set errno
+    assert(string_map_file(path, STRING_MAP_NORMAL) == NULL && errno == ENOENT);
+    assert(string_map_file("/tmp", STRING_MAP_NORMAL) == NULL && errno == EINVAL);
+    assert(string_map_file("/tmp", STRING_MAP_SEQUENTIAL | STRING_MAP_RANDOM) == NULL && errno == EINVAL);
+    assert(string_map_file(NULL, STRING_MAP_NORMAL) == NULL && errno == EINVAL);
+
+    free(content);
+
+    printf("✅ File mapping tests passed\n");
+}
+
+/**
+ * @brief Main test runner function
+ * @details Executes all I/O test suites
+ * @return int Returns 0 on successful completion of all tests
+ */
+int main(void) {
+    printf("Running strings I/O tests...\n\n");
+
+    test_io_read();
+    test_io_vectored();
+    test_io_read_line();
+    test_io_map_file();
+
+    printf("\n🎉 All I/O tests passed!\n");
+
+    return 0;
+}
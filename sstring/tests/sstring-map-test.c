@@ -0,0 +1,208 @@
+/**
+ * @file sstring-map-test.c
+ * @brief Test suite for the safe strings hash map and string hashing
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * This file contains unit tests for the string hash, its cache in string_t,
+ * and the string-keyed hash map, covering insertion, lookup by views and
+ * strings, removal, growth and iteration.
+ */
+
+#include <assert.h>
+
+#include "sstring.h"
+#include "sstring_map.h"
+
+/** @brief Number of keys used by the growth test */
+#define MANY_KEYS 5000
+
+/**
+ * @brief Test function for string hashing
+ * @details Tests hashing functionality including:
+ *          - Agreement between views, strings and the cache
+ *          - Every input length around the block boundaries
+ *          - Cache invalidation by modification functions
+ */
+void test_string_hashing(void) {
+    printf("Testing string hashing...\n");
+
+    // Test every length hashes differently and consistently
+    char buffer[200];
+    for (size_t i = 0; i < sizeof(buffer); ++i) {
+        buffer[i] = (char)('a' + i % 26);
+    }
+    for (size_t length = 1; length < sizeof(buffer); ++length) {
+        uint64_t hash = string_view_hash(string_view_from_buffer(buffer, length));
+        assert(hash != string_view_hash(string_view_from_buffer(buffer, length - 1)));
+        assert(hash != string_view_hash(string_view_from_buffer(buffer + 1, length)));
+        assert(hash == string_view_hash(string_view_from_buffer(buffer, length)));
+    }
+    assert(string_view_hash(string_view_from_buffer("a\0", 2)) != string_view_hash(string_view_from_buffer("a", 1)));
+
+    // Test the cache and its invalidation
+    string_t *str = string_create_from_cstr("tag:value");
+    uint64_t hash = string_view_hash(string_view_from_cstr("tag:value"));
+    assert(string_hash(str) == hash);
+    assert(!str->has_hash);
+    assert(string_hash_cached(str) == hash);
+    assert(str->has_hash && string_hash(str) == hash);
+
+    // Test capacity-only operations keep the cache
+    char *spare;
+    size_t available;
+    assert(string_reserve(str, 256) == STRING_SUCCESS);
+    assert(string_reserve_hint(str, 512) == STRING_SUCCESS);
+    assert(string_reserve_spare(str, 16, &spare, &available) == STRING_SUCCESS);
+    assert(string_shrink_to_fit(str) == STRING_SUCCESS);
+    assert(str->has_hash && string_hash(str) == hash);
+
+    assert(string_append_char(str, '!') == STRING_SUCCESS);
+    assert(!str->has_hash);
+    assert(string_hash_cached(str) == string_view_hash(string_view_from_cstr("tag:value!")));
+    assert(string_set_at(str, 0, 'T') == STRING_SUCCESS);
+    assert(string_hash_cached(str) == string_view_hash(string_view_from_cstr("Tag:value!")));
+    assert(string_to_upper(str) == STRING_SUCCESS);
+    assert(string_hash(str) == string_view_hash(string_view_from_cstr("TAG:VALUE!")));
+    assert(string_clear(str) == STRING_SUCCESS);
+    assert(string_hash(str) == string_view_hash(string_view_from_cstr("")));
+
+    // Test a read-only string keeps its cache
+    string_t view;
+    assert(string_init_view(&view, string_view_from_cstr("fixed")) == STRING_SUCCESS);
+    assert(string_hash_cached(&view) == string_view_hash(string_view_from_cstr("fixed")));
+    assert(string_append_char(&view, 'x') == STRING_ERROR_READ_ONLY);
+    assert(view.has_hash);
+
+    assert(string_hash(NULL) == 0 && string_hash_cached(NULL) == 0);
+    string_destroy(str);
+
+    printf("✅ String hashing tests passed\n");
+}
+
+/**
+ * @brief Test function for map insertion and lookup
+ * @details Tests map functionality including:
+ *          - Insert, replace and lookup by view and by string
+ *          - Keys containing null bytes and the empty key
+ *          - Growth across many keys, removal and iteration
+ */
+void test_map_operations(void) {
+    printf("Testing map operations...\n");
+
+    string_map_t *map = string_map_create();
+    assert(map != NULL && string_map_size(map) == 0);
+
+    // Test lookups on an empty map
+    void *value = NULL;
+    assert(!string_map_get(map, string_view_from_cstr("missing"), &value));
+    assert(!string_map_remove(map, string_view_from_cstr("missing"), NULL));
+
+    // Test insertion, replacement and heterogeneous lookup
+    int one = 1, two = 2, three = 3;
+    assert(string_map_put(map, string_view_from_cstr("host"), &one) == STRING_SUCCESS);
+    assert(string_map_put(map, string_view_from_buffer("a\0b", 3), &two) == STRING_SUCCESS);
+    assert(string_map_put(map, string_view_from_cstr(""), &three) == STRING_SUCCESS);
+    assert(string_map_size(map) == 3);
+
+    const char *header = "Host: example.com";
+    assert(!string_map_get(map, string_view_from_buffer(header, 4), NULL));
+    string_t *key = string_create_from_cstr("host");
+    assert(string_map_get_string(map, key, &value) && value == &one);
+    string_hash_cached(key);
+    assert(string_map_put_string(map, key, &two) == STRING_SUCCESS);
+    assert(string_map_size(map) == 3);
+    assert(string_map_get(map, string_view_from_cstr("host"), &value) && value == &two);
+    assert(string_map_get(map, string_view_from_buffer("a\0b", 3), &value) && value == &two);
+    assert(!string_map_get(map, string_view_from_buffer("a", 1), NULL));
+    assert(string_map_get(map, string_view_from_cstr(""), &value) && value == &three);
+
+    // Test growth and removal across many keys
+    string_map_clear(map);
+    assert(string_map_size(map) == 0 && !string_map_get_string(map, key, NULL));
+    assert(string_map_reserve(map, 100) == STRING_SUCCESS);
+    string_t *name = string_create();
+    for (int i = 0; i < MANY_KEYS; ++i) {
+        string_clear(name);
+        string_append_format(name, "key-%d", i);
+        assert(string_map_put_string(map, name, (void *)(size_t)(i + 1)) == STRING_SUCCESS);
+    }
+    assert(string_map_size(map) == MANY_KEYS);
+    for (int i = 0; i < MANY_KEYS; i += 2) {
+        string_clear(name);
+        string_append_format(name, "key-%d", i);
+        assert(string_map_remove(map, string_view_from_string(name), &value));
+        assert(value == (void *)(size_t)(i + 1));
+    }
+    assert(string_map_size(map) == MANY_KEYS / 2);
+    for (int i = 0; i < MANY_KEYS; ++i) {
+        string_clear(name);
+        string_append_format(name, "key-%d", i);
+        bool found = string_map_get(map, string_view_from_string(name), &value);
+        assert(found == (i % 2 == 1));
+        assert(!found || value == (void *)(size_t)(i + 1));
+    }
+
+    // Test iteration visits every remaining entry once
+    size_t cursor = 0, visited = 0, sum = 0;
+    string_view_t entry;
+    while (string_map_next(map, &cursor, &entry, &value)) {
+        assert(entry.length > 4 && memcmp(entry.data, "key-", 4) == 0);
+        assert(entry.data[entry.length] == '\0');
+        sum += (size_t)value;
+        visited++;
+    }
+    assert(visited == MANY_KEYS / 2);
+    assert(sum == (size_t)(MANY_KEYS / 2) * (MANY_KEYS / 2 + 1));
+
+    string_destroy(name);
+    string_destroy(key);
+    string_map_destroy(map);
+
+    printf("✅ Map operation tests passed\n");
+}
+
+/**
+ * @brief Test function for map error handling
+ * @details Tests that invalid input is rejected without crashing
+ */
+void test_map_errors(void) {
+    printf("Testing map error handling...\n");
+
+    string_map_t *map = string_map_create();
+    string_view_t broken = {NULL, 3};
+
+    assert(string_map_put(NULL, string_view_from_cstr("x"), NULL) == STRING_ERROR_NULL_POINTER);
+    assert(string_map_put(map, broken, NULL) == STRING_ERROR_NULL_POINTER);
+    assert(string_map_put_string(map, NULL, NULL) == STRING_ERROR_NULL_POINTER);
+    assert(!string_map_get(NULL, string_view_from_cstr("x"), NULL));
+    assert(!string_map_get(map, broken, NULL));
+    assert(!string_map_get_string(map, NULL, NULL));
+    assert(!string_map_remove(NULL, string_view_from_cstr("x"), NULL));
+    assert(string_map_reserve(NULL, 1) == STRING_ERROR_NULL_POINTER);
+    assert(!string_map_next(map, NULL, NULL, NULL));
+    assert(string_map_size(NULL) == 0);
+
+    string_map_clear(NULL);
+    string_map_destroy(map);
+    string_map_destroy(NULL);
+
+    printf("✅ Map error handling tests passed\n");
+}
+
+/**
+ * @brief Main test runner function
+ * @details Executes all hashing and map test suites
+ * @return int Returns 0 on successful completion of all tests
+ */
+int main(void) {
+    printf("Running strings map tests...\n\n");
+
+    test_string_hashing();
+    test_map_operations();
+    test_map_errors();
+
+    printf("\n🎉 All map tests passed!\n");
+
+    return 0;
+}
@@ -0,0 +1,228 @@
+/**
+ * @file sstring-matcher-test.c
+ * @brief Test suite for the safe strings multi-pattern matcher
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * This file contains unit tests for the Aho-Corasick matcher, covering
+ * overlapping and binary patterns, streaming input and error handling.
+ */
+
+#include <assert.h>
+
+#include "sstring.h"
+#include "sstring_matcher.h"
+
+/** @brief Maximum number of matches recorded by the test collector */
+#define MAX_MATCHES 64
+
+/**
+ * @brief Matches collected by a scan
+ */
+typedef struct {
+    string_match_t matches[MAX_MATCHES];  /**< Recorded matches */
+    size_t count;                         /**< Number of recorded matches */
+    size_t limit;                         /**< Stop after this many matches (0 = never) */
+} match_log_t;
+
+/**
+ * @brief Callback that records every match into a match_log_t
+ * @param match Reported match
+ * @param user_data Pointer to the match_log_t
+ * @return bool false once the log limit is reached
+ */
+static bool collect_match(const string_match_t *match, void *user_data) {
+    match_log_t *log = user_data;
+    assert(log->count < MAX_MATCHES);
+    log->matches[log->count++] = *match;
+    return log->limit == 0 || log->count < log->limit;
+}
+
+/**
+ * @brief Check whether a log contains a given match
+ * @param log Match log
+ * @param pattern_id Expected pattern id
+ * @param offset Expected offset
+ * @return bool true if the match was recorded
+ */
+static bool has_match(const match_log_t *log, size_t pattern_id, size_t offset) {
+    for (size_t i = 0; i < log->count; ++i) {
+        if (log->matches[i].pattern_id == pattern_id && log->matches[i].offset == offset) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Test function for single-pass matching
+ * @details Tests matcher functionality including:
+ *          - Overlapping and nested patterns
+ *          - Patterns containing null bytes
+ *          - Early stop from the callback
+ */
+void test_matcher_scan(void) {
+    printf("Testing matcher scanning...\n");
+
+    string_matcher_t *matcher = string_matcher_create();
+    assert(matcher != NULL);
+
+    size_t he, she, his, hers;
+    assert(string_matcher_add_cstr(matcher, "he", &he) == STRING_SUCCESS);
+    assert(string_matcher_add_cstr(matcher, "she", &she) == STRING_SUCCESS);
+    assert(string_matcher_add_cstr(matcher, "his", &his) == STRING_SUCCESS);
+    assert(string_matcher_add_cstr(matcher, "hers", &hers) == STRING_SUCCESS);
+    assert(he == 0 && she == 1 && his == 2 && hers == 3);
+    assert(string_matcher_pattern_count(matcher) == 4);
+    assert(string_matcher_compile(matcher) == STRING_SUCCESS);
+
+    // Test overlapping matches
+    match_log_t log = {0};
+    assert(string_matcher_scan(matcher, string_view_from_cstr("ushers"), collect_match, &log) == STRING_SUCCESS);
+    assert(log.count == 3);
+    assert(has_match(&log, she, 1));
+    assert(has_match(&log, he, 2));
+    assert(has_match(&log, hers, 2));
+    assert(log.matches[2].pattern_id == hers && log.matches[2].length == 4);
+
+    // Test scanning a string
+    string_t *text = string_create_from_cstr("that one is his");
+    log.count = 0;
+    assert(string_matcher_scan_string(matcher, text, collect_match, &log) == STRING_SUCCESS);
+    assert(log.count == 1 && has_match(&log, his, 12));
+    string_destroy(text);
+
+    // Test early stop
+    log.count = 0;
+    log.limit = 1;
+    assert(string_matcher_scan(matcher, string_view_from_cstr("hehehe"), collect_match, &log) == STRING_SUCCESS);
+    assert(log.count == 1 && log.matches[0].offset == 0);
+
+    // Test binary patterns and duplicates
+    string_matcher_t *binary = string_matcher_create();
+    size_t zero, dup1, dup2;
+    assert(string_matcher_add(binary, "a\0b", 3, &zero) == STRING_SUCCESS);
+    assert(string_matcher_add(binary, "\xff", 1, &dup1) == STRING_SUCCESS);
+    assert(string_matcher_add(binary, "\xff", 1, &dup2) == STRING_SUCCESS);
+    assert(string_matcher_compile(binary) == STRING_SUCCESS);
+
+    log.count = 0;
+    log.limit = 0;
+    const char data[] = "xa\0b\xff";
+    assert(string_matcher_scan(binary, string_view_from_buffer(data, sizeof(data) - 1), collect_match, &log) == STRING_SUCCESS);
+    assert(log.count == 3);
+    assert(has_match(&log, zero, 1));
+    assert(log.matches[1].pattern_id == dup1 && log.matches[2].pattern_id == dup2);
+    string_matcher_destroy(binary);
+
+    string_matcher_destroy(matcher);
+
+    printf("✅ Matcher scanning tests passed\n");
+}
+
+/**
+ * @brief Test function for streaming input
+ * @details Tests matcher functionality including:
+ *          - Matches straddling chunk boundaries
+ *          - Offsets relative to the start of the stream
+ *          - Byte-at-a-time feeding agrees with a one-shot scan
+ */
+void test_matcher_stream(void) {
+    printf("Testing matcher streaming...\n");
+
+    string_matcher_t *matcher = string_matcher_create();
+    assert(string_matcher_add_cstr(matcher, "needle", NULL) == STRING_SUCCESS);
+    assert(string_matcher_add_cstr(matcher, "dle", NULL) == STRING_SUCCESS);
+    assert(string_matcher_compile(matcher) == STRING_SUCCESS);
+
+    // Test a match split across chunks
+    string_matcher_stream_t stream;
+    string_matcher_stream_init(&stream);
+    match_log_t log = {0};
+    assert(string_matcher_feed(matcher, &stream, string_view_from_cstr("hay nee"), collect_match, &log) == STRING_SUCCESS);
+    assert(log.count == 0);
+    assert(string_matcher_feed(matcher, &stream, string_view_from_cstr("dle hay"), collect_match, &log) == STRING_SUCCESS);
+    assert(log.count == 2);
+    assert(has_match(&log, 0, 4));
+    assert(has_match(&log, 1, 7));
+    assert(stream.offset == 14);
+
+    // Test byte-at-a-time feeding
+    const char *text = "needleneedle dle";
+    match_log_t whole = {0};
+    assert(string_matcher_scan(matcher, string_view_from_cstr(text), collect_match, &whole) == STRING_SUCCESS);
+
+    match_log_t pieces = {0};
+    string_matcher_stream_init(&stream);
+    for (size_t i = 0; text[i]; ++i) {
+        assert(string_matcher_feed(matcher, &stream, string_view_from_buffer(text + i, 1), collect_match, &pieces) == STRING_SUCCESS);
+    }
+    assert(whole.count == 5 && pieces.count == whole.count);
+    for (size_t i = 0; i < whole.count; ++i) {
+        assert(pieces.matches[i].pattern_id == whole.matches[i].pattern_id);
+        assert(pieces.matches[i].offset == whole.matches[i].offset);
+    }
+
+    string_matcher_destroy(matcher);
+
+    printf("✅ Matcher streaming tests passed\n");
+}
+
+/**
+ * @brief Test function for matcher error handling
+ * @details Tests that invalid input is rejected without crashing
+ */
+void test_matcher_errors(void) {
+    printf("Testing matcher error handling...\n");
+
+    match_log_t log = {0};
+    string_matcher_t *matcher = string_matcher_create();
+
+    assert(string_matcher_add(NULL, "x", 1, NULL) == STRING_ERROR_NULL_POINTER);
+    assert(string_matcher_add(matcher, NULL, 1, NULL) == STRING_ERROR_NULL_POINTER);
+    assert(string_matcher_add_cstr(matcher, "", NULL) == STRING_ERROR_INVALID_ARGUMENT);
+    assert(string_matcher_add_string(matcher, NULL, NULL) == STRING_ERROR_NULL_POINTER);
+
+    // Test scanning before compilation, and after compilation is discarded
+    assert(string_matcher_scan(matcher, string_view_from_cstr("x"), collect_match, &log) == STRING_ERROR_INVALID_ARGUMENT);
+    assert(string_matcher_add_cstr(matcher, "x", NULL) == STRING_SUCCESS);
+    assert(string_matcher_compile(matcher) == STRING_SUCCESS);
+    assert(string_matcher_add_cstr(matcher, "y", NULL) == STRING_SUCCESS);
+    assert(string_matcher_scan(matcher, string_view_from_cstr("x"), collect_match, &log) == STRING_ERROR_INVALID_ARGUMENT);
+    assert(string_matcher_compile(matcher) == STRING_SUCCESS);
+    assert(string_matcher_scan(matcher, string_view_from_cstr("xy"), NULL, NULL) == STRING_ERROR_NULL_POINTER);
+    assert(string_matcher_scan(matcher, string_view_from_cstr("xy"), collect_match, &log) == STRING_SUCCESS);
+    assert(log.count == 2);
+
+    // Test an empty matcher compiles and never matches
+    string_matcher_t *empty = string_matcher_create();
+    assert(string_matcher_compile(empty) == STRING_SUCCESS);
+    log.count = 0;
+    assert(string_matcher_scan(empty, string_view_from_cstr("anything"), collect_match, &log) == STRING_SUCCESS);
+    assert(log.count == 0);
+    string_matcher_destroy(empty);
+
+    assert(string_matcher_compile(NULL) == STRING_ERROR_NULL_POINTER);
+    assert(string_matcher_pattern_count(NULL) == 0);
+    string_matcher_destroy(matcher);
+    string_matcher_destroy(NULL);
+
+    printf("✅ Matcher error handling tests passed\n");
+}
+
+/**
+ * @brief Main test runner function
+ * @details Executes all matcher test suites
+ * @return int Returns 0 on successful completion of all tests
+ */
+int main(void) {
+    printf("Running strings matcher tests...\n\n");
+
+    test_matcher_scan();
+    test_matcher_stream();
+    test_matcher_errors();
+
+    printf("\n🎉 All matcher tests passed!\n");
+
+    return 0;
+}
@@ -0,0 +1,237 @@
+/**
+ * @file sstring-parallel-test.c
+ * @brief Test suite for the safe strings parallel functions
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * This file contains unit tests for the parallel search and transform
+ * functions, checking every result against the serial functions, including
+ * matches that straddle chunk boundaries and needles that overlap themselves.
+ */
+
+#include <assert.h>
+
+#include "sstring.h"
+#include "sstring_parallel.h"
+
+/** @brief Size of the test haystacks, several chunks long */
+#define TEST_LENGTH (5 * STRING_PAR_MIN_CHUNK + 12345)
+
+/**
+ * @brief Count non-overlapping matches with the serial find
+ * @param view View to search in
+ * @param needle Bytes to count
+ * @return Number of matches, scanning left to right
+ */
+static size_t serial_count(string_view_t view, string_view_t needle) {
+    size_t count = 0;
+    size_t position = string_view_find(view, needle, 0);
+    while (position != STRING_NPOS) {
+        ++count;
+        position = string_view_find(view, needle, position + needle.length);
+    }
+    return count;
+}
+
+/**
+ * @brief Build a large string of one repeated character
+ * @param c Character to fill with
+ * @return Newly created string of TEST_LENGTH bytes
+ */
+static string_t *create_filled(char c) {
+    string_t *str = string_create();
+    assert(str != NULL);
+    assert(string_resize(str, TEST_LENGTH) == STRING_SUCCESS);
+    memset(str->data, c, TEST_LENGTH);
+    return str;
+}
+
+/**
+ * @brief Test function for thread pool management
+ * @details Tests pool functionality including:
+ *          - Explicit and automatic thread counts
+ *          - A single-thread pool and the NULL pool
+ *          - Reusing one pool across many calls
+ */
+void test_parallel_pool(void) {
+    printf("Testing thread pools...\n");
+
+    string_thread_pool_t *pool = string_thread_pool_create(4);
+    assert(pool != NULL);
+    assert(string_thread_pool_size(pool) == 4);
+    assert(string_thread_pool_size(NULL) == 1);
+
+    string_thread_pool_t *automatic = string_thread_pool_create(0);
+    assert(automatic != NULL && string_thread_pool_size(automatic) >= 1);
+
+    string_thread_pool_t *single = string_thread_pool_create(1);
+    assert(single != NULL && string_thread_pool_size(single) == 1);
+
+    // Test the same pool serves many calls
+    string_t *str = create_filled('x');
+    string_view_t view = string_view_from_string(str);
+    for (size_t i = 0; i < 50; ++i) {
+        size_t position = TEST_LENGTH - 1 - i * 4099;
+        str->data[position] = 'y';
+        assert(string_par_find(pool, view, string_view_from_cstr("y"), 0) == position);
+        assert(string_par_find(automatic, view, string_view_from_cstr("y"), 0) == position);
+        assert(string_par_find(single, view, string_view_from_cstr("y"), 0) == position);
+        assert(string_par_find(NULL, view, string_view_from_cstr("y"), 0) == position);
+        str->data[position] = 'x';
+    }
+
+    string_destroy(str);
+    string_thread_pool_destroy(single);
+    string_thread_pool_destroy(automatic);
+    string_thread_pool_destroy(pool);
+    string_thread_pool_destroy(NULL);
+
+    printf("✅ Thread pool tests passed\n");
+}
+
+/**
+ * @brief Test function for parallel find and count
+ * @details Tests search functionality including:
+ *          - Matches straddling every chunk boundary
+ *          - Start positions and missing needles
+ *          - Self-overlapping needles across boundaries
+ *          - Small inputs and empty needles
+ */
+void test_parallel_search(void) {
+    printf("Testing parallel search...\n");
+
+    string_thread_pool_t *pool = string_thread_pool_create(4);
+    string_t *str = create_filled('.');
+    string_view_t view = string_view_from_string(str);
+    string_view_t needle = string_view_from_cstr("needle");
+
+    // Test matches placed across every chunk boundary
+    for (size_t boundary = 1; boundary <= 5; ++boundary) {
+        memcpy(str->data + boundary * STRING_PAR_MIN_CHUNK - 3, "needle", 6);
+    }
+    memcpy(str->data + TEST_LENGTH - 6, "needle", 6);
+    for (size_t start = 0; start < TEST_LENGTH; start += STRING_PAR_MIN_CHUNK / 3) {
+        assert(string_par_find(pool, view, needle, start) == string_view_find(view, needle, start));
+    }
+    assert(string_par_find(pool, view, needle, TEST_LENGTH - 6) == TEST_LENGTH - 6);
+    assert(string_par_find(pool, view, needle, TEST_LENGTH - 5) == STRING_NPOS);
+    assert(string_par_find(pool, view, needle, TEST_LENGTH + 1) == STRING_NPOS);
+    assert(string_par_find(pool, view, string_view_from_cstr("missing"), 0) == STRING_NPOS);
+    assert(string_par_count(pool, view, needle) == 6);
+    assert(string_par_count(pool, view, string_view_from_cstr(".")) == serial_count(view, string_view_from_cstr(".")));
+
+    // Test self-overlapping needles over runs crossing the boundaries
+    string_destroy(str);
+    str = create_filled('a');
+    view = string_view_from_string(str);
+    const char *periodic[] = { "aa", "aaa", "aaaaaaa", "aba", "abab" };
+    for (size_t gap = 0; gap < 4; ++gap) {
+        for (size_t boundary = 1; boundary <= 5; ++boundary) {
+            str->data[boundary * STRING_PAR_MIN_CHUNK + gap * 3 - 2] = 'b';
+        }
+        for (size_t i = 0; i < sizeof(periodic) / sizeof(periodic[0]); ++i) {
+            string_view_t pattern = string_view_from_cstr(periodic[i]);
+            assert(string_par_count(pool, view, pattern) == serial_count(view, pattern));
+            assert(string_par_find(pool, view, pattern, 17) == string_view_find(view, pattern, 17));
+        }
+    }
+
+    // Test the counts match string_replace_all()
+    string_t *copy = string_clone(str);
+    size_t replaced = 0;
+    assert(string_replace_all(copy, string_view_from_cstr("aaa"), string_view_from_cstr("-"), &replaced) == STRING_SUCCESS);
+    assert(string_par_count(pool, view, string_view_from_cstr("aaa")) == replaced);
+    string_destroy(copy);
+
+    // Test small inputs and empty needles
+    string_view_t small = string_view_from_cstr("abcabc");
+    assert(string_par_find(pool, small, string_view_from_cstr("ca"), 0) == 2);
+    assert(string_par_find(pool, small, string_view_from_cstr(""), 3) == string_view_find(small, string_view_from_cstr(""), 3));
+    assert(string_par_count(pool, small, string_view_from_cstr("bc")) == 2);
+    assert(string_par_count(pool, small, string_view_from_cstr("")) == 0);
+    assert(string_par_count(pool, small, string_view_from_cstr("abcabcabc")) == 0);
+
+    string_destroy(str);
+    string_thread_pool_destroy(pool);
+
+    printf("✅ Parallel search tests passed\n");
+}
+
+/**
+ * @brief Test function for parallel transforms
+ * @details Tests transform functionality including:
+ *          - Case conversion matching the serial functions
+ *          - Character replacement across chunks
+ *          - Detaching shared strings and rejecting read-only ones
+ */
+void test_parallel_transform(void) {
+    printf("Testing parallel transforms...\n");
+
+    string_thread_pool_t *pool = string_thread_pool_create(3);
+    string_t *str = string_create();
+    assert(string_reserve_hint(str, TEST_LENGTH) == STRING_SUCCESS);
+    for (size_t i = 0; i < TEST_LENGTH; ++i) {
+        assert(string_append_char(str, (char)(' ' + i % 95)) == STRING_SUCCESS);
+    }
+
+    // Test case conversion matches the serial functions
+    string_t *expected = string_clone(str);
+    assert(string_par_to_upper(pool, str) == STRING_SUCCESS);
+    assert(string_to_upper(expected) == STRING_SUCCESS);
+    assert(string_equals(str, expected));
+    assert(string_par_to_lower(pool, str) == STRING_SUCCESS);
+    assert(string_to_lower(expected) == STRING_SUCCESS);
+    assert(string_equals(str, expected));
+
+    // Test character replacement
+    assert(string_par_replace_char(pool, str, 'a', '#') == STRING_SUCCESS);
+    assert(string_replace_char(expected, 'a', '#') == STRING_SUCCESS);
+    assert(string_equals(str, expected));
+    assert(string_find_char(str, 'a', 0) == STRING_NPOS);
+
+    // Test a shared clone is detached before it is modified
+    assert(string_make_shared(str) == STRING_SUCCESS);
+    string_t *shared = string_clone(str);
+    assert(string_is_shared(shared));
+    assert(string_par_replace_char(pool, shared, '#', 'a') == STRING_SUCCESS);
+    assert(!string_is_shared(shared) && string_find_char(shared, '#', 0) == STRING_NPOS);
+    assert(string_equals(str, expected));
+
+    // Test small strings and invalid input
+    string_t *small = string_create_from_cstr("Hello");
+    assert(string_par_to_upper(pool, small) == STRING_SUCCESS);
+    assert(strcmp(string_cstr(small), "HELLO") == 0);
+    assert(string_par_to_lower(NULL, small) == STRING_SUCCESS);
+    assert(strcmp(string_cstr(small), "hello") == 0);
+    string_t view;
+    assert(string_init_view(&view, string_view_from_cstr("read only")) == STRING_SUCCESS);
+    assert(string_par_to_upper(pool, &view) == STRING_ERROR_READ_ONLY);
+    assert(string_par_to_upper(pool, NULL) == STRING_ERROR_NULL_POINTER);
+    assert(string_par_transform(pool, small, NULL, NULL) == STRING_ERROR_NULL_POINTER);
+
+    string_deinit(&view);
+    string_destroy(small);
+    string_destroy(shared);
+    string_destroy(expected);
+    string_destroy(str);
+    string_thread_pool_destroy(pool);
+
+    printf("✅ Parallel transform tests passed\n");
+}
+
+/**
+ * @brief Main test runner function
+ * @details Executes all string parallel test suites
+ * @return int Returns 0 on successful completion of all tests
+ */
+int main(void) {
+    printf("Running strings parallel tests...\n\n");
+
+    test_parallel_pool();
+    test_parallel_search();
+    test_parallel_transform();
+
+    printf("\n🎉 All parallel tests passed!\n");
+
+    return 0;
+}
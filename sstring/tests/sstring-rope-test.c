@@ -0,0 +1,171 @@
+/**
+ * @file sstring-rope-test.c
+ * @brief Test suite for the safe strings rope
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * This file contains unit tests for the rope, covering insertion and erasure
+ * at arbitrary positions, indexing, chunk iteration and flattening, checked
+ * against the same edits applied to a string_t.
+ */
+
+#include <assert.h>
+
+#include "sstring.h"
+#include "sstring_rope.h"
+
+/** @brief Number of random edits applied by the consistency test */
+#define ROPE_EDITS 20000
+
+/**
+ * @brief Check that a rope and a string hold the same bytes
+ * @param rope Rope to check
+ * @param expected String with the expected content
+ */
+static void assert_same(const string_rope_t *rope, const string_t *expected) {
+    assert(string_rope_length(rope) == string_length(expected));
+
+    size_t cursor = 0;
+    string_view_t chunk;
+    while (string_rope_next_chunk(rope, &cursor, &chunk)) {
+        assert(chunk.length > 0);
+        assert(memcmp(chunk.data, string_cstr(expected) + cursor - chunk.length, chunk.length) == 0);
+    }
+    assert(cursor == string_length(expected));
+}
+
+/**
+ * @brief Test function for rope editing
+ * @details Tests rope functionality including:
+ *          - Insert variants at the front, middle and end
+ *          - Erase within one piece and across pieces
+ *          - Indexing, substrings and flattening
+ */
+void test_rope_editing(void) {
+    printf("Testing rope editing...\n");
+
+    string_rope_t *rope = string_rope_create_from_buffer("Hello World", 11);
+    assert(rope != NULL && string_rope_length(rope) == 11);
+
+    // Test insertion variants
+    assert(string_rope_insert_cstr(rope, 5, ",") == STRING_SUCCESS);
+    assert(string_rope_insert_char(rope, 12, '!') == STRING_SUCCESS);
+    string_t *prefix = string_create_from_cstr(">> ");
+    assert(string_rope_insert_string(rope, 0, prefix) == STRING_SUCCESS);
+    assert(string_rope_append_buffer(rope, "\0end", 4) == STRING_SUCCESS);
+    assert(string_rope_length(rope) == 20);
+    assert(string_rope_at(rope, 0) == '>' && string_rope_at(rope, 8) == ',');
+    assert(string_rope_at(rope, 16) == '\0' && string_rope_at(rope, 19) == 'd');
+    assert(string_rope_at(rope, 20) == '\0');
+
+    // Test erasing across pieces and clamping the count
+    string_t *out = string_create();
+    assert(string_rope_erase(rope, 1, 2) == STRING_SUCCESS);
+    assert(string_rope_erase(rope, 14, 100) == STRING_SUCCESS);
+    assert(string_rope_flatten(rope, out) == STRING_SUCCESS);
+    assert(string_equals_cstr(out, ">Hello, World!"));
+    assert(string_rope_substring(rope, 8, 5, out) == STRING_SUCCESS);
+    assert(string_equals_cstr(out, "World"));
+    assert(string_rope_substring(rope, 14, 5, out) == STRING_SUCCESS);
+    assert(string_length(out) == 0);
+
+    // Test inserting text taken from the rope itself
+    size_t cursor = 8;
+    string_view_t chunk;
+    assert(string_rope_next_chunk(rope, &cursor, &chunk));
+    assert(string_rope_insert_buffer(rope, 0, chunk.data, 5) == STRING_SUCCESS);
+    assert(string_rope_flatten(rope, out) == STRING_SUCCESS);
+    assert(string_equals_cstr(out, "World>Hello, World!"));
+
+    // Test error handling
+    assert(string_rope_insert_cstr(rope, 100, "x") == STRING_ERROR_INVALID_INDEX);
+    assert(string_rope_insert_buffer(rope, 0, NULL, 1) == STRING_ERROR_INVALID_ARGUMENT);
+    assert(string_rope_insert_cstr(NULL, 0, "x") == STRING_ERROR_NULL_POINTER);
+    assert(string_rope_erase(rope, 19, 1) == STRING_ERROR_INVALID_INDEX);
+    assert(string_rope_flatten(rope, NULL) == STRING_ERROR_NULL_POINTER);
+    assert(!string_rope_next_chunk(rope, NULL, &chunk));
+    assert(string_rope_length(NULL) == 0 && string_rope_at(NULL, 0) == '\0');
+    assert(string_rope_create_from_string(NULL) == NULL);
+
+    string_destroy(prefix);
+    string_destroy(out);
+    string_rope_destroy(rope);
+    string_rope_destroy(NULL);
+
+    printf("✅ Rope editing tests passed\n");
+}
+
+/**
+ * @brief Test function for rope consistency
+ * @details Applies the same random inserts and erases to a rope and a string_t
+ *          and checks after every edit that both agree, including typing-style
+ *          runs of single-byte inserts at one position
+ */
+void test_rope_consistency(void) {
+    printf("Testing rope consistency...\n");
+
+    string_rope_t *rope = string_rope_create();
+    string_t *expected = string_create();
+    unsigned seed = 12345;
+    size_t typing_at = 0;
+
+    for (int i = 0; i < ROPE_EDITS; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        size_t length = string_length(expected);
+        unsigned choice = (seed >> 16) % 10;
+
+        if (choice < 4) {
+            // Keep typing at the same place, as an editor would
+            typing_at = typing_at > length ? length : typing_at;
+            char c = (char)('a' + (seed >> 8) % 26);
+            assert(string_rope_insert_char(rope, typing_at, c) == STRING_SUCCESS);
+            assert(string_insert_char(expected, typing_at, c) == STRING_SUCCESS);
+            typing_at++;
+        } else if (choice < 7 || length == 0) {
+            size_t index = length ? (seed >> 4) % (length + 1) : 0;
+            assert(string_rope_insert_cstr(rope, index, "[piece]") == STRING_SUCCESS);
+            assert(string_insert_cstr(expected, index, "[piece]") == STRING_SUCCESS);
+            typing_at = index;
+        } else {
+            size_t index = (seed >> 4) % length;
+            size_t count = (seed >> 20) % 12;
+            assert(string_rope_erase(rope, index, count) == STRING_SUCCESS);
+            assert(string_erase(expected, index, count) == STRING_SUCCESS);
+        }
+
+        if (string_length(expected) > 0) {
+            size_t probe = (seed >> 3) % string_length(expected);
+            assert(string_rope_at(rope, probe) == string_at(expected, probe));
+        }
+        if (i % 1000 == 0) {
+            assert_same(rope, expected);
+        }
+    }
+    assert_same(rope, expected);
+
+    string_t *flat = string_create();
+    assert(string_rope_flatten(rope, flat) == STRING_SUCCESS);
+    assert(string_equals(flat, expected));
+
+    string_destroy(flat);
+    string_destroy(expected);
+    string_rope_destroy(rope);
+
+    printf("✅ Rope consistency tests passed\n");
+}
+
+/**
+ * @brief Main test runner function
+ * @details Executes all rope test suites
+ * @return int Returns 0 on successful completion of all tests
+ */
+int main(void) {
+    printf("Running strings rope tests...\n\n");
+
+    test_rope_editing();
+    test_rope_consistency();
+
+    printf("\n🎉 All rope tests passed!\n");
+
+    return 0;
+}
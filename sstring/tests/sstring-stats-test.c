@@ -0,0 +1,270 @@
+/**
+ * @file sstring-stats-test.c
+ * @brief Test suite for the safe strings instrumentation counters
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * This file contains unit tests for the optional instrumentation layer,
+ * covering the allocation, copy, memmove and search counters, the
+ * capacity-utilization histogram, per-thread snapshots and the timing hook.
+ * Built without STRING_ENABLE_STATS, it checks that everything reads as zero.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "sstring.h"
+#include "sstring_stats.h"
+
+/** @brief Number of operations of each kind reported to the test hook */
+static size_t test_hook_calls[STRING_STATS_OP_FIND + 1];
+
+/** @brief Bytes reported to the test hook for the last call */
+static size_t test_hook_bytes;
+
+/**
+ * @brief Timing hook counting the calls it receives
+ * @param op Operation that completed
+ * @param nanoseconds Time spent in the operation
+ * @param bytes Size of the operation's input
+ * @param context Must point to the test's marker
+ */
+static void test_hook(string_stats_op_t op, uint64_t nanoseconds, size_t bytes, void *context) {
+    (void)nanoseconds;
+    assert(context == test_hook_calls);
+    assert((size_t)op < sizeof(test_hook_calls) / sizeof(test_hook_calls[0]));
+    test_hook_calls[op]++;
+    test_hook_bytes = bytes;
+}
+
+/**
+ * @brief Body of a thread that does some string work
+ * @param argument Unused
+ * @return NULL
+ */
+static void *test_worker(void *argument) {
+    (void)argument;
+    for (int i = 0; i < 10; ++i) {
+        string_t *str = string_create_from_cstr("a thread-local string that lives on the heap");
+        assert(str != NULL);
+        string_destroy(str);
+    }
+
+    // This thread's counters do not include the main thread's work
+    string_stats_t stats;
+    string_stats_snapshot(&stats);
+    assert(stats.allocations == 20);
+    return NULL;
+}
+
+/**
+ * @brief Sum the utilization histogram
+ * @param stats Counters to sum
+ * @return Number of sampled buffers
+ */
+static uint64_t test_utilization_total(const string_stats_t *stats) {
+    uint64_t total = 0;
+    for (size_t i = 0; i < STRING_STATS_UTILIZATION_BUCKETS; ++i) {
+        total += stats->utilization[i];
+    }
+    return total;
+}
+
+/**
+ * @brief Test function for the counters of one thread
+ * @details Tests counting including:
+ *          - Allocations and reallocations of growing strings
+ *          - Bytes copied and memmoves by insert and erase
+ *          - Bytes scanned by searches
+ *          - Utilization histogram of released buffers
+ */
+void test_stats_counters(void) {
+    printf("Testing instrumentation counters...\n");
+
+    string_stats_t stats;
+    string_stats_reset();
+    string_stats_snapshot(&stats);
+    assert(stats.allocations == 0 && stats.bytes_copied == 0 && test_utilization_total(&stats) == 0);
+
+    // Test a heap string: one header and one buffer
+    string_t *str = string_create_from_cstr("instrumented content on the heap");
+    string_stats_snapshot(&stats);
+    assert(stats.allocations == 2);
+    assert(stats.bytes_allocated >= sizeof(string_t) + 33);
+    assert(stats.bytes_copied == 32);
+    assert(stats.reallocations == 0);
+
+    // Test growth goes through reallocate
+    string_t *grown = string_create();
+    for (int i = 0; i < 100; ++i) {
+        assert(string_append_cstr(grown, "0123456789") == STRING_SUCCESS);
+    }
+    string_stats_snapshot(&stats);
+    assert(stats.allocations == 4);
+    assert(stats.reallocations > 0 && stats.reallocations < 20);
+    assert(stats.bytes_copied == 32 + 1000);
+
+    // Test insert and erase count their memmoves
+    string_stats_reset();
+    assert(string_insert_cstr(str, 0, ">> ") == STRING_SUCCESS);
+    assert(string_insert_cstr(str, string_length(str), "!") == STRING_SUCCESS);
+    assert(string_erase(str, 0, 3) == STRING_SUCCESS);
+    string_stats_snapshot(&stats);
+    assert(stats.memmoves == 2);
+    assert(stats.bytes_moved == 32 + 33);
+    assert(stats.bytes_copied == 4);
+    assert(string_equals_cstr(str, "instrumented content on the heap!"));
+
+    // Test searches count the bytes handed to the kernels
+    string_stats_reset();
+    string_view_t view = string_view_from_string(grown);
+    assert(string_view_find(view, string_view_from_cstr("9012"), 10) == 19);
+    assert(string_view_find_char(view, 'x', 0) == STRING_NPOS);
+    string_stats_snapshot(&stats);
+    assert(stats.searches == 2);
+    assert(stats.bytes_scanned == 990 + 1000);
+
+    // Test released heap buffers land in the histogram
+    string_stats_reset();
+    string_stats_sample(str);
+    string_stats_sample(NULL);
+    string_destroy(grown);
+    string_destroy(str);
+    string_t *inline_str = string_create_from_cstr("short");
+    string_destroy(inline_str);
+    string_stats_snapshot(&stats);
+    assert(test_utilization_total(&stats) == 3);
+
+    // Test an exactly full buffer lands in the last bucket
+    string_stats_reset();
+    string_t *full = string_create_with_capacity(64);
+    assert(string_resize(full, 63) == STRING_SUCCESS);
+    string_destroy(full);
+    string_stats_snapshot(&stats);
+    assert(stats.utilization[STRING_STATS_UTILIZATION_BUCKETS - 1] == 1);
+
+    string_stats_snapshot(NULL);
+    string_stats_snapshot_all(NULL);
+
+    printf("✅ Instrumentation counter tests passed\n");
+}
+
+/**
+ * @brief Test function for per-thread and process-wide snapshots
+ * @details Tests snapshots including:
+ *          - Threads counting separately
+ *          - Exited threads still counted by snapshot_all
+ */
+void test_stats_threads(void) {
+    printf("Testing per-thread counters...\n");
+
+    // Reset first: resetting lowers the process-wide sum too
+    string_stats_reset();
+    string_stats_t before;
+    string_stats_snapshot_all(&before);
+
+    pthread_t threads[4];
+    for (size_t i = 0; i < 4; ++i) {
+        assert(pthread_create(&threads[i], NULL, test_worker, NULL) == 0);
+    }
+    for (size_t i = 0; i < 4; ++i) {
+        assert(pthread_join(threads[i], NULL) == 0);
+    }
+
+    string_stats_t mine;
+    string_stats_snapshot(&mine);
+    assert(mine.allocations == 0);
+
+    string_stats_t after;
+    string_stats_snapshot_all(&after);
+    assert(after.allocations - before.allocations >= 80);
+
+    printf("✅ Per-thread counter tests passed\n");
+}
+
+/**
+ * @brief Test function for the timing hook
+ * @details Tests timing including:
+ *          - Each instrumented operation reported once per call
+ *          - Removing the hook stops the reports
+ */
+void test_stats_hook(void) {
+    printf("Testing timing hook...\n");
+
+    string_stats_set_hook(test_hook, test_hook_calls);
+    string_t *str = string_create();
+    assert(string_append_cstr(str, "hello world") == STRING_SUCCESS);
+    assert(test_hook_bytes == (string_stats_enabled() ? 11u : 0u));
+    assert(string_insert_char(str, 5, ',') == STRING_SUCCESS);
+    assert(string_erase(str, 5, 1) == STRING_SUCCESS);
+    assert(string_replace_all_cstr(str, "world", "there") == STRING_SUCCESS);
+    assert(string_append_format(str, " %d", 42) == STRING_SUCCESS);
+    assert(string_view_find(string_view_from_string(str), string_view_from_cstr("42"), 0) == 12);
+    assert(string_equals_cstr(str, "hello there 42"));
+
+    string_stats_set_hook(NULL, NULL);
+    assert(string_append_cstr(str, "!") == STRING_SUCCESS);
+
+    size_t expected = string_stats_enabled() ? 1 : 0;
+    assert(test_hook_calls[STRING_STATS_OP_APPEND] == expected);
+    assert(test_hook_calls[STRING_STATS_OP_INSERT] == expected);
+    assert(test_hook_calls[STRING_STATS_OP_ERASE] == expected);
+    assert(test_hook_calls[STRING_STATS_OP_REPLACE] == expected);
+    assert(test_hook_calls[STRING_STATS_OP_FORMAT] == expected);
+    assert(test_hook_calls[STRING_STATS_OP_FIND] == expected);
+
+    assert(strcmp(string_stats_op_name(STRING_STATS_OP_REPLACE), "replace") == 0);
+    assert(strcmp(string_stats_op_name((string_stats_op_t)99), "unknown") == 0);
+
+    string_destroy(str);
+
+    printf("✅ Timing hook tests passed\n");
+}
+
+/**
+ * @brief Test function for a library built without instrumentation
+ * @details Tests that snapshots read as zero and nothing fails
+ */
+void test_stats_disabled(void) {
+    printf("Testing disabled instrumentation...\n");
+
+    string_t *str = string_create_from_cstr("content that would have been counted");
+    assert(string_insert_cstr(str, 0, "some ") == STRING_SUCCESS);
+    string_stats_sample(str);
+    string_destroy(str);
+
+    string_stats_t stats;
+    memset(&stats, 0xff, sizeof(stats));
+    string_stats_snapshot(&stats);
+    assert(stats.allocations == 0 && stats.memmoves == 0 && test_utilization_total(&stats) == 0);
+    memset(&stats, 0xff, sizeof(stats));
+    string_stats_snapshot_all(&stats);
+    assert(stats.bytes_copied == 0 && stats.bytes_scanned == 0);
+    string_stats_reset();
+
+    printf("✅ Disabled instrumentation tests passed\n");
+}
+
+/**
+ * @brief Main test runner function
+ * @details Executes the test suites matching how the library was built
+ * @return int Returns 0 on successful completion of all tests
+ */
+int main(void) {
+    printf("Running strings stats tests...\n\n");
+
+    if (string_stats_enabled()) {
+        test_stats_counters();
+        test_stats_threads();
+    } else {
+        test_stats_disabled();
+    }
+    test_stats_hook();
+
+    printf("\n🎉 All stats tests passed!\n");
+
+    return 0;
+}
@@ -10,6 +10,7 @@
  */
 
 #include <assert.h>
+#include <math.h>
 
 #include "sstring.h"
 
@@ -56,6 +57,171 @@ void test_string_creation(void) {
     printf("✅ String creation tests passed\n");
 }
 
+/**
+ * @brief Test function for small-string optimization
+ * @details Tests inline storage behavior including:
+ *          - Short strings stored inline
+ *          - Spilling to the heap on growth
+ *          - Moving back inline on shrink
+ */
+void test_string_sso(void) {
+    printf("Testing small-string optimization...\n");
+
+    // Test short string stays inline
+    string_t *str = string_create_from_cstr("key");
+    assert(str != NULL);
+    assert(string_is_inline(str));
+    assert(string_capacity(str) == STRING_SSO_CAPACITY);
+    assert(string_equals_cstr(str, "key"));
+
+    // Test longest inline string
+    assert(string_assign_cstr(str, "0123456789abcdefghijklm") == STRING_SUCCESS);
+    assert(string_length(str) == STRING_SSO_CAPACITY - 1);
+    assert(string_is_inline(str));
+
+    // Test spill to heap on growth
+    assert(string_append_char(str, 'n') == STRING_SUCCESS);
+    assert(!string_is_inline(str));
+    assert(string_equals_cstr(str, "0123456789abcdefghijklmn"));
+
+    // Test shrink moves content back inline
+    assert(string_resize(str, 5) == STRING_SUCCESS);
+    assert(string_shrink_to_fit(str) == STRING_SUCCESS);
+    assert(string_is_inline(str));
+    assert(string_equals_cstr(str, "01234"));
+    string_destroy(str);
+
+    // Test long strings and explicit capacities use the heap
+    string_t *str2 = string_create_from_cstr("This string is too long to be stored inline");
+    assert(!string_is_inline(str2));
+    string_destroy(str2);
+
+    string_t *str3 = string_create_with_capacity(8);
+    assert(string_is_inline(str3));
+    assert(string_capacity(str3) >= 8);
+    string_destroy(str3);
+
+    assert(!string_is_inline(NULL));
+
+    printf("✅ Small-string optimization tests passed\n");
+}
+
+/**
+ * @brief Test function for caller-owned string initialization
+ * @details Tests stack/embedded string functionality including:
+ *          - Initialization without allocation
+ *          - Initialization on a caller-supplied buffer
+ *          - Moving to the heap when the buffer is outgrown
+ *          - Deinitialization and reuse
+ */
+void test_string_init(void) {
+    printf("Testing caller-owned string initialization...\n");
+
+    // Test stack string
+    string_t str;
+    assert(string_init(&str) == STRING_SUCCESS);
+    assert(string_is_empty(&str));
+    assert(string_is_inline(&str));
+    assert(string_append_cstr(&str, "Hello") == STRING_SUCCESS);
+    assert(string_equals_cstr(&str, "Hello"));
+    string_deinit(&str);
+    assert(string_is_empty(&str));
+
+    // Test string on caller-supplied buffer
+    char buffer[8];
+    assert(string_init_with_buffer(&str, buffer, sizeof(buffer)) == STRING_SUCCESS);
+    assert(string_capacity(&str) == sizeof(buffer));
+    assert(string_append_cstr(&str, "1234567") == STRING_SUCCESS);
+    assert(string_cstr(&str) == buffer);
+
+    // Test growth past the buffer moves to the heap
+    assert(string_append_cstr(&str, " and more text that does not fit") == STRING_SUCCESS);
+    assert(string_cstr(&str) != buffer);
+    assert(string_equals_cstr(&str, "1234567 and more text that does not fit"));
+    string_deinit(&str);
+
+    // Test reuse after deinit
+    assert(string_assign_cstr(&str, "reused") == STRING_SUCCESS);
+    assert(string_equals_cstr(&str, "reused"));
+    string_deinit(&str);
+
+    assert(string_init(NULL) == STRING_ERROR_NULL_POINTER);
+    assert(string_init_with_buffer(&str, buffer, 0) == STRING_ERROR_BUFFER_TOO_SMALL);
+    string_deinit(NULL);
+
+    printf("✅ Caller-owned string initialization tests passed\n");
+}
+
+/**
+ * @brief Test function for capacity growth
+ * @details Tests growth functionality including:
+ *          - Doubling and one-and-a-half growth policies
+ *          - Requests larger than the grown capacity allocated exactly
+ *          - Exact pre-sizing with a length hint
+ *          - Overflowing size requests rejected as out of memory
+ */
+void test_string_growth(void) {
+    printf("Testing capacity growth...\n");
+
+    char filler[200];
+    memset(filler, 'x', sizeof(filler));
+    assert(string_get_growth_policy() == STRING_GROWTH_DOUBLE);
+
+    // Test the default policy doubles the capacity
+    string_t str;
+    assert(string_init(&str) == STRING_SUCCESS);
+    assert(string_append_buffer(&str, filler, STRING_SSO_CAPACITY) == STRING_SUCCESS);
+    assert(string_capacity(&str) == 2 * STRING_SSO_CAPACITY);
+    assert(string_append_buffer(&str, filler, 100) == STRING_SUCCESS);
+    assert(string_capacity(&str) == STRING_SSO_CAPACITY + 100 + 1);
+    string_deinit(&str);
+
+    // Test growth by half
+    assert(string_set_growth_policy(STRING_GROWTH_ONE_AND_HALF) == STRING_GROWTH_DOUBLE);
+    assert(string_reserve(&str, 64) == STRING_SUCCESS);
+    assert(string_capacity(&str) == 64);
+    assert(string_append_buffer(&str, filler, 64) == STRING_SUCCESS);
+    assert(string_capacity(&str) == 96);
+    string_deinit(&str);
+
+    // Test the allocator slack is claimed without breaking the content
+    assert(string_set_growth_policy(STRING_GROWTH_USABLE_SIZE) == STRING_GROWTH_ONE_AND_HALF);
+    assert(string_append_buffer(&str, filler, 100) == STRING_SUCCESS);
+    assert(string_capacity(&str) >= 101);
+    size_t capacity = string_capacity(&str);
+    const char *data = string_cstr(&str);
+    assert(string_append_buffer(&str, filler, capacity - 101) == STRING_SUCCESS);
+    assert(string_cstr(&str) == data && string_length(&str) == capacity - 1);
+    string_deinit(&str);
+    assert(string_set_growth_policy((string_growth_t)42) == STRING_GROWTH_USABLE_SIZE);
+    assert(string_get_growth_policy() == STRING_GROWTH_DOUBLE);
+
+    // Test the hint allocates exactly once
+    assert(string_reserve_hint(&str, 1000) == STRING_SUCCESS);
+    assert(string_capacity(&str) == 1001);
+    data = string_cstr(&str);
+    for (size_t i = 0; i < 5; ++i) {
+        assert(string_append_buffer(&str, filler, 200) == STRING_SUCCESS);
+    }
+    assert(string_cstr(&str) == data && string_capacity(&str) == 1001);
+    assert(string_reserve_hint(&str, 10) == STRING_SUCCESS);
+    assert(string_capacity(&str) == 1001);
+    assert(string_append_char(&str, 'y') == STRING_SUCCESS);
+    assert(string_capacity(&str) == 2002);
+
+    // Test sizes that cannot be represented fail instead of wrapping
+    assert(string_resize(&str, SIZE_MAX) == STRING_ERROR_OUT_OF_MEMORY);
+    assert(string_append_buffer(&str, filler, SIZE_MAX - 100) == STRING_ERROR_OUT_OF_MEMORY);
+    assert(string_insert_buffer(&str, 0, filler, SIZE_MAX) == STRING_ERROR_OUT_OF_MEMORY);
+    assert(string_assign_buffer(&str, filler, SIZE_MAX) == STRING_ERROR_OUT_OF_MEMORY);
+    assert(string_reserve_hint(&str, SIZE_MAX) == STRING_ERROR_OUT_OF_MEMORY);
+    assert(string_length(&str) == 1001 && string_capacity(&str) == 2002);
+    assert(string_reserve_hint(NULL, 1) == STRING_ERROR_NULL_POINTER);
+    string_deinit(&str);
+
+    printf("✅ Capacity growth tests passed\n");
+}
+
 /**
  * @brief Test function for string assignment operations
  * @details Tests various string assignment methods including:
@@ -90,12 +256,198 @@ void test_string_assignment(void) {
     printf("✅ String assignment tests passed\n");
 }
 
+/**
+ * @brief Test function for shared copy-on-write strings
+ * @details Tests sharing functionality including:
+ *          - Clones and assignments sharing one buffer
+ *          - Detaching on the first modification of any sharer, but not on a
+ *            replace that finds nothing
+ *          - Clearing and destroying sharers in any order
+ */
+void test_string_shared(void) {
+    printf("Testing shared strings...\n");
+
+    string_t *original = string_create_from_cstr("a response body that is long enough for the heap");
+    assert(!string_is_shared(original) && string_shared_count(original) == 0);
+    assert(string_make_shared(original) == STRING_SUCCESS);
+    assert(string_is_shared(original) && string_shared_count(original) == 1);
+    assert(string_make_shared(original) == STRING_SUCCESS);
+
+    // Test clones and assignment share the buffer
+    string_t *clone = string_clone(original);
+    string_t *assigned = string_create_from_cstr("short");
+    assert(string_assign_string(assigned, clone) == STRING_SUCCESS);
+    assert(string_assign_string(assigned, original) == STRING_SUCCESS);
+    assert(string_cstr(clone) == string_cstr(original) && string_cstr(assigned) == string_cstr(original));
+    assert(string_shared_count(original) == 3);
+    assert(string_equals(clone, original));
+
+    // Test a replace that finds nothing neither detaches nor drops the cached hash
+    size_t replaced = 1;
+    assert(string_hash_cached(clone) == string_hash(original));
+    assert(string_replace_all(clone, string_view_from_cstr("missing"), string_view_from_cstr("found"), &replaced) == STRING_SUCCESS);
+    assert(replaced == 0 && string_is_shared(clone) && clone->has_hash);
+    assert(string_cstr(clone) == string_cstr(original) && string_shared_count(original) == 3);
+
+    // Test the first modification detaches only the modified string
+    assert(string_append_char(clone, '!') == STRING_SUCCESS);
+    assert(!string_is_shared(clone) && string_shared_count(original) == 2);
+    assert(string_equals_cstr(original, "a response body that is long enough for the heap"));
+    assert(string_equals_cstr(clone, "a response body that is long enough for the heap!"));
+    assert(string_set_at(assigned, 0, 'A') == STRING_SUCCESS);
+    assert(string_at(original, 0) == 'a' && string_shared_count(original) == 1);
+
+    // Test clearing a sharer and destroying the owner first
+    string_t *second = string_clone(original);
+    string_t *third = string_clone(second);
+    assert(string_shared_count(third) == 3);
+    assert(string_clear(second) == STRING_SUCCESS);
+    assert(string_length(second) == 0 && string_is_inline(second));
+    string_destroy(original);
+    assert(string_shared_count(third) == 1);
+    assert(string_to_upper(third) == STRING_SUCCESS);
+    assert(string_equals_cstr(third, "A RESPONSE BODY THAT IS LONG ENOUGH FOR THE HEAP"));
+
+    // Test short shared content detaches inline and views stay read-only
+    string_t *tiny = string_create_from_cstr("tag");
+    assert(string_make_shared(tiny) == STRING_SUCCESS);
+    string_t *tiny_clone = string_clone(tiny);
+    assert(string_append_cstr(tiny_clone, "s") == STRING_SUCCESS);
+    assert(string_is_inline(tiny_clone) && string_equals_cstr(tiny_clone, "tags"));
+    string_t view;
+    assert(string_init_view(&view, string_view_from_cstr("fixed")) == STRING_SUCCESS);
+    assert(string_make_shared(&view) == STRING_ERROR_READ_ONLY);
+    assert(string_assign_string(&view, tiny) == STRING_ERROR_READ_ONLY);
+    assert(string_make_shared(NULL) == STRING_ERROR_NULL_POINTER);
+
+    // Test views of a sole-owner shared string survive the detach they trigger
+    const char body[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+    string_t *self = string_create_from_cstr(body);
+    assert(string_make_shared(self) == STRING_SUCCESS);
+    assert(string_assign_view(self, string_substr_view(self, 2, 10)) == STRING_SUCCESS);
+    assert(string_equals_cstr(self, "23456789ab"));
+    assert(string_assign_cstr(self, body) == STRING_SUCCESS && string_make_shared(self) == STRING_SUCCESS);
+    assert(string_assign_buffer(self, string_cstr(self) + 1, 30) == STRING_SUCCESS);
+    assert(string_equals_buffer(self, body + 1, 30));
+    assert(string_assign_cstr(self, body) == STRING_SUCCESS && string_make_shared(self) == STRING_SUCCESS);
+    assert(string_replace_all(self, string_substr_view(self, 0, 2), string_substr_view(self, 4, 30), NULL) == STRING_SUCCESS);
+    assert(string_equals_cstr(self, "456789abcdefghijklmnopqrstuvwx"
+                                    "23456789abcdefghijklmnopqrstuvwxyz"));
+    assert(string_assign_cstr(self, body) == STRING_SUCCESS && string_make_shared(self) == STRING_SUCCESS);
+    replaced = 0;
+    assert(string_replace_first(self, string_substr_view(self, 10, 3), string_substr_view(self, 0, 1), &replaced) == STRING_SUCCESS);
+    assert(replaced == 1 && string_equals_cstr(self, "01234567890defghijklmnopqrstuvwxyz"));
+    string_destroy(self);
+
+    string_destroy(clone);
+    string_destroy(assigned);
+    string_destroy(second);
+    string_destroy(third);
+    string_destroy(tiny);
+    string_destroy(tiny_clone);
+
+    printf("✅ Shared string tests passed\n");
+}
+
+/**
+ * @brief Test function for ownership transfer
+ * @details Tests ownership transfer functionality including:
+ *          - Adopting a caller buffer without copying
+ *          - Releasing heap data, and copies of inline or shared data
+ *          - Swapping and moving inline and heap content
+ *          - Refusing to exchange heap data across allocators
+ */
+void test_string_ownership(void) {
+    printf("Testing ownership transfer...\n");
+
+    // Test adoption keeps the caller's buffer
+    char *buffer = malloc(4096);
+    assert(buffer != NULL);
+    memcpy(buffer, "payload", 7);
+    string_t *adopted = string_adopt(buffer, 7, 4096);
+    assert(adopted != NULL);
+    assert(string_cstr(adopted) == buffer && string_capacity(adopted) == 4096);
+    assert(string_equals_cstr(adopted, "payload"));
+    assert(string_append_cstr(adopted, " received") == STRING_SUCCESS);
+    assert(string_cstr(adopted) == buffer);
+    assert(string_adopt(buffer, 4096, 4096) == NULL);
+    assert(string_adopt(NULL, 0, 1) == NULL);
+
+    // Test release hands heap data back and empties the string
+    size_t length = 0;
+    size_t capacity = 0;
+    char *released = string_release(adopted, &length, &capacity);
+    assert(released == buffer && length == 16 && capacity == 4096);
+    assert(strcmp(released, "payload received") == 0);
+    assert(string_length(adopted) == 0 && string_is_inline(adopted));
+    assert(string_append_cstr(adopted, "reused") == STRING_SUCCESS);
+    free(released);
+
+    // Test release copies inline and shared content
+    released = string_release(adopted, &length, NULL);
+    assert(released != NULL && length == 6 && strcmp(released, "reused") == 0);
+    free(released);
+    string_t *shared = string_create_from_cstr("a shared configuration blob stored on the heap");
+    string_t *sharer = string_clone(shared);
+    assert(string_make_shared(shared) == STRING_SUCCESS);
+    string_assign_string(sharer, shared);
+    released = string_release(sharer, NULL, NULL);
+    assert(strcmp(released, string_cstr(shared)) == 0 && string_shared_count(shared) == 1);
+    free(released);
+
+    // Test swap of inline and heap content
+    string_t *small = string_create_from_cstr("small");
+    string_t *large = string_create_from_cstr("a string that does not fit the inline buffer");
+    const char *large_data = string_cstr(large);
+    assert(string_swap(small, large) == STRING_SUCCESS);
+    assert(string_cstr(small) == large_data && string_is_inline(large));
+    assert(string_equals_cstr(large, "small"));
+    assert(string_equals_cstr(small, "a string that does not fit the inline buffer"));
+    assert(string_swap(small, small) == STRING_SUCCESS);
+
+    // Test move leaves the source empty
+    assert(string_move(large, small) == STRING_SUCCESS);
+    assert(string_cstr(large) == large_data && string_length(small) == 0);
+    assert(string_append_cstr(small, "still usable") == STRING_SUCCESS);
+    assert(string_move(large, small) == STRING_SUCCESS);
+    assert(string_equals_cstr(large, "still usable") && string_is_inline(large));
+
+    // Test heap data never crosses allocators
+    string_allocator_t other = *string_default_allocator();
+    string_t local;
+    assert(string_init_with_allocator(&local, &other) == STRING_SUCCESS);
+    assert(string_swap(&local, small) == STRING_SUCCESS);
+    assert(string_assign_cstr(small, "grown beyond the inline buffer to the heap") == STRING_SUCCESS);
+    assert(string_swap(&local, small) == STRING_ERROR_INVALID_ARGUMENT);
+    assert(string_move(&local, small) == STRING_ERROR_INVALID_ARGUMENT);
+    string_deinit(&local);
+
+    // Test invalid input
+    string_t view;
+    assert(string_init_view(&view, string_view_from_cstr("fixed")) == STRING_SUCCESS);
+    assert(string_swap(&view, small) == STRING_ERROR_READ_ONLY);
+    assert(string_move(small, &view) == STRING_ERROR_READ_ONLY);
+    assert(string_release(&view, NULL, NULL) == NULL);
+    assert(string_swap(NULL, small) == STRING_ERROR_NULL_POINTER);
+    assert(string_move(small, NULL) == STRING_ERROR_NULL_POINTER);
+    assert(string_release(NULL, NULL, NULL) == NULL);
+
+    string_destroy(adopted);
+    string_destroy(shared);
+    string_destroy(sharer);
+    string_destroy(small);
+    string_destroy(large);
+
+    printf("✅ Ownership transfer tests passed\n");
+}
+
 /**
  * @brief Test function for string concatenation operations
  * @details Tests various string concatenation methods including:
  *          - C string append
  *          - Character append
  *          - String-to-string append
+ *          - Bulk concatenation, join and gather append
  */
 void test_string_concatenation(void) {
     printf("Testing string concatenation...\n");
@@ -115,8 +467,37 @@ void test_string_concatenation(void) {
     assert(string_append_string(str, str2) == STRING_SUCCESS);
     assert(string_equals_cstr(str, "Hello, World!"));
 
+    // Test bulk concatenation and join, including the destination itself
+    string_t *parts = string_create_from_cstr("ab");
+    const string_t *pieces[] = {str2, NULL, parts, str2};
+    assert(string_concat_many(str, pieces, 4) == STRING_SUCCESS);
+    assert(string_equals_cstr(str, "Hello, World!orld!aborld!"));
+    string_clear(str);
+    assert(string_join(str, pieces, 4, string_view_from_cstr(", ")) == STRING_SUCCESS);
+    assert(string_equals_cstr(str, "orld!, , ab, orld!"));
+    const string_t *self[] = {parts, parts, parts};
+    assert(string_join(parts, self, 3, string_view_from_cstr("-")) == STRING_SUCCESS);
+    assert(string_equals_cstr(parts, "abab-ab-ab"));
+
+    // Test gather append with views into the destination
+    string_clear(str);
+    assert(string_append_cstr(str, "0123456789") == STRING_SUCCESS);
+    string_view_t views[] = {string_view_substr(string_view_from_string(str), 2, 3), string_view_from_cstr(" and a longer tail "),
+                             string_view_from_buffer("x\0y", 3)};
+    assert(string_append_views(str, views, 3) == STRING_SUCCESS);
+    assert(string_length(str) == 10 + 3 + 19 + 3);
+    assert(memcmp(string_cstr(str), "0123456789234 and a longer tail x\0y", 35) == 0);
+    string_clear(str);
+    assert(string_join_views(str, views + 1, 1, string_view_from_cstr("|")) == STRING_SUCCESS);
+    assert(string_equals_cstr(str, " and a longer tail "));
+    assert(string_join_views(str, NULL, 0, string_view_from_cstr("|")) == STRING_SUCCESS);
+    assert(string_equals_cstr(str, " and a longer tail "));
+    assert(string_append_views(NULL, views, 3) == STRING_ERROR_NULL_POINTER);
+    assert(string_append_views(str, NULL, 3) == STRING_ERROR_NULL_POINTER);
+
     string_destroy(str);
     string_destroy(str2);
+    string_destroy(parts);
 
     printf("✅ String concatenation tests passed\n");
 }
@@ -126,6 +507,7 @@ void test_string_concatenation(void) {
  * @details Tests string insertion functionality including:
  *          - Character insertion at specific position
  *          - C string insertion at specific position
+ *          - Insertion from a view of the destination itself
  */
 void test_string_insertion(void) {
     printf("Testing string insertion...\n");
@@ -140,6 +522,19 @@ void test_string_insertion(void) {
     assert(string_insert_cstr(str, 7, "Beautiful ") == STRING_SUCCESS);
     assert(string_equals_cstr(str, "Hello, Beautiful World!"));
 
+    // Test insertion from a view of the string itself
+    const char *body = "0123456789abcdefghijklmnopqrstuvwxyz";
+    assert(string_assign_cstr(str, body) == STRING_SUCCESS);
+    assert(string_insert_buffer(str, 3, string_cstr(str) + 5, 20) == STRING_SUCCESS);
+    assert(string_equals_cstr(str, "012" "56789abcdefghijklmno" "3456789abcdefghijklmnopqrstuvwxyz"));
+    assert(string_assign_cstr(str, body) == STRING_SUCCESS);
+    string_view_t straddling = string_substr_view(str, 5, 10);
+    assert(string_insert_buffer(str, 10, straddling.data, straddling.length) == STRING_SUCCESS);
+    assert(string_equals_cstr(str, "0123456789" "56789abcde" "abcdefghijklmnopqrstuvwxyz"));
+    assert(string_assign_cstr(str, body) == STRING_SUCCESS && string_make_shared(str) == STRING_SUCCESS);
+    assert(string_insert_buffer(str, 0, string_cstr(str) + 30, 6) == STRING_SUCCESS);
+    assert(string_equals_cstr(str, "uvwxyz" "0123456789abcdefghijklmnopqrstuvwxyz"));
+
     string_destroy(str);
 
     printf("✅ String insertion tests passed\n");
@@ -199,12 +594,164 @@ void test_string_searching(void) {
     printf("✅ String searching tests passed\n");
 }
 
+/**
+ * @brief Test function for vectorized character searching
+ * @details Tests the SIMD search kernels including:
+ *          - Character set search forward and backward
+ *          - Agreement of every kernel level with the scalar loops
+ *          - Matches in vector bodies and scalar tails
+ */
+void test_string_simd_searching(void) {
+    printf("Testing vectorized character searching...\n");
+
+    string_t *str = string_create_from_cstr("name,age;city\tzip");
+    assert(string_find_first_of(str, ",;\t", 0) == 4);
+    assert(string_find_first_of(str, ",;\t", 5) == 8);
+    assert(string_find_last_of(str, ",;\t", STRING_NPOS) == 13);
+    assert(string_find_last_of(str, ",;\t", 12) == 8);
+    assert(string_find_first_of(str, "#", 0) == STRING_NPOS);
+    assert(string_find_first_of(str, "", 0) == STRING_NPOS);
+    assert(string_find_first_of(NULL, ",", 0) == STRING_NPOS);
+
+    // Build a large haystack with matches at known positions
+    string_t *big = string_create();
+    for (size_t i = 0; i < 1000; ++i) {
+        assert(string_append_char(big, (char)('a' + (i % 23))) == STRING_SUCCESS);
+    }
+    assert(string_set_at(big, 517, '|') == STRING_SUCCESS);
+    assert(string_set_at(big, 998, '|') == STRING_SUCCESS);
+
+    string_simd_t best = string_get_simd_level();
+    const string_simd_t levels[] = {STRING_SIMD_NONE, STRING_SIMD_SSE2, best};
+    for (size_t l = 0; l < sizeof(levels) / sizeof(levels[0]); ++l) {
+        string_set_simd_level(levels[l]);
+
+        assert(string_find_char(big, '|', 0) == 517);
+        assert(string_find_char(big, '|', 518) == 998);
+        assert(string_find_char(big, '#', 0) == STRING_NPOS);
+        assert(string_rfind_char(big, '|', STRING_NPOS) == 998);
+        assert(string_rfind_char(big, '|', 997) == 517);
+        assert(string_rfind_char(big, 'a', STRING_NPOS) == 989);
+        assert(string_find_first_of(big, "|#~", 3) == 517);
+        assert(string_find_last_of(big, "|#~", 900) == 517);
+        assert(string_find_first_of(big, "!\"#$%&'()*+-./:<>=?@[]^_{}", 0) == STRING_NPOS);
+
+        // Every offset and tail length must agree with a plain scan
+        for (size_t start = 0; start < 70; ++start) {
+            size_t expected = STRING_NPOS;
+            for (size_t i = start; i < string_length(big); ++i) {
+                if (string_at(big, i) == 'w') {
+                    expected = i;
+                    break;
+                }
+            }
+            assert(string_find_char(big, 'w', start) == expected);
+        }
+    }
+    string_set_simd_level(best);
+    assert(string_get_simd_level() == best);
+
+    string_destroy(big);
+    string_destroy(str);
+
+    printf("✅ Vectorized character searching tests passed\n");
+}
+
+/**
+ * @brief Reference substring search used to validate the search engine
+ */
+static size_t naive_find(const char *haystack, size_t length, const char *needle, size_t needle_length, size_t start) {
+    for (size_t i = start; i + needle_length <= length; ++i) {
+        if (memcmp(haystack + i, needle, needle_length) == 0) {
+            return i;
+        }
+    }
+    return STRING_NPOS;
+}
+
+/**
+ * @brief Test function for the substring search engine
+ * @details Tests substring search functionality including:
+ *          - Needles with embedded null bytes
+ *          - Repetitive data with short, long and periodic needles
+ *          - Agreement of every kernel level with a reference search
+ *          - Precompiled Boyer-Moore-Horspool needles
+ */
+void test_string_substring_search(void) {
+    printf("Testing substring search engine...\n");
+
+    // Test length-aware search with embedded null bytes
+    string_t *bin = string_create_from_buffer("ab\0cd\0ef", 8);
+    string_t *pat = string_create_from_buffer("\0ef", 3);
+    assert(string_find_string(bin, pat, 0) == 5);
+    assert(string_find_buffer(bin, "d\0e", 3, 0) == 4);
+    assert(string_find_buffer(bin, "d\0x", 3, 0) == STRING_NPOS);
+    string_destroy(pat);
+    string_destroy(bin);
+
+    // Build repetitive log-like data with a single real match near the end
+    string_t *log = string_create();
+    for (int i = 0; i < 400; ++i) {
+        assert(string_append_cstr(log, "aaaaaaaaab") == STRING_SUCCESS);
+    }
+    assert(string_append_cstr(log, "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaac") == STRING_SUCCESS);
+    const char *data = string_cstr(log);
+    size_t length = string_length(log);
+
+    const char *needles[] = {
+        "ab",
+        "aab",
+        "baaaaaaaaab",
+        "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaac",
+        "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaac",
+        "abaaaaaaaaabaaaaaaaaabaaaaaaaaabaaaaaaaaab",
+        "bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb",
+        "c",
+    };
+
+    string_simd_t best = string_get_simd_level();
+    const string_simd_t levels[] = {STRING_SIMD_NONE, STRING_SIMD_SSE2, best};
+    for (size_t l = 0; l < sizeof(levels) / sizeof(levels[0]); ++l) {
+        string_set_simd_level(levels[l]);
+        for (size_t n = 0; n < sizeof(needles) / sizeof(needles[0]); ++n) {
+            size_t needle_length = strlen(needles[n]);
+            for (size_t start = 0; start < 40; start += 7) {
+                size_t expected = naive_find(data, length, needles[n], needle_length, start);
+                assert(string_find_cstr(log, needles[n], start) == expected);
+            }
+        }
+    }
+    string_set_simd_level(best);
+
+    // Test precompiled needles agree with the one-off engine
+    for (size_t n = 0; n < sizeof(needles) / sizeof(needles[0]); ++n) {
+        string_needle_t *needle = string_needle_create_from_cstr(needles[n]);
+        assert(needle != NULL);
+        size_t pos = string_find_needle(log, needle, 0);
+        assert(pos == string_find_cstr(log, needles[n], 0));
+        if (pos != STRING_NPOS) {
+            assert(string_find_needle(log, needle, pos + 1) == string_find_cstr(log, needles[n], pos + 1));
+        }
+        string_needle_destroy(needle);
+    }
+
+    string_needle_t *binary_needle = string_needle_create("\0x", 2);
+    assert(string_needle_find(binary_needle, string_view_from_buffer("ab\0x\0x", 6), 3) == 4);
+    string_needle_destroy(binary_needle);
+    string_needle_destroy(NULL);
+
+    string_destroy(log);
+
+    printf("✅ Substring search engine tests passed\n");
+}
+
 /**
  * @brief Test function for string utility operations
  * @details Tests string utility functionality including:
  *          - Case conversion (upper/lower)
  *          - String trimming
  *          - Character replacement
+ *          - Substring replacement, shrinking and growing
  */
 void test_string_utility(void) {
     printf("Testing string utility functions...\n");
@@ -226,16 +773,233 @@ void test_string_utility(void) {
     assert(string_replace_char(str, 'o', '0') == STRING_SUCCESS);
     assert(string_equals_cstr(str, "Hell0, W0rld!"));
 
+    // Test substring replacement in place and with growth
+    size_t count;
+    assert(string_replace_all(str, string_view_from_cstr("0"), string_view_from_cstr(""), &count) == STRING_SUCCESS);
+    assert(count == 2 && string_equals_cstr(str, "Hell, Wrld!"));
+    assert(string_replace_all_cstr(str, "l", "{{l}}") == STRING_SUCCESS);
+    assert(string_equals_cstr(str, "He{{l}}{{l}}, Wr{{l}}d!"));
+    assert(string_replace_first(str, string_view_from_cstr("{{l}}"), string_view_from_cstr("L"), &count) == STRING_SUCCESS);
+    assert(count == 1 && string_equals_cstr(str, "HeL{{l}}, Wr{{l}}d!"));
+    assert(string_replace_all(str, string_view_from_cstr("aaa"), string_view_from_cstr("b"), &count) == STRING_SUCCESS);
+    assert(count == 0 && string_equals_cstr(str, "HeL{{l}}, Wr{{l}}d!"));
+    assert(string_replace_all_cstr(str, "{{l}}", string_cstr(str)) == STRING_SUCCESS);
+    assert(string_equals_cstr(str, "HeLHeL{{l}}, Wr{{l}}d!, WrHeL{{l}}, Wr{{l}}d!d!"));
+    assert(string_replace_all(str, string_view_from_cstr(""), string_view_from_cstr("x"), NULL) == STRING_ERROR_INVALID_ARGUMENT);
+    assert(string_replace_all_cstr(NULL, "a", "b") == STRING_ERROR_NULL_POINTER);
+
     string_destroy(str);
 
     printf("✅ String utility tests passed\n");
 }
 
+/**
+ * @brief Test function for character classes, trimming and whitespace collapse
+ * @details Tests class functionality including:
+ *          - Class scans against a plain scan at every SIMD level
+ *          - Custom classes with bytes above 0x7F
+ *          - Trimming both ends, one end and custom classes, including empty strings
+ *          - Collapsing whitespace runs and trimming views without copying
+ */
+void test_string_trimming(void) {
+    printf("Testing character classes and trimming...\n");
+
+    // Test predefined and custom classes byte by byte
+    string_char_class_t custom;
+    string_char_class_init(&custom, string_view_from_buffer("x\0\xFF", 3));
+    string_char_class_add_range(&custom, 0x80, 0x8F);
+    for (unsigned c = 0; c < 256; ++c) {
+        assert(string_char_class_contains(&string_class_space, (char)c) == (isspace((int)c) != 0 && c < 0x80));
+        assert(string_char_class_contains(&string_class_digit, (char)c) == (c >= '0' && c <= '9'));
+        assert(string_char_class_contains(&custom, (char)c) == (c == 'x' || c == 0 || c == 0xFF || (c >= 0x80 && c <= 0x8F)));
+    }
+
+    // Test scans against a plain scan over every byte value and alignment
+    char bytes[300];
+    for (size_t i = 0; i < sizeof(bytes); ++i) {
+        bytes[i] = (char)((i * 37 + 11) % 256);
+    }
+    string_view_t view = string_view_from_buffer(bytes, sizeof(bytes));
+    string_simd_t best = string_get_simd_level();
+    const string_simd_t levels[] = {STRING_SIMD_NONE, STRING_SIMD_SSE2, best};
+    const string_char_class_t *classes[] = {&string_class_space, &string_class_digit, &custom};
+    for (size_t l = 0; l < sizeof(levels) / sizeof(levels[0]); ++l) {
+        string_set_simd_level(levels[l]);
+        for (size_t k = 0; k < sizeof(classes) / sizeof(classes[0]); ++k) {
+            for (size_t start = 0; start < 80; ++start) {
+                size_t first = STRING_NPOS, first_not = STRING_NPOS, last = STRING_NPOS, last_not = STRING_NPOS;
+                for (size_t i = start; i < view.length && (first == STRING_NPOS || first_not == STRING_NPOS); ++i) {
+                    bool member = string_char_class_contains(classes[k], bytes[i]);
+                    first = member && first == STRING_NPOS ? i : first;
+                    first_not = !member && first_not == STRING_NPOS ? i : first_not;
+                }
+                size_t end = view.length - start;
+                for (size_t i = end; i > 0 && (last == STRING_NPOS || last_not == STRING_NPOS); --i) {
+                    bool member = string_char_class_contains(classes[k], bytes[i - 1]);
+                    last = member && last == STRING_NPOS ? i - 1 : last;
+                    last_not = !member && last_not == STRING_NPOS ? i - 1 : last_not;
+                }
+                assert(string_view_find_class(view, classes[k], start) == first);
+                assert(string_view_find_not_class(view, classes[k], start) == first_not);
+                assert(string_view_rfind_class(view, classes[k], end - 1) == last);
+                assert(string_view_rfind_not_class(view, classes[k], end - 1) == last_not);
+            }
+        }
+
+        // Test trimming long whitespace runs
+        string_t *padded = string_create();
+        assert(string_append_cstr(padded, "\t\n\v\f\r                                   ") == STRING_SUCCESS);
+        assert(string_append_cstr(padded, "core") == STRING_SUCCESS);
+        assert(string_append_cstr(padded, "                                       \r\n") == STRING_SUCCESS);
+        assert(string_rtrim(padded) == STRING_SUCCESS);
+        assert(string_length(padded) == 44 && string_cstr(padded)[40] == 'c');
+        assert(string_ltrim(padded) == STRING_SUCCESS);
+        assert(string_equals_cstr(padded, "core"));
+        string_destroy(padded);
+    }
+    string_set_simd_level(best);
+
+    // Test trimming whole, empty and all-whitespace strings
+    string_t *str = string_create_from_cstr("  \t Hello,  World! \n ");
+    assert(string_trim(str) == STRING_SUCCESS);
+    assert(string_equals_cstr(str, "Hello,  World!"));
+    assert(string_assign_cstr(str, "") == STRING_SUCCESS);
+    assert(string_trim(str) == STRING_SUCCESS && string_length(str) == 0);
+    assert(string_ltrim(str) == STRING_SUCCESS && string_rtrim(str) == STRING_SUCCESS);
+    assert(string_assign_cstr(str, " \n\t ") == STRING_SUCCESS);
+    assert(string_trim(str) == STRING_SUCCESS && string_length(str) == 0);
+    assert(string_assign_cstr(str, "007800") == STRING_SUCCESS);
+    assert(string_trim_class(str, &string_class_digit) == STRING_SUCCESS && string_length(str) == 0);
+    assert(string_assign_cstr(str, "xx-x-xx") == STRING_SUCCESS);
+    assert(string_trim_class(str, &custom) == STRING_SUCCESS && string_equals_cstr(str, "-x-"));
+
+    // Test collapsing whitespace
+    assert(string_assign_cstr(str, "  one \t two\n\n\nthree four   ") == STRING_SUCCESS);
+    assert(string_collapse_whitespace(str) == STRING_SUCCESS);
+    assert(string_equals_cstr(str, "one two three four"));
+    assert(string_collapse_whitespace(str) == STRING_SUCCESS);
+    assert(string_equals_cstr(str, "one two three four"));
+    assert(string_assign_cstr(str, " \t ") == STRING_SUCCESS);
+    assert(string_collapse_whitespace(str) == STRING_SUCCESS && string_length(str) == 0);
+
+    // Test view trimming moves nothing
+    const char *text = "\r\n  padded  \t";
+    string_view_t trimmed = string_view_trim(string_view_from_cstr(text));
+    assert(trimmed.data == text + 4 && trimmed.length == 6);
+    assert(string_view_trim(string_view_from_cstr(" \t")).length == 0);
+    assert(string_view_trim(string_view_from_cstr("")).length == 0);
+    assert(string_view_trim_class(string_view_from_cstr("12ab34"), &string_class_digit).length == 2);
+
+    // Test invalid input
+    string_t view_string;
+    assert(string_init_view(&view_string, string_view_from_cstr(" read only ")) == STRING_SUCCESS);
+    assert(string_trim(&view_string) == STRING_ERROR_READ_ONLY);
+    assert(string_trim(NULL) == STRING_ERROR_NULL_POINTER);
+    assert(string_trim_class(str, NULL) == STRING_ERROR_NULL_POINTER);
+    assert(string_collapse_whitespace(NULL) == STRING_ERROR_NULL_POINTER);
+    assert(string_view_find_class(string_view_from_cstr("a b"), NULL, 0) == STRING_NPOS);
+
+    string_deinit(&view_string);
+    string_destroy(str);
+
+    printf("✅ Character class and trimming tests passed\n");
+}
+
+/**
+ * @brief Test function for case conversion and case-insensitive operations
+ * @details Tests case functionality including:
+ *          - Vectorized ASCII conversion on long strings at every SIMD level
+ *          - Locale-aware conversion
+ *          - Case-insensitive compare, equality and search
+ */
+void test_string_case(void) {
+    printf("Testing case-insensitive operations...\n");
+
+    static const char mixed[] = "Content-Type: TEXT/html; Charset=UTF-8 \xc9t\xe9 [@`{]";
+    static const char upper[] = "CONTENT-TYPE: TEXT/HTML; CHARSET=UTF-8 \xc9T\xe9 [@`{]";
+    static const char lower[] = "content-type: text/html; charset=utf-8 \xc9t\xe9 [@`{]";
+    string_simd_t original = string_get_simd_level();
+
+    for (int level = STRING_SIMD_NONE; level <= STRING_SIMD_NEON; ++level) {
+        if (string_set_simd_level((string_simd_t)level) != (string_simd_t)level) {
+            continue;
+        }
+
+        // Test ASCII conversion leaves non-ASCII bytes alone
+        string_t *str = string_create_from_cstr(mixed);
+        assert(string_to_upper(str) == STRING_SUCCESS);
+        assert(string_equals_cstr(str, upper));
+        assert(string_to_lower(str) == STRING_SUCCESS);
+        assert(string_equals_cstr(str, lower));
+
+        // Test case-insensitive compare and equality
+        string_t *other = string_create_from_cstr(mixed);
+        assert(string_equals_icase(str, other));
+        assert(string_compare_icase(str, other) == 0);
+        assert(!string_equals(str, other));
+        assert(string_append_char(other, '!') == STRING_SUCCESS);
+        assert(string_compare_icase(str, other) < 0);
+        assert(string_compare_icase(other, str) > 0);
+        assert(!string_equals_icase(str, other));
+        assert(string_view_compare_icase(string_view_from_cstr("apple"), string_view_from_cstr("BANANA")) < 0);
+        assert(string_view_compare_icase(string_view_from_cstr("_"), string_view_from_cstr("a")) < 0);
+        assert(string_view_equals_icase(string_view_from_cstr("\xc9"), string_view_from_cstr("\xc9")));
+        assert(!string_view_equals_icase(string_view_from_cstr("\xc9"), string_view_from_cstr("\xe9")));
+
+        // Test case-insensitive search, short and long needles
+        assert(string_find_icase(other, "CHARSET", 0) == 25);
+        assert(string_find_icase(other, "content", 1) == STRING_NPOS);
+        assert(string_find_icase(other, "t", 4) == 6);
+        assert(string_find_icase(other, "", 3) == 3);
+        assert(string_find_icase(other, "text/HTML; charset=utf-8 \xc9T\xe9 [@`{]!", 0) == 14);
+        assert(string_find_icase(other, "text/HTML; charset=utf-8 \xe9", 0) == STRING_NPOS);
+        assert(string_view_find_icase(string_view_from_cstr("xxABAB"), string_view_from_cstr("abab"), 0) == 2);
+
+        string_destroy(other);
+        string_destroy(str);
+    }
+    string_set_simd_level(original);
+
+    // Test locale-aware conversion in the default "C" locale
+    string_t *str = string_create_from_cstr("MiXeD 123");
+    assert(string_to_upper_locale(str) == STRING_SUCCESS);
+    assert(string_equals_cstr(str, "MIXED 123"));
+    assert(string_to_lower_locale(str) == STRING_SUCCESS);
+    assert(string_equals_cstr(str, "mixed 123"));
+    string_destroy(str);
+
+    // Test NULL handling
+    assert(string_compare_icase(NULL, NULL) == 0);
+    assert(string_equals_icase(NULL, NULL));
+    assert(string_find_icase(NULL, "a", 0) == STRING_NPOS);
+    assert(string_to_upper_locale(NULL) == STRING_ERROR_NULL_POINTER);
+
+    printf("✅ Case-insensitive operation tests passed\n");
+}
+
+/**
+ * @brief Variadic wrapper used to exercise the va_list formatting API
+ * @param str Destination string
+ * @param format Printf-style format string
+ * @param ... Variable arguments for format string
+ * @return string_result_t Result of string_append_vformat()
+ */
+static string_result_t append_log_line(string_t *str, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    string_result_t result = string_append_vformat(str, format, args);
+    va_end(args);
+
+    return result;
+}
+
 /**
  * @brief Test function for string formatting operations
  * @details Tests string formatting functionality including:
  *          - String format with printf-style formatting
  *          - String append format operation
+ *          - Growth when the output does not fit the spare capacity
+ *          - The va_list variants
  */
 void test_string_formatting(void) {
     printf("Testing string formatting...\n");
@@ -252,9 +1016,455 @@ void test_string_formatting(void) {
 
     string_destroy(str);
 
+    // Test output that does not fit the inline buffer
+    string_t *small = string_create_from_cstr("ab");
+    assert(string_is_inline(small));
+    assert(string_append_format(small, "%s-%040d", "cd", 7) == STRING_SUCCESS);
+    assert(string_length(small) == 2 + 3 + 40);
+    assert(string_find_cstr(small, "abcd-0000", 0) == 0);
+    assert(string_cstr(small)[string_length(small) - 1] == '7');
+    assert(string_format(small, "%d", 5) == STRING_SUCCESS);
+    assert(string_equals_cstr(small, "5"));
+
+    // Test va_list variants
+    assert(append_log_line(small, " [%s] %u", "INFO", 12u) == STRING_SUCCESS);
+    assert(string_equals_cstr(small, "5 [INFO] 12"));
+    for (int i = 0; i < 100; ++i) {
+        assert(append_log_line(small, "%d,", i) == STRING_SUCCESS);
+    }
+    assert(string_find_cstr(small, "98,99,", 0) == string_length(small) - 6);
+    string_destroy(small);
+
+    // Test errors
+    string_t view;
+    assert(string_init_view(&view, string_view_from_cstr("borrowed")) == STRING_SUCCESS);
+    assert(string_append_format(&view, "%d", 1) == STRING_ERROR_READ_ONLY);
+    assert(string_equals_cstr(&view, "borrowed"));
+    string_deinit(&view);
+    assert(string_format(NULL, "%d", 1) == STRING_ERROR_NULL_POINTER);
+
     printf("✅ String formatting tests passed\n");
 }
 
+/**
+ * @brief Test function for number conversion operations
+ * @details Tests number conversion functionality including:
+ *          - Integer, unsigned and hexadecimal appenders
+ *          - Shortest round-trip double output
+ *          - Integer and double parsers with error reporting
+ */
+void test_string_numbers(void) {
+    printf("Testing number conversion...\n");
+
+    string_t *str = string_create_from_cstr("n=");
+
+    // Test integer appenders
+    assert(string_append_int(str, -42) == STRING_SUCCESS);
+    assert(string_append_char(str, ',') == STRING_SUCCESS);
+    assert(string_append_int(str, INT64_MIN) == STRING_SUCCESS);
+    assert(string_append_char(str, ',') == STRING_SUCCESS);
+    assert(string_append_uint(str, UINT64_MAX) == STRING_SUCCESS);
+    assert(string_append_char(str, ',') == STRING_SUCCESS);
+    assert(string_append_hex(str, 0xdeadbeefULL) == STRING_SUCCESS);
+    assert(string_append_char(str, ',') == STRING_SUCCESS);
+    assert(string_append_hex(str, 0) == STRING_SUCCESS);
+    assert(string_equals_cstr(str, "n=-42,-9223372036854775808,18446744073709551615,deadbeef,0"));
+
+    // Test shortest round-trip doubles
+    const struct {
+        double value;
+        const char *text;
+    } doubles[] = {
+        {0.1, "0.1"}, {-2.5, "-2.5"}, {42.0, "42"}, {0.0, "0"}, {-0.0, "-0"},
+        {1.0 / 3.0, "0.3333333333333333"}, {1e-5, "0.00001"}, {1.5e-6, "1.5e-06"},
+        {1e21, "1e+21"}, {123456789012345680.0, "1.2345678901234568e+17"},
+        {5e-324, "5e-324"}, {1.7976931348623157e308, "1.7976931348623157e+308"},
+        {3.14159, "3.14159"}, {100.125, "100.125"}
+    };
+    for (size_t i = 0; i < sizeof(doubles) / sizeof(doubles[0]); ++i) {
+        assert(string_clear(str) == STRING_SUCCESS);
+        assert(string_append_double(str, doubles[i].value) == STRING_SUCCESS);
+        assert(string_equals_cstr(str, doubles[i].text));
+
+        double parsed = 1.0;
+        assert(string_to_double(str, &parsed) == STRING_SUCCESS);
+        assert(memcmp(&parsed, &doubles[i].value, sizeof(double)) == 0);
+    }
+
+    // Test non-finite doubles
+    assert(string_assign_cstr(str, "") == STRING_SUCCESS);
+    assert(string_append_double(str, HUGE_VAL) == STRING_SUCCESS);
+    assert(string_append_double(str, -HUGE_VAL) == STRING_SUCCESS);
+    assert(string_equals_cstr(str, "inf-inf"));
+
+    // Test integer parsing
+    int64_t number = 7;
+    assert(string_assign_cstr(str, "-9223372036854775808") == STRING_SUCCESS);
+    assert(string_to_int64(str, &number) == STRING_SUCCESS && number == INT64_MIN);
+    assert(string_assign_cstr(str, "+123") == STRING_SUCCESS);
+    assert(string_to_int64(str, &number) == STRING_SUCCESS && number == 123);
+    assert(string_assign_cstr(str, "9223372036854775808") == STRING_SUCCESS);
+    assert(string_to_int64(str, &number) == STRING_ERROR_OUT_OF_RANGE && number == 123);
+    assert(string_assign_cstr(str, "12a") == STRING_SUCCESS);
+    assert(string_to_int64(str, &number) == STRING_ERROR_INVALID_ARGUMENT);
+    assert(string_assign_cstr(str, " 1") == STRING_SUCCESS);
+    assert(string_to_int64(str, &number) == STRING_ERROR_INVALID_ARGUMENT);
+    assert(string_assign_cstr(str, "-") == STRING_SUCCESS);
+    assert(string_to_int64(str, &number) == STRING_ERROR_INVALID_ARGUMENT);
+
+    // Test double parsing, including the exact slow path
+    double real = 0.0;
+    assert(string_assign_cstr(str, "1.25e2") == STRING_SUCCESS);
+    assert(string_to_double(str, &real) == STRING_SUCCESS && real == 125.0);
+    assert(string_assign_cstr(str, ".5") == STRING_SUCCESS);
+    assert(string_to_double(str, &real) == STRING_SUCCESS && real == 0.5);
+    assert(string_assign_cstr(str, "2.2250738585072011e-308") == STRING_SUCCESS);
+    assert(string_to_double(str, &real) == STRING_SUCCESS && real == 2.2250738585072011e-308);
+    assert(string_assign_cstr(str, "0.30000000000000000000000000001") == STRING_SUCCESS);
+    assert(string_to_double(str, &real) == STRING_SUCCESS && real == 0.3);
+    assert(string_assign_cstr(str, "-Infinity") == STRING_SUCCESS);
+    assert(string_to_double(str, &real) == STRING_SUCCESS && real == -HUGE_VAL);
+    assert(string_assign_cstr(str, "NaN") == STRING_SUCCESS);
+    assert(string_to_double(str, &real) == STRING_SUCCESS && real != real);
+    assert(string_assign_cstr(str, "1e999") == STRING_SUCCESS);
+    assert(string_to_double(str, &real) == STRING_ERROR_OUT_OF_RANGE);
+    assert(string_assign_cstr(str, "1e") == STRING_SUCCESS);
+    assert(string_to_double(str, &real) == STRING_ERROR_INVALID_ARGUMENT);
+    assert(string_assign_cstr(str, ".") == STRING_SUCCESS);
+    assert(string_to_double(str, &real) == STRING_ERROR_INVALID_ARGUMENT);
+    assert(string_assign_cstr(str, "0x10") == STRING_SUCCESS);
+    assert(string_to_double(str, &real) == STRING_ERROR_INVALID_ARGUMENT);
+
+    // Test errors
+    assert(string_append_int(NULL, 1) == STRING_ERROR_NULL_POINTER);
+    assert(string_to_int64(str, NULL) == STRING_ERROR_NULL_POINTER);
+    assert(string_to_double(NULL, &real) == STRING_ERROR_NULL_POINTER);
+
+    string_destroy(str);
+
+    printf("✅ Number conversion tests passed\n");
+}
+
+/**
+ * @brief Test function for equality and string literal helpers
+ * @details Tests equality functionality including:
+ *          - Every length around the word-compare boundaries
+ *          - Cached hashes and shared buffers
+ *          - Embedded null bytes against C strings and literals
+ *          - The STRING_LIT() family
+ */
+void test_string_equality(void) {
+    printf("Testing string equality and literals...\n");
+
+    // Test a difference at every position for lengths around 4, 8 and 16
+    char bytes[40];
+    for (size_t i = 0; i < sizeof(bytes); ++i) {
+        bytes[i] = (char)('a' + i % 26);
+    }
+    for (size_t length = 0; length <= 33; ++length) {
+        string_t *a = string_create_from_buffer(bytes, length);
+        string_t *b = string_create_from_buffer(bytes, length);
+        assert(string_equals(a, b) && string_equals_buffer(a, bytes, length));
+        assert(string_view_equals(string_view_from_string(a), string_view_from_buffer(bytes, length)));
+        for (size_t i = 0; i < length; ++i) {
+            b->data[i] ^= 0x20;
+            assert(!string_equals(a, b) && !string_equals_buffer(b, bytes, length));
+            assert(!string_view_equals(string_view_from_string(a), string_view_from_string(b)));
+            b->data[i] ^= 0x20;
+        }
+        assert(!string_equals_buffer(a, bytes, length + 1));
+        string_destroy(b);
+        string_destroy(a);
+    }
+
+    // Test cached hashes and shared buffers give the same answers
+    string_t *first = string_create_from_cstr("the same content, long enough for the heap");
+    string_t *second = string_clone(first);
+    string_hash_cached(first);
+    assert(string_equals(first, second));
+    string_hash_cached(second);
+    assert(string_equals(first, second));
+    assert(string_set_at(second, 0, 'T') == STRING_SUCCESS);
+    string_hash_cached(second);
+    assert(!string_equals(first, second));
+    assert(string_make_shared(first) == STRING_SUCCESS);
+    string_t *shared = string_clone(first);
+    assert(string_equals(first, shared) && !string_equals(first, NULL) && string_equals(NULL, NULL));
+
+    // Test comparing with C strings uses the whole length
+    string_t *embedded = string_create_from_buffer("ab\0cd", 5);
+    assert(!string_equals_cstr(embedded, "ab"));
+    assert(string_compare_cstr(embedded, "ab") > 0);
+    assert(string_compare_cstr(embedded, "ac") < 0);
+    assert(string_equals_lit(embedded, "ab\0cd"));
+    assert(!string_equals_lit(embedded, "ab"));
+    assert(string_equals_cstr(NULL, NULL) && !string_equals_cstr(embedded, NULL));
+
+    // Test the literal helpers
+    string_view_t lit = STRING_LIT("key\0value");
+    assert(lit.length == 9 && lit.data[4] == 'v');
+    assert(STRING_LIT("").length == 0);
+    assert(string_append_lit(embedded, "\0ef") == STRING_SUCCESS);
+    assert(string_length(embedded) == 8 && string_equals_lit(embedded, "ab\0cd\0ef"));
+    assert(string_find_lit(embedded, "\0e", 0) == 5);
+    assert(string_find_lit(embedded, "cd", 0) == 3);
+    assert(string_find_lit(embedded, "zz", 0) == STRING_NPOS);
+    assert(string_view_equals(STRING_LIT("ab"), string_view_from_cstr("ab")));
+
+    string_destroy(embedded);
+    string_destroy(shared);
+    string_destroy(second);
+    string_destroy(first);
+
+    printf("✅ String equality and literal tests passed\n");
+}
+
+/**
+ * @brief Test function for batch operations over arrays of strings
+ * @details Tests batch functionality including:
+ *          - Case conversion validated before any string changes
+ *          - Comparing and finding against one key
+ *          - Finding a byte and summing lengths
+ *          - The same operations over views
+ */
+void test_string_batch(void) {
+    printf("Testing string batch operations...\n");
+
+    string_t *shared = string_create_from_cstr("Shared Buffer Content That Lives On The Heap");
+    assert(string_make_shared(shared) == STRING_SUCCESS);
+    string_t *sharer = string_clone(shared);
+    string_t *strings[] = {
+        string_create_from_cstr("Alpha"),
+        string_create_from_cstr("BETA"),
+        string_create_from_cstr(""),
+        string_create_from_cstr("gamma:Delta"),
+        sharer,
+        string_create_from_cstr("beta"),
+    };
+    size_t count = sizeof(strings) / sizeof(strings[0]);
+
+    // Test a read-only or NULL entry rejects the whole batch
+    string_t borrowed;
+    assert(string_init_view(&borrowed, string_view_from_cstr("Borrowed")) == STRING_SUCCESS);
+    string_t *with_borrowed[] = { strings[0], &borrowed };
+    assert(string_batch_to_lower(with_borrowed, 2) == STRING_ERROR_READ_ONLY);
+    assert(string_equals_cstr(strings[0], "Alpha"));
+    string_t *with_null[] = { strings[0], NULL };
+    assert(string_batch_to_upper(with_null, 2) == STRING_ERROR_NULL_POINTER);
+    assert(string_equals_cstr(strings[0], "Alpha"));
+    assert(string_batch_to_lower(NULL, 1) == STRING_ERROR_NULL_POINTER);
+    assert(string_batch_to_lower(NULL, 0) == STRING_SUCCESS);
+
+    // Test case conversion, detaching shared buffers
+    assert(string_batch_to_lower(strings, count) == STRING_SUCCESS);
+    assert(string_equals_cstr(strings[0], "alpha") && string_equals_cstr(strings[1], "beta"));
+    assert(string_equals_cstr(strings[3], "gamma:delta"));
+    assert(string_equals_cstr(sharer, "shared buffer content that lives on the heap"));
+    assert(string_equals_cstr(shared, "Shared Buffer Content That Lives On The Heap"));
+    assert(string_batch_to_upper(strings, 2) == STRING_SUCCESS);
+    assert(string_equals_cstr(strings[1], "BETA") && string_equals_cstr(strings[5], "beta"));
+
+    // Test comparing against one key
+    const string_t *const *readonly = (const string_t *const *)strings;
+    bool matches[6];
+    assert(string_batch_count_equal(readonly, count, string_view_from_cstr("beta"), matches) == 1);
+    assert(!matches[0] && !matches[1] && matches[5]);
+    assert(string_batch_count_equal(readonly, count, string_view_from_cstr(""), NULL) == 1);
+    assert(string_batch_find_equal(readonly, count, string_view_from_cstr("BETA")) == 1);
+    assert(string_batch_find_equal(readonly, count, string_view_from_cstr("BET")) == STRING_NPOS);
+    assert(string_batch_find_equal(NULL, count, string_view_from_cstr("BETA")) == STRING_NPOS);
+    string_view_t invalid = { NULL, 4 };
+    assert(string_batch_count_equal(readonly, count, invalid, matches) == 0 && !matches[5]);
+
+    // Test finding a byte and summing lengths
+    size_t position = 0;
+    assert(string_batch_find_char(readonly, count, ':', &position) == 3 && position == 5);
+    assert(string_batch_find_char(readonly, count, 'h', &position) == 4 && position == 1);
+    assert(string_batch_find_char(readonly, count, '#', NULL) == STRING_NPOS);
+    assert(string_batch_total_length(readonly, count) == 5 + 4 + 0 + 11 + 44 + 4);
+    const string_t *with_gap[] = { strings[0], NULL, strings[1] };
+    assert(string_batch_total_length(with_gap, 3) == 9);
+    assert(string_batch_find_equal(with_gap, 3, string_view_from_cstr("")) == 1);
+
+    // Test the view variants
+    string_view_t views[] = {
+        string_view_from_cstr("red"),
+        string_view_from_cstr("green"),
+        string_view_from_buffer("gr\0en", 5),
+        string_view_from_cstr("green"),
+    };
+    assert(string_batch_count_equal_views(views, 4, string_view_from_cstr("green"), matches) == 2);
+    assert(!matches[0] && matches[1] && !matches[2] && matches[3]);
+    assert(string_batch_find_equal_views(views, 4, string_view_from_buffer("gr\0en", 5)) == 2);
+    assert(string_batch_find_char_views(views, 4, '\0', &position) == 2 && position == 2);
+    assert(string_batch_find_char_views(views, 4, 'n', &position) == 1 && position == 4);
+    assert(string_batch_total_length_views(views, 4) == 18);
+    string_view_t huge[] = { { "a", SIZE_MAX }, { "b", 1 } };
+    assert(string_batch_total_length_views(huge, 2) == SIZE_MAX);
+    assert(string_batch_total_length_views(NULL, 2) == 0);
+
+    for (size_t i = 0; i < count; ++i) {
+        string_destroy(strings[i]);
+    }
+    string_destroy(shared);
+    string_deinit(&borrowed);
+
+    printf("✅ String batch operation tests passed\n");
+}
+
+/**
+ * @brief Test function for string view operations
+ * @details Tests non-owning view functionality including:
+ *          - Views over strings, buffers and C strings
+ *          - Substring and slice without copying
+ *          - Compare, find and hash on views
+ *          - Read-only borrowed strings and conversions
+ */
+void test_string_views(void) {
+    printf("Testing string views...\n");
+
+    string_t *str = string_create_from_cstr("key=value; other=thing");
+
+    // Test zero-copy substring
+    string_view_t key = string_substr_view(str, 0, 3);
+    assert(key.data == string_cstr(str));
+    assert(key.length == 3);
+    string_view_t value = string_view_slice(string_view_from_string(str), 4, 9);
+    assert(string_view_equals(value, string_view_from_cstr("value")));
+    assert(string_view_substr(value, 10, 2).length == 0);
+    assert(string_view_substr(value, 2, STRING_NPOS).length == 3);
+
+    // Test compare and hash
+    assert(string_view_compare(key, string_view_from_cstr("kez")) < 0);
+    assert(string_view_compare(key, string_view_from_cstr("ke")) > 0);
+    assert(string_view_hash(key) == string_view_hash(string_view_from_buffer("key", 3)));
+    assert(string_view_hash(key) != string_view_hash(value));
+
+    // Test find on views, including embedded null bytes
+    string_view_t whole = string_view_from_string(str);
+    assert(string_view_find_char(whole, ';', 0) == 9);
+    assert(string_view_rfind_char(whole, '=', STRING_NPOS) == 16);
+    assert(string_view_find(whole, string_view_from_cstr("other"), 0) == 11);
+    assert(string_view_find(whole, string_view_from_cstr("missing"), 0) == STRING_NPOS);
+    const char binary[] = {'a', '\0', 'b', 'a', '\0', 'c'};
+    assert(string_view_find(string_view_from_buffer(binary, 6), string_view_from_buffer("\0c", 2), 0) == 4);
+
+    // Test conversions to and from string_t
+    string_t *copy = string_create_from_view(value);
+    assert(string_equals_cstr(copy, "value"));
+    assert(string_append_view(copy, string_view_substr(value, 0, 2)) == STRING_SUCCESS);
+    assert(string_equals_cstr(copy, "valueva"));
+    assert(string_assign_view(copy, string_substr_view(copy, 5, 2)) == STRING_SUCCESS);
+    assert(string_equals_cstr(copy, "va"));
+    string_destroy(copy);
+
+    // Test borrowed strings are read-only
+    string_t borrowed;
+    assert(string_init_view(&borrowed, string_substr_view(str, 11, STRING_NPOS)) == STRING_SUCCESS);
+    assert(!borrowed.is_owner);
+    assert(string_length(&borrowed) == 11);
+    assert(string_find_char(&borrowed, '=', 0) == 5);
+    assert(string_append_char(&borrowed, '!') == STRING_ERROR_READ_ONLY);
+    assert(string_set_at(&borrowed, 0, 'O') == STRING_ERROR_READ_ONLY);
+    assert(string_to_upper(&borrowed) == STRING_ERROR_READ_ONLY);
+    assert(string_clear(&borrowed) == STRING_ERROR_READ_ONLY);
+    assert(string_equals_cstr(str, "key=value; other=thing"));
+    string_deinit(&borrowed);
+
+    string_destroy(str);
+
+    printf("✅ String view tests passed\n");
+}
+
+/**
+ * @brief Test function for tokenizers
+ * @details Tests tokenizer functionality including:
+ *          - Splitting on a byte, a byte set and a byte sequence
+ *          - Empty, leading and trailing fields
+ *          - Batch splitting across several calls at every SIMD level
+ */
+void test_string_tokenizer(void) {
+    printf("Testing tokenizers...\n");
+
+    string_tokenizer_t tok;
+    string_view_t token;
+    string_view_t tokens[4];
+
+    // Test single-byte splitting keeps empty fields
+    string_t *csv = string_create_from_cstr("a,,bc,");
+    assert(string_tokenizer_init(&tok, string_view_from_string(csv), ',') == STRING_SUCCESS);
+    assert(string_tokenizer_next(&tok, &token) && string_view_equals(token, string_view_from_cstr("a")));
+    assert(token.data == string_cstr(csv));
+    assert(string_tokenizer_next(&tok, &token) && token.length == 0);
+    assert(string_tokenizer_next(&tok, &token) && string_view_equals(token, string_view_from_cstr("bc")));
+    assert(string_tokenizer_next(&tok, &token) && token.length == 0);
+    assert(!string_tokenizer_next(&tok, &token));
+    assert(string_tokenizer_next_batch(&tok, tokens, 4) == 0);
+    string_destroy(csv);
+
+    // Test an empty input yields one empty token
+    assert(string_tokenizer_init(&tok, string_view_from_cstr(""), ',') == STRING_SUCCESS);
+    assert(string_tokenizer_next(&tok, &token) && token.length == 0);
+    assert(!string_tokenizer_next(&tok, &token));
+
+    // Test splitting on any byte of a set
+    assert(string_tokenizer_init_any(&tok, string_view_from_cstr("k=v; x\ty"), string_view_from_cstr("=; \t")) == STRING_SUCCESS);
+    assert(string_tokenizer_next_batch(&tok, tokens, 4) == 4);
+    assert(string_view_equals(tokens[0], string_view_from_cstr("k")));
+    assert(string_view_equals(tokens[1], string_view_from_cstr("v")));
+    assert(tokens[2].length == 0);
+    assert(string_view_equals(tokens[3], string_view_from_cstr("x")));
+    assert(string_tokenizer_next_batch(&tok, tokens, 4) == 1);
+    assert(string_view_equals(tokens[0], string_view_from_cstr("y")));
+
+    // Test splitting on a byte sequence without overlaps
+    assert(string_tokenizer_init_substr(&tok, string_view_from_cstr("a::b:::c"), string_view_from_cstr("::")) == STRING_SUCCESS);
+    assert(string_tokenizer_next(&tok, &token) && string_view_equals(token, string_view_from_cstr("a")));
+    assert(string_tokenizer_next(&tok, &token) && string_view_equals(token, string_view_from_cstr("b")));
+    assert(string_tokenizer_next(&tok, &token) && string_view_equals(token, string_view_from_cstr(":c")));
+    assert(!string_tokenizer_next(&tok, &token));
+
+    // Test batch splitting of a long line matches token-by-token splitting
+    string_t *line = string_create_from_cstr("");
+    for (int i = 0; i < 100; ++i) {
+        assert(string_append_format(line, i % 9 ? "f%d|" : "|", i) == STRING_SUCCESS);
+    }
+    assert(string_append_cstr(line, "end") == STRING_SUCCESS);
+    string_simd_t original = string_get_simd_level();
+    for (int level = STRING_SIMD_NONE; level <= STRING_SIMD_NEON; ++level) {
+        if (string_set_simd_level((string_simd_t)level) != (string_simd_t)level) {
+            continue;
+        }
+
+        string_tokenizer_t single, batch;
+        assert(string_tokenizer_init(&single, string_view_from_string(line), '|') == STRING_SUCCESS);
+        assert(string_tokenizer_init(&batch, string_view_from_string(line), '|') == STRING_SUCCESS);
+        size_t total = 0;
+        size_t count;
+        while ((count = string_tokenizer_next_batch(&batch, tokens, 3)) > 0) {
+            for (size_t i = 0; i < count; ++i) {
+                assert(string_tokenizer_next(&single, &token));
+                assert(token.data == tokens[i].data && token.length == tokens[i].length);
+            }
+            total += count;
+        }
+        assert(total == 101);
+        assert(string_view_equals(tokens[(total - 1) % 3], string_view_from_cstr("end")));
+        assert(!string_tokenizer_next(&single, &token));
+    }
+    string_set_simd_level(original);
+    string_destroy(line);
+
+    // Test error handling
+    assert(string_tokenizer_init(NULL, string_view_from_cstr("x"), ',') == STRING_ERROR_NULL_POINTER);
+    assert(string_tokenizer_init_any(&tok, string_view_from_cstr("x"), string_view_from_cstr("")) == STRING_ERROR_INVALID_ARGUMENT);
+    assert(string_tokenizer_init_substr(&tok, string_view_from_cstr("x"), string_view_from_cstr("")) == STRING_ERROR_INVALID_ARGUMENT);
+    assert(!string_tokenizer_next(NULL, &token));
+    assert(string_tokenizer_next_batch(NULL, tokens, 4) == 0);
+
+    printf("✅ Tokenizer tests passed\n");
+}
+
 /**
  * @brief Test function for string safety features
  * @details Tests string safety functionality including:
@@ -287,13 +1497,24 @@ void test_string_safety(void) {
  * @brief Main test runner function
  * @details Executes all test suites for the safe strings library including:
  *          - String creation tests
+ *          - Small-string optimization tests
+ *          - Caller-owned string initialization tests
+ *          - Capacity growth tests
  *          - String assignment tests
+ *          - Shared copy-on-write string tests
+ *          - Ownership transfer tests
  *          - String concatenation tests
  *          - String insertion tests
  *          - String removal tests
  *          - String searching tests
+ *          - Vectorized character searching tests
+ *          - Substring search engine tests
  *          - String utility tests
+ *          - Case-insensitive operation tests
  *          - String formatting tests
+ *          - Number conversion tests
+ *          - String view tests
+ *          - Tokenizer tests
  *          - String safety tests
  * @return int Returns 0 on successful completion of all tests
  */
@@ -301,13 +1522,27 @@ int main(void) {
     printf("Running strings safety library tests...\n\n");
 
     test_string_creation();
+    test_string_sso();
+    test_string_init();
+    test_string_growth();
     test_string_assignment();
+    test_string_shared();
+    test_string_ownership();
     test_string_concatenation();
     test_string_insertion();
     test_string_removal();
     test_string_searching();
+    test_string_simd_searching();
+    test_string_substring_search();
     test_string_utility();
+    test_string_trimming();
+    test_string_case();
     test_string_formatting();
+    test_string_numbers();
+    test_string_equality();
+    test_string_batch();
+    test_string_views();
+    test_string_tokenizer();
     test_string_safety();
 
     printf("\n🎉 All tests passed! The strings library is working correctly.\n");
@@ -0,0 +1,370 @@
+/**
+ * @file sstring-utf8-test.c
+ * @brief Test suite for the safe strings UTF-8 functions
+ * @author Antonio Bernardini
+ * @date 2025
+ *
+ * This file contains unit tests for UTF-8 validation, code point counting and
+ * indexing, and UTF-16 and UTF-32 transcoding. The validator is checked at
+ * every SIMD level against a plain reference decoder, on fixed edge cases and
+ * on randomly mutated text with sequences placed across block boundaries.
+ */
+
+#include <assert.h>
+
+#include "sstring.h"
+#include "sstring_utf8.h"
+
+/** @brief SIMD levels every scan is checked at (unsupported ones fall back) */
+static const string_simd_t test_levels[] = { STRING_SIMD_NONE, STRING_SIMD_SSE2, STRING_SIMD_AVX2, STRING_SIMD_NEON };
+
+/** @brief Number of entries in test_levels */
+#define TEST_LEVEL_COUNT (sizeof(test_levels) / sizeof(test_levels[0]))
+
+/**
+ * @brief Reference validator written straight from Unicode table 3-7
+ * @param data Bytes to check
+ * @param length Number of bytes
+ * @return Offset of the first invalid sequence, or STRING_NPOS
+ */
+static size_t reference_invalid(const unsigned char *data, size_t length) {
+    size_t i = 0;
+    while (i < length) {
+        unsigned char b = data[i];
+        size_t n;
+        unsigned char low = 0x80;
+        unsigned char high = 0xBF;
+        if (b <= 0x7F) {
+            i++;
+            continue;
+        } else if (b >= 0xC2 && b <= 0xDF) {
+            n = 2;
+        } else if (b == 0xE0) {
+            n = 3;
+            low = 0xA0;
+        } else if (b == 0xED) {
+            n = 3;
+            high = 0x9F;
+        } else if (b >= 0xE1 && b <= 0xEF) {
+            n = 3;
+        } else if (b == 0xF0) {
+            n = 4;
+            low = 0x90;
+        } else if (b == 0xF4) {
+            n = 4;
+            high = 0x8F;
+        } else if (b >= 0xF1 && b <= 0xF3) {
+            n = 4;
+        } else {
+            return i;
+        }
+
+        if (i + n > length || data[i + 1] < low || data[i + 1] > high) {
+            return i;
+        }
+        for (size_t k = 2; k < n; ++k) {
+            if (data[i + k] < 0x80 || data[i + k] > 0xBF) {
+                return i;
+            }
+        }
+        i += n;
+    }
+    return STRING_NPOS;
+}
+
+/**
+ * @brief Check the validator agrees with the reference at every SIMD level
+ * @param data Bytes to check
+ * @param length Number of bytes
+ */
+static void check_validator(const char *data, size_t length) {
+    size_t expected = reference_invalid((const unsigned char *)data, length);
+    string_simd_t saved = string_get_simd_level();
+    for (size_t level = 0; level < TEST_LEVEL_COUNT; ++level) {
+        string_set_simd_level(test_levels[level]);
+        assert(string_utf8_find_invalid(string_view_from_buffer(data, length)) == expected);
+    }
+    string_set_simd_level(saved);
+}
+
+/**
+ * @brief Small deterministic generator for the randomized tests
+ * @param state Generator state
+ * @return Next pseudo-random value
+ */
+static uint32_t next_random(uint32_t *state) {
+    *state = *state * 1664525u + 1013904223u;
+    return *state >> 8;
+}
+
+/**
+ * @brief Test function for UTF-8 validation
+ * @details Tests validation including:
+ *          - Every kind of malformed sequence from table 3-7
+ *          - Sequences straddling 16- and 32-byte block boundaries
+ *          - Sequences truncated by the end of input
+ *          - Randomly mutated text at every SIMD level
+ */
+void test_utf8_validation(void) {
+    printf("Testing UTF-8 validation...\n");
+
+    // Test fixed edge cases
+    const char *cases[] = {
+        "", "plain ascii", "caf\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80", "\xF4\x8F\xBF\xBF",
+        "\xC0\xAF", "\xC1\xBF", "\xE0\x9F\xBF", "\xF0\x8F\xBF\xBF", "\xED\xA0\x80", "\xED\xBF\xBF",
+        "\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xFF", "\x80", "\xBF\xBF", "\xC3", "\xE2\x82",
+        "\xF0\x9F\x98", "\xC3\xA9\xA9", "\xE2\x28\xA1", "\xF0\x9F\x28\x80", "\xED\x9F\xBF", "\xEE\x80\x80",
+    };
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+        check_validator(cases[i], strlen(cases[i]));
+    }
+    assert(string_utf8_find_invalid(string_view_from_cstr("ab\xC3\xA9""cd\xED\xA0\x80")) == 6);
+    assert(string_utf8_is_valid(string_view_from_cstr("\xE2\x82\xAC")));
+    assert(!string_utf8_is_valid(string_view_from_cstr("\xE2\x82")));
+
+    // Test every sequence placed at every offset around the block boundaries
+    char text[160];
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+        size_t n = strlen(cases[i]);
+        for (size_t at = 0; at + n <= 100; ++at) {
+            memset(text, 'a', sizeof(text));
+            memcpy(text + at, cases[i], n);
+            check_validator(text, 100);
+            check_validator(text, at + n);
+        }
+    }
+
+    // Test randomly mutated valid text
+    const char *pieces[] = { "a", "Z", "\xC3\xA9", "\xDF\xBF", "\xE2\x82\xAC", "\xEF\xBF\xBF", "\xF0\x9F\x98\x80", "\xF4\x8F\xBF\xBF" };
+    uint32_t state = 12345;
+    char buffer[600];
+    for (size_t round = 0; round < 4000; ++round) {
+        size_t length = 0;
+        size_t target = next_random(&state) % 580;
+        while (length < target) {
+            const char *piece = pieces[next_random(&state) % (round % 3 == 0 ? 2 : 8)];
+            size_t n = strlen(piece);
+            memcpy(buffer + length, piece, n);
+            length += n;
+        }
+        check_validator(buffer, length);
+
+        size_t mutations = next_random(&state) % 3;
+        for (size_t m = 0; m < mutations && length > 0; ++m) {
+            buffer[next_random(&state) % length] = (char)next_random(&state);
+        }
+        check_validator(buffer, length);
+        if (length > 0) {
+            check_validator(buffer, length - 1 - next_random(&state) % (length < 4 ? length : 4));
+        }
+    }
+
+    printf("✅ UTF-8 validation tests passed\n");
+}
+
+/**
+ * @brief Test function for the validated bit
+ * @details Tests the bit including:
+ *          - Checking and creating strings as UTF-8
+ *          - Clearing by any modification, but not by capacity changes
+ *          - Propagation to clones
+ */
+void test_utf8_validated_bit(void) {
+    printf("Testing UTF-8 validated strings...\n");
+
+    string_t *str = string_create_from_cstr("gr\xC3\xBC\xC3\x9F");
+    assert(!str->is_utf8);
+    assert(string_is_utf8(str) && !str->is_utf8);
+    assert(string_check_utf8(str) && str->is_utf8);
+
+    string_t *clone = string_clone(str);
+    assert(clone->is_utf8);
+
+    // Test growing the buffer keeps the bit
+    assert(string_reserve(str, 128) == STRING_SUCCESS && str->is_utf8);
+    assert(string_shrink_to_fit(str) == STRING_SUCCESS && str->is_utf8);
+
+    // Test any modification clears the bit, even a valid one
+    assert(string_append_cstr(str, "e") == STRING_SUCCESS);
+    assert(!str->is_utf8);
+    assert(string_check_utf8(str));
+    assert(string_append_char(str, (char)0xC3) == STRING_SUCCESS);
+    assert(!str->is_utf8 && !string_check_utf8(str) && !str->is_utf8);
+    assert(string_to_upper(clone) == STRING_SUCCESS);
+    assert(!clone->is_utf8);
+
+    // Test creating from UTF-8 validates
+    string_t *created = string_create_from_utf8("\xE2\x82\xAC 5", 5);
+    assert(created != NULL && created->is_utf8);
+    assert(string_create_from_utf8("\xE2\x82", 2) == NULL);
+    assert(string_create_from_utf8(NULL, 1) == NULL);
+    assert(!string_is_utf8(NULL) && !string_check_utf8(NULL));
+
+    string_destroy(created);
+    string_destroy(clone);
+    string_destroy(str);
+
+    printf("✅ UTF-8 validated string tests passed\n");
+}
+
+/**
+ * @brief Test function for code point counting, indexing and decoding
+ * @details Tests code points including:
+ *          - Counting at every SIMD level on long text
+ *          - Offsets of every code point and past the end
+ *          - Decoding and encoding round trips
+ */
+void test_utf8_code_points(void) {
+    printf("Testing UTF-8 code points...\n");
+
+    // Build text of mixed widths, long enough to span several index blocks
+    string_t *str = string_create();
+    uint32_t points[1000];
+    size_t offsets[1000];
+    for (size_t i = 0; i < 1000; ++i) {
+        uint32_t widths[] = { 0x41, 0xE9, 0x20AC, 0x1F600 };
+        points[i] = widths[(i * 7) % 4] + (uint32_t)(i % 5);
+        offsets[i] = string_length(str);
+        assert(string_append_code_point(str, points[i]) == STRING_SUCCESS);
+    }
+    assert(str->is_utf8);
+    string_view_t view = string_view_from_string(str);
+
+    string_simd_t saved = string_get_simd_level();
+    for (size_t level = 0; level < TEST_LEVEL_COUNT; ++level) {
+        string_set_simd_level(test_levels[level]);
+        assert(string_utf8_length(view) == 1000);
+        for (size_t i = 0; i < 1000; i += 37) {
+            assert(string_utf8_offset(view, i) == offsets[i]);
+        }
+    }
+    string_set_simd_level(saved);
+    assert(string_utf8_offset(view, 999) == offsets[999]);
+    assert(string_utf8_offset(view, 1000) == string_length(str));
+    assert(string_utf8_offset(view, 1001) == STRING_NPOS);
+
+    // Test decoding walks the same code points back
+    size_t offset = 0;
+    for (size_t i = 0; i < 1000; ++i) {
+        uint32_t code_point;
+        assert(offset == offsets[i]);
+        assert(string_utf8_decode(view, &offset, &code_point) == STRING_SUCCESS);
+        assert(code_point == points[i]);
+    }
+    uint32_t code_point;
+    assert(string_utf8_decode(view, &offset, &code_point) == STRING_ERROR_INVALID_INDEX);
+
+    // Test malformed input and invalid code points
+    string_view_t bad = string_view_from_cstr("\xE2\x82" "a\xED\xA0\x80");
+    offset = 0;
+    assert(string_utf8_decode(bad, &offset, &code_point) == STRING_ERROR_INVALID_ENCODING);
+    assert(offset == 0);
+    offset = 2;
+    assert(string_utf8_decode(bad, &offset, &code_point) == STRING_SUCCESS && code_point == 'a');
+    assert(string_utf8_decode(bad, &offset, &code_point) == STRING_ERROR_INVALID_ENCODING);
+    assert(string_append_code_point(str, 0xD800) == STRING_ERROR_INVALID_ENCODING);
+    assert(string_append_code_point(str, 0x110000) == STRING_ERROR_INVALID_ENCODING);
+    assert(string_append_code_point(NULL, 'a') == STRING_ERROR_NULL_POINTER);
+    assert(string_utf8_length(string_view_from_cstr("")) == 0);
+    assert(string_utf8_offset(string_view_from_cstr(""), 0) == 0);
+
+    string_destroy(str);
+
+    printf("✅ UTF-8 code point tests passed\n");
+}
+
+/**
+ * @brief Test function for UTF-16 and UTF-32 transcoding
+ * @details Tests transcoding including:
+ *          - Round trips through both encodings at every SIMD level
+ *          - Surrogate pairs and long ASCII runs
+ *          - Length queries and buffers that are too small
+ *          - Rejecting invalid input on both sides
+ */
+void test_utf8_transcoding(void) {
+    printf("Testing UTF transcoding...\n");
+
+    string_t *str = string_create();
+    for (size_t i = 0; i < 300; ++i) {
+        assert(string_append_cstr(str, i % 50 == 0 ? "\xF0\x9F\x98\x80\xC3\xA9\xE2\x82\xAC" : "ascii run ") == STRING_SUCCESS);
+    }
+    size_t code_points = string_utf8_length(string_view_from_string(str));
+
+    string_simd_t saved = string_get_simd_level();
+    for (size_t level = 0; level < TEST_LEVEL_COUNT; ++level) {
+        string_set_simd_level(test_levels[level]);
+
+        // Test UTF-16 length query, conversion and the way back
+        size_t length = 0;
+        assert(string_to_utf16(str, NULL, 0, &length) == STRING_SUCCESS);
+        assert(length == code_points + 6);
+        uint16_t *units = malloc(length * sizeof(uint16_t));
+        assert(string_to_utf16(str, units, length - 1, &length) == STRING_ERROR_BUFFER_TOO_SMALL);
+        assert(length == code_points + 6);
+        assert(string_to_utf16(str, units, length, &length) == STRING_SUCCESS);
+        assert(units[0] == 0xD83D && units[1] == 0xDE00 && units[2] == 0xE9 && units[3] == 0x20AC && units[4] == 'a');
+
+        string_t *back = string_create();
+        assert(string_append_utf16(back, units, length) == STRING_SUCCESS);
+        assert(string_equals(back, str) && back->is_utf8);
+        free(units);
+
+        // Test UTF-32 the same way
+        assert(string_to_utf32(str, NULL, 0, &length) == STRING_SUCCESS && length == code_points);
+        uint32_t *points = malloc(length * sizeof(uint32_t));
+        assert(string_to_utf32(str, points, 3, &length) == STRING_ERROR_BUFFER_TOO_SMALL);
+        assert(string_to_utf32(str, points, length, &length) == STRING_SUCCESS);
+        assert(points[0] == 0x1F600 && points[1] == 0xE9);
+        assert(string_clear(back) == STRING_SUCCESS);
+        assert(string_append_utf32(back, points, length) == STRING_SUCCESS);
+        assert(string_equals(back, str));
+        free(points);
+        string_destroy(back);
+    }
+    string_set_simd_level(saved);
+
+    // Test invalid input on both sides leaves the destination unchanged
+    string_t *bad = string_create_from_cstr("ok\xC3");
+    size_t length = 99;
+    assert(string_to_utf16(bad, NULL, 0, &length) == STRING_ERROR_INVALID_ENCODING && length == 0);
+    length = 99;
+    assert(string_to_utf32(bad, NULL, 0, &length) == STRING_ERROR_INVALID_ENCODING && length == 0);
+    const uint16_t lone[] = { 'a', 0xDC00, 'b' };
+    const uint16_t unpaired[] = { 'a', 0xD800 };
+    const uint32_t surrogate[] = { 'a', 0xDFFF };
+    assert(string_append_utf16(str, lone, 3) == STRING_ERROR_INVALID_ENCODING);
+    assert(string_append_utf16(str, unpaired, 2) == STRING_ERROR_INVALID_ENCODING);
+    assert(string_append_utf32(str, surrogate, 2) == STRING_ERROR_INVALID_ENCODING);
+    assert(string_utf8_length(string_view_from_string(str)) == code_points);
+    assert(string_to_utf16(NULL, NULL, 0, &length) == STRING_ERROR_NULL_POINTER);
+    assert(string_append_utf16(str, NULL, 1) == STRING_ERROR_NULL_POINTER);
+
+    // Test the validated bit survives a valid append and conversion skips the scan
+    assert(string_check_utf8(str));
+    const uint16_t greek[] = { 0x3B1, 0x3B2 };
+    assert(string_append_utf16(str, greek, 2) == STRING_SUCCESS);
+    assert(str->is_utf8);
+
+    string_destroy(bad);
+    string_destroy(str);
+
+    printf("✅ UTF transcoding tests passed\n");
+}
+
+/**
+ * @brief Main test runner function
+ * @details Executes all string UTF-8 test suites
+ * @return int Returns 0 on successful completion of all tests
+ */
+int main(void) {
+    printf("Running strings UTF-8 tests...\n\n");
+
+    test_utf8_validation();
+    test_utf8_validated_bit();
+    test_utf8_code_points();
+    test_utf8_transcoding();
+
+    printf("\n🎉 All UTF-8 tests passed!\n");
+
+    return 0;
+}